@@ -477,6 +477,9 @@ struct MapCompilerOptions
     /// <summary> Maximum num of parallel threads. </summary>
     int maxThreads = 4;
 
+    /// <summary> How to divide the iterations of parallel loops among threads ("staticBlocks" or "workStealing"). </summary>
+    std::string parallelSchedulingPolicy = "staticBlocks";
+
     /// <summary> Allow emitting more efficient code that isn't necessarily IEEE-754 compatible. </summary>
     bool useFastMath = true;
 
@@ -183,6 +183,7 @@ class ConvolutionMethod:
     simple = ConvolutionMethod_simple
     winograd = ConvolutionMethod_winograd
     unrolled = ConvolutionMethod_unrolled
+    tiled = ConvolutionMethod_tiled
 
 # Remove flat defines so callers only see the class above
 del ConvolutionMethod_automatic
@@ -190,6 +191,7 @@ del ConvolutionMethod_diagonal
 del ConvolutionMethod_simple
 del ConvolutionMethod_winograd
 del ConvolutionMethod_unrolled
+del ConvolutionMethod_tiled
 
 # Python friendly class for EpsilonSummand
 class EpsilonSummand:
@@ -19,6 +19,7 @@
 
 #include <dsp/include/FilterBank.h>
 
+#include <emitters/include/CompilerOptions.h>
 #include <emitters/include/ModuleEmitter.h>
 
 #include <model/include/InputNode.h>
@@ -957,6 +958,7 @@ CompiledMap Map::Compile(const std::string& targetDevice, const std::string& mod
     settings.compilerSettings.parallelize = compilerSettings.parallelize;
     settings.compilerSettings.useThreadPool = compilerSettings.useThreadPool;
     settings.compilerSettings.maxThreads = compilerSettings.maxThreads;
+    settings.compilerSettings.parallelSchedulingPolicy = ell::utilities::FromString<ell::emitters::ParallelSchedulingPolicy>(compilerSettings.parallelSchedulingPolicy);
     settings.compilerSettings.useFastMath = compilerSettings.useFastMath;
     settings.compilerSettings.includeDiagnosticInfo = compilerSettings.includeDiagnosticInfo;
     settings.compilerSettings.useBlas = compilerSettings.useBlas;
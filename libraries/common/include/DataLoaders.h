@@ -17,8 +17,10 @@
 
 #include <utilities/include/StringUtil.h>
 
+#include <algorithm>
 #include <istream>
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -96,6 +98,7 @@ namespace common
 #pragma region implementation
 
 #include <data/include/SingleLineParsingExampleIterator.h>
+#include <data/include/StlIndexValueIterator.h>
 
 #include <model/include/IRCompiledMap.h>
 #include <model/include/IRMapCompiler.h>
@@ -183,6 +186,56 @@ namespace common
 
             jitter.DefineFunction(callback, callbackAddress);
         }
+
+        // Runs a dataset through a compiled map a batch of examples at a time, which avoids a separate call into the
+        // jitted code (and a copy of its output) for each example
+        template <typename InputType, typename OutputType, typename ExampleType, typename CompiledMapType>
+        data::Dataset<ExampleType> ComputeDatasetInBatches(data::Dataset<ExampleType>& input, CompiledMapType& compiledMap)
+        {
+            constexpr size_t maxBatchSize = 256;
+            const auto inputSize = compiledMap.GetInputSize();
+            const auto outputSize = compiledMap.GetOutputSize();
+            std::vector<InputType> inputs(maxBatchSize * inputSize);
+            std::vector<OutputType> outputs(maxBatchSize * outputSize);
+
+            data::Dataset<ExampleType> result;
+            const auto numExamples = input.NumExamples();
+            for (size_t batchStart = 0; batchStart < numExamples; batchStart += maxBatchSize)
+            {
+                const auto batchSize = std::min(maxBatchSize, numExamples - batchStart);
+                for (size_t index = 0; index < batchSize; ++index)
+                {
+                    auto data = input.GetExample(batchStart + index).GetDataVector().ToArray(inputSize);
+                    std::transform(data.begin(), data.end(), inputs.begin() + index * inputSize, [](double val) { return static_cast<InputType>(val); });
+                }
+
+                compiledMap.ComputeBatch(inputs.data(), batchSize, outputs.data());
+
+                for (size_t index = 0; index < batchSize; ++index)
+                {
+                    std::vector<OutputType> output(outputs.begin() + index * outputSize, outputs.begin() + (index + 1) * outputSize);
+                    typename ExampleType::DataVectorType transformedDataVector(data::MakeVectorIndexValueIterator<data::IterationPolicy::skipZeros>(output));
+                    result.AddExample(ExampleType(std::move(transformedDataVector), input.GetExample(batchStart + index).GetMetadata()));
+                }
+            }
+            return result;
+        }
+
+        template <typename InputType, typename ExampleType, typename CompiledMapType>
+        data::Dataset<ExampleType> TransformDatasetInBatches(data::Dataset<ExampleType>& input, CompiledMapType& compiledMap)
+        {
+            auto type = compiledMap.GetOutputType();
+            switch (type)
+            {
+            case model::Port::PortType::smallReal:
+                return ComputeDatasetInBatches<InputType, float>(input, compiledMap);
+            case model::Port::PortType::real:
+                return ComputeDatasetInBatches<InputType, double>(input, compiledMap);
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch,
+                    utilities::FormatString("Unexpected output type %d, expecting float or double", type));
+            }
+        }
     } // namespace detail
 
     template <typename ExampleType, typename MapType>
@@ -217,24 +270,9 @@ namespace common
             switch (type)
             {
             case model::Port::PortType::smallReal:
-            {
-                return input.template Transform<ExampleType>([&compiledMap](const ExampleType& example) {
-                    auto data = example.GetDataVector().ToArray();
-                    std::vector<float> smallData(data.size());
-                    std::transform(data.begin(), data.end(), smallData.begin(), [](double val) { return static_cast<float>(val); });
-                    compiledMap.SetInputValue(0, smallData);
-                    auto transformedDataVector = compiledMap.template ComputeOutput<typename ExampleType::DataVectorType>(0);
-                    return ExampleType(std::move(transformedDataVector), example.GetMetadata());
-                });
-            }
+                return detail::TransformDatasetInBatches<float>(input, compiledMap);
             case model::Port::PortType::real:
-            {
-                return input.template Transform<ExampleType>([&compiledMap](const ExampleType& example) {
-                    compiledMap.SetInputValue(0, example.GetDataVector().ToArray());
-                    auto transformedDataVector = compiledMap.template ComputeOutput<typename ExampleType::DataVectorType>(0);
-                    return ExampleType(std::move(transformedDataVector), example.GetMetadata());
-                });
-            }
+                return detail::TransformDatasetInBatches<double>(input, compiledMap);
             default:
                 throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch,
                     utilities::FormatString("Unexpected input type %d, expecting float or double", type));
@@ -29,6 +29,7 @@ namespace common
     struct MapCompilerArguments
     {
         using PreferredConvolutionMethod = model::PreferredConvolutionMethod;
+        using WeightStorageType = model::WeightStorageType;
 
         std::string compilerOptionsFilename;
         std::string compiledFunctionName; // defaults to output filename
@@ -48,11 +49,22 @@ namespace common
         bool parallelize = true;
         bool useThreadPool = true;
         int maxThreads = 4;
+        emitters::ParallelSchedulingPolicy parallelSchedulingPolicy = emitters::ParallelSchedulingPolicy::staticBlocks;
+        bool reentrant = false;
+        bool reusePortBuffers = false;
+        bool emitBatchFunction = false;
+        int batchSize = 1;
 
         // optimization options (configurable per-node)
+        bool foldConstants = true;
         bool fuseLinearOperations = true;
+        bool fuseElementwiseOperations = true;
         bool optimizeReorderDataNodes = true;
-        PreferredConvolutionMethod convolutionMethod = PreferredConvolutionMethod::automatic; // known methods: auto, unrolled, simple, diagonal, winograd
+        PreferredConvolutionMethod convolutionMethod = PreferredConvolutionMethod::automatic; // known methods: auto, unrolled, simple, diagonal, winograd, tiled, autotune
+        std::string convolutionTuningDatabase = "";
+        bool autotuneMatrixMultiply = false;
+        std::string matrixMultiplyTuningDatabase = "";
+        WeightStorageType weightStorageType = WeightStorageType::float32; // known types: float, fp16, bf16
 
         // raw options to store in metadata
         std::vector<std::string> modelOptions; // in format "<option-name>,<option-value-string>"
@@ -34,6 +34,7 @@
 #include <nodes/include/FFTNode.h>
 #include <nodes/include/FilterBankNode.h>
 #include <nodes/include/ForestPredictorNode.h>
+#include <nodes/include/FusedElementwiseNode.h>
 #include <nodes/include/GRUNode.h>
 #include <nodes/include/HammingWindowNode.h>
 #include <nodes/include/HannWindowNode.h>
@@ -51,6 +52,8 @@
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/ProtoNNPredictorNode.h>
 #include <nodes/include/RNNNode.h>
+#include <nodes/include/QuantizedConvolutionNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
 #include <nodes/include/ReorderDataNode.h>
@@ -60,6 +63,7 @@
 #include <nodes/include/SinkNode.h>
 #include <nodes/include/SourceNode.h>
 #include <nodes/include/SpatialConvolutionNode.h>
+#include <nodes/include/TiledConvolutionNode.h>
 #include <nodes/include/UnaryOperationNode.h>
 #include <nodes/include/UnrolledConvolutionNode.h>
 #include <nodes/include/VoiceActivityDetectorNode.h>
@@ -140,6 +144,8 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::MovingAverageNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::MovingVarianceNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::NeuralNetworkPredictorNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::QuantizedConvolutionNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::QuantizedMatrixMatrixMultiplyNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReceptiveFieldMatrixNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReorderDataCodeNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReorderDataNode<ElementType>>();
@@ -152,6 +158,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::SourceNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SpatialConvolutionNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SumNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::TiledConvolutionNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::TypeCastNode<bool, ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::TypeCastNode<int, ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::TypeCastNode<int64_t, ElementType>>();
@@ -169,6 +176,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::BinaryConvolutionalLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ConvolutionalLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::FullyConnectedLayerNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::FusedElementwiseNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ParametricReLUActivationLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::PoolingLayerNode<ElementType, MeanPoolingFunction>>();
         context.GetTypeFactory().AddType<model::Node, nodes::PoolingLayerNode<ElementType, MaxPoolingFunction>>();
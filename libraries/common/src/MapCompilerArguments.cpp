@@ -55,6 +55,13 @@ namespace common
             "Emit code that calls BLAS",
             true);
 
+        parser.AddOption(
+            foldConstants,
+            "foldConstants",
+            "",
+            "Evaluate parts of the model that only depend on constants when compiling",
+            true);
+
         parser.AddOption(
             fuseLinearOperations,
             "fuseLinearOps",
@@ -62,6 +69,13 @@ namespace common
             "Fuse sequences of linear operations with constant coefficients into a single operation",
             true);
 
+        parser.AddOption(
+            fuseElementwiseOperations,
+            "fuseElementwiseOps",
+            "",
+            "Fuse chains of elementwise operations (linear functions, activations, unary operations) into a single loop",
+            true);
+
         parser.AddOption(
             optimizeReorderDataNodes,
             "optimizeReorderDataNodes",
@@ -78,9 +92,42 @@ namespace common
               { "simple", PreferredConvolutionMethod::simple },
               { "diagonal", PreferredConvolutionMethod::diagonal },
               { "winograd", PreferredConvolutionMethod::winograd },
+              { "tiled", PreferredConvolutionMethod::tiled },
+              { "autotune", PreferredConvolutionMethod::autotune },
               { "auto", PreferredConvolutionMethod::automatic } },
             "auto");
 
+        parser.AddOption(
+            convolutionTuningDatabase,
+            "convolutionTuningDatabase",
+            "",
+            "JSON file that caches the convolution methods chosen by '--convolutionMethod autotune'",
+            "");
+
+        parser.AddOption(
+            autotuneMatrixMultiply,
+            "autotuneMatrixMultiply",
+            "",
+            "Search for the fastest loop-nest schedule for each matrix multiplication shape (host target only)",
+            false);
+
+        parser.AddOption(
+            matrixMultiplyTuningDatabase,
+            "matrixMultiplyTuningDatabase",
+            "",
+            "JSON file holding the matrix multiplication schedules found by '--autotuneMatrixMultiply'",
+            "");
+
+        parser.AddOption(
+            weightStorageType,
+            "weightStorageType",
+            "",
+            "Store constant matrix multiplication weights in reduced precision, converting them back to floating-point as they are loaded (the rounding error is logged with --verbose)",
+            { { "float", WeightStorageType::float32 },
+              { "fp16", WeightStorageType::float16 },
+              { "bf16", WeightStorageType::bfloat16 } },
+            "float");
+
         parser.AddOption(
             modelOptions,
             "modelOption",
@@ -130,6 +177,43 @@ namespace common
             "Maximum num of parallel threads",
             4);
 
+        parser.AddOption(
+            parallelSchedulingPolicy,
+            "parallelSchedule",
+            "",
+            "How to divide the iterations of parallel loops among threads",
+            { { "static", emitters::ParallelSchedulingPolicy::staticBlocks },
+              { "workStealing", emitters::ParallelSchedulingPolicy::workStealing } },
+            "static");
+
+        parser.AddOption(
+            reentrant,
+            "reentrant",
+            "",
+            "Keep the model state in a separately-allocated struct, so the compiled model can run on several threads at once (disables parallelization)",
+            false);
+
+        parser.AddOption(
+            reusePortBuffers,
+            "reusePortBuffers",
+            "",
+            "Share memory between intermediate port buffers whose lifetimes don't overlap",
+            false);
+
+        parser.AddOption(
+            emitBatchFunction,
+            "emitBatchFunction",
+            "",
+            "Emit a batch predict function that computes several examples, stored one after another, in a single call",
+            false);
+
+        parser.AddOption(
+            batchSize,
+            "batchSize",
+            "",
+            "The number of examples the batch predict function computes at once, e.g., as one matrix-matrix product instead of several matrix-vector products. Models with nodes that can't compute several examples at once compute one at a time",
+            1);
+
         parser.AddOption(
             debug,
             "debug",
@@ -240,9 +324,16 @@ namespace common
         settings.compilerSettings.optimize = optimize;
         settings.compilerSettings.useBlas = useBlas;
         settings.compilerSettings.allowVectorInstructions = enableVectorization;
-        settings.compilerSettings.parallelize = parallelize;
+        settings.compilerSettings.parallelize = parallelize && !reentrant;
+        settings.compilerSettings.useThreadPool = useThreadPool;
+        settings.compilerSettings.maxThreads = maxThreads;
+        settings.compilerSettings.parallelSchedulingPolicy = parallelSchedulingPolicy;
+        settings.compilerSettings.reentrant = reentrant;
         settings.compilerSettings.vectorWidth = vectorWidth;
         settings.profile = profile;
+        settings.reusePortBuffers = reusePortBuffers;
+        settings.emitBatchFunction = emitBatchFunction;
+        settings.batchSize = batchSize;
         settings.compilerSettings.profile = profile;
         settings.compilerSettings.positionIndependentCode = positionIndependentCode;
         settings.compilerSettings.globalValueAlignment = globalValueAlignment;
@@ -291,9 +382,21 @@ namespace common
     model::ModelOptimizerOptions MapCompilerArguments::GetModelOptimizerOptions() const
     {
         model::ModelOptimizerOptions options;
+        options["foldConstants"] = foldConstants;
         options["fuseLinearFunctionNodes"] = fuseLinearOperations;
+        options["fuseElementwiseNodes"] = fuseElementwiseOperations;
         options["optimizeReorderDataNodes"] = optimizeReorderDataNodes;
         options["preferredConvolutionMethod"] = convolutionMethod;
+        if (!convolutionTuningDatabase.empty())
+        {
+            options["convolutionTuningDatabase"] = convolutionTuningDatabase;
+        }
+        options["autotuneMatrixMultiply"] = autotuneMatrixMultiply;
+        if (!matrixMultiplyTuningDatabase.empty())
+        {
+            options["matrixMultiplyTuningDatabase"] = matrixMultiplyTuningDatabase;
+        }
+        options["weightStorageType"] = weightStorageType;
 
         auto metadata = GetOptionsMetadata();
         if (metadata.HasEntry("model"))
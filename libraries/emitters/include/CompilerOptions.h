@@ -28,6 +28,15 @@ namespace emitters
 
     std::string ToString(BlasType t);
 
+    /// <summary> List of ways to divide the iterations of a parallel loop among worker threads. </summary>
+    enum class ParallelSchedulingPolicy
+    {
+        staticBlocks = 0, // one contiguous block of iterations per task
+        workStealing // each task owns a range of small chunks, and steals chunks from other tasks when its own range is exhausted
+    };
+
+    std::string ToString(ParallelSchedulingPolicy t);
+
     /// <summary> Standard compiler switches. </summary>
     struct CompilerOptions
     {
@@ -61,6 +70,15 @@ namespace emitters
         /// <summary> Maximum num of parallel threads. </summary>
         int maxThreads = 4;
 
+        /// <summary> How the iterations of parallel loops are divided among the threads. </summary>
+        ParallelSchedulingPolicy parallelSchedulingPolicy = ParallelSchedulingPolicy::staticBlocks;
+
+        /// <summary> Number of chunks each thread's share of a parallel loop is split into, with the `workStealing` policy. </summary>
+        int parallelChunksPerThread = 4;
+
+        /// <summary> Keep all mutable model state in a separately-allocated state struct, so the compiled code can be run concurrently with independent state. </summary>
+        bool reentrant = false;
+
         /// <summary> Allow emitting more efficient code that isn't necessarily IEEE-754 compatible. </summary>
         bool useFastMath = true;
 
@@ -86,6 +104,9 @@ namespace emitters
         /// <summary> Size of vector units. </summary>
         int vectorWidth = 4;
 
+        /// <summary> Emit elementwise nodes (binary, unary and broadcast operations) with vector instructions as wide as the target device's vector registers. </summary>
+        bool vectorizeElementwiseOperations = true;
+
         /// <summary> Emit debug code. </summary>
         bool debug = false;
 
@@ -108,5 +129,8 @@ namespace utilities
 {
     template <>
     emitters::BlasType FromString<emitters::BlasType>(const std::string& s);
+
+    template <>
+    emitters::ParallelSchedulingPolicy FromString<emitters::ParallelSchedulingPolicy>(const std::string& s);
 }
 } // namespace ell
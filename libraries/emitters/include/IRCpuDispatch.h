@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRCpuDispatch.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TargetDevice.h"
+
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    class IRModuleEmitter;
+
+    /// <summary> Gets a fully-specified target device for a particular x86 CPU, to compile a version of a module
+    /// that `LinkCpuSpecificModules` can dispatch to. </summary>
+    ///
+    /// <param name="baseDevice"> The device the module is otherwise compiled for. Only its triple and data layout are used. </param>
+    /// <param name="cpu"> The LLVM name of the CPU, for instance "haswell" or "skylake-avx512". </param>
+    ///
+    /// <returns> The target device. Its features are the ones of the CPU that can be detected at runtime. </returns>
+    TargetDevice GetCpuSpecificTargetDevice(const TargetDevice& baseDevice, const std::string& cpu);
+
+    /// <summary> Gets the name of the version of a module compiled for a particular CPU. </summary>
+    std::string GetCpuSpecificModuleName(const std::string& moduleName, const std::string& cpu);
+
+    /// <summary> Gets the name a public function of a module has in the version of the module compiled for a particular CPU. </summary>
+    ///
+    /// <param name="functionName"> The name of the function. </param>
+    /// <param name="moduleName"> The name of the module. </param>
+    /// <param name="cpu"> The LLVM name of the CPU. </param>
+    std::string GetCpuSpecificFunctionName(const std::string& functionName, const std::string& moduleName, const std::string& cpu);
+
+    /// <summary> Links versions of a module compiled for particular x86 CPUs into the module. Each public function
+    /// of the module is replaced with a dispatcher that uses CPUID the first time it's called to pick the first
+    /// version whose CPU features are all available, and falls back to the original function if there is none. </summary>
+    ///
+    /// <param name="module"> The module to link into. Its public functions keep their names and signatures. </param>
+    /// <param name="cpuSpecificModules"> The modules to link, in order of preference. Each one must be compiled
+    /// from the same map as `module`, for a target device returned by `GetCpuSpecificTargetDevice` and with the
+    /// module name returned by `GetCpuSpecificModuleName`. They can't be used after this call. </param>
+    void LinkCpuSpecificModules(IRModuleEmitter& module, const std::vector<IRModuleEmitter*>& cpuSpecificModules);
+} // namespace emitters
+} // namespace ell
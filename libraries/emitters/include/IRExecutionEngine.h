@@ -13,9 +13,11 @@
 #include <utilities/include/Exception.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Module.h>
 
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 namespace ell
@@ -43,7 +45,8 @@ namespace emitters
         ///
         /// <param name="pModule"> The module. </param>
         /// <param name="verify"> Indicates if the execution engine should run a verification pass before running the code. </param>
-        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify = false, llvm::CodeGenOpt::Level optLevel = llvm::CodeGenOpt::Level::Default);
+        /// <param name="objectCache"> An optional cache the engine loads the module's object code from, or stores it in after compiling it. </param>
+        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify = false, llvm::CodeGenOpt::Level optLevel = llvm::CodeGenOpt::Level::Default, std::shared_ptr<llvm::ObjectCache> objectCache = nullptr);
 
         /// <summary> Destructor </summary>
         ~IRExecutionEngine();
@@ -132,6 +135,7 @@ namespace emitters
 
         std::unique_ptr<llvm::EngineBuilder> _pBuilder;
         std::unique_ptr<llvm::ExecutionEngine> _pEngine;
+        std::shared_ptr<llvm::ObjectCache> _objectCache;
     };
 } // namespace emitters
 } // namespace ell
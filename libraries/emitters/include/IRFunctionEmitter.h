@@ -1676,6 +1676,31 @@ namespace emitters
         /// <summary> Utility function for setting number of threads used by OpenBLAS (if present) </summary>
         void SetNumOpenBLASThreads(LLVMValue numThreads);
 
+        //
+        // Atomic operations
+        //
+
+        /// <summary> Emits an atomic load of an integer value. The load imposes no ordering on other memory operations. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the integer to load. </param>
+        ///
+        /// <returns> The loaded value. </returns>
+        LLVMValue AtomicLoad(LLVMValue pPointer);
+
+        /// <summary> Emits an atomic store of an integer value. The store imposes no ordering on other memory operations. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the integer to store into. </param>
+        /// <param name="pValue"> The value to store. </param>
+        void AtomicStore(LLVMValue pPointer, LLVMValue pValue);
+
+        /// <summary> Emits an atomic fetch-and-add of an integer value. The operation imposes no ordering on other memory operations. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the integer to add to. </param>
+        /// <param name="pIncrement"> The value to add. </param>
+        ///
+        /// <returns> The value stored at `pPointer` before the addition. </returns>
+        LLVMValue AtomicFetchAdd(LLVMValue pPointer, LLVMValue pIncrement);
+
         //
         // Calling POSIX functions
         //
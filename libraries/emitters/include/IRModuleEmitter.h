@@ -127,6 +127,13 @@ namespace emitters
         /// <summary> End your reset function created with BeginResetFunction. </summary>
         void EndResetFunction() { EndFunction(); }
 
+        /// <summary> Moves all the mutable module-level state (port buffers, node state, the callback context) into a single
+        /// `<module>_State` struct and emits the public `<module>_AllocateState`, `<module>_FreeState` and `<module>_SetState` functions.
+        /// Emitted code finds its state through a thread-local pointer set by `<module>_SetState`, so the same module can run on several
+        /// threads at once, each with its own state. Threads that never call `<module>_SetState` share a default state.
+        /// Must be called after all the functions that use global state have been emitted. </summary>
+        void EmitReentrantState();
+
         /// <summary> Begins an IR function with no arguments and directs subsequent commands to it. </summary>
         ///
         /// <param name="functionName"> The name of the function. </param>
@@ -317,6 +324,15 @@ namespace emitters
         template <typename ValueType>
         llvm::GlobalVariable* GlobalArray(const std::string& name, const std::vector<ValueType>& value, bool isThreadLocal = false);
 
+        /// <summary> Replaces a set of zero-initialized global variables with views into a single new global byte buffer. </summary>
+        ///
+        /// <param name="name"> The name of the new buffer. </param>
+        /// <param name="globals"> The globals to replace, each paired with its byte offset in the new buffer. </param>
+        /// <param name="size"> The size of the new buffer, in bytes. </param>
+        ///
+        /// <returns> Pointer to the llvm::GlobalVariable that represents the new buffer. </returns>
+        llvm::GlobalVariable* MergeGlobals(const std::string& name, const std::vector<std::pair<llvm::GlobalVariable*, size_t>>& globals, size_t size);
+
         //
         // Functions
         //
@@ -571,6 +587,15 @@ namespace emitters
         /// <param name="filename"> The name of the file containing the Assembler text </param>
         void LoadAsmFromFile(const std::string& filename);
 
+        /// <summary> Links the code of another module into this module. Everything the other module defines becomes
+        /// private to this module, so it only adds to this module's header and public API what this module's own
+        /// functions expose, but this module's code can call the other module's functions by name. </summary>
+        ///
+        /// <param name="privateModule"> The module to link. Its declarations of functions with its own module name
+        /// prefix (e.g., callbacks) are resolved to the functions with this module's prefix. It can't be used after
+        /// this call. </param>
+        void LinkPrivateModule(IRModuleEmitter& privateModule);
+
         //
         // Optimization
         //
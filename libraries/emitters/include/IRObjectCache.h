@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "CompilerOptions.h"
+
+#include <utilities/include/MillisecondTimer.h>
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary> An on-disk cache for the object code the JIT generates for one module. The module is identified by
+    /// a key computed from its unoptimized IR and the options that affect how it's optimized and compiled, so a later
+    /// run that emits the same IR can skip the LLVM optimization and code generation passes and load the object file
+    /// instead. The key is a SHA-1 digest of that key material, and the material itself is stored next to the object
+    /// and compared on every lookup, so a digest collision is a miss rather than the wrong code. Along with the object,
+    /// the cache records how long optimizing and generating code for it took. </summary>
+    class IRObjectCache : public llvm::ObjectCache
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="directory"> The directory the cached objects are stored in. It is created if necessary. </param>
+        /// <param name="module"> The module, before any optimization passes are run on it. </param>
+        /// <param name="options"> The options the module is compiled with. </param>
+        IRObjectCache(const std::string& directory, const llvm::Module& module, const CompilerOptions& options);
+
+        /// <summary> Gets everything that determines the code generated for an unoptimized module: its IR, the
+        /// options that affect optimization and code generation, and the host and LLVM version. </summary>
+        ///
+        /// <param name="module"> The module, before any optimization passes are run on it. </param>
+        /// <param name="options"> The options the module is compiled with. </param>
+        ///
+        /// <returns> The key material, as text. </returns>
+        static std::string GetKeyMaterial(const llvm::Module& module, const CompilerOptions& options);
+
+        /// <summary> Computes the cache key for an unoptimized module: its name and a SHA-1 digest of its key material. </summary>
+        ///
+        /// <param name="module"> The module, before any optimization passes are run on it. </param>
+        /// <param name="keyMaterial"> The module's key material, from `GetKeyMaterial`. </param>
+        ///
+        /// <returns> The key, as a string usable as a file name. </returns>
+        static std::string GetKey(const llvm::Module& module, const std::string& keyMaterial);
+
+        /// <summary> Gets the key identifying the module. </summary>
+        ///
+        /// <returns> The key. </returns>
+        const std::string& GetKey() const { return _key; }
+
+        /// <summary> Indicates if the module's object was already in the cache when this object was created. </summary>
+        ///
+        /// <returns> `true` for a cache hit. </returns>
+        bool IsHit() const { return _isHit; }
+
+        /// <summary> Gets the time the cached object originally took to optimize and compile, which a cache hit saves. </summary>
+        ///
+        /// <returns> The time saved, or zero for a cache miss. </returns>
+        std::chrono::milliseconds::rep GetTimeSaved() const { return _timeSaved; }
+
+        /// <summary> Adds the time spent optimizing the module to the compile time stored with its object. </summary>
+        ///
+        /// <param name="time"> The optimization time, in milliseconds. </param>
+        void AddOptimizationTime(std::chrono::milliseconds::rep time) { _optimizationTime += time; }
+
+        /// <summary> Called by the JIT after it compiles a module. Writes the object to the cache. </summary>
+        ///
+        /// <param name="module"> The module that was compiled. </param>
+        /// <param name="object"> The object code. </param>
+        void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) override;
+
+        /// <summary> Called by the JIT before it compiles a module. Loads the object from the cache on a hit. </summary>
+        ///
+        /// <param name="module"> The module about to be compiled. </param>
+        ///
+        /// <returns> The object code, or null if it isn't in the cache. </returns>
+        std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+    private:
+        std::string _keyMaterial;
+        std::string _key;
+        std::string _objectPath;
+        std::string _timePath;
+        std::string _keyMaterialPath;
+        bool _isHit = false;
+        std::chrono::milliseconds::rep _timeSaved = 0;
+        std::chrono::milliseconds::rep _optimizationTime = 0;
+        utilities::MillisecondTimer _codeGenerationTimer;
+    };
+} // namespace emitters
+} // namespace ell
@@ -53,7 +53,11 @@ namespace emitters
         void EmitLoop(int begin, int end, int increment, const ParallelLoopOptions& options, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
         void EmitLoop(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, const ParallelLoopOptions& options, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
 
+        void EmitStaticBlockTasks(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
+        void EmitWorkStealingTasks(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
+
         IRFunctionEmitter GetTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body);
+        IRFunctionEmitter GetWorkStealingTaskFunction(int numTasks, int chunksPerTask, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
 
         LLVMValue GetIterationVariable();
         LLVMValue LoadIterationVariable();
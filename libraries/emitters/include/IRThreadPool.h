@@ -34,6 +34,9 @@ namespace emitters
     // IRThreadPoolTaskQueue
     // IRThreadPool
     //
+    // With the `workStealing` scheduling policy, idle workers spin briefly looking for new work before parking on the
+    // queue's condition variable, so back-to-back parallel loops don't pay for a wakeup each time.
+    //
 
     //
     // IRThreadPoolTask
@@ -152,6 +155,12 @@ namespace emitters
         /// <param name="function"> The function currently being emitted into. </param>
         void WaitAll(IRFunctionEmitter& function);
 
+        /// <summary> Busy-wait, without taking the queue mutex, until a task is available or a fixed number of checks have been made. </summary>
+        ///
+        /// <param name="function"> The function currently being emitted into. </param>
+        /// <param name="maxSpins"> The maximum number of times to check for work. </param>
+        void SpinWhileEmpty(IRFunctionEmitter& function, int maxSpins);
+
         /// <summary> Gets the array of tasks in the thread pool. </summary>
         ///
         /// <returns> A task array object representing the tasks. </param>
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "CompilerOptions.h"
 #include "EmitterException.h"
 #include "EmitterTypes.h"
 #include "IRFunctionEmitter.h"
@@ -14,6 +15,9 @@
 
 #include <utilities/include/TypeTraits.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace ell
 {
 namespace emitters
@@ -52,6 +56,57 @@ namespace emitters
     /// <returns> The sum of the elements in the given vector </returns>
     template <typename ValueType>
     LLVMValue HorizontalVectorSum(IRFunctionEmitter& function, LLVMValue vectorValue);
+
+    /// <summary> Gets the number of elements elementwise operations should process at once: as many as fit in one of
+    /// the target device's vector registers. </summary>
+    ///
+    /// <typeparam name="ValueType"> The element type </typeparam>
+    /// <param name="options"> The compiler options, which include the target device </param>
+    ///
+    /// <returns> The vector width, or 1 if elementwise vectorization is turned off or the target has no vector registers </returns>
+    template <typename ValueType>
+    int GetElementwiseVectorWidth(const CompilerOptions& options);
+
+    /// <summary> Type alias for the body of a vectorized loop. `width` is the number of elements the body processes,
+    /// starting at `index`: the vector size in the main loop, and 1 in the scalar loop that handles the tail. </summary>
+    using VectorizedForLoopBodyFunction = std::function<void(IRFunctionEmitter& function, IRLocalScalar index, int width)>;
+
+    /// <summary> Emits a loop over contiguous elements that processes `vectorSize` elements per iteration, followed
+    /// by a scalar loop over the elements left over. </summary>
+    ///
+    /// <param name="function"> The function being emitted </param>
+    /// <param name="count"> The number of elements </param>
+    /// <param name="vectorSize"> The number of elements per vector. If 1, only the scalar loop is emitted. </param>
+    /// <param name="body"> A function that emits the body of the loops </param>
+    void VectorizedFor(IRFunctionEmitter& function, int count, int vectorSize, VectorizedForLoopBodyFunction body);
+
+    /// <summary> Loads `width` contiguous elements as a vector. The load is only assumed to be aligned to the element
+    /// type, since port buffers may start anywhere inside a larger allocation. </summary>
+    ///
+    /// <param name="function"> The function being emitted </param>
+    /// <param name="pointer"> Pointer to the elements </param>
+    /// <param name="offset"> The offset of the first element to load </param>
+    /// <param name="width"> The number of elements to load. If 1, a scalar is loaded. </param>
+    ///
+    /// <returns> The loaded vector (or scalar) </returns>
+    LLVMValue LoadVector(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue offset, int width);
+
+    /// <summary> Stores a vector (or scalar) into contiguous elements. </summary>
+    ///
+    /// <param name="function"> The function being emitted </param>
+    /// <param name="pointer"> Pointer to the elements </param>
+    /// <param name="offset"> The offset of the first element to store </param>
+    /// <param name="value"> The value to store </param>
+    void StoreVector(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue offset, LLVMValue value);
+
+    /// <summary> Creates a vector filled with copies of a (non-constant) scalar value </summary>
+    ///
+    /// <param name="function"> The function being emitted </param>
+    /// <param name="value"> The scalar value </param>
+    /// <param name="width"> The number of elements in the vector. If 1, the scalar is returned unchanged. </param>
+    ///
+    /// <returns> The vector </returns>
+    LLVMValue SplatVector(IRFunctionEmitter& function, LLVMValue value, int width);
 } // namespace emitters
 } // namespace ell
 
@@ -137,6 +192,16 @@ namespace emitters
         auto half2 = emitter.GetIRBuilder().CreateExtractElement(vectorValue, static_cast<uint64_t>(1));
         return function.Operator(emitters::GetAddForValueType<ValueType>(), half1, half2);
     }
+
+    template <typename ValueType>
+    int GetElementwiseVectorWidth(const CompilerOptions& options)
+    {
+        if (!options.vectorizeElementwiseOperations)
+        {
+            return 1;
+        }
+        return std::max(1, static_cast<int>(options.targetDevice.GetVectorRegisterSize() / sizeof(ValueType)));
+    }
 } // namespace emitters
 } // namespace ell
 
@@ -39,6 +39,11 @@ namespace emitters
         /// </remarks>
         inline bool HasFeature(const std::string& feature) const { return features.find(feature) != std::string::npos; }
 
+        /// <summary> Gets the size of the target's vector registers, based on its architecture and features </summary>
+        ///
+        /// <returns> The size of a vector register in bytes, or zero if the target has no vector unit ELL knows about. </returns>
+        size_t GetVectorRegisterSize() const;
+
         /// <summary> Indicates if the target device is a Windows system </summary>
         bool IsWindows() const;
 
@@ -37,6 +37,19 @@ namespace emitters
         }
     }
 
+    std::string ToString(ParallelSchedulingPolicy t)
+    {
+        switch (t)
+        {
+        case ParallelSchedulingPolicy::staticBlocks:
+            return "staticBlocks";
+        case ParallelSchedulingPolicy::workStealing:
+            return "workStealing";
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument);
+        }
+    }
+
     /// <summary> Constructor from a property bag </summary>
     CompilerOptions::CompilerOptions(const utilities::PropertyBag& properties)
     {
@@ -64,12 +77,16 @@ namespace emitters
         inlineOperators = properties.GetOrParseEntry<bool>("inlineOperators", inlineOperators);
         allowVectorInstructions = properties.GetOrParseEntry<bool>("allowVectorInstructions", allowVectorInstructions);
         vectorWidth = properties.GetOrParseEntry<int>("vectorWidth", vectorWidth);
+        vectorizeElementwiseOperations = properties.GetOrParseEntry<bool>("vectorizeElementwiseOperations", vectorizeElementwiseOperations);
         useBlas = properties.GetOrParseEntry<bool>("useBlas", useBlas);
         profile = properties.GetOrParseEntry<bool>("profile", profile);
         includeDiagnosticInfo = properties.GetOrParseEntry<bool>("includeDiagnosticInfo", includeDiagnosticInfo);
         parallelize = properties.GetOrParseEntry<bool>("parallelize", parallelize);
         useThreadPool = properties.GetOrParseEntry<bool>("useThreadPool", useThreadPool);
         maxThreads = properties.GetOrParseEntry<int>("maxThreads", maxThreads);
+        parallelSchedulingPolicy = properties.GetOrParseEntry<ParallelSchedulingPolicy>("parallelSchedulingPolicy", parallelSchedulingPolicy);
+        parallelChunksPerThread = properties.GetOrParseEntry<int>("parallelChunksPerThread", parallelChunksPerThread);
+        reentrant = properties.GetOrParseEntry<bool>("reentrant", reentrant);
         useFastMath = properties.GetOrParseEntry<bool>("useFastMath", useFastMath);
         debug = properties.GetOrParseEntry<bool>("debug", debug);
         globalValueAlignment = properties.GetOrParseEntry<int>("globalValueAlignment", globalValueAlignment);
@@ -99,5 +116,19 @@ namespace utilities
         
         return it->second;
     }
+
+    template <>
+    emitters::ParallelSchedulingPolicy FromString<emitters::ParallelSchedulingPolicy>(const std::string& s)
+    {
+        static std::map<std::string, emitters::ParallelSchedulingPolicy> nameMap = { { "staticBlocks", emitters::ParallelSchedulingPolicy::staticBlocks },
+                                                                                     { "workStealing", emitters::ParallelSchedulingPolicy::workStealing } };
+        auto it = nameMap.find(s);
+        if (it == nameMap.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown ParallelSchedulingPolicy");
+        }
+
+        return it->second;
+    }
 } // namespace utilities
 } // namespace ell
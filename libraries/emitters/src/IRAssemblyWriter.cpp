@@ -61,9 +61,15 @@ namespace emitters
     {
         void SetFunctionAttributes(const std::string& cpu, const std::string& features, llvm::Module& module)
         {
-            // Loop over the functions in the module, settings the cpu and features attributes
+            // Loop over the functions in the module, settings the cpu and features attributes. Functions that already
+            // have a target, like the CPU-specific versions linked in by `LinkCpuSpecificModules`, keep it.
             for (auto& function : module)
             {
+                if (function.hasFnAttribute("target-cpu") || function.hasFnAttribute("target-features"))
+                {
+                    continue;
+                }
+
                 if (!cpu.empty())
                 {
                     function.addFnAttr("target-cpu", cpu);
@@ -178,7 +184,7 @@ namespace emitters
         // Set the data layout of the module to match the target machine
         module.setDataLayout(targetMachine->createDataLayout());
 
-        // Override function attributes based on cpu and features
+        // Set function attributes based on cpu and features
         if (!ellOptions.targetDevice.cpu.empty() || !ellOptions.targetDevice.features.empty())
         {
             SetFunctionAttributes(ellOptions.targetDevice.cpu, ellOptions.targetDevice.features, module);
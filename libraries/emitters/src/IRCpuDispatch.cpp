@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRCpuDispatch.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRCpuDispatch.h"
+#include "EmitterException.h"
+#include "IRModuleEmitter.h"
+#include "LLVMUtilities.h"
+
+#include <llvm/ADT/Triple.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InlineAsm.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/Support/TargetRegistry.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        enum CpuidRegister
+        {
+            ebx1,
+            ecx1,
+            ebx7,
+            ecx7,
+            numCpuidRegisters
+        };
+
+        // An x86 feature, and where CPUID reports it. Features that use the AVX or AVX-512 registers also need
+        // the OS to save those registers on context switches, which XGETBV reports in XCR0.
+        struct CpuFeature
+        {
+            const char* name;
+            CpuidRegister cpuidRegister;
+            int bit;
+            uint32_t xcr0Mask;
+        };
+
+        constexpr uint32_t avxStateMask = 0x6; // SSE and AVX state
+        constexpr uint32_t avx512StateMask = 0xe6; // ...plus the opmask and upper ZMM state
+
+        const CpuFeature dispatchFeatures[] = {
+            { "sse4.1", ecx1, 19, 0 },
+            { "sse4.2", ecx1, 20, 0 },
+            { "popcnt", ecx1, 23, 0 },
+            { "fma", ecx1, 12, avxStateMask },
+            { "avx", ecx1, 28, avxStateMask },
+            { "f16c", ecx1, 29, avxStateMask },
+            { "bmi", ebx7, 3, 0 },
+            { "avx2", ebx7, 5, avxStateMask },
+            { "bmi2", ebx7, 8, 0 },
+            { "avx512f", ebx7, 16, avx512StateMask },
+            { "avx512dq", ebx7, 17, avx512StateMask },
+            { "avx512cd", ebx7, 28, avx512StateMask },
+            { "avx512bw", ebx7, 30, avx512StateMask },
+            { "avx512vl", ebx7, 31, avx512StateMask },
+            { "avx512vnni", ecx7, 11, avx512StateMask }
+        };
+
+        constexpr int osxsaveBit = 27; // in ecx1
+
+        std::string GetIdentifier(const std::string& name)
+        {
+            auto result = name;
+            std::replace_if(
+                result.begin(), result.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+            return result;
+        }
+
+        bool IsX86(const TargetDevice& device)
+        {
+            auto arch = llvm::Triple(llvm::Triple::normalize(device.triple)).getArch();
+            return arch == llvm::Triple::x86 || arch == llvm::Triple::x86_64;
+        }
+
+        std::vector<const CpuFeature*> GetRequiredFeatures(const std::string& features)
+        {
+            std::vector<const CpuFeature*> result;
+            const auto featureList = "," + features + ",";
+            for (const auto& feature : dispatchFeatures)
+            {
+                if (featureList.find(",+" + std::string(feature.name) + ",") != std::string::npos)
+                {
+                    result.push_back(&feature);
+                }
+            }
+            return result;
+        }
+
+        bool HasPrefix(const std::string& name, const std::string& prefix)
+        {
+            return name.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        // The functions the header declares are the ones tagged with ELL's metadata
+        bool HasEllMetadata(const llvm::Function& function)
+        {
+            llvm::SmallVector<llvm::StringRef, 32> kindNames;
+            function.getContext().getMDKindNames(kindNames);
+            llvm::SmallVector<std::pair<unsigned, llvm::MDNode*>, 4> metadata;
+            function.getAllMetadata(metadata);
+            return std::any_of(metadata.begin(), metadata.end(), [&kindNames](const auto& entry) {
+                return kindNames[entry.first].startswith("ell.");
+            });
+        }
+
+        // Emits `int GetCpuSpecificModuleIndex()`, which returns the index of the first set of features the CPU
+        // supports, or the number of sets if it supports none of them. The result is cached in a global.
+        llvm::Function* EmitGetModuleIndexFunction(llvm::Module& module, const std::string& name, const std::vector<std::vector<const CpuFeature*>>& requiredFeatures)
+        {
+            auto& context = module.getContext();
+            auto int32Type = llvm::Type::getInt32Ty(context);
+            auto cachedIndex = new llvm::GlobalVariable(module, int32Type, false, llvm::GlobalValue::InternalLinkage, llvm::ConstantInt::get(int32Type, -1), name + "_cachedIndex");
+            auto function = llvm::Function::Create(llvm::FunctionType::get(int32Type, false), llvm::GlobalValue::InternalLinkage, name, &module);
+
+            auto entryBlock = llvm::BasicBlock::Create(context, "entry", function);
+            auto cachedBlock = llvm::BasicBlock::Create(context, "cached", function);
+            auto detectBlock = llvm::BasicBlock::Create(context, "detect", function);
+            auto leaf7Block = llvm::BasicBlock::Create(context, "leaf7", function);
+            auto afterLeaf7Block = llvm::BasicBlock::Create(context, "afterLeaf7", function);
+            auto xgetbvBlock = llvm::BasicBlock::Create(context, "xgetbv", function);
+            auto selectBlock = llvm::BasicBlock::Create(context, "select", function);
+
+            llvm::IRBuilder<> builder(entryBlock);
+            auto index = builder.CreateLoad(int32Type, cachedIndex);
+            builder.CreateCondBr(builder.CreateICmpSGE(index, builder.getInt32(0)), cachedBlock, detectBlock);
+
+            builder.SetInsertPoint(cachedBlock);
+            builder.CreateRet(index);
+
+            // CPUID clobbers ebx, so it's emitted as inline assembly rather than relying on a target intrinsic
+            auto cpuidResultType = llvm::StructType::get(context, { int32Type, int32Type, int32Type, int32Type });
+            auto cpuid = llvm::InlineAsm::get(llvm::FunctionType::get(cpuidResultType, { int32Type, int32Type }, false),
+                                              "cpuid",
+                                              "={ax},={bx},={cx},={dx},{ax},{cx},~{dirflag},~{fpsr},~{flags}",
+                                              false);
+            auto callCpuid = [&](int leaf) {
+                return builder.CreateCall(cpuid->getFunctionType(), cpuid, { builder.getInt32(leaf), builder.getInt32(0) });
+            };
+
+            builder.SetInsertPoint(detectBlock);
+            auto maxLeaf = builder.CreateExtractValue(callCpuid(0), 0);
+            auto leaf1 = callCpuid(1);
+            llvm::Value* registers[numCpuidRegisters] = {};
+            registers[ebx1] = builder.CreateExtractValue(leaf1, 1);
+            registers[ecx1] = builder.CreateExtractValue(leaf1, 2);
+            builder.CreateCondBr(builder.CreateICmpUGE(maxLeaf, builder.getInt32(7)), leaf7Block, afterLeaf7Block);
+
+            builder.SetInsertPoint(leaf7Block);
+            auto leaf7 = callCpuid(7);
+            auto leaf7Ebx = builder.CreateExtractValue(leaf7, 1);
+            auto leaf7Ecx = builder.CreateExtractValue(leaf7, 2);
+            builder.CreateBr(afterLeaf7Block);
+
+            builder.SetInsertPoint(afterLeaf7Block);
+            auto ebx7Phi = builder.CreatePHI(int32Type, 2);
+            ebx7Phi->addIncoming(builder.getInt32(0), detectBlock);
+            ebx7Phi->addIncoming(leaf7Ebx, leaf7Block);
+            auto ecx7Phi = builder.CreatePHI(int32Type, 2);
+            ecx7Phi->addIncoming(builder.getInt32(0), detectBlock);
+            ecx7Phi->addIncoming(leaf7Ecx, leaf7Block);
+            registers[ebx7] = ebx7Phi;
+            registers[ecx7] = ecx7Phi;
+            auto osxsave = builder.CreateAnd(registers[ecx1], builder.getInt32(1u << osxsaveBit));
+            builder.CreateCondBr(builder.CreateICmpNE(osxsave, builder.getInt32(0)), xgetbvBlock, selectBlock);
+
+            // XGETBV is only valid if the OS has enabled it. Its encoding is emitted directly so the assembler
+            // doesn't reject it for targets without the xsave feature.
+            builder.SetInsertPoint(xgetbvBlock);
+            auto xgetbv = llvm::InlineAsm::get(llvm::FunctionType::get(llvm::StructType::get(context, { int32Type, int32Type }), { int32Type }, false),
+                                               ".byte 0x0f, 0x01, 0xd0",
+                                               "={ax},={dx},{cx},~{dirflag},~{fpsr},~{flags}",
+                                               true);
+            auto xcr0Value = builder.CreateExtractValue(builder.CreateCall(xgetbv->getFunctionType(), xgetbv, { builder.getInt32(0) }), 0);
+            builder.CreateBr(selectBlock);
+
+            builder.SetInsertPoint(selectBlock);
+            auto xcr0 = builder.CreatePHI(int32Type, 2);
+            xcr0->addIncoming(builder.getInt32(0), afterLeaf7Block);
+            xcr0->addIncoming(xcr0Value, xgetbvBlock);
+
+            llvm::Value* result = builder.getInt32(static_cast<int>(requiredFeatures.size()));
+            for (auto moduleIndex = static_cast<int>(requiredFeatures.size()) - 1; moduleIndex >= 0; --moduleIndex)
+            {
+                llvm::Value* isSupported = builder.getTrue();
+                uint32_t xcr0Mask = 0;
+                for (auto feature : requiredFeatures[moduleIndex])
+                {
+                    auto bit = builder.CreateAnd(registers[feature->cpuidRegister], builder.getInt32(1u << feature->bit));
+                    isSupported = builder.CreateAnd(isSupported, builder.CreateICmpNE(bit, builder.getInt32(0)));
+                    xcr0Mask |= feature->xcr0Mask;
+                }
+                if (xcr0Mask != 0)
+                {
+                    auto state = builder.CreateAnd(xcr0, builder.getInt32(xcr0Mask));
+                    isSupported = builder.CreateAnd(isSupported, builder.CreateICmpEQ(state, builder.getInt32(xcr0Mask)));
+                }
+                result = builder.CreateSelect(isSupported, builder.getInt32(moduleIndex), result);
+            }
+            builder.CreateStore(result, cachedIndex);
+            builder.CreateRet(result);
+            return function;
+        }
+
+        // Replaces `function` with a function of the same name and signature that calls the version picked by `getModuleIndex`
+        void EmitDispatchFunction(llvm::Function* function, llvm::Function* getModuleIndex, const std::vector<llvm::Function*>& cpuSpecificFunctions)
+        {
+            auto& context = function->getContext();
+            auto name = function->getName().str();
+            function->setName(name + "_default");
+            function->setLinkage(llvm::GlobalValue::InternalLinkage);
+
+            auto dispatcher = llvm::Function::Create(function->getFunctionType(), llvm::GlobalValue::ExternalLinkage, name, function->getParent());
+            dispatcher->setAttributes(function->getAttributes());
+            dispatcher->setCallingConv(function->getCallingConv());
+
+            // The header writer finds the public functions by their metadata, so move it to the dispatcher
+            llvm::SmallVector<std::pair<unsigned, llvm::MDNode*>, 4> metadata;
+            function->getAllMetadata(metadata);
+            for (const auto& entry : metadata)
+            {
+                if (entry.first != llvm::LLVMContext::MD_dbg)
+                {
+                    dispatcher->setMetadata(entry.first, entry.second);
+                    function->setMetadata(entry.first, nullptr);
+                }
+            }
+
+            std::vector<llvm::Value*> arguments;
+            for (auto& argument : dispatcher->args())
+            {
+                arguments.push_back(&argument);
+            }
+
+            auto entryBlock = llvm::BasicBlock::Create(context, "entry", dispatcher);
+            llvm::IRBuilder<> builder(entryBlock);
+            auto index = builder.CreateCall(getModuleIndex->getFunctionType(), getModuleIndex);
+
+            auto emitCall = [&](llvm::Function* callee) {
+                auto result = builder.CreateCall(callee->getFunctionType(), callee, arguments);
+                result->setCallingConv(callee->getCallingConv());
+                if (callee->getReturnType()->isVoidTy())
+                {
+                    builder.CreateRetVoid();
+                }
+                else
+                {
+                    builder.CreateRet(result);
+                }
+            };
+
+            auto defaultBlock = llvm::BasicBlock::Create(context, "default", dispatcher);
+            auto switchInst = builder.CreateSwitch(index, defaultBlock, static_cast<unsigned>(cpuSpecificFunctions.size()));
+            for (size_t moduleIndex = 0; moduleIndex < cpuSpecificFunctions.size(); ++moduleIndex)
+            {
+                auto callee = cpuSpecificFunctions[moduleIndex];
+                if (callee == nullptr)
+                {
+                    continue;
+                }
+                auto block = llvm::BasicBlock::Create(context, callee->getName(), dispatcher);
+                switchInst->addCase(builder.getInt32(static_cast<int>(moduleIndex)), block);
+                builder.SetInsertPoint(block);
+                emitCall(callee);
+            }
+
+            builder.SetInsertPoint(defaultBlock);
+            emitCall(function);
+        }
+    } // namespace
+
+    TargetDevice GetCpuSpecificTargetDevice(const TargetDevice& baseDevice, const std::string& cpu)
+    {
+        InitializeLLVM();
+
+        TargetDevice device = baseDevice;
+        CompleteTargetDevice(device);
+        if (!IsX86(device))
+        {
+            throw EmitterException(EmitterError::targetNotSupported, "CPU dispatch is only supported for x86 targets");
+        }
+
+        std::string error;
+        auto target = llvm::TargetRegistry::lookupTarget(device.triple, error);
+        if (target == nullptr)
+        {
+            throw EmitterException(EmitterError::targetNotSupported, "Couldn't create target " + error);
+        }
+        std::unique_ptr<llvm::TargetMachine> targetMachine(target->createTargetMachine(device.triple, cpu, "", llvm::TargetOptions(), llvm::Reloc::Static));
+        if (!targetMachine)
+        {
+            throw EmitterException(EmitterError::targetNotSupported, "Unable to allocate target machine");
+        }
+
+        auto subtargetInfo = targetMachine->getMCSubtargetInfo();
+        if (!subtargetInfo->isCPUStringValid(cpu))
+        {
+            throw EmitterException(EmitterError::targetNotSupported, "Unknown CPU: " + cpu);
+        }
+
+        std::string features;
+        for (const auto& feature : dispatchFeatures)
+        {
+            auto featureString = "+" + std::string(feature.name);
+            if (subtargetInfo->checkFeatures(featureString))
+            {
+                features += featureString + ",";
+            }
+        }
+        if (!features.empty())
+        {
+            features.pop_back();
+        }
+
+        device.deviceName = "custom";
+        device.cpu = cpu;
+        device.features = features;
+        return device;
+    }
+
+    std::string GetCpuSpecificModuleName(const std::string& moduleName, const std::string& cpu)
+    {
+        return moduleName + "_" + GetIdentifier(cpu);
+    }
+
+    std::string GetCpuSpecificFunctionName(const std::string& functionName, const std::string& moduleName, const std::string& cpu)
+    {
+        const auto prefix = moduleName + "_";
+        const auto baseName = HasPrefix(functionName, prefix) ? functionName.substr(prefix.size()) : functionName;
+        return GetCpuSpecificModuleName(moduleName, cpu) + "_" + baseName;
+    }
+
+    void LinkCpuSpecificModules(IRModuleEmitter& module, const std::vector<IRModuleEmitter*>& cpuSpecificModules)
+    {
+        if (cpuSpecificModules.empty())
+        {
+            return;
+        }
+
+        auto& llvmModule = *module.GetLLVMModule();
+        const auto moduleName = module.GetModuleName();
+        if (!IsX86(module.GetCompilerOptions().targetDevice))
+        {
+            throw EmitterException(EmitterError::targetNotSupported, "CPU dispatch is only supported for x86 targets");
+        }
+
+        std::vector<llvm::Function*> publicFunctions;
+        for (auto& function : llvmModule)
+        {
+            if (!function.isDeclaration() && function.hasExternalLinkage() && HasEllMetadata(function))
+            {
+                publicFunctions.push_back(&function);
+            }
+        }
+
+        std::vector<std::vector<const CpuFeature*>> requiredFeatures;
+        std::vector<std::string> cpus;
+        for (auto cpuSpecificModule : cpuSpecificModules)
+        {
+            const auto& device = cpuSpecificModule->GetCompilerOptions().targetDevice;
+            if (cpuSpecificModule->GetModuleName() != GetCpuSpecificModuleName(moduleName, device.cpu))
+            {
+                throw EmitterException(EmitterError::badFunctionArguments, "Module " + cpuSpecificModule->GetModuleName() + " isn't named for CPU " + device.cpu);
+            }
+            requiredFeatures.push_back(GetRequiredFeatures(device.features + ","));
+            cpus.push_back(device.cpu);
+            module.LinkPrivateModule(*cpuSpecificModule);
+        }
+
+        auto getModuleIndex = EmitGetModuleIndexFunction(llvmModule, moduleName + "_GetCpuSpecificModuleIndex", requiredFeatures);
+        for (auto function : publicFunctions)
+        {
+            std::vector<llvm::Function*> cpuSpecificFunctions;
+            for (const auto& cpu : cpus)
+            {
+                auto cpuSpecificFunction = llvmModule.getFunction(GetCpuSpecificFunctionName(function->getName().str(), moduleName, cpu));
+                if (cpuSpecificFunction != nullptr && (cpuSpecificFunction->isDeclaration() || cpuSpecificFunction->getFunctionType() != function->getFunctionType()))
+                {
+                    cpuSpecificFunction = nullptr;
+                }
+                cpuSpecificFunctions.push_back(cpuSpecificFunction);
+            }
+            if (std::any_of(cpuSpecificFunctions.begin(), cpuSpecificFunctions.end(), [](auto f) { return f != nullptr; }))
+            {
+                EmitDispatchFunction(function, getModuleIndex, cpuSpecificFunctions);
+            }
+        }
+    }
+} // namespace emitters
+} // namespace ell
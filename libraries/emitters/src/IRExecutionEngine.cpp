@@ -11,11 +11,15 @@
 
 #include <utilities/include/TypeAliases.h>
 
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/TargetSelect.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <iostream>
+#include <vector>
 
 extern "C"
 {
@@ -45,23 +49,35 @@ namespace emitters
     {
     }
 
-    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify, llvm::CodeGenOpt::Level optLevel)
+    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify, llvm::CodeGenOpt::Level optLevel, std::shared_ptr<llvm::ObjectCache> objectCache) :
+        _objectCache(std::move(objectCache))
     {
         auto debugPrintFunction = pModule->getFunction("DebugPrint");
 
-        llvm::InitializeNativeTarget();
-        llvm::InitializeNativeTargetAsmPrinter();
+        // Engines may be created on several threads at once when maps are compiled in parallel
+        static std::once_flag initialized;
+        std::call_once(initialized, [] {
+            llvm::InitializeNativeTarget();
+            llvm::InitializeNativeTargetAsmPrinter();
+            llvm::remove_fatal_error_handler();
+            llvm::install_fatal_error_handler(&FatalErrorHandler, nullptr);
+        });
 
         _pBuilder = std::make_unique<llvm::EngineBuilder>(std::move(pModule));
         _pBuilder->setEngineKind(llvm::EngineKind::JIT).setVerifyModules(verify).setOptLevel(optLevel).setEmulatedTLS(true);
 
-        static bool installed = false;
-        if (!installed)
+        // Jitted code always runs on the host, so let it use all of the host's vector instructions. Otherwise the JIT
+        // targets a generic CPU, and splits vectors wider than that CPU's registers.
+        llvm::StringMap<bool> hostFeatures;
+        std::vector<std::string> attributes;
+        if (llvm::sys::getHostCPUFeatures(hostFeatures))
         {
-            installed = true;
-            llvm::remove_fatal_error_handler();
-            llvm::install_fatal_error_handler(&FatalErrorHandler, nullptr);
+            for (const auto& feature : hostFeatures)
+            {
+                attributes.push_back((feature.second ? "+" : "-") + feature.first().str());
+            }
         }
+        _pBuilder->setMCPU(llvm::sys::getHostCPUName()).setMAttrs(attributes);
 
         // If DeclareDebugPrint was called, then define it here.
         if (debugPrintFunction)
@@ -157,6 +173,12 @@ namespace emitters
         {
             auto pEngine = _pBuilder->create();
             _pEngine.reset(pEngine);
+
+            // The cache has to be in place before anything triggers code generation, including the static constructors
+            if (_objectCache)
+            {
+                _pEngine->setObjectCache(_objectCache.get());
+            }
             PerformInitialization();
         }
     }
@@ -1651,6 +1651,32 @@ namespace emitters
         Call(setNumThreadsFunction, { numThreads });
     }
 
+    //
+    // Atomic operations
+    //
+
+    LLVMValue IRFunctionEmitter::AtomicLoad(LLVMValue pPointer)
+    {
+        auto valueType = pPointer->getType()->getPointerElementType();
+        auto load = GetEmitter().Load(pPointer);
+        load->setAlignment(GetModule().GetTargetDataLayout().getABITypeAlignment(valueType));
+        load->setAtomic(llvm::AtomicOrdering::Monotonic);
+        return load;
+    }
+
+    void IRFunctionEmitter::AtomicStore(LLVMValue pPointer, LLVMValue pValue)
+    {
+        auto store = GetEmitter().Store(pPointer, pValue);
+        store->setAlignment(GetModule().GetTargetDataLayout().getABITypeAlignment(pValue->getType()));
+        store->setAtomic(llvm::AtomicOrdering::Monotonic);
+    }
+
+    LLVMValue IRFunctionEmitter::AtomicFetchAdd(LLVMValue pPointer, LLVMValue pIncrement)
+    {
+        auto& irBuilder = GetEmitter().GetIRBuilder();
+        return irBuilder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, pPointer, pIncrement, llvm::AtomicOrdering::Monotonic);
+    }
+
     //
     // Calling POSIX functions
     //
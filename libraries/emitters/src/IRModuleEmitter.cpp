@@ -21,13 +21,19 @@
 #include <utilities/include/Logger.h>
 
 #include <llvm/AsmParser/Parser.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/MathExtras.h>
 #include <llvm/Support/TargetRegistry.h>
 #include <llvm/Support/ToolOutputFile.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/Transforms/Utils/ModuleUtils.h>
 
 #include <algorithm>
+#include <map>
+#include <sstream>
+#include <unordered_set>
 #include <vector>
 
 namespace ell
@@ -38,6 +44,103 @@ namespace emitters
     using utilities::logging::Log;
     using namespace ell::utilities;
 
+    namespace
+    {
+        // Returns the instruction before which a replacement for the given operand must be inserted
+        llvm::Instruction* GetInsertionPointForUse(llvm::Use& use)
+        {
+            auto user = llvm::cast<llvm::Instruction>(use.getUser());
+            if (auto phi = llvm::dyn_cast<llvm::PHINode>(user))
+            {
+                return phi->getIncomingBlock(use)->getTerminator();
+            }
+            return user;
+        }
+
+        // Rewrites the constant expressions that use the given value as instructions, so that all the remaining users are instructions
+        void ExpandConstantExpressionUsers(llvm::Constant* value)
+        {
+            std::unordered_set<llvm::User*> users(value->user_begin(), value->user_end());
+            for (auto user : users)
+            {
+                if (auto expression = llvm::dyn_cast<llvm::ConstantExpr>(user))
+                {
+                    ExpandConstantExpressionUsers(expression);
+
+                    std::vector<llvm::Use*> uses;
+                    for (auto& use : expression->uses())
+                    {
+                        uses.push_back(&use);
+                    }
+
+                    for (auto use : uses)
+                    {
+                        auto instruction = expression->getAsInstruction();
+                        instruction->insertBefore(GetInsertionPointForUse(*use));
+                        use->set(instruction);
+                    }
+                    expression->destroyConstant();
+                }
+                else if (!llvm::isa<llvm::Instruction>(user))
+                {
+                    throw EmitterException(EmitterError::notSupported, "Global state referenced from a constant initializer can't be moved into the state struct");
+                }
+            }
+        }
+
+        // Makes everything a module defines private to it, so it can be linked into another module without clashing
+        // with it, and points its declarations of its own callbacks at the names they have in the other module
+        void PrepareModuleForPrivateLinking(llvm::Module& privateModule, const std::string& moduleName)
+        {
+            const auto privatePrefix = privateModule.getName().str() + "_";
+            for (auto& global : privateModule.global_values())
+            {
+                if (global.isDeclaration())
+                {
+                    if (llvm::isa<llvm::Function>(global) && global.getName().startswith(privatePrefix))
+                    {
+                        global.setName(moduleName + "_" + global.getName().substr(privatePrefix.size()).str());
+                    }
+                }
+                else if (!global.getName().startswith("llvm."))
+                {
+                    global.setLinkage(llvm::GlobalValue::InternalLinkage);
+                    if (auto globalObject = llvm::dyn_cast<llvm::GlobalObject>(&global))
+                    {
+                        globalObject->setComdat(nullptr);
+                    }
+                }
+            }
+
+            // Drop ELL's metadata, so the header only describes the other module's own functions and types
+            llvm::SmallVector<llvm::StringRef, 32> kindNames;
+            privateModule.getContext().getMDKindNames(kindNames);
+            for (auto& function : privateModule)
+            {
+                for (unsigned kind = 0; kind < kindNames.size(); ++kind)
+                {
+                    if (kindNames[kind].startswith("ell."))
+                    {
+                        function.setMetadata(kind, nullptr);
+                    }
+                }
+            }
+
+            std::vector<llvm::NamedMDNode*> namedMetadata;
+            for (auto& node : privateModule.named_metadata())
+            {
+                if (node.getName().startswith("ell."))
+                {
+                    namedMetadata.push_back(&node);
+                }
+            }
+            for (auto node : namedMetadata)
+            {
+                node->eraseFromParent();
+            }
+        }
+    } // namespace
+
     //
     // Constructors
     //
@@ -494,6 +597,40 @@ namespace emitters
         return llvm::cast<llvm::GlobalVariable>(global);
     }
 
+    llvm::GlobalVariable* IRModuleEmitter::MergeGlobals(const std::string& name, const std::vector<std::pair<llvm::GlobalVariable*, size_t>>& globals, size_t size)
+    {
+        auto& context = GetLLVMContext();
+        auto int32Type = llvm::Type::getInt32Ty(context);
+        auto buffer = GlobalArray(VariableType::Byte, name, size);
+        auto bufferType = buffer->getValueType();
+        for (const auto& [global, offset] : globals)
+        {
+            if (!global->hasInitializer() || !global->getInitializer()->isNullValue())
+            {
+                throw EmitterException(EmitterError::badFunctionArguments, "Only zero-initialized globals can be merged");
+            }
+            if (offset + GetLLVMModule()->getDataLayout().getTypeAllocSize(global->getValueType()) > size)
+            {
+                throw EmitterException(EmitterError::indexOutOfRange, "Global doesn't fit in the merged buffer");
+            }
+
+            llvm::Constant* indices[] = { llvm::ConstantInt::get(int32Type, 0), llvm::ConstantInt::get(int32Type, offset) };
+            auto address = llvm::ConstantExpr::getInBoundsGetElementPtr(bufferType, buffer, indices);
+            auto view = llvm::ConstantExpr::getPointerCast(address, global->getType());
+            global->replaceAllUsesWith(view);
+
+            // Variables that are emitted again later must resolve to the view
+            std::string globalName = global->getName();
+            if (_globals.Contains(globalName))
+            {
+                _globals.Remove(globalName);
+                _globals.Add(globalName, view);
+            }
+            global->eraseFromParent();
+        }
+        return buffer;
+    }
+
     //
     // Functions
     //
@@ -898,6 +1035,26 @@ namespace emitters
         LoadAsm(stream);
     }
 
+    void IRModuleEmitter::LinkPrivateModule(IRModuleEmitter& privateModule)
+    {
+        // The modules have their own LLVM contexts, so move the code over as bitcode. Writing it also tags its
+        // functions with the CPU and features to generate code for, which may differ from this module's.
+        std::stringstream bitcode;
+        privateModule.WriteToStream(bitcode, ModuleOutputFormat::bitcode);
+        auto buffer = bitcode.str();
+        auto loadedModule = llvm::parseBitcodeFile(llvm::MemoryBufferRef(buffer, privateModule.GetModuleName()), GetLLVMContext());
+        if (!loadedModule)
+        {
+            throw EmitterException(EmitterError::unexpected, "Error loading module " + privateModule.GetModuleName() + ": " + llvm::toString(loadedModule.takeError()));
+        }
+
+        PrepareModuleForPrivateLinking(**loadedModule, GetModuleName());
+        if (llvm::Linker::linkModules(*GetLLVMModule(), std::move(*loadedModule)))
+        {
+            throw EmitterException(EmitterError::unexpected, "Error linking module " + privateModule.GetModuleName());
+        }
+    }
+
     void IRModuleEmitter::WriteHeader(std::ostream& os)
     {
         WriteModuleHeader(os, *this);
@@ -1096,6 +1253,144 @@ namespace emitters
         InsertFunctionMetadata(function, c_callbackFunctionTagName, { nodeName });
     }
 
+    //
+    // Reentrant state
+    //
+    void IRModuleEmitter::EmitReentrantState()
+    {
+        auto module = GetLLVMModule();
+        auto& context = GetLLVMContext();
+        const auto& dataLayout = module->getDataLayout();
+        const auto moduleName = GetModuleName();
+
+        // The state allocator stashes the unaligned malloc pointer just before the state, so leave room for it
+        const uint64_t alignment = std::max<uint64_t>(GetCompilerOptions().globalValueAlignment, 16);
+
+        // The module's private, mutable globals are the state: port buffers, node state and the callback context
+        std::vector<llvm::GlobalVariable*> stateGlobals;
+        for (auto& global : module->globals())
+        {
+            if (global.hasInternalLinkage() && global.hasInitializer() && !global.isConstant() && !global.isThreadLocal())
+            {
+                stateGlobals.push_back(&global);
+            }
+        }
+
+        // Lay them out in a packed struct, keeping each field at the global value alignment
+        auto byteType = llvm::Type::getInt8Ty(context);
+        std::vector<llvm::Type*> fieldTypes;
+        std::vector<llvm::Constant*> fieldValues;
+        std::vector<unsigned> fieldIndices;
+        uint64_t offset = 0;
+        for (auto global : stateGlobals)
+        {
+            auto paddedOffset = llvm::alignTo(offset, alignment);
+            if (paddedOffset > offset)
+            {
+                auto paddingType = llvm::ArrayType::get(byteType, paddedOffset - offset);
+                fieldTypes.push_back(paddingType);
+                fieldValues.push_back(ZeroInitializer(paddingType));
+            }
+            fieldIndices.push_back(static_cast<unsigned>(fieldTypes.size()));
+            fieldTypes.push_back(global->getValueType());
+            fieldValues.push_back(global->getInitializer());
+            offset = paddedOffset + dataLayout.getTypeAllocSize(global->getValueType());
+        }
+        const int64_t stateSize = llvm::alignTo(offset, alignment);
+
+        auto stateType = llvm::StructType::create(context, fieldTypes, moduleName + "_State", true);
+        auto stateInitializer = llvm::ConstantStruct::get(stateType, fieldValues);
+        auto initialState = AddGlobal(moduleName + "_InitialState", stateType, stateInitializer, true);
+        auto defaultState = AddGlobal(moduleName + "_DefaultState", stateType, stateInitializer, false);
+        auto currentState = AddGlobal(moduleName + "_CurrentState", stateType->getPointerTo(), defaultState, false, true);
+
+        // Redirect every use of a state global to its field in the current thread's state. The state pointer is
+        // loaded once at the top of each function that uses it.
+        std::map<llvm::Function*, llvm::Instruction*> functionStates;
+        auto getFunctionState = [&](llvm::Function* function) {
+            auto& state = functionStates[function];
+            if (state == nullptr)
+            {
+                llvm::IRBuilder<> builder(&*function->getEntryBlock().getFirstInsertionPt());
+                state = builder.CreateLoad(currentState, "state");
+            }
+            return state;
+        };
+
+        for (size_t index = 0; index < stateGlobals.size(); ++index)
+        {
+            auto global = stateGlobals[index];
+            ExpandConstantExpressionUsers(global);
+
+            std::vector<llvm::Use*> uses;
+            for (auto& use : global->uses())
+            {
+                uses.push_back(&use);
+            }
+
+            std::map<llvm::Function*, llvm::Value*> fieldPointers;
+            for (auto use : uses)
+            {
+                auto function = llvm::cast<llvm::Instruction>(use->getUser())->getFunction();
+                auto& fieldPointer = fieldPointers[function];
+                if (fieldPointer == nullptr)
+                {
+                    auto state = getFunctionState(function);
+                    llvm::IRBuilder<> builder(state->getNextNode());
+                    fieldPointer = builder.CreateStructGEP(stateType, state, fieldIndices[index], global->getName());
+                }
+                use->set(fieldPointer);
+            }
+
+            std::string name = global->getName();
+            if (_globals.Contains(name))
+            {
+                _globals.Remove(name);
+            }
+            global->eraseFromParent();
+        }
+
+        // void* <module>_AllocateState(): allocates and initializes a new, aligned state
+        auto& allocateFunction = BeginFunction(moduleName + "_AllocateState", VariableType::BytePointer);
+        allocateFunction.IncludeInHeader();
+        {
+            auto rawPointer = allocateFunction.Malloc(VariableType::Byte, stateSize + static_cast<int64_t>(alignment));
+            auto rawAddress = allocateFunction.CastPointerToInt(rawPointer, VariableType::Int64);
+            auto paddedAddress = allocateFunction.Operator(TypedOperator::add, rawAddress, allocateFunction.Literal<int64_t>(static_cast<int64_t>(alignment)));
+            auto alignedAddress = allocateFunction.Operator(TypedOperator::logicalAnd, paddedAddress, allocateFunction.Literal<int64_t>(~static_cast<int64_t>(alignment - 1)));
+            auto state = allocateFunction.CastIntToPointer(alignedAddress, VariableType::BytePointer);
+            auto rawPointerSlot = allocateFunction.CastPointer(state, VariableType::BytePointerPointer);
+            allocateFunction.Store(allocateFunction.PointerOffset(rawPointerSlot, -1), rawPointer);
+            allocateFunction.GetEmitter().MemoryCopy(allocateFunction.CastPointer(initialState, VariableType::BytePointer), state, allocateFunction.Literal<int64_t>(stateSize));
+            allocateFunction.Return(state);
+        }
+        EndFunction();
+
+        // void <module>_FreeState(void* state)
+        auto& freeFunction = BeginFunction(moduleName + "_FreeState", VariableType::Void, NamedVariableTypeList{ { "state", VariableType::BytePointer } });
+        freeFunction.IncludeInHeader();
+        {
+            auto state = freeFunction.GetFunctionArgument("state");
+            auto isNotNull = freeFunction.Comparison(TypedComparison::notEquals, freeFunction.CastPointerToInt(state, VariableType::Int64), freeFunction.Literal<int64_t>(0));
+            freeFunction.If(isNotNull, [state](IRFunctionEmitter& function) {
+                auto rawPointerSlot = function.CastPointer(state, VariableType::BytePointerPointer);
+                function.Free(function.Load(function.PointerOffset(rawPointerSlot, -1)));
+            });
+        }
+        EndFunction();
+
+        // void <module>_SetState(void* state): binds a state to the calling thread (null restores the default state)
+        auto& setStateFunction = BeginFunction(moduleName + "_SetState", VariableType::Void, NamedVariableTypeList{ { "state", VariableType::BytePointer } });
+        setStateFunction.IncludeInHeader();
+        {
+            auto state = setStateFunction.GetFunctionArgument("state");
+            auto isNull = setStateFunction.Comparison(TypedComparison::equals, setStateFunction.CastPointerToInt(state, VariableType::Int64), setStateFunction.Literal<int64_t>(0));
+            auto newState = setStateFunction.Select(isNull, defaultState, setStateFunction.CastPointer(state, stateType->getPointerTo()));
+            setStateFunction.Store(currentState, newState);
+        }
+        EndFunction();
+    }
+
     //
     // Module initialization / finalization
     //
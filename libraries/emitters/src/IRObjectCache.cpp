@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRObjectCache.h"
+
+#include <utilities/include/Files.h>
+#include <utilities/include/Logger.h>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    using namespace logging;
+
+    IRObjectCache::IRObjectCache(const std::string& directory, const llvm::Module& module, const CompilerOptions& options) :
+        _keyMaterial(GetKeyMaterial(module, options)),
+        _key(GetKey(module, _keyMaterial)),
+        _objectPath(utilities::JoinPaths(directory, _key + ".o")),
+        _timePath(utilities::JoinPaths(directory, _key + ".time")),
+        _keyMaterialPath(utilities::JoinPaths(directory, _key + ".key"))
+    {
+        utilities::EnsureDirectoryExists(directory);
+        if (utilities::FileExists(_objectPath) && utilities::FileExists(_keyMaterialPath))
+        {
+            auto stream = utilities::OpenBinaryIfstream(_keyMaterialPath);
+            std::string storedKeyMaterial{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+            _isHit = storedKeyMaterial == _keyMaterial;
+            if (!_isHit)
+            {
+                // Either a digest collision or a damaged entry: compiling overwrites it
+                Log() << "Object cache: key material for " << _key << " doesn't match, ignoring the cached object" << EOL;
+            }
+        }
+        if (_isHit && utilities::FileExists(_timePath))
+        {
+            auto stream = utilities::OpenIfstream(_timePath);
+            stream >> _timeSaved;
+        }
+    }
+
+    std::string IRObjectCache::GetKeyMaterial(const llvm::Module& module, const CompilerOptions& options)
+    {
+        // Everything that changes the code generated from the same IR: the optimizer settings, the target, and the
+        // version of LLVM doing the work. The JIT compiles for the host's enabled features (see IRExecutionEngine),
+        // which can differ between hosts with the same CPU name, e.g. when the OS or a VM turns AVX-512 off.
+        std::vector<std::string> hostFeatures;
+        llvm::StringMap<bool> features;
+        if (llvm::sys::getHostCPUFeatures(features))
+        {
+            for (const auto& feature : features)
+            {
+                if (feature.second)
+                {
+                    hostFeatures.push_back(feature.first().str());
+                }
+            }
+        }
+        std::sort(hostFeatures.begin(), hostFeatures.end());
+
+        std::string keyMaterial;
+        llvm::raw_string_ostream stream(keyMaterial);
+        stream << "llvm: " << LLVM_VERSION_STRING << "\n"
+               << "host: " << llvm::sys::getHostCPUName() << "\n"
+               << "hostFeatures:";
+        for (const auto& feature : hostFeatures)
+        {
+            stream << " +" << feature;
+        }
+        stream << "\n"
+               << "optimize: " << options.optimize << "\n"
+               << "useFastMath: " << options.useFastMath << "\n"
+               << "triple: " << options.targetDevice.triple << "\n"
+               << "dataLayout: " << options.targetDevice.dataLayout << "\n"
+               << "cpu: " << options.targetDevice.cpu << "\n"
+               << "features: " << options.targetDevice.features << "\n"
+               << "\n";
+        module.print(stream, nullptr);
+        stream.flush();
+        return keyMaterial;
+    }
+
+    std::string IRObjectCache::GetKey(const llvm::Module& module, const std::string& keyMaterial)
+    {
+        auto digest = llvm::SHA1::hash(llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(keyMaterial.data()), keyMaterial.size()));
+
+        std::stringstream key;
+        key << module.getModuleIdentifier() << "_" << std::hex << std::setfill('0');
+        for (auto byte : digest)
+        {
+            key << std::setw(2) << static_cast<int>(byte);
+        }
+        return key.str();
+    }
+
+    void IRObjectCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object)
+    {
+        _codeGenerationTimer.Stop();
+        auto elapsed = _optimizationTime + _codeGenerationTimer.Elapsed();
+
+        // Write to temporary files and rename them into place, so another process never sees a partial object
+        auto tempObjectPath = _objectPath + ".tmp";
+        {
+            auto stream = utilities::OpenBinaryOfstream(tempObjectPath);
+            stream.write(object.getBufferStart(), object.getBufferSize());
+        }
+        auto tempTimePath = _timePath + ".tmp";
+        {
+            auto stream = utilities::OpenOfstream(tempTimePath);
+            stream << elapsed;
+        }
+        auto tempKeyMaterialPath = _keyMaterialPath + ".tmp";
+        {
+            auto stream = utilities::OpenBinaryOfstream(tempKeyMaterialPath);
+            stream.write(_keyMaterial.data(), _keyMaterial.size());
+        }
+        std::rename(tempTimePath.c_str(), _timePath.c_str());
+        std::rename(tempKeyMaterialPath.c_str(), _keyMaterialPath.c_str());
+        std::rename(tempObjectPath.c_str(), _objectPath.c_str());
+
+        Log() << "Object cache: stored " << _key << " (" << elapsed << " ms to optimize and compile)" << EOL;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> IRObjectCache::getObject(const llvm::Module* module)
+    {
+        if (!_isHit)
+        {
+            // The JIT generates code right after this returns
+            _codeGenerationTimer.Start();
+            return nullptr;
+        }
+
+        auto buffer = llvm::MemoryBuffer::getFile(_objectPath);
+        if (!buffer)
+        {
+            // Fall back to compiling the module, which overwrites the unreadable object
+            Log() << "Object cache: couldn't read " << _objectPath << EOL;
+            _isHit = false;
+            _timeSaved = 0;
+            _codeGenerationTimer.Start();
+            return nullptr;
+        }
+
+        Log() << "Object cache: loaded " << _key << " (saved " << _timeSaved << " ms)" << EOL;
+        return std::move(buffer.get());
+    }
+} // namespace emitters
+} // namespace ell
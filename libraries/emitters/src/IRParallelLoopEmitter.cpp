@@ -12,6 +12,7 @@
 #include "IRMath.h"
 #include "IRModuleEmitter.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace ell
@@ -40,26 +41,18 @@ namespace emitters
     {
         auto compilerSettings = _functionEmitter.GetCompilerOptions();
         const int numTasks = options.numTasks == 0 ? compilerSettings.maxThreads : options.numTasks;
-        auto span = end - begin;
-        auto numIterations = (span - 1) / increment + 1;
         // TODO: explicitly check for empty loop?
 
-        auto taskSize = (numIterations - 1) / numTasks + 1;
         if (compilerSettings.parallelize && numTasks > 1)
         {
-            auto taskFunction = GetTaskFunction(capturedValues, body);
-
-            std::vector<std::vector<LLVMValue>> taskArgs;
-            for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+            if (compilerSettings.parallelSchedulingPolicy == ParallelSchedulingPolicy::workStealing)
             {
-                auto blockStart = begin + taskIndex * taskSize * increment;
-                auto blockEnd = Min(blockStart + taskSize * increment, end);
-                std::vector<LLVMValue> args{ blockStart, blockEnd, increment };
-                std::copy(capturedValues.begin(), capturedValues.end(), std::back_inserter(args));
-                taskArgs.push_back(args);
+                EmitWorkStealingTasks(begin, end, increment, numTasks, capturedValues, body);
+            }
+            else
+            {
+                EmitStaticBlockTasks(begin, end, increment, numTasks, capturedValues, body);
             }
-            auto tasks = _functionEmitter.StartTasks(taskFunction, taskArgs);
-            tasks.WaitAll(_functionEmitter);
         }
         else
         {
@@ -70,6 +63,57 @@ namespace emitters
         }
     }
 
+    void IRParallelForLoopEmitter::EmitStaticBlockTasks(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, const std::vector<LLVMValue>& capturedValues, BodyFunction body)
+    {
+        auto span = end - begin;
+        auto numIterations = (span - 1) / increment + 1;
+        auto taskSize = (numIterations - 1) / numTasks + 1;
+        auto taskFunction = GetTaskFunction(capturedValues, body);
+
+        std::vector<std::vector<LLVMValue>> taskArgs;
+        for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            auto blockStart = begin + taskIndex * taskSize * increment;
+            auto blockEnd = Min(blockStart + taskSize * increment, end);
+            std::vector<LLVMValue> args{ blockStart, blockEnd, increment };
+            std::copy(capturedValues.begin(), capturedValues.end(), std::back_inserter(args));
+            taskArgs.push_back(args);
+        }
+        auto tasks = _functionEmitter.StartTasks(taskFunction, taskArgs);
+        tasks.WaitAll(_functionEmitter);
+    }
+
+    void IRParallelForLoopEmitter::EmitWorkStealingTasks(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, const std::vector<LLVMValue>& capturedValues, BodyFunction body)
+    {
+        // The loop is split into numTasks * chunksPerTask equal chunks. Task `t` owns chunks [t * chunksPerTask, (t + 1) * chunksPerTask),
+        // and each task has a counter holding the next unclaimed chunk in its range. A task claims its own chunks in order, then
+        // visits the other tasks' counters and claims whatever they haven't gotten to yet, so a slow task's leftover work is
+        // picked up by the tasks that finish early.
+        const int chunksPerTask = std::max(1, _functionEmitter.GetCompilerOptions().parallelChunksPerThread);
+        const int numChunks = numTasks * chunksPerTask;
+        auto span = end - begin;
+        auto numIterations = (span - 1) / increment + 1;
+        auto chunkSize = (numIterations - 1) / numChunks + 1;
+
+        auto nextChunks = _functionEmitter.Variable(VariableType::Int32, numTasks);
+        for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            _functionEmitter.Store(_functionEmitter.PointerOffset(nextChunks, taskIndex), _functionEmitter.Literal<int>(taskIndex * chunksPerTask));
+        }
+
+        auto taskFunction = GetWorkStealingTaskFunction(numTasks, chunksPerTask, capturedValues, body);
+
+        std::vector<std::vector<LLVMValue>> taskArgs;
+        for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            std::vector<LLVMValue> args{ _functionEmitter.Literal<int>(taskIndex), nextChunks, begin, end, increment, chunkSize };
+            std::copy(capturedValues.begin(), capturedValues.end(), std::back_inserter(args));
+            taskArgs.push_back(args);
+        }
+        auto tasks = _functionEmitter.StartTasks(taskFunction, taskArgs);
+        tasks.WaitAll(_functionEmitter);
+    }
+
     IRFunctionEmitter IRParallelForLoopEmitter::GetTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body)
     {
         std::string name = "parForTask";
@@ -102,5 +146,61 @@ namespace emitters
         _functionEmitter.GetModule().EndFunction();
         return taskFunction;
     }
+
+    IRFunctionEmitter IRParallelForLoopEmitter::GetWorkStealingTaskFunction(int numTasks, int chunksPerTask, const std::vector<LLVMValue>& capturedValues, BodyFunction body)
+    {
+        std::string name = "parForStealingTask";
+
+        // args = task index, next-chunk counters, begin, end, increment, chunk size, captured args
+        auto& irEmitter = _functionEmitter.GetModule().GetIREmitter();
+        auto returnType = irEmitter.Type(VariableType::Void);
+        auto argTypes = irEmitter.GetLLVMTypes({ VariableType::Int32, VariableType::Int32Pointer, VariableType::Int32, VariableType::Int32, VariableType::Int32, VariableType::Int32 });
+        auto capturedTypes = GetLLVMTypes(capturedValues);
+        std::copy(capturedTypes.begin(), capturedTypes.end(), std::back_inserter(argTypes));
+        auto taskFunction = _functionEmitter.GetModule().BeginFunction(name, returnType, argTypes);
+
+        {
+            auto arguments = taskFunction.Arguments().begin();
+            auto taskIndex = taskFunction.LocalScalar(&(*arguments++));
+            auto nextChunks = &(*arguments++);
+            auto begin = taskFunction.LocalScalar(&(*arguments++));
+            auto end = taskFunction.LocalScalar(&(*arguments++));
+            auto increment = taskFunction.LocalScalar(&(*arguments++));
+            auto chunkSize = taskFunction.LocalScalar(&(*arguments++));
+            std::vector<LLVMValue> innerCapturedValues;
+            int numCapturedValues = static_cast<int>(capturedValues.size());
+            for (int index = 0; index < numCapturedValues; ++index)
+            {
+                auto capturedValue = &(*arguments++);
+                capturedValue->setName("captured_" + std::to_string(index));
+                innerCapturedValues.push_back(capturedValue);
+            }
+
+            auto isClaimingVar = taskFunction.Variable(VariableType::Boolean, "isClaiming");
+            taskFunction.For(numTasks, [=](IRFunctionEmitter& taskFunction, IRLocalScalar victimOffset) {
+                // Start with our own chunks, then move on to the other tasks' ranges
+                auto victim = (taskIndex + victimOffset) % numTasks;
+                auto nextChunk = taskFunction.PointerOffset(nextChunks, victim);
+                auto endChunk = (victim + 1) * chunksPerTask;
+
+                taskFunction.Store(isClaimingVar, taskFunction.TrueBit());
+                taskFunction.While(isClaimingVar, [=](IRFunctionEmitter& taskFunction) {
+                    auto chunk = taskFunction.LocalScalar(taskFunction.AtomicFetchAdd(nextChunk, taskFunction.Literal<int>(1)));
+                    taskFunction.If(chunk < endChunk, [=](IRFunctionEmitter& taskFunction) {
+                                    auto chunkBegin = begin + chunk * chunkSize * increment;
+                                    auto chunkEnd = Min(chunkBegin + chunkSize * increment, end);
+                                    taskFunction.For(chunkBegin, chunkEnd, increment, [innerCapturedValues, body](IRFunctionEmitter& taskFunction, LLVMValue i) {
+                                        body(taskFunction, taskFunction.LocalScalar(i), innerCapturedValues);
+                                    });
+                                })
+                        .Else([isClaimingVar](IRFunctionEmitter& taskFunction) {
+                            taskFunction.Store(isClaimingVar, taskFunction.FalseBit());
+                        });
+                });
+            });
+        }
+        _functionEmitter.GetModule().EndFunction();
+        return taskFunction;
+    }
 } // namespace emitters
 } // namespace ell
@@ -23,6 +23,12 @@ namespace ell
 {
 namespace emitters
 {
+    namespace
+    {
+        // Number of times an idle worker checks for new work before waiting on the condition variable
+        const int workerSpinCount = 4096;
+    } // namespace
+
     //
     // IRThreadPool
     //
@@ -120,7 +126,12 @@ namespace emitters
         {
             auto notDoneVar = workerThreadFunction.Variable(boolType, "notDone");
             workerThreadFunction.Store(notDoneVar, workerThreadFunction.TrueBit());
-            workerThreadFunction.While(notDoneVar, [this, notDoneVar](IRFunctionEmitter& workerThreadFunction) {
+            const bool spinBeforeWaiting = _module.GetCompilerOptions().parallelSchedulingPolicy == ParallelSchedulingPolicy::workStealing;
+            workerThreadFunction.While(notDoneVar, [this, notDoneVar, spinBeforeWaiting](IRFunctionEmitter& workerThreadFunction) {
+                if (spinBeforeWaiting)
+                {
+                    _taskQueue.SpinWhileEmpty(workerThreadFunction, workerSpinCount);
+                }
                 auto task = _taskQueue.PopNextTask(workerThreadFunction);
                 // check for a poison "null" task, indicating we should break out of the loop and terminate the thread
                 workerThreadFunction.If(
@@ -297,6 +308,24 @@ namespace emitters
         UnlockQueueMutex(function);
     }
 
+    void IRThreadPoolTaskQueue::SpinWhileEmpty(IRFunctionEmitter& function, int maxSpins)
+    {
+        assert(IsInitialized());
+
+        // The unscheduled count is always written atomically, so it's safe to poll it without holding the mutex
+        auto unscheduledCountPtr = function.GetStructFieldPointer(_queueData, static_cast<int>(Fields::unscheduledCount));
+        auto spinsLeftVar = function.Variable(VariableType::Int32, "spinsLeft");
+        function.Store(spinsLeftVar, function.Literal<int>(maxSpins));
+        auto shouldSpin = [=](IRFunctionEmitter& function) -> LLVMValue {
+            auto spinsLeft = function.LocalScalar(function.Load(spinsLeftVar));
+            auto unscheduledCount = function.LocalScalar(function.AtomicLoad(unscheduledCountPtr));
+            return (spinsLeft > 0) && (unscheduledCount == 0);
+        };
+        function.While(shouldSpin, [=](IRFunctionEmitter& function) {
+            function.OperationAndUpdate(spinsLeftVar, TypedOperator::subtract, function.Literal<int>(1));
+        });
+    }
+
     llvm::StructType* IRThreadPoolTaskQueue::GetTaskQueueDataType(IRModuleEmitter& module) const // TODO: come up with a naming convention for "class" structs like this
     {
         auto& context = module.GetLLVMContext();
@@ -331,7 +360,7 @@ namespace emitters
     {
         assert(IsInitialized());
         auto fieldPtr = function.GetStructFieldPointer(_queueData, static_cast<int>(Fields::unscheduledCount));
-        return function.Load(fieldPtr);
+        return function.AtomicLoad(fieldPtr);
     }
 
     LLVMValue IRThreadPoolTaskQueue::GetUnfinishedCount(IRFunctionEmitter& function) const
@@ -344,17 +373,18 @@ namespace emitters
     void IRThreadPoolTaskQueue::SetInitialCount(IRFunctionEmitter& function, LLVMValue numTasks)
     {
         assert(IsInitialized());
-        function.Store(function.GetStructFieldPointer(_queueData, static_cast<int>(Fields::unscheduledCount)), numTasks);
+        function.AtomicStore(function.GetStructFieldPointer(_queueData, static_cast<int>(Fields::unscheduledCount)), numTasks);
         function.Store(function.GetStructFieldPointer(_queueData, static_cast<int>(Fields::unfinishedCount)), numTasks);
     }
 
     LLVMValue IRThreadPoolTaskQueue::DecrementCountField(IRFunctionEmitter& function, LLVMValue fieldPtr)
     {
-        auto count = function.Load(fieldPtr);
+        // Called with the queue mutex held; the accesses are atomic only so that `SpinWhileEmpty` can poll without it
+        auto count = function.AtomicLoad(fieldPtr);
         auto newCount = function.Operator(TypedOperator::subtract, count, function.Literal<int>(1));
         auto isNotZero = function.Comparison(TypedComparison::notEquals, count, function.Literal<int>(0));
         function.If(isNotZero, [=](auto& function) {
-            function.Store(fieldPtr, newCount);
+            function.AtomicStore(fieldPtr, newCount);
         });
         return newCount;
     }
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRVectorUtilities.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRVectorUtilities.h"
+#include "IRModuleEmitter.h"
+
+namespace ell
+{
+namespace emitters
+{
+    void VectorizedFor(IRFunctionEmitter& function, int count, int vectorSize, VectorizedForLoopBodyFunction body)
+    {
+        const int numBlocks = vectorSize > 1 ? count / vectorSize : 0;
+        if (numBlocks > 0)
+        {
+            function.For(numBlocks, [vectorSize, body](IRFunctionEmitter& function, IRLocalScalar blockIndex) {
+                body(function, blockIndex * vectorSize, vectorSize);
+            });
+        }
+
+        const int tailBegin = numBlocks * vectorSize;
+        if (tailBegin < count)
+        {
+            function.For(tailBegin, count, [body](IRFunctionEmitter& function, IRLocalScalar index) {
+                body(function, index, 1);
+            });
+        }
+    }
+
+    LLVMValue LoadVector(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue offset, int width)
+    {
+        if (width == 1)
+        {
+            return function.ValueAt(pointer, offset);
+        }
+
+        auto elementPointer = function.PointerOffset(pointer, offset);
+        auto elementType = elementPointer->getType()->getPointerElementType();
+        auto vectorPointer = function.CastPointer(elementPointer, llvm::VectorType::get(elementType, width)->getPointerTo());
+        auto load = function.GetEmitter().Load(vectorPointer);
+        load->setAlignment(function.GetModule().GetTargetDataLayout().getABITypeAlignment(elementType));
+        return load;
+    }
+
+    void StoreVector(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue offset, LLVMValue value)
+    {
+        if (!value->getType()->isVectorTy())
+        {
+            function.SetValueAt(pointer, offset, value);
+            return;
+        }
+
+        auto elementPointer = function.PointerOffset(pointer, offset);
+        auto elementType = elementPointer->getType()->getPointerElementType();
+        auto vectorPointer = function.CastPointer(elementPointer, value->getType()->getPointerTo());
+        auto store = function.GetEmitter().Store(vectorPointer, value);
+        store->setAlignment(function.GetModule().GetTargetDataLayout().getABITypeAlignment(elementType));
+    }
+
+    LLVMValue SplatVector(IRFunctionEmitter& function, LLVMValue value, int width)
+    {
+        if (width == 1)
+        {
+            return value;
+        }
+        return function.GetEmitter().GetIRBuilder().CreateVectorSplat(width, value);
+    }
+} // namespace emitters
+} // namespace ell
@@ -150,6 +150,33 @@ namespace emitters
         return tripleObj.getOS() == llvm::Triple::MacOSX || tripleObj.getOS() == llvm::Triple::Darwin;
     }
 
+    size_t TargetDevice::GetVectorRegisterSize() const
+    {
+        auto tripleObj = GetNormalizedTriple(triple);
+        switch (tripleObj.getArch())
+        {
+        case llvm::Triple::x86:
+        case llvm::Triple::x86_64:
+            if (HasFeature("+avx512f"))
+            {
+                return 64;
+            }
+            if (HasFeature("+avx"))
+            {
+                return 32;
+            }
+            // SSE2 is part of the x86-64 baseline
+            return (tripleObj.getArch() == llvm::Triple::x86_64 || HasFeature("+sse2")) ? 16 : 0;
+        case llvm::Triple::aarch64:
+            return 16;
+        case llvm::Triple::arm:
+        case llvm::Triple::thumb:
+            return HasFeature("+neon") ? 16 : 0;
+        default:
+            return 0;
+        }
+    }
+
     TargetDevice GetTargetDevice(std::string deviceName)
     {
         TargetDevice target;
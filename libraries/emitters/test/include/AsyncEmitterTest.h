@@ -12,3 +12,5 @@ void TestIRAsyncTask(bool parallel);
 void TestParallelTasks(bool parallel, bool useThreadPool);
 
 void TestParallelFor(int start, int end, int increment, bool parallel);
+
+void TestWorkStealingParallelFor(int start, int end, int increment, int numThreads);
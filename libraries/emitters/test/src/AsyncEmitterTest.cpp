@@ -212,13 +212,8 @@ void TestParallelTasks(bool parallel, bool useThreadPool)
 //
 // TestParallelFor
 //
-void TestParallelFor(int begin, int end, int increment, bool parallel)
+static int RunParallelFor(const CompilerOptions& options, int begin, int end, int increment)
 {
-    CompilerOptions options;
-    options.optimize = false;
-    options.targetDevice.deviceName = "host";
-    options.parallelize = parallel;
-    options.useThreadPool = true;
     IRModuleEmitter module("ParallelForTest", options);
 
     // Function to run test
@@ -257,8 +252,7 @@ void TestParallelFor(int begin, int end, int increment, bool parallel)
 
         // Call the function
         auto functionPtr = (IntFunction)executionEngine.ResolveFunctionAddress(functionName);
-        auto result = functionPtr();
-        testing::ProcessTest("Testing compilable parallel for loop", testing::IsEqual(result, 0));
+        return functionPtr();
     }
     catch (utilities::Exception& exception)
     {
@@ -267,3 +261,29 @@ void TestParallelFor(int begin, int end, int increment, bool parallel)
         throw;
     }
 }
+
+void TestParallelFor(int begin, int end, int increment, bool parallel)
+{
+    CompilerOptions options;
+    options.optimize = false;
+    options.targetDevice.deviceName = "host";
+    options.parallelize = parallel;
+    options.useThreadPool = true;
+
+    auto result = RunParallelFor(options, begin, end, increment);
+    testing::ProcessTest("Testing compilable parallel for loop", testing::IsEqual(result, 0));
+}
+
+void TestWorkStealingParallelFor(int begin, int end, int increment, int numThreads)
+{
+    CompilerOptions options;
+    options.optimize = false;
+    options.targetDevice.deviceName = "host";
+    options.parallelize = true;
+    options.useThreadPool = true;
+    options.maxThreads = numThreads;
+    options.parallelSchedulingPolicy = ParallelSchedulingPolicy::workStealing;
+
+    auto result = RunParallelFor(options, begin, end, increment);
+    testing::ProcessTest("Testing compilable work-stealing parallel for loop with " + std::to_string(numThreads) + " threads", testing::IsEqual(result, 0));
+}
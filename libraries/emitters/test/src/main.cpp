@@ -86,6 +86,11 @@ void TestAsyncEmitter()
     TestParallelFor(10, 90, 2, true);
     TestParallelFor(10, 90, 3, true);
     TestParallelFor(30, 40, 11, true);
+
+    TestWorkStealingParallelFor(0, 100, 1, 4);
+    TestWorkStealingParallelFor(10, 90, 3, 4);
+    TestWorkStealingParallelFor(0, 101, 1, 8);
+    TestWorkStealingParallelFor(30, 40, 11, 8);
 }
 
 void TestPosixEmitter()
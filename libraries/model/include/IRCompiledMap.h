@@ -18,6 +18,7 @@
 
 #include <emitters/include/IRExecutionEngine.h>
 #include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IRObjectCache.h>
 #include <emitters/include/ModuleEmitter.h>
 
 #include <utilities/include/Boolean.h>
@@ -43,8 +44,10 @@ namespace model
         IRCompiledMap(const IRCompiledMap&) = delete;
         IRCompiledMap(IRCompiledMap&& other);
         IRCompiledMap& operator=(const IRCompiledMap&) = delete;
+        ~IRCompiledMap() override;
 
-        /// <summary> Clone the compiled model </summary>
+        /// <summary> Clone the compiled model. If the model was compiled with the `reentrant` option, the clone shares
+        /// the jitted code with this map and only gets its own copy of the model state. </summary>
         IRCompiledMap Clone();
 
         /// <summary> Output the compiled model to the given file </summary>
@@ -106,6 +109,12 @@ namespace model
         /// <returns> The jitter. </returns>
         emitters::IRExecutionEngine& GetJitter();
 
+        /// <summary> Gets the on-disk cache the map's object code is loaded from or stored in, which reports
+        /// whether the compile was a cache hit and how much time it saved. </summary>
+        ///
+        /// <returns> The object cache, or null if `MapCompilerOptions::objectCacheDirectory` wasn't set. </returns>
+        const emitters::IRObjectCache* GetObjectCache() const { return _objectCache.get(); }
+
         //
         // Node profiling support
         //
@@ -219,12 +228,15 @@ namespace model
         std::vector<float> ComputeFloatOutput(const model::PortElementsBase& outputs) override;
         std::vector<double> ComputeDoubleOutput(const model::PortElementsBase& outputs) override;
 
+        void ComputeBatchOutput(const void* inputs, size_t batchSize, void* outputs) override;
+
     private:
         friend class IRMapCompiler;
 
-        IRCompiledMap(Map map, const std::string& functionName, const MapCompilerOptions& options, emitters::IRModuleEmitter& module, bool verifyJittedModule);
+        IRCompiledMap(Map map, const std::string& functionName, const MapCompilerOptions& options, emitters::IRModuleEmitter& module, bool verifyJittedModule, std::shared_ptr<emitters::IRObjectCache> objectCache = nullptr);
 
         void EnsureExecutionEngine();
+        void EnsureState();
         void SetComputeFunction();
         template <typename InputType>
         void SetComputeFunctionForInputType();
@@ -235,10 +247,16 @@ namespace model
         emitters::IRModuleEmitter& _module;
         std::string _moduleName;
 
-        std::unique_ptr<emitters::IRExecutionEngine> _executionEngine;
+        std::shared_ptr<emitters::IRExecutionEngine> _executionEngine;
+        std::shared_ptr<emitters::IRObjectCache> _objectCache;
         bool _verifyJittedModule = true;
         void* _context = nullptr;
 
+        // The model state owned by this map, if the model was compiled with the `reentrant` option
+        void* _state = nullptr;
+        std::function<void(void*)> _setStateFunction;
+        std::function<void(void*)> _freeStateFunction;
+
         void* InternalGetContext();
         void ResolveCallbacks();
 
@@ -249,6 +267,8 @@ namespace model
         std::variant<ComputeFunction<bool>, ComputeFunction<int>, ComputeFunction<int64_t>, ComputeFunction<float>, ComputeFunction<double>> _computeInputFunction;
         std::variant<Vector<bool>, Vector<int>, Vector<int64_t>, Vector<float>, Vector<double>> _cachedOutput;
         std::function<void(void*, void* const*, void* const*)> _computeDispatchFunction;
+        std::function<void(void*, const void*, void*)> _computePredictFunction;
+        std::function<void(void*, const void*, void*, int)> _computeBatchFunction; // only if compiled with `emitBatchFunction`
         std::function<void()> _resetFunction;
     };
 } // namespace model
@@ -326,6 +346,14 @@ namespace model
             }
 
             _computeInputFunction = computeFunction;
+
+            // Batches are computed straight into the caller's buffers, so they bypass the cached output
+            _computePredictFunction = reinterpret_cast<void (*)(void*, const void*, void*)>(functionPointer);
+            if (GetMapCompilerOptions().emitBatchFunction)
+            {
+                _computeBatchFunction = reinterpret_cast<void (*)(void*, const void*, void*, int)>(_executionEngine->ResolveFunctionAddress(_functionName + "_batch"));
+            }
+
             functionPointer = _executionEngine->ResolveFunctionAddress(_functionName + "_dispatch");
             _computeDispatchFunction = reinterpret_cast<void(*)(void*, void* const*, void* const*)>(functionPointer);
 
@@ -14,6 +14,7 @@
 #include "Node.h"
 #include "NodeMap.h"
 #include "OutputPort.h"
+#include "PortBufferPlanner.h"
 
 #include <emitters/include/IRModuleEmitter.h>
 #include <emitters/include/LLVMUtilities.h>
@@ -147,6 +148,11 @@ namespace model
         /// <returns> The generated name. </returns>
         std::string GetGlobalName(const Node& node, const std::string& baseName) const;
 
+        /// <summary> Gets the port buffer layout chosen by the last call to `Compile`, if the `reusePortBuffers` option was set. </summary>
+        ///
+        /// <returns> The arena layout of the reusable port buffers. </returns>
+        const BufferPlan& GetPortBufferPlan() const { return _portBufferPlan; }
+
     protected:
         void OnBeginCompileModel(const Model& model) override;
         void OnEndCompileModel(const Model& model) override;
@@ -165,9 +171,14 @@ namespace model
         NodeMap<emitters::IRBlockRegion*>& GetCurrentNodeBlocks();
         const Node* GetUniqueParent(const Node& node);
         void RefineAndOptimize(Map& map);
+        void CompileBatchedMap(Map map);
+        void ReusePortBuffers(const Model& model);
         bool TryMergeNodeIntoRegion(emitters::IRBlockRegion* pDestination, const Node& src);
 
         void EmitPredictDispatchFunction(const Map& map);
+        // Emits "<predict>_batch", which computes whole batches with the batched map compiled by `CompileBatchedMap`,
+        // if there is one, and the remaining examples with the predict function, one at a time.
+        void EmitPredictBatchFunction(const Map& map);
         void EmitGetInputSizeFunction(const Map& map);
         void EmitGetOutputSizeFunction(const Map& map);
         void EmitGetSinkOutputSizeFunction(const Map& map);
@@ -185,6 +196,11 @@ namespace model
 
         // stack of node regions
         std::vector<NodeMap<emitters::IRBlockRegion*>> _nodeRegions;
+
+        BufferPlan _portBufferPlan;
+
+        // The function, linked in from another module, that computes a batch of examples at once
+        std::string _batchedPredictFunctionName;
     };
 } // namespace model
 } // namespace ell
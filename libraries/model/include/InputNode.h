@@ -64,6 +64,11 @@ namespace model
         /// <param name="inputValues"> The values for this node to output </param>
         void SetInput(std::vector<ValueType> inputValues);
 
+        /// <summary> Sets the values output by this node, copying them into the node's existing storage </summary>
+        ///
+        /// <param name="inputValues"> Pointer to the values for this node to output. Must point to `Size()` values. </param>
+        void SetInput(const ValueType* inputValues);
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -85,6 +90,7 @@ namespace model
 
     private:
         void Copy(ModelTransformer& transformer) const override;
+        bool Batch(ModelTransformer& transformer) const override;
 
         std::vector<ValueType> _inputValues;
         OutputPort<ValueType> _output;
@@ -169,6 +175,12 @@ namespace model
         _inputValues = inputValues;
     }
 
+    template <typename ValueType>
+    void InputNode<ValueType>::SetInput(const ValueType* inputValues)
+    {
+        _inputValues.assign(inputValues, inputValues + _output.Size());
+    }
+
     template <typename ValueType>
     void InputNode<ValueType>::Compute() const
     {
@@ -182,6 +194,14 @@ namespace model
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool InputNode<ValueType>::Batch(ModelTransformer& transformer) const
+    {
+        auto newNode = transformer.AddNode<InputNode<ValueType>>(GetBatchedMemoryLayout(GetMemoryLayout(), transformer.GetBatchSize()));
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void InputNode<ValueType>::Compile(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
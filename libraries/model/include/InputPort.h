@@ -147,6 +147,11 @@ namespace model
         /// <returns> The (already-computed) output value corresponding to this input </returns>
         std::vector<ValueType> GetValue() const;
 
+        /// <summary> Returns a reference to the (already-computed) output value corresponding to this input, without copying it </summary>
+        ///
+        /// <returns> The output value </returns>
+        const std::vector<ValueType>& GetValueReference() const;
+
         /// <summary> Returns an element from the (already-computed) output value corresponding to this input </summary>
         ///
         /// <param name="index"> The index of the element to return </param>
@@ -219,6 +224,12 @@ namespace model
         return result;
     }
 
+    template <typename ValueType>
+    const std::vector<ValueType>& InputPort<ValueType>::GetValueReference() const
+    {
+        return GetReferencedPort().GetOutput();
+    }
+
     template <typename ValueType>
     ValueType InputPort<ValueType>::GetValue(size_t index) const
     {
@@ -10,6 +10,7 @@
 
 #include "InputNode.h"
 #include "Node.h"
+#include "ParallelModelExecutor.h"
 #include "PortElements.h"
 #include "Submodel.h"
 #include "Transformation.h"
@@ -21,6 +22,7 @@
 #include <utilities/include/IArchivable.h>
 #include <utilities/include/PropertyBag.h>
 #include <utilities/include/StlVectorUtil.h>
+#include <utilities/include/ThreadPool.h>
 #include <utilities/include/TypeName.h>
 #include <utilities/include/TypeTraits.h>
 
@@ -29,6 +31,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -108,9 +111,38 @@ namespace model
         template <typename OutputVectorType, typename InputVectorType, data::IsDataVector<OutputVectorType> OutputConcept = true, data::IsDataVector<InputVectorType> InputConcept = true>
         OutputVectorType Compute(const InputVectorType& inputValues);
 
+        /// <summary> Computes the map's output for each of a batch of inputs </summary>
+        ///
+        /// <param name="inputs"> The inputs to the map, one vector per example </param>
+        /// <returns> The outputs of the map, one vector per example </returns>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = true, utilities::IsFundamental<InputType> InputConcept = true>
+        std::vector<std::vector<OutputType>> ComputeBatch(const std::vector<std::vector<InputType>>& inputs);
+
+        /// <summary> Computes the map's output for each of a batch of inputs stored contiguously, one example after another.
+        /// The examples are computed one at a time; batching saves the per-call overhead of `Compute`, but doesn't turn
+        /// matrix-vector products into matrix-matrix products. </summary>
+        ///
+        /// <param name="inputs"> Pointer to `batchSize * GetInputSize()` input values </param>
+        /// <param name="batchSize"> The number of examples in the batch </param>
+        /// <param name="outputs"> Pointer to a buffer with room for `batchSize * GetOutputSize()` output values </param>
+        template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType> OutputConcept = true, utilities::IsFundamental<InputType> InputConcept = true>
+        void ComputeBatch(const InputType* inputs, size_t batchSize, OutputType* outputs);
+
         /// <summary> Reset the state of the model </summary>
         void Reset();
 
+        /// <summary> Sets the number of threads used to compute the map's outputs. With more than one thread,
+        /// nodes whose inputs are ready are computed concurrently on a work-stealing thread pool. The default is 1,
+        /// which computes the nodes one at a time on the calling thread. </summary>
+        ///
+        /// <param name="numThreads"> The number of threads, including the calling thread. If zero, the number of hardware threads is used. </param>
+        void SetNumComputeThreads(size_t numThreads);
+
+        /// <summary> Gets the number of threads used to compute the map's outputs. </summary>
+        ///
+        /// <returns> The number of threads, including the calling thread. </returns>
+        size_t GetNumComputeThreads() const { return _numComputeThreads; }
+
         /// <summary> Returns the number of inputs to the map </summary>
         ///
         /// <returns> The number of inputs to the map </returns>
@@ -213,6 +245,16 @@ namespace model
         /// <param name="context"> The TransformContext to use during the transformation </param>
         void Transform(Transformation& transformation, const TransformContext& context);
 
+        /// <summary> Changes the map so each call computes a batch of examples at once. Its inputs and outputs hold the
+        /// examples one after another, and nodes that support it (e.g., matrix-vector products) compute all of them
+        /// in one operation (e.g., a matrix-matrix product). </summary>
+        ///
+        /// <param name="batchSize"> The number of examples in a batch. </param>
+        /// <param name="context"> The TransformContext to use during the transformation </param>
+        /// <remarks> Throws a LogicException, and leaves the map unchanged, if one of its nodes can't compute a batch
+        /// of examples (e.g., because it has state that depends on earlier examples). </remarks>
+        void Batch(int batchSize, const TransformContext& context);
+
         /// <summary> Renames the model callbacks in this map. </summary>
         ///
         /// <param name="sourceCallbackName"> The new source callback name. </param>
@@ -459,12 +501,21 @@ namespace model
         virtual std::vector<float> ComputeFloatOutput(const PortElementsBase& outputs);
         virtual std::vector<double> ComputeDoubleOutput(const PortElementsBase& outputs);
 
+        // Computes a batch of examples for a map with a single input and output. The buffers have already been checked
+        // to hold the port types, and are laid out one example after another.
+        virtual void ComputeBatchOutput(const void* inputs, size_t batchSize, void* outputs);
+
     private:
         std::vector<const Node*> GetAllOutputNodes() const;
         std::vector<const Node*> GetDebugSinkNodes() const;
         std::vector<const Node*> GetMatchingNodesByType(const std::string name) const;
         void FixTransformedIO(ModelTransformer& transformer);
 
+        template <typename ValueType>
+        std::vector<ValueType> ComputeModelOutput(const PortElementsBase& outputs);
+        const ParallelModelExecutor& GetParallelExecutor(const std::vector<const OutputPortBase*>& outputs);
+        void ResetParallelExecutor();
+
         Model _model;
 
         std::vector<InputNodeBase*> _inputNodes;
@@ -477,6 +528,11 @@ namespace model
         utilities::PropertyBag _metadata;
 
         value::ComputeContext _computeContext{ "map_compute" };
+
+        size_t _numComputeThreads = 1;
+        std::unique_ptr<utilities::ThreadPool> _computeThreadPool;
+        std::unique_ptr<ParallelModelExecutor> _parallelExecutor;
+        size_t _parallelExecutorModelSize = 0;
     };
 
     /// <summary> A serialization context used during Map deserialization. Wraps an existing `ModelSerializationContext` </summary>
@@ -534,6 +590,56 @@ namespace model
         return ComputeOutput<OutputVectorType>(GetOutput(0));
     }
 
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    std::vector<std::vector<OutputType>> Map::ComputeBatch(const std::vector<std::vector<InputType>>& inputs)
+    {
+        if (NumInputs() != 1 || NumOutputs() != 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Map::ComputeBatch can only be called on maps with a single input and output");
+        }
+
+        // std::vector<bool> isn't contiguous, so pack the batch into plain arrays
+        const auto batchSize = inputs.size();
+        const auto inputSize = GetInputSize(0);
+        const auto outputSize = GetOutputSize(0);
+        std::unique_ptr<InputType[]> inputBuffer(new InputType[batchSize * inputSize]);
+        for (size_t index = 0; index < batchSize; ++index)
+        {
+            if (inputs[index].size() != inputSize)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Map::ComputeBatch input has the wrong size");
+            }
+            std::copy(inputs[index].begin(), inputs[index].end(), inputBuffer.get() + index * inputSize);
+        }
+
+        std::unique_ptr<OutputType[]> outputBuffer(new OutputType[batchSize * outputSize]);
+        ComputeBatch(inputBuffer.get(), batchSize, outputBuffer.get());
+
+        std::vector<std::vector<OutputType>> result;
+        result.reserve(batchSize);
+        for (size_t index = 0; index < batchSize; ++index)
+        {
+            auto begin = outputBuffer.get() + index * outputSize;
+            result.emplace_back(begin, begin + outputSize);
+        }
+        return result;
+    }
+
+    template <typename OutputType, typename InputType, utilities::IsFundamental<OutputType>, utilities::IsFundamental<InputType>>
+    void Map::ComputeBatch(const InputType* inputs, size_t batchSize, OutputType* outputs)
+    {
+        if (NumInputs() != 1 || NumOutputs() != 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Map::ComputeBatch can only be called on maps with a single input and output");
+        }
+        if (GetInputType(0) != Port::GetPortType<InputType>() || GetOutputType(0) != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        ComputeBatchOutput(inputs, batchSize, outputs);
+    }
+
     //
     // SetInput
     //
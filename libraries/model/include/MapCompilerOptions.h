@@ -36,6 +36,10 @@ namespace model
         std::string sinkFunctionName;
         bool verifyJittedModule = true;
         bool profile = false;
+        bool reusePortBuffers = false; // pack intermediate port buffers with non-overlapping lifetimes into a shared arena
+        bool emitBatchFunction = false; // emit a "<predict>_batch" function that computes several contiguous examples per call
+        int batchSize = 1; // if greater than 1, the batch function computes this many examples at once where it can (e.g., one matrix-matrix product instead of several matrix-vector products)
+        std::string objectCacheDirectory; // if set, cache jitted object code here and reuse it when the same IR is compiled again
 
         // per-node options
         bool inlineNodes = false;
@@ -24,7 +24,16 @@ namespace model
         diagonal,
         simple,
         winograd,
-        unrolled
+        unrolled,
+        tiled,
+        autotune // time each method on the host and pick the fastest
+    };
+
+    enum class WeightStorageType : int
+    {
+        float32 = 0,
+        float16, // IEEE half precision
+        bfloat16 // the upper 16 bits of a float32
     };
 
     // Interchange format:
@@ -109,6 +118,7 @@ namespace model
     void AppendMetadataToOptions(const utilities::PropertyBag& properties, ModelOptimizerOptions& options);
 
     std::string ToString(const PreferredConvolutionMethod& m);
+    std::string ToString(const WeightStorageType& t);
 
 } // namespace model
 
@@ -116,6 +126,9 @@ namespace utilities
 {
     template <>
     model::PreferredConvolutionMethod FromString<model::PreferredConvolutionMethod>(const std::string& s);
+
+    template <>
+    model::WeightStorageType FromString<model::WeightStorageType>(const std::string& s);
 }
 
 } // namespace ell
@@ -186,6 +186,17 @@ namespace model
                                    const TransformContext& context,
                                    const NodeTransformFunction& transformFunction);
 
+        /// <summary> Returns a copy of the input model that computes a batch of examples at once, by calling Batch() on
+        /// each of the model's nodes. The model's inputs and outputs hold the examples one after another. </summary>
+        ///
+        /// <param name="model"> The model. </param>
+        /// <param name="context"> The context. </param>
+        /// <param name="batchSize"> The number of examples in a batch. </param>
+        ///
+        /// <returns> The batched model. </returns>
+        /// <remarks> Throws a LogicException if one of the nodes that depend on the inputs can't compute a batch. </remarks>
+        Model BatchModel(const Model& model, const TransformContext& context, int batchSize);
+
         /// <summary> Returns the port from the new model corresponding to the given input port on the input model </summary>
         /// <remarks> Only available after calling CopyModel or TransformModel </remarks>
         template <typename ValueType>
@@ -284,6 +295,22 @@ namespace model
         /// <returns> Returns `true` if the node refined itself into something different. </returns>
         bool RefineNode(const Node& node);
 
+        /// <summary> Makes a version of the target node in the new model that computes a batch of examples </summary>
+        ///
+        /// <param name="node"> The target node to batch in the new model </param>
+        ///
+        /// <returns> Returns `false` if the node can't compute a batch of examples. </returns>
+        bool BatchNode(const Node& node);
+
+        /// <summary> Gets the number of examples the model being built by `BatchModel` computes at once. Called by node implementors </summary>
+        int GetBatchSize() const { return _batchSize; }
+
+        /// <summary> Indicates if the port in the new model corresponding to an input holds a batch of examples, rather
+        /// than values shared by all of them (e.g., constants). Called by node implementors </summary>
+        ///
+        /// <param name="input"> The input port in the old model. </param>
+        bool IsBatched(const InputPortBase& input) const;
+
         /// <summary> Sets up an old-to-new model output mapping. Called by node implementors </summary>
         ///
         /// <param name="oldPort"> The port in the old model to map to the new model. </param>
@@ -328,10 +355,16 @@ namespace model
             bool IsOutputMapped(const OutputPortBase& queryPort) const;
             const OutputPortBase& GetCorrespondingPort(const OutputPortBase& port, bool isInPlace) const;
             void MapNodeOutput(const OutputPortBase* oldPort, const OutputPortBase* newPort);
+            void SetBatchSize(int batchSize) { _batchSize = batchSize; }
             static PortOutputsMap ConcatenateMaps(const PortOutputsMap& oldMap, const PortOutputsMap& newMap, bool isInPlace);
 
         private:
+            bool AreSizesCompatible(size_t oldSize, size_t newSize) const;
+
             std::unordered_map<const OutputPortBase*, const OutputPortBase*> _outputPortMap;
+
+            // When batching, ports that hold a batch of examples are `_batchSize` times the size of the original ones
+            int _batchSize = 1;
         };
 
         bool ShouldCopyNode(const Node& node) const;
@@ -339,6 +372,7 @@ namespace model
         bool HasNontrivialInputMapping(const InputPortBase& input) const;
         bool IsOutputMapped(const OutputPortBase& output) const;
         bool IsInputNode(const Node& node) const;
+        bool IsOutputNode(const Node& node) const;
         static bool ArePortsCompatible(const InputPortBase* source, const OutputPortBase* dest);
         void MapCorrespondingInputs(const std::vector<const InputPortBase*>& sources, const std::vector<const OutputPortBase*>& destinations);
         bool IsModelCompilable(const Model& model) const;
@@ -362,6 +396,7 @@ namespace model
         TransformContext _context;
         PortOutputsMap _elementsMap;
         bool _isInPlace = false;
+        int _batchSize = 1;
     };
 } // namespace model
 } // namespace ell
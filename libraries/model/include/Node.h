@@ -173,6 +173,10 @@ namespace model
         /// <summary> Resets any state on the node, if any </summary>
         virtual void Reset() {}
 
+        /// <summary> Indicates if the node's output depends on anything besides its current input values (e.g., earlier
+        /// inputs, or a callback), so computing it once isn't enough to know its output. </summary>
+        virtual bool HasRuntimeState() const { return false; }
+
         /// <summary> Get this object's metadata object. </summary>
         ///
         /// <returns> A reference to the PropertyBag containing the metadata for this object. </returns>
@@ -210,6 +214,7 @@ namespace model
 
         virtual void Copy(ModelTransformer& transformer) const = 0;
         virtual bool Refine(ModelTransformer& transformer) const;
+        virtual bool Batch(ModelTransformer& transformer) const;
 
         void SetId(Node::NodeId id);
         void SetModel(Model* model);
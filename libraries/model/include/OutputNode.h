@@ -71,6 +71,7 @@ namespace model
 
     private:
         void Copy(ModelTransformer& transformer) const override;
+        bool Batch(ModelTransformer& transformer) const override;
     };
 
     /// <summary> Convenience function for adding an OutputNode to a model. </summary>
@@ -128,7 +129,7 @@ namespace model
     template <typename ValueType>
     void OutputNode<ValueType>::Compute() const
     {
-        _output.SetOutput(_input.GetValue());
+        _output.SetOutput(_input.GetValueReference());
     }
 
     template <typename ValueType>
@@ -139,6 +140,23 @@ namespace model
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool OutputNode<ValueType>::Batch(ModelTransformer& transformer) const
+    {
+        // Each example's output has to come from its own input
+        if (!transformer.IsBatched(_input))
+        {
+            return false;
+        }
+
+        const auto& newInputs = transformer.GetCorrespondingInputs(_input);
+        auto shape = GetShape().ToVector();
+        shape.insert(shape.begin(), transformer.GetBatchSize());
+        auto newNode = transformer.AddNode<OutputNode<ValueType>>(newInputs, MemoryShape{ shape });
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void OutputNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
     {
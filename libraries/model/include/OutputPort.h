@@ -128,6 +128,15 @@ namespace model
         template <typename IteratorType>
         void SetOutput(IteratorType begin, IteratorType end) const;
 
+        /// <summary> Gets the cached output from this port for writing, resized to hold the given number of values.
+        /// Lets a node compute its output in place, reusing the storage from the previous call instead of allocating. </summary>
+        ///
+        /// <param name="size"> The number of values the output will hold </param>
+        /// <typeparam name="ValueType"> The fundamental type of the values </typeparam>
+        /// <returns> The cached output from this port </returns>
+        template <typename ValueType>
+        std::vector<ValueType>& GetOutputBuffer(size_t size) const;
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -196,6 +205,12 @@ namespace model
         /// <returns> The cached output for the element </returns>
         ValueType GetOutput(size_t index) const;
 
+        /// <summary> Gets the cached output from this port for writing, resized to hold the given number of values </summary>
+        ///
+        /// <param name="size"> The number of values the output will hold </param>
+        /// <returns> The cached output from this port </returns>
+        std::vector<ValueType>& GetOutputBuffer(size_t size) const { return OutputPortBase::GetOutputBuffer<ValueType>(size); }
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -254,6 +269,14 @@ namespace model
         std::get<VectorType>(_cachedOutput).assign(begin, end);
     }
 
+    template <typename ValueType>
+    std::vector<ValueType>& OutputPortBase::GetOutputBuffer(size_t size) const
+    {
+        auto& output = std::get<std::vector<ValueType>>(_cachedOutput);
+        output.resize(size);
+        return output;
+    }
+
     //
     // OutputPort
     //
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelMapCompiler.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "IRCompiledMap.h"
+#include "IRMapCompiler.h"
+#include "Map.h"
+#include "MapCompilerOptions.h"
+#include "ModelOptimizerOptions.h"
+#include "Port.h"
+
+#include <utilities/include/Exception.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary> A map compiled into its own LLVM module. The compiler owns the module, so it must outlive the compiled map. </summary>
+    struct CompiledMapSegment
+    {
+        std::unique_ptr<IRMapCompiler> compiler;
+        std::unique_ptr<IRCompiledMap> compiledMap;
+    };
+
+    /// <summary> Compiles several maps, each with its own `IRMapCompiler` and LLVM module. The maps are emitted one at
+    /// a time, but optimizing and jitting them -- usually most of the compile time -- runs concurrently. </summary>
+    ///
+    /// <param name="maps"> The maps to compile. </param>
+    /// <param name="settings"> The options used to compile each map. The map's index is appended to the module name. </param>
+    /// <param name="optimizerOptions"> The optimizer options used to compile each map. </param>
+    /// <param name="numThreads"> The maximum number of maps to compile at once. If zero, the number of hardware threads is used. </param>
+    ///
+    /// <returns> The compiled maps, in the same order as `maps`. </returns>
+    std::vector<CompiledMapSegment> CompileMapsInParallel(const std::vector<Map>& maps, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t numThreads = 0);
+
+    /// <summary> A map split into segments (see `SplitMapIntoStages`) that are compiled into separate modules on
+    /// separate threads, so compiling a large model can use all the cores. Computing runs the segments one after
+    /// another on the calling thread; the only cost compared to compiling the map as a whole is that the optimizer
+    /// can't inline across segment boundaries. </summary>
+    class SegmentedCompiledMap
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="map"> The map to compile. See `SplitMapIntoStages` for the restrictions on it. </param>
+        /// <param name="numSegments"> The number of segments to split the map into. </param>
+        /// <param name="settings"> The options used to compile each segment. </param>
+        /// <param name="optimizerOptions"> The optimizer options used to compile each segment. </param>
+        /// <param name="numThreads"> The maximum number of segments to compile at once. If zero, the number of hardware threads is used. </param>
+        SegmentedCompiledMap(const Map& map, int numSegments, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t numThreads = 0);
+
+        /// <summary> Gets the number of segments. </summary>
+        ///
+        /// <returns> The number of segments. </returns>
+        size_t NumSegments() const { return _segments.size(); }
+
+        /// <summary> Gets the compiled map for one of the segments. </summary>
+        ///
+        /// <param name="index"> The index of the segment. </param>
+        ///
+        /// <returns> The segment's compiled map. </returns>
+        IRCompiledMap& GetSegment(size_t index) { return *_segments[index].compiledMap; }
+
+        /// <summary> Computes the map's output from input values </summary>
+        ///
+        /// <param name="input"> The input to the map </param>
+        /// <returns> A vector of output values </returns>
+        template <typename OutputType, typename InputType>
+        std::vector<OutputType> Compute(const std::vector<InputType>& input);
+
+        /// <summary> Resets the state of every segment. </summary>
+        void Reset();
+
+    private:
+        void ComputeSegments();
+
+        std::vector<CompiledMapSegment> _segments;
+
+        // _buffers[k] holds the input of segment k; the last buffer holds the map's output
+        std::vector<std::vector<char>> _buffers;
+        Port::PortType _inputType;
+        Port::PortType _outputType;
+        size_t _inputSize;
+        size_t _outputSize;
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename OutputType, typename InputType>
+    std::vector<OutputType> SegmentedCompiledMap::Compute(const std::vector<InputType>& input)
+    {
+        if (Port::GetPortType<InputType>() != _inputType || Port::GetPortType<OutputType>() != _outputType)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "SegmentedCompiledMap::Compute called with the wrong input or output type");
+        }
+        if (input.size() != _inputSize)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "SegmentedCompiledMap::Compute input has the wrong size");
+        }
+
+        auto inputValues = reinterpret_cast<InputType*>(_buffers.front().data());
+        for (size_t index = 0; index < _inputSize; ++index)
+        {
+            inputValues[index] = input[index];
+        }
+
+        ComputeSegments();
+
+        auto outputValues = reinterpret_cast<const OutputType*>(_buffers.back().data());
+        return { outputValues, outputValues + _outputSize };
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelModelExecutor.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class Model;
+    class Node;
+    class OutputPortBase;
+
+    /// <summary> Computes the part of a model needed to produce a set of outputs, running nodes whose inputs are
+    /// ready concurrently on a thread pool. The dependency graph is built once, at construction, so the executor
+    /// must be rebuilt if the model changes. </summary>
+    class ParallelModelExecutor
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="model"> The model to compute. </param>
+        /// <param name="outputs"> The outputs to compute. Only the nodes they depend on are run. </param>
+        ParallelModelExecutor(const Model& model, const std::vector<const OutputPortBase*>& outputs);
+
+        /// <summary> Computes the outputs, calling `Compute()` on each node after all of its parents have finished.
+        /// If a node throws, its dependents are skipped and the first exception is rethrown once the pool is idle. </summary>
+        ///
+        /// <param name="threadPool"> The thread pool to run the nodes on. </param>
+        void Compute(utilities::ThreadPool& threadPool) const;
+
+        /// <summary> Gets the number of nodes the executor runs. </summary>
+        ///
+        /// <returns> The number of nodes. </returns>
+        size_t NumNodes() const { return _nodes.size(); }
+
+        /// <summary> Gets the outputs this executor was built for. </summary>
+        ///
+        /// <returns> The outputs. </returns>
+        const std::vector<const OutputPortBase*>& GetOutputs() const { return _outputs; }
+
+    private:
+        struct ScheduledNode
+        {
+            const Node* node;
+            std::vector<size_t> dependents;
+            int numParents;
+
+            // Nodes that compute through the shared value context, or that call user callbacks, are run one at a time
+            bool requiresExclusiveAccess;
+        };
+
+        struct ExecutionState;
+        void RunNode(ExecutionState& state, size_t index) const;
+
+        std::vector<const OutputPortBase*> _outputs;
+        std::vector<ScheduledNode> _nodes;
+        std::vector<size_t> _roots;
+    };
+} // namespace model
+} // namespace ell
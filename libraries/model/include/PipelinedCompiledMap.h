@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PipelinedCompiledMap.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "IRCompiledMap.h"
+#include "IRMapCompiler.h"
+#include "Map.h"
+#include "MapCompilerOptions.h"
+#include "ModelOptimizerOptions.h"
+#include "ParallelMapCompiler.h"
+#include "Port.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/LockFreeQueue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary> Splits a map with a single input and output into a chain of maps, each one computing a contiguous
+    /// range of the original map's nodes (in dependency order). The map can only be cut where exactly one port
+    /// carries values from the nodes before the cut to the nodes after it, and the cuts are chosen to balance the
+    /// number of nodes in each stage. Feeding the output of each stage into the next one computes the original map. </summary>
+    ///
+    /// <param name="map"> The map to split. Must have a single input and a single output, and no source or sink nodes. </param>
+    /// <param name="numStages"> The number of stages to split the map into. </param>
+    ///
+    /// <returns> The stage maps, in order. </returns>
+    std::vector<Map> SplitMapIntoStages(const Map& map, int numStages);
+
+    /// <summary> A map that is split into stages, each of which is compiled separately (see `CompileMapsInParallel`) and run on its own thread.
+    /// Consecutive stages are connected by fixed-capacity single-producer / single-consumer queues, so while stage
+    /// `k` computes frame `t`, stage `k+1` can compute frame `t-1`. This raises the number of frames per second a
+    /// streaming model can process, at the cost of `NumStages() - 1` extra frames of latency. Frames go in with `Push`
+    /// and come out, in the same order, with `Pop`; both must be called from the same thread. </summary>
+    class PipelinedCompiledMap
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="map"> The map to compile. See `SplitMapIntoStages` for the restrictions on it. </param>
+        /// <param name="numStages"> The number of pipeline stages (and threads) to use. </param>
+        /// <param name="settings"> The options used to compile each stage. </param>
+        /// <param name="optimizerOptions"> The optimizer options used to compile each stage. </param>
+        /// <param name="queueCapacity"> The number of frames each queue between stages can hold. </param>
+        PipelinedCompiledMap(const Map& map, int numStages, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t queueCapacity = 4);
+
+        PipelinedCompiledMap(const PipelinedCompiledMap&) = delete;
+        PipelinedCompiledMap& operator=(const PipelinedCompiledMap&) = delete;
+
+        /// <summary> Destructor. Stops the stage threads; frames still in the pipeline are discarded. </summary>
+        ~PipelinedCompiledMap();
+
+        /// <summary> Gets the number of pipeline stages. </summary>
+        ///
+        /// <returns> The number of stages. </returns>
+        size_t NumStages() const { return _stages.size(); }
+
+        /// <summary> Gets the compiled map for one of the stages. </summary>
+        ///
+        /// <param name="stage"> The index of the stage. </param>
+        ///
+        /// <returns> The stage's compiled map. </returns>
+        const IRCompiledMap& GetStage(size_t stage) const { return *_stages[stage].compiledMap; }
+
+        /// <summary> Gets the number of frames that have been pushed but not yet popped. </summary>
+        ///
+        /// <returns> The number of frames in the pipeline. </returns>
+        size_t NumFramesInFlight() const { return _numFramesInFlight; }
+
+        /// <summary> Adds a frame to the pipeline, if there is room for it. </summary>
+        ///
+        /// <param name="input"> The input frame. </param>
+        ///
+        /// <returns> `true` if the frame was added, `false` if the first stage's queue is full. </returns>
+        template <typename InputType>
+        bool TryPush(const std::vector<InputType>& input);
+
+        /// <summary> Adds a frame to the pipeline, waiting for room if the first stage's queue is full. </summary>
+        ///
+        /// <param name="input"> The input frame. </param>
+        template <typename InputType>
+        void Push(const std::vector<InputType>& input);
+
+        /// <summary> Gets the output for the oldest frame in the pipeline, if it is ready. </summary>
+        ///
+        /// <param name="output"> Receives the output. </param>
+        ///
+        /// <returns> `true` if an output was ready. </returns>
+        template <typename OutputType>
+        bool TryPop(std::vector<OutputType>& output);
+
+        /// <summary> Gets the output for the oldest frame in the pipeline, waiting for it if necessary. </summary>
+        ///
+        /// <returns> The output. </returns>
+        template <typename OutputType>
+        std::vector<OutputType> Pop();
+
+        /// <summary> Runs a sequence of frames through the pipeline, keeping as many of them in flight as possible.
+        /// Can only be called when no frames are in flight. </summary>
+        ///
+        /// <param name="inputs"> The input frames. </param>
+        ///
+        /// <returns> The output for each input frame. </returns>
+        template <typename InputType, typename OutputType>
+        std::vector<std::vector<OutputType>> ComputeStream(const std::vector<std::vector<InputType>>& inputs);
+
+        /// <summary> Resets the state of every stage. Can only be called when no frames are in flight. </summary>
+        void Reset();
+
+    private:
+        using Frame = std::vector<char>;
+
+        void RunStage(size_t stage);
+        void ThrowIfFailed();
+
+        // Any thread that moves a frame into or out of a queue bumps the progress count. A thread that can't
+        // move a frame reads the count before trying, then waits for it to change: it spins briefly, since stages
+        // usually finish quickly, and then blocks on a condition variable so idle stages don't burn a core.
+        uint64_t GetProgress() const { return _progress.load(); }
+        void NotifyProgress();
+        void WaitForProgress(uint64_t progress);
+
+        std::vector<CompiledMapSegment> _stages;
+
+        // _queues[k] holds the inputs of stage k; the last queue holds the pipeline's outputs
+        std::vector<std::unique_ptr<utilities::LockFreeQueue<Frame>>> _queues;
+        std::vector<std::thread> _threads;
+
+        Port::PortType _inputType;
+        Port::PortType _outputType;
+        size_t _inputSize;
+        size_t _outputSize;
+        size_t _numFramesInFlight = 0;
+
+        std::atomic<bool> _stopping{ false };
+        std::atomic<bool> _failed{ false };
+        std::mutex _errorMutex;
+        std::exception_ptr _error;
+
+        std::atomic<uint64_t> _progress{ 0 };
+        std::atomic<int> _numWaiters{ 0 };
+        std::mutex _progressMutex;
+        std::condition_variable _progressChanged;
+
+        static const int _numSpinsBeforeBlocking = 64;
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename InputType>
+    bool PipelinedCompiledMap::TryPush(const std::vector<InputType>& input)
+    {
+        if (Port::GetPortType<InputType>() != _inputType)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "PipelinedCompiledMap::Push called with the wrong input type");
+        }
+        if (input.size() != _inputSize)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "PipelinedCompiledMap::Push input has the wrong size");
+        }
+        ThrowIfFailed();
+
+        auto& queue = *_queues.front();
+        auto slot = queue.TryBeginWrite();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        auto values = reinterpret_cast<InputType*>(slot->data());
+        for (size_t index = 0; index < _inputSize; ++index)
+        {
+            values[index] = input[index];
+        }
+        queue.EndWrite();
+        NotifyProgress();
+        ++_numFramesInFlight;
+        return true;
+    }
+
+    template <typename InputType>
+    void PipelinedCompiledMap::Push(const std::vector<InputType>& input)
+    {
+        auto progress = GetProgress();
+        while (!TryPush(input))
+        {
+            WaitForProgress(progress);
+            progress = GetProgress();
+        }
+    }
+
+    template <typename OutputType>
+    bool PipelinedCompiledMap::TryPop(std::vector<OutputType>& output)
+    {
+        if (Port::GetPortType<OutputType>() != _outputType)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "PipelinedCompiledMap::Pop called with the wrong output type");
+        }
+        ThrowIfFailed();
+
+        auto& queue = *_queues.back();
+        auto slot = queue.TryBeginRead();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+
+        auto values = reinterpret_cast<const OutputType*>(slot->data());
+        output.assign(values, values + _outputSize);
+        queue.EndRead();
+        NotifyProgress();
+        --_numFramesInFlight;
+        return true;
+    }
+
+    template <typename OutputType>
+    std::vector<OutputType> PipelinedCompiledMap::Pop()
+    {
+        if (_numFramesInFlight == 0)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "PipelinedCompiledMap::Pop called with no frames in flight");
+        }
+
+        std::vector<OutputType> output;
+        auto progress = GetProgress();
+        while (!TryPop(output))
+        {
+            WaitForProgress(progress);
+            progress = GetProgress();
+        }
+        return output;
+    }
+
+    template <typename InputType, typename OutputType>
+    std::vector<std::vector<OutputType>> PipelinedCompiledMap::ComputeStream(const std::vector<std::vector<InputType>>& inputs)
+    {
+        if (_numFramesInFlight != 0)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "PipelinedCompiledMap::ComputeStream called with frames already in flight");
+        }
+
+        std::vector<std::vector<OutputType>> outputs;
+        outputs.reserve(inputs.size());
+        auto nextInput = inputs.begin();
+        std::vector<OutputType> output;
+        while (outputs.size() < inputs.size())
+        {
+            auto progress = GetProgress();
+            while (nextInput != inputs.end() && TryPush(*nextInput))
+            {
+                ++nextInput;
+            }
+
+            if (TryPop(output))
+            {
+                outputs.push_back(output);
+            }
+            else
+            {
+                WaitForProgress(progress);
+            }
+        }
+        return outputs;
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
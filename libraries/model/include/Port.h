@@ -13,6 +13,7 @@
 #include <utilities/include/IArchivable.h>
 #include <utilities/include/PropertyBag.h>
 
+#include <cstddef>
 #include <string>
 
 namespace ell
@@ -129,6 +130,12 @@ namespace model
     /// <returns> A string representation of the C type to use </returns>
     std::string GetPortCTypeName(ell::model::Port::PortType type);
 
+    /// <summary> Returns the size in bytes of one element of the given `PortType`, as laid out in a plain array </summary>
+    ///
+    /// <param name="type"> The type of the port </param>
+    /// <returns> The size of an element, in bytes </returns>
+    size_t GetPortElementSize(ell::model::Port::PortType type);
+
     template <Port::PortType portType>
     struct PortTypeToValueType
     {
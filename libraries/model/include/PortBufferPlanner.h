@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortBufferPlanner.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary> The size of a buffer and the interval during which it holds live data. The interval is given
+    /// as the positions (in compilation order) of the first node that writes the buffer and the last node that reads it. </summary>
+    struct BufferLifetime
+    {
+        size_t size;
+        int firstUse;
+        int lastUse;
+    };
+
+    /// <summary> An assignment of buffers to offsets in a single shared arena. </summary>
+    struct BufferPlan
+    {
+        /// <summary> The offset of each buffer in the arena, in the same order as the lifetimes passed to `PlanBufferReuse`. </summary>
+        std::vector<size_t> offsets;
+
+        /// <summary> The size of the arena needed to hold all the buffers. </summary>
+        size_t arenaSize = 0;
+
+        /// <summary> The total size of the buffers if each one had its own storage (including alignment padding). </summary>
+        size_t totalSize = 0;
+    };
+
+    /// <summary> Assigns each buffer an offset in a shared arena, such that buffers whose lifetimes overlap never share memory.
+    /// Buffers are placed largest-first, each at the lowest aligned offset that doesn't collide with an already-placed
+    /// buffer that is live at the same time. </summary>
+    ///
+    /// <param name="buffers"> The size and lifetime of each buffer. </param>
+    /// <param name="alignment"> The alignment of each buffer in the arena, in the same units as the buffer sizes. </param>
+    ///
+    /// <returns> The arena offsets and sizes. </returns>
+    BufferPlan PlanBufferReuse(const std::vector<BufferLifetime>& buffers, size_t alignment);
+} // namespace model
+} // namespace ell
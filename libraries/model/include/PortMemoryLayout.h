@@ -41,5 +41,12 @@ namespace model
     /// <param name="layout"> The layout of the memory </param>
     /// <returns> A value representing `true` if the location is out of bounds </returns>
     emitters::IRLocalScalar EmitIsOutOfBounds(emitters::IRFunctionEmitter& function, const std::vector<emitters::IRLocalScalar>& physicalCoordinates, const PortMemoryLayout& layout);
+
+    /// <summary> Gets the layout of a batch of entries with the given layout, stored one after another </summary>
+    ///
+    /// <param name="layout"> The layout of each entry </param>
+    /// <param name="batchSize"> The number of entries in the batch </param>
+    /// <returns> A layout with an extra outermost dimension of size `batchSize` </returns>
+    PortMemoryLayout GetBatchedMemoryLayout(const PortMemoryLayout& layout, int batchSize);
 } // namespace model
 } // namespace ell
\ No newline at end of file
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PreparedMap.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "InputNode.h"
+#include "Map.h"
+#include "Node.h"
+#include "OutputPort.h"
+#include "Port.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/TypeName.h>
+
+#include <value/include/ComputeContext.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary> A map whose execution plan has been computed ahead of time, for repeatedly evaluating a map
+    /// with the reference interpreter. The node order and the input and output port bindings are captured once,
+    /// at construction, so `Compute` just replays the nodes without walking the graph or allocating. The `Map` must
+    /// outlive the `PreparedMap`, and the prepared map must be recreated if the map's model is modified. </summary>
+    class PreparedMap
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="map"> The map to prepare. </param>
+        PreparedMap(Map& map);
+
+        /// <summary> Gets the number of inputs. </summary>
+        ///
+        /// <returns> The number of inputs. </returns>
+        size_t NumInputs() const { return _inputs.size(); }
+
+        /// <summary> Gets the number of outputs. </summary>
+        ///
+        /// <returns> The number of outputs. </returns>
+        size_t NumOutputs() const { return _outputs.size(); }
+
+        /// <summary> Gets the number of nodes run by each call to `Compute`. </summary>
+        ///
+        /// <returns> The number of nodes. </returns>
+        size_t NumNodes() const { return _nodes.size(); }
+
+        /// <summary> Gets the size of an input. </summary>
+        ///
+        /// <param name="index"> The index of the input. </param>
+        /// <returns> The number of elements in the input. </returns>
+        size_t GetInputSize(size_t index = 0) const { return _inputSizes.at(index); }
+
+        /// <summary> Gets the size of an output. </summary>
+        ///
+        /// <param name="index"> The index of the output. </param>
+        /// <returns> The number of elements in the output. </returns>
+        size_t GetOutputSize(size_t index = 0) const { return _outputSizes.at(index); }
+
+        /// <summary> Sets the value of an input. </summary>
+        ///
+        /// <param name="index"> The index of the input. </param>
+        /// <param name="values"> Pointer to the input values. Must point to `GetInputSize(index)` values. </param>
+        template <typename ValueType>
+        void SetInput(size_t index, const ValueType* values);
+
+        /// <summary> Computes the map's outputs from the current inputs. </summary>
+        void Compute() const;
+
+        /// <summary> Copies the value of an output into a buffer. </summary>
+        ///
+        /// <param name="index"> The index of the output. </param>
+        /// <param name="values"> Pointer to the buffer to fill. Must have room for `GetOutputSize(index)` values. </param>
+        template <typename ValueType>
+        void GetOutput(size_t index, ValueType* values) const;
+
+        /// <summary> Sets the first input, computes the outputs, and copies the first output into a buffer. </summary>
+        ///
+        /// <param name="input"> Pointer to the input values. </param>
+        /// <param name="output"> Pointer to the buffer to fill with the output values. </param>
+        template <typename InputType, typename OutputType>
+        void Compute(const InputType* input, OutputType* output);
+
+        /// <summary> Resets the state of the nodes. </summary>
+        void Reset();
+
+    private:
+        std::vector<const Node*> _nodes;
+        std::vector<InputNodeBase*> _inputs;
+        std::vector<size_t> _inputSizes;
+        std::vector<const OutputPortBase*> _outputs;
+        std::vector<size_t> _outputSizes;
+
+        mutable value::ComputeContext _computeContext{ "prepared_map_compute" };
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    void PreparedMap::SetInput(size_t index, const ValueType* values)
+    {
+        auto node = dynamic_cast<InputNode<ValueType>*>(_inputs.at(index));
+        if (node == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "missing InputNode<" + utilities::TypeName<ValueType>::GetName() + ">");
+        }
+        node->SetInput(values);
+    }
+
+    template <typename ValueType>
+    void PreparedMap::GetOutput(size_t index, ValueType* values) const
+    {
+        const auto port = _outputs.at(index);
+        if (port->GetType() != Port::GetPortType<ValueType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        const auto& output = port->GetOutput<ValueType>();
+        std::copy(output.begin(), output.end(), values);
+    }
+
+    template <typename InputType, typename OutputType>
+    void PreparedMap::Compute(const InputType* input, OutputType* output)
+    {
+        SetInput(0, input);
+        Compute();
+        GetOutput(0, output);
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
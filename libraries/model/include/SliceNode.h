@@ -121,9 +121,8 @@ namespace model
     template <typename ValueType>
     void SliceNode<ValueType>::Compute() const
     {
-        auto input = _input.GetValue();
-        auto output = std::vector<ValueType>(input.begin() + _largestDimensionStart, input.begin() + _largestDimensionStart + _largestDimensionCount);
-        _output.SetOutput(output);
+        const auto& input = _input.GetValueReference();
+        _output.SetOutput(input.begin() + _largestDimensionStart, input.begin() + _largestDimensionStart + _largestDimensionCount);
     }
 
     template <typename ValueType>
@@ -145,14 +145,19 @@ namespace model
     template <typename ValueType>
     void SpliceNode<ValueType>::Compute() const
     {
-        std::vector<ValueType> output;
-        output.reserve(_output.Size());
+        size_t outputSize = 0;
         for (const auto& input : _inputPorts)
         {
-            auto value = input->GetValue();
-            std::copy(value.begin(), value.end(), std::back_inserter(output));
+            outputSize += input->GetValueReference().size();
+        }
+
+        auto& output = _output.GetOutputBuffer(outputSize);
+        auto outputIter = output.begin();
+        for (const auto& input : _inputPorts)
+        {
+            const auto& value = input->GetValueReference();
+            outputIter = std::copy(value.begin(), value.end(), outputIter);
         }
-        _output.SetOutput(output);
     }
 
     template <typename ValueType>
@@ -46,17 +46,23 @@ namespace model
         _module(other._module),
         _moduleName(std::move(other._moduleName)),
         _executionEngine(std::move(other._executionEngine)),
+        _objectCache(std::move(other._objectCache)),
         _verifyJittedModule(other._verifyJittedModule),
         _context(other._context),
+        _state(other._state),
+        _setStateFunction(std::move(other._setStateFunction)),
+        _freeStateFunction(std::move(other._freeStateFunction)),
         _computeFunctionDefined(false)
     {
+        other._state = nullptr;
     }
 
     // private constructor:
-    IRCompiledMap::IRCompiledMap(Map map, const std::string& functionName, const MapCompilerOptions& options, emitters::IRModuleEmitter& module, bool verifyJittedModule) :
+    IRCompiledMap::IRCompiledMap(Map map, const std::string& functionName, const MapCompilerOptions& options, emitters::IRModuleEmitter& module, bool verifyJittedModule, std::shared_ptr<emitters::IRObjectCache> objectCache) :
         CompiledMap(std::move(map), functionName, options),
         _module(module),
         _moduleName(_module.GetModuleName()),
+        _objectCache(std::move(objectCache)),
         _verifyJittedModule(verifyJittedModule),
         _computeFunctionDefined(false)
     {
@@ -68,12 +74,25 @@ namespace model
         _boolCallbacks = module.GetCallbackRegistry<bool>();
     }
 
+    IRCompiledMap::~IRCompiledMap()
+    {
+        if (_state != nullptr && _freeStateFunction)
+        {
+            _freeStateFunction(_state);
+        }
+    }
+
     IRCompiledMap IRCompiledMap::Clone()
     {
         EnsureExecutionEngine();
 
         Map newMap(*this);
-        IRCompiledMap result(std::move(newMap), GetFunctionName(), GetMapCompilerOptions(), _module, _verifyJittedModule);
+        IRCompiledMap result(std::move(newMap), GetFunctionName(), GetMapCompilerOptions(), _module, _verifyJittedModule, _objectCache);
+        if (GetMapCompilerOptions().compilerSettings.reentrant)
+        {
+            // A reentrant module keeps no state of its own, so the clone can run the same jitted code with a new state
+            result._executionEngine = _executionEngine;
+        }
         result.SetContext(GetContext());
         result.FinishJitting();
         return result;
@@ -95,7 +114,7 @@ namespace model
         if (!_executionEngine)
         {
             auto moduleClone = std::unique_ptr<llvm::Module>(llvm::CloneModule(*_module.GetLLVMModule()));
-            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _verifyJittedModule);
+            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _verifyJittedModule, llvm::CodeGenOpt::Level::Default, _objectCache);
         }
     }
 
@@ -104,6 +123,29 @@ namespace model
         EnsureExecutionEngine();
         ResolveCallbacks();
         SetComputeFunction();
+        EnsureState();
+    }
+
+    void IRCompiledMap::EnsureState()
+    {
+        if (!GetMapCompilerOptions().compilerSettings.reentrant)
+        {
+            return;
+        }
+
+        if (!_setStateFunction)
+        {
+            auto allocateStateFunction = reinterpret_cast<void* (*)()>(_executionEngine->ResolveFunctionAddress(_moduleName + "_AllocateState"));
+            _freeStateFunction = reinterpret_cast<void (*)(void*)>(_executionEngine->ResolveFunctionAddress(_moduleName + "_FreeState"));
+            _setStateFunction = reinterpret_cast<void (*)(void*)>(_executionEngine->ResolveFunctionAddress(_moduleName + "_SetState"));
+            if (_state == nullptr)
+            {
+                _state = allocateStateFunction();
+            }
+        }
+
+        // The state is bound per-thread, so bind it before every call into the compiled code
+        _setStateFunction(_state);
     }
 
     void IRCompiledMap::ComputeMultiple(const std::vector<void*>& inputs, const std::vector<void*>& outputs)
@@ -112,6 +154,26 @@ namespace model
         _computeDispatchFunction(InternalGetContext(), inputs.data(), outputs.data());
     }
 
+    void IRCompiledMap::ComputeBatchOutput(const void* inputs, size_t batchSize, void* outputs)
+    {
+        FinishJitting();
+        if (_computeBatchFunction)
+        {
+            _computeBatchFunction(InternalGetContext(), inputs, outputs, static_cast<int>(batchSize));
+            return;
+        }
+
+        const auto inputStride = GetInputSize(0) * GetPortElementSize(GetInputType(0));
+        const auto outputStride = GetOutputSize(0) * GetPortElementSize(GetOutputType(0));
+        auto input = static_cast<const char*>(inputs);
+        auto output = static_cast<char*>(outputs);
+        auto context = InternalGetContext();
+        for (size_t index = 0; index < batchSize; ++index)
+        {
+            _computePredictFunction(context, input + index * inputStride, output + index * outputStride);
+        }
+    }
+
     void IRCompiledMap::Reset()
     {
         FinishJitting();
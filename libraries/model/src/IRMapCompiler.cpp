@@ -17,19 +17,26 @@
 
 #include <emitters/include/EmitterException.h>
 #include <emitters/include/IRMetadata.h>
+#include <emitters/include/IRObjectCache.h>
 #include <emitters/include/LLVMUtilities.h>
 #include <emitters/include/Variable.h>
 
 #include <nodes/include/SinkNode.h>
 #include <nodes/include/SourceNode.h>
 
+#include <utilities/include/Exception.h>
 #include <utilities/include/Logger.h>
+#include <utilities/include/MillisecondTimer.h>
 #include <utilities/include/StringUtil.h>
 
 #include <value/include/LLVMContext.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace ell
@@ -39,6 +46,16 @@ namespace model
     using namespace logging;
     using namespace value;
 
+    namespace
+    {
+        // Refining and emitting a map goes through process-wide state (e.g., the value library's emitter context), so
+        // only one map is emitted at a time. Optimization and code generation only touch the compiler's own LLVM context,
+        // so they can overlap with other compiles. The mutex is recursive because some optimization passes (e.g.,
+        // autotuning) compile and time small maps of their own while the outer map is being refined; the value library's
+        // context guards restore the outer compiler's context when the nested compile is done.
+        std::recursive_mutex emitMutex;
+    } // namespace
+
     IRMapCompiler::IRMapCompiler() :
         IRMapCompiler(MapCompilerOptions{}, ModelOptimizerOptions{})
     {
@@ -73,6 +90,18 @@ namespace model
     {
         Log() << "Compile called for map" << EOL;
 
+        const auto& compilerSettings = GetMapCompilerOptions().compilerSettings;
+        if (compilerSettings.reentrant && (compilerSettings.parallelize || GetMapCompilerOptions().profile))
+        {
+            // Parallel tasks run on worker threads that don't see the caller's state, and the profiling API reads its counters outside of a compute call
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Reentrant compilation can't be combined with parallelization or profiling");
+        }
+
+        std::unique_lock<std::recursive_mutex> emitLock(emitMutex);
+        if (GetMapCompilerOptions().emitBatchFunction && GetMapCompilerOptions().batchSize > 1)
+        {
+            CompileBatchedMap(map);
+        }
         RefineAndOptimize(map);
 
         // Renaming callbacks based on map compiler parameters
@@ -98,10 +127,32 @@ namespace model
             CompileMap(map, GetPredictFunctionName());
         }
 
+        if (GetMapCompilerOptions().reusePortBuffers)
+        {
+            Log() << "Packing port buffers..." << EOL;
+            ReusePortBuffers(map.GetModel());
+        }
+
         // Emit runtime model APIs
         EmitModelAPIFunctions(map);
 
-        if (GetMapCompilerOptions().compilerSettings.optimize)
+        if (compilerSettings.reentrant)
+        {
+            Log() << "Moving model state into the reentrant state struct..." << EOL;
+            _moduleEmitter.EmitReentrantState();
+        }
+        emitLock.unlock();
+
+        // With an object cache, the key is computed from the unoptimized IR. On a hit, the JIT loads the cached
+        // object instead of generating code, so there's no need to optimize the module either.
+        std::shared_ptr<emitters::IRObjectCache> objectCache;
+        if (!GetMapCompilerOptions().objectCacheDirectory.empty())
+        {
+            objectCache = std::make_shared<emitters::IRObjectCache>(GetMapCompilerOptions().objectCacheDirectory, *_moduleEmitter.GetLLVMModule(), compilerSettings);
+            Log() << "Object cache " << (objectCache->IsHit() ? "hit" : "miss") << " for " << objectCache->GetKey() << EOL;
+        }
+
+        if (GetMapCompilerOptions().compilerSettings.optimize && !(objectCache && objectCache->IsHit()))
         {
             // Save callback declarations in case they get optimized away
             std::vector<std::tuple<std::string, llvm::FunctionType*, std::vector<std::string>>> savedCallbacks;
@@ -111,9 +162,14 @@ namespace model
                 savedCallbacks.emplace_back(callbackInfo.function->getName(), callbackInfo.function->getFunctionType(), callbackInfo.values);
             }
 
+            utilities::MillisecondTimer timer;
             emitters::IROptimizer optimizer(_moduleEmitter);
             optimizer.AddStandardPasses();
             _moduleEmitter.Optimize(optimizer);
+            if (objectCache)
+            {
+                objectCache->AddOptimizationTime(timer.Elapsed());
+            }
 
             // Reinsert callback declarations after optimization
             for (const auto& savedCallback : savedCallbacks)
@@ -123,7 +179,7 @@ namespace model
                 _moduleEmitter.IncludeInCallbackInterface(functionName, std::get<2>(savedCallback)[0]);
             }
         }
-        return IRCompiledMap(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), _moduleEmitter, GetMapCompilerOptions().verifyJittedModule);
+        return IRCompiledMap(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), _moduleEmitter, GetMapCompilerOptions().verifyJittedModule, objectCache);
     }
 
     void IRMapCompiler::RefineAndOptimize(Map& map)
@@ -139,6 +195,128 @@ namespace model
         map.Prune();
     }
 
+    void IRMapCompiler::CompileBatchedMap(Map map)
+    {
+        const auto& options = GetMapCompilerOptions();
+        if (map.NumInputs() != 1 || map.NumOutputs() != 1 || options.compilerSettings.reentrant || options.profile)
+        {
+            // The batched map keeps its state in its own module, and isn't profiled
+            Log() << "Not batching the map: it needs a single input and output, and can't be reentrant or profiled" << EOL;
+            return;
+        }
+
+        // Refine the map first, so it has the nodes that know how to compute a batch (e.g., matrix-vector products).
+        // The nested compiler optimizes it, after it's batched.
+        TransformContext context(this);
+        map.Refine(context);
+        try
+        {
+            map.Batch(options.batchSize, context);
+        }
+        catch (const utilities::LogicException& exception)
+        {
+            Log() << "Not batching the map: " << exception.GetMessage() << EOL;
+            return;
+        }
+
+        // Compile the batched map into its own module, and link that into this one as private code
+        auto batchedOptions = options;
+        batchedOptions.moduleName = GetModule().GetModuleName() + "_batched";
+        batchedOptions.mapFunctionName = batchedOptions.moduleName + "_predict";
+        batchedOptions.emitBatchFunction = false;
+        batchedOptions.batchSize = 1;
+        batchedOptions.objectCacheDirectory.clear();
+
+        Log() << "Compiling the map for batches of " << options.batchSize << " examples..." << EOL;
+        IRMapCompiler batchedCompiler(batchedOptions, GetModelOptimizerOptions());
+        batchedCompiler.Compile(map);
+        _moduleEmitter.LinkPrivateModule(batchedCompiler.GetModule());
+        _batchedPredictFunctionName = batchedOptions.mapFunctionName;
+    }
+
+    void IRMapCompiler::ReusePortBuffers(const Model& model)
+    {
+        std::vector<const Node*> nodes;
+        model.Visit([&nodes](const Node& node) { nodes.push_back(&node); });
+
+        // Find the order in which the nodes' code actually runs. A node whose code was merged into another node's
+        // region runs along with the rest of that region, not at its own place in the compilation order.
+        const int numNodes = static_cast<int>(nodes.size());
+        std::unordered_map<const emitters::IRBlockRegion*, int> regionPositions;
+        std::vector<std::pair<int, int>> sortKeys;
+        for (int index = 0; index < numNodes; ++index)
+        {
+            auto region = GetCurrentNodeBlocks().Get(*nodes[index]);
+            auto position = (region == nullptr) ? index : regionPositions.emplace(region, index).first->second;
+            sortKeys.emplace_back(position, index);
+        }
+        std::sort(sortKeys.begin(), sortKeys.end());
+        std::vector<int> executionPositions(numNodes);
+        for (int position = 0; position < numNodes; ++position)
+        {
+            executionPositions[sortKeys[position].second] = position;
+        }
+
+        // Compute the lifetime of each zero-initialized global port buffer. Buffers with an initial value hold state
+        // across calls, and the map's inputs and outputs are function arguments, so neither is eligible for reuse.
+        const auto& dataLayout = GetModule().GetLLVMModule()->getDataLayout();
+        std::vector<llvm::GlobalVariable*> globals;
+        std::vector<BufferLifetime> lifetimes;
+        std::unordered_map<const emitters::Variable*, size_t> bufferIndices;
+        auto addUse = [&](const emitters::Variable* pVar, int position) {
+            if (pVar == nullptr || !pVar->IsGlobal() || pVar->HasInitValue() || !pVar->HasEmittedName())
+            {
+                return;
+            }
+
+            auto iter = bufferIndices.find(pVar);
+            if (iter == bufferIndices.end())
+            {
+                auto global = GetModule().GetLLVMModule()->getNamedGlobal(pVar->EmittedName());
+                if (global == nullptr)
+                {
+                    return;
+                }
+                bufferIndices[pVar] = lifetimes.size();
+                globals.push_back(global);
+                lifetimes.push_back({ dataLayout.getTypeAllocSize(global->getValueType()), position, position });
+                return;
+            }
+
+            auto& lifetime = lifetimes[iter->second];
+            lifetime.firstUse = std::min(lifetime.firstUse, position);
+            lifetime.lastUse = std::max(lifetime.lastUse, position);
+        };
+
+        for (int index = 0; index < numNodes; ++index)
+        {
+            auto position = executionPositions[index];
+            for (auto outputPort : nodes[index]->GetOutputPorts())
+            {
+                addUse(GetVariableForPort(*outputPort), position);
+            }
+            for (auto inputPort : nodes[index]->GetInputPorts())
+            {
+                addUse(GetVariableForPort(inputPort->GetReferencedPort()), position);
+            }
+        }
+
+        _portBufferPlan = PlanBufferReuse(lifetimes, GetMapCompilerOptions().compilerSettings.globalValueAlignment);
+        Log() << "Port buffers: " << lifetimes.size() << " buffers, " << _portBufferPlan.totalSize << " bytes unpacked, "
+              << _portBufferPlan.arenaSize << " bytes packed" << EOL;
+        if (_portBufferPlan.arenaSize >= _portBufferPlan.totalSize)
+        {
+            return;
+        }
+
+        std::vector<std::pair<llvm::GlobalVariable*, size_t>> placements;
+        for (size_t index = 0; index < globals.size(); ++index)
+        {
+            placements.emplace_back(globals[index], _portBufferPlan.offsets[index]);
+        }
+        GetModule().MergeGlobals(GetNamespacePrefix() + "_PortBuffers", placements, _portBufferPlan.arenaSize);
+    }
+
     void IRMapCompiler::EmitPredictDispatchFunction(const Map& map)
     {
         auto& emitter = _moduleEmitter.GetIREmitter();
@@ -205,6 +383,62 @@ namespace model
         _moduleEmitter.EndFunction();
     }
 
+    void IRMapCompiler::EmitPredictBatchFunction(const Map& map)
+    {
+        if (map.NumInputs() != 1 || map.NumOutputs() != 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "The batch predict function can only be emitted for maps with a single input and output");
+        }
+
+        auto& emitter = _moduleEmitter.GetIREmitter();
+
+        // Adds "predict_batch(context, inputs, outputs, count)", which computes `count` examples laid out one after
+        // another in the input and output buffers, so callers scoring many examples make one call
+        auto predictFunction = _moduleEmitter.GetFunction(GetPredictFunctionName());
+        emitters::NamedLLVMTypeList args;
+        for (auto arg = predictFunction->arg_begin(), end = predictFunction->arg_end(); arg != end; ++arg)
+        {
+            args.push_back({ arg->getName(), arg->getType() });
+        }
+        args.push_back({ "count", emitter.Type(emitters::VariableType::Int32) });
+
+        auto function = _moduleEmitter.BeginFunction(GetPredictFunctionName() + "_batch", emitter.Type(emitters::VariableType::Void), args);
+        function.GetFunction()->setLinkage(llvm::GlobalValue::LinkageTypes::ExternalLinkage);
+        function.IncludeInHeader();
+
+        auto argIter = function.GetFunction()->arg_begin();
+        auto context = &(*argIter++);
+        auto inputs = &(*argIter++);
+        auto outputs = &(*argIter++);
+        auto count = &(*argIter++);
+
+        const auto inputSize = static_cast<int>(map.GetInputSize(0));
+        const auto outputSize = static_cast<int>(map.GetOutputSize(0));
+        auto numBatchedExamples = function.LocalScalar(0);
+        if (!_batchedPredictFunctionName.empty())
+        {
+            // Whole batches go through the batched map, which, e.g., computes a fully-connected layer as one
+            // matrix-matrix product per batch instead of one matrix-vector product per example
+            auto batchedPredictFunction = _moduleEmitter.GetFunction(_batchedPredictFunctionName);
+            const auto batchSize = GetMapCompilerOptions().batchSize;
+            auto numBatches = function.LocalScalar(count) / batchSize;
+            function.For(numBatches, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar index) {
+                auto input = fn.PointerOffset(inputs, index * (batchSize * inputSize));
+                auto output = fn.PointerOffset(outputs, index * (batchSize * outputSize));
+                fn.Call(batchedPredictFunction, { context, input, output });
+            });
+            numBatchedExamples = numBatches * batchSize;
+        }
+
+        function.For(numBatchedExamples, count, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar index) {
+            auto input = fn.PointerOffset(inputs, index * inputSize);
+            auto output = fn.PointerOffset(outputs, index * outputSize);
+            fn.Call(predictFunction, { context, input, output });
+        });
+        function.Return();
+        _moduleEmitter.EndFunction();
+    }
+
     void IRMapCompiler::EmitModelAPIFunctions(const Map& map)
     {
         EmitGetInputSizeFunction(map);
@@ -217,6 +451,10 @@ namespace model
         EmitGetSinkOutputShapeFunction(map);
         EmitGetMetadataFunction(map);
         EmitPredictDispatchFunction(map);
+        if (GetMapCompilerOptions().emitBatchFunction)
+        {
+            EmitPredictBatchFunction(map);
+        }
 
         // Finish any profiling stuff we need to do and emit functions
         _profiler.EmitModelProfilerFunctions();
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <thread>
 #include <unordered_set>
 
 namespace ell
@@ -92,6 +93,8 @@ namespace model
 
         // TODO (kerha): _computeContext isn't copied right now. Not sure if it should be. [2019-08-23]
 
+        SetNumComputeThreads(other._numComputeThreads);
+
         _model.Verify();
     }
 
@@ -131,29 +134,93 @@ namespace model
         node->SetInput(inputValues);
     }
 
+    template <typename ValueType>
+    std::vector<ValueType> Map::ComputeModelOutput(const PortElementsBase& outputs)
+    {
+        if (_numComputeThreads == 1)
+        {
+            return _model.ComputeOutput<ValueType>(outputs);
+        }
+
+        auto elements = PortElements<ValueType>(outputs);
+        std::vector<const OutputPortBase*> ports;
+        for (const auto& range : elements.GetRanges())
+        {
+            ports.push_back(range.ReferencedPort());
+        }
+        std::sort(ports.begin(), ports.end());
+        ports.erase(std::unique(ports.begin(), ports.end()), ports.end());
+
+        if (!_computeThreadPool)
+        {
+            // The calling thread helps run nodes while it waits, so it counts as one of the threads
+            _computeThreadPool = std::make_unique<utilities::ThreadPool>(_numComputeThreads - 1);
+        }
+        GetParallelExecutor(ports).Compute(*_computeThreadPool);
+
+        auto numElements = elements.Size();
+        std::vector<ValueType> result(numElements);
+        for (size_t index = 0; index < numElements; ++index)
+        {
+            auto element = elements.GetElement(index);
+            result[index] = element.ReferencedPort()->GetOutput()[element.GetIndex()];
+        }
+        return result;
+    }
+
+    const ParallelModelExecutor& Map::GetParallelExecutor(const std::vector<const OutputPortBase*>& outputs)
+    {
+        // The schedule is only valid for the model it was built from, so rebuild it if nodes were added through `GetModel()`
+        if (!_parallelExecutor || _parallelExecutor->GetOutputs() != outputs || _parallelExecutorModelSize != _model.Size())
+        {
+            _parallelExecutor = std::make_unique<ParallelModelExecutor>(_model, outputs);
+            _parallelExecutorModelSize = _model.Size();
+        }
+        return *_parallelExecutor;
+    }
+
+    void Map::ResetParallelExecutor()
+    {
+        _parallelExecutor.reset();
+    }
+
+    void Map::SetNumComputeThreads(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        if (numThreads != _numComputeThreads)
+        {
+            _numComputeThreads = numThreads;
+            _computeThreadPool.reset();
+        }
+    }
+
     std::vector<bool> Map::ComputeBoolOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<bool>(outputs);
+        return ComputeModelOutput<bool>(outputs);
     }
 
     std::vector<int> Map::ComputeIntOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<int>(outputs);
+        return ComputeModelOutput<int>(outputs);
     }
 
     std::vector<int64_t> Map::ComputeInt64Output(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<int64_t>(outputs);
+        return ComputeModelOutput<int64_t>(outputs);
     }
 
     std::vector<float> Map::ComputeFloatOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<float>(outputs);
+        return ComputeModelOutput<float>(outputs);
     }
 
     std::vector<double> Map::ComputeDoubleOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<double>(outputs);
+        return ComputeModelOutput<double>(outputs);
     }
 
     template <>
@@ -224,11 +291,13 @@ namespace model
                 int* intData = reinterpret_cast<int*>(ptr);
                 SetInputValue<int>(i, std::vector<int>(intData, intData + size));
             }
+            break;
             case ell::model::Port::PortType::bigInt:
             {
                 int64_t* int64Data = reinterpret_cast<int64_t*>(ptr);
                 SetInputValue<int64_t>(i, std::vector<int64_t>(int64Data, int64Data + size));
             }
+            break;
             case ell::model::Port::PortType::boolean:
             {
                 bool* boolData = reinterpret_cast<bool*>(ptr);
@@ -290,6 +359,18 @@ namespace model
         }
     }
 
+    void Map::ComputeBatchOutput(const void* inputs, size_t batchSize, void* outputs)
+    {
+        const auto inputStride = GetInputSize(0) * GetPortElementSize(GetInputType(0));
+        const auto outputStride = GetOutputSize(0) * GetPortElementSize(GetOutputType(0));
+        auto input = static_cast<char*>(const_cast<void*>(inputs));
+        auto output = static_cast<char*>(outputs);
+        for (size_t index = 0; index < batchSize; ++index)
+        {
+            ComputeMultiple({ input + index * inputStride }, { output + index * outputStride });
+        }
+    }
+
     void Map::Reset()
     {
         ContextGuard<> guard(_computeContext);
@@ -318,6 +399,7 @@ namespace model
         _outputs.push_back(&newOutputPort);
         _outputNames.push_back(outputName);
         _outputsMap.insert({ outputName, &newOutputPort });
+        ResetParallelExecutor();
     }
 
     void swap(Map& a, Map& b)
@@ -332,6 +414,10 @@ namespace model
         swap(a._outputsMap, b._outputsMap);
         swap(a._metadata, b._metadata);
         swap(a._computeContext, b._computeContext);
+        swap(a._numComputeThreads, b._numComputeThreads);
+        swap(a._computeThreadPool, b._computeThreadPool);
+        swap(a._parallelExecutor, b._parallelExecutor);
+        swap(a._parallelExecutorModelSize, b._parallelExecutorModelSize);
     }
 
     std::vector<const Node*> Map::GetAllOutputNodes() const
@@ -447,6 +533,7 @@ namespace model
         FixTransformedIO(transformer);
         _model = minimalModel.GetModel().ShallowCopy();
         _model.Verify();
+        ResetParallelExecutor();
     }
 
     size_t Map::NumInputs() const
@@ -605,6 +692,7 @@ namespace model
         auto newModel = transformer.TransformModel(_model, context, transformFunction);
         FixTransformedIO(transformer);
         _model = std::move(newModel);
+        ResetParallelExecutor();
     }
 
     void Map::Transform(Transformation& transformation)
@@ -619,6 +707,16 @@ namespace model
         auto newModel = transformation.TransformModel(_model, transformer, context);
         FixTransformedIO(transformer);
         _model = newModel.ShallowCopy();
+        ResetParallelExecutor();
+    }
+
+    void Map::Batch(int batchSize, const TransformContext& context)
+    {
+        ModelTransformer transformer;
+        auto newModel = transformer.BatchModel(_model, context, batchSize);
+        FixTransformedIO(transformer);
+        _model = std::move(newModel);
+        ResetParallelExecutor();
     }
 
     void Map::RenameCallbacks(const std::string& sourceCallbackName, const std::string& sinkCallbackName)
@@ -736,6 +834,7 @@ namespace model
             _outputsMap[_outputNames[index]] = _outputs[index];
         }
 
+        ResetParallelExecutor();
         archiver.PopContext();
     }
 
@@ -33,6 +33,10 @@ namespace model
         sinkFunctionName = properties.GetOrParseEntry("sinkFunctionName", sinkFunctionName);
         verifyJittedModule = properties.GetOrParseEntry("verifyJittedModule", verifyJittedModule);
         profile = properties.GetOrParseEntry("profile", profile);
+        reusePortBuffers = properties.GetOrParseEntry("reusePortBuffers", reusePortBuffers);
+        emitBatchFunction = properties.GetOrParseEntry("emitBatchFunction", emitBatchFunction);
+        batchSize = properties.GetOrParseEntry("batchSize", batchSize);
+        objectCacheDirectory = properties.GetOrParseEntry("objectCacheDirectory", objectCacheDirectory);
         inlineNodes = properties.GetOrParseEntry("inlineNodes", inlineNodes);
     }
 } // namespace model
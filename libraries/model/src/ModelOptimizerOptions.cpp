@@ -30,11 +30,25 @@ namespace model
             ADD_TO_STRING_ENTRY(PreferredConvolutionMethod, simple);
             ADD_TO_STRING_ENTRY(PreferredConvolutionMethod, winograd);
             ADD_TO_STRING_ENTRY(PreferredConvolutionMethod, unrolled);
+            ADD_TO_STRING_ENTRY(PreferredConvolutionMethod, tiled);
+            ADD_TO_STRING_ENTRY(PreferredConvolutionMethod, autotune);
         default:
             throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown PreferredConvolutionMethod");
         };
     }
 
+    std::string ToString(const WeightStorageType& t)
+    {
+        switch (t)
+        {
+            ADD_TO_STRING_ENTRY(WeightStorageType, float32);
+            ADD_TO_STRING_ENTRY(WeightStorageType, float16);
+            ADD_TO_STRING_ENTRY(WeightStorageType, bfloat16);
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown WeightStorageType");
+        };
+    }
+
     ModelOptimizerOptions::ModelOptimizerOptions(const utilities::PropertyBag& properties) :
         _options(properties)
     {
@@ -83,9 +97,22 @@ namespace utilities
         ADD_FROM_STRING_ENTRY(model::PreferredConvolutionMethod, simple);
         ADD_FROM_STRING_ENTRY(model::PreferredConvolutionMethod, winograd);
         ADD_FROM_STRING_ENTRY(model::PreferredConvolutionMethod, unrolled);
+        ADD_FROM_STRING_ENTRY(model::PreferredConvolutionMethod, tiled);
+        ADD_FROM_STRING_ENTRY(model::PreferredConvolutionMethod, autotune);
 
         throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown PreferredConvolutionMethod");
     }
+
+    template <>
+    model::WeightStorageType FromString<model::WeightStorageType>(const std::string& s)
+    {
+        BEGIN_FROM_STRING;
+        ADD_FROM_STRING_ENTRY(model::WeightStorageType, float32);
+        ADD_FROM_STRING_ENTRY(model::WeightStorageType, float16);
+        ADD_FROM_STRING_ENTRY(model::WeightStorageType, bfloat16);
+
+        throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown WeightStorageType");
+    }
 } // namespace utilities
 } // namespace ell
 
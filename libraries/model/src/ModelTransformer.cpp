@@ -161,7 +161,7 @@ namespace model
 
         auto targetPort = _outputPortMap.at(queryPortPtr);
 
-        if (targetPort->Size() != queryPort.Size())
+        if (!AreSizesCompatible(queryPort.Size(), targetPort->Size()))
         {
             throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch,
                                             utilities::FormatString("Model transformation resulted in a mismatching port size, expecting %lld, but found %lld", queryPort.Size(), targetPort->Size()));
@@ -171,7 +171,7 @@ namespace model
 
     void ModelTransformer::PortOutputsMap::MapNodeOutput(const OutputPortBase* oldPort, const OutputPortBase* newPort)
     {
-        if (oldPort->Size() != newPort->Size())
+        if (!AreSizesCompatible(oldPort->Size(), newPort->Size()))
         {
             throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch,
                                             utilities::FormatString("Trying to map port %s to output of different size, expecting %lld, but found %lld", oldPort->GetName().c_str(), oldPort->Size(), newPort->Size()));
@@ -182,6 +182,7 @@ namespace model
     ModelTransformer::PortOutputsMap ModelTransformer::PortOutputsMap::ConcatenateMaps(const PortOutputsMap& prevMap, const PortOutputsMap& newMap, bool isInPlace)
     {
         PortOutputsMap result;
+        result._batchSize = prevMap._batchSize * newMap._batchSize;
         for (const auto& entry : prevMap._outputPortMap)
         {
             const auto& newMappedValue = newMap.GetCorrespondingPort(*entry.second, isInPlace);
@@ -191,6 +192,11 @@ namespace model
         return result;
     }
 
+    bool ModelTransformer::PortOutputsMap::AreSizesCompatible(size_t oldSize, size_t newSize) const
+    {
+        return newSize == oldSize || (_batchSize > 1 && newSize == oldSize * _batchSize);
+    }
+
     //
     // ModelTransformer implementation
     //
@@ -312,6 +318,11 @@ namespace model
         return dynamic_cast<const InputNodeBase*>(&node) != nullptr;
     }
 
+    bool ModelTransformer::IsOutputNode(const Node& node) const
+    {
+        return dynamic_cast<const OutputNodeBase*>(&node) != nullptr;
+    }
+
     bool ModelTransformer::ArePortsCompatible(const InputPortBase* source, const OutputPortBase* dest)
     {
         return (source->Size() == dest->Size()) && (source->GetType() == dest->GetType());
@@ -342,6 +353,26 @@ namespace model
         return result.GetModel().ShallowCopy();
     }
 
+    Model ModelTransformer::BatchModel(const Model& model, const TransformContext& context, int batchSize)
+    {
+        if (batchSize < 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Batch size must be positive");
+        }
+
+        _batchSize = batchSize;
+        auto result = TransformModel(model, context, [](const Node& node, ModelTransformer& transformer) {
+            if (!transformer.BatchNode(node))
+            {
+                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Can't compute a batch of examples with " + node.GetRuntimeTypeName());
+            }
+        });
+
+        // Later transformations with this transformer aren't batched. The mapping kept for the caller still knows the batch size.
+        _batchSize = 1;
+        return result;
+    }
+
     // Transforms the submodel by visiting its nodes in execution order (visit all inputs to a node before visiting that node)
     Submodel ModelTransformer::TransformSubmodelOnto(const Submodel& submodel, const Model& destModel, const std::vector<const OutputPortBase*>& onto, const TransformContext& context, const NodeTransformFunction& transformFunction)
     {
@@ -350,6 +381,7 @@ namespace model
         _isInPlace = (submodel.GetModel() == destModel);
         auto previousElementMap = std::move(_elementsMap);
         _elementsMap.Clear();
+        _elementsMap.SetBatchSize(_batchSize);
 
         VerifyOntoModel(destModel, onto);
         VerifyOntoCorrespondences(submodel.GetInputs(), onto);
@@ -602,6 +634,27 @@ namespace model
         return false;
     }
 
+    bool ModelTransformer::BatchNode(const Node& node)
+    {
+        // Nodes that only depend on values shared by every example (e.g., constants) are computed once for the whole
+        // batch, unless their output also depends on something else (e.g., earlier inputs, or a callback)
+        const auto& inputs = node.GetInputPorts();
+        auto hasBatchedInput = std::any_of(inputs.begin(), inputs.end(), [this](const InputPortBase* input) { return IsBatched(*input); });
+        if (!hasBatchedInput && !IsInputNode(node) && !IsOutputNode(node) && !node.HasRuntimeState())
+        {
+            CopyNode(node);
+            return true;
+        }
+
+        Log() << "Attempting to batch " << node.GetRuntimeTypeName() << " [id = " << node.GetId().ToString() << "]" << EOL;
+        return node.Batch(*this);
+    }
+
+    bool ModelTransformer::IsBatched(const InputPortBase& input) const
+    {
+        return _batchSize > 1 && GetCorrespondingOutputs(input).Size() != input.Size();
+    }
+
     void ModelTransformer::AssignNodeAncestor(const Node& ancestorNode)
     {
         auto iter = _model.GetReverseNodeIterator();
@@ -188,6 +188,12 @@ namespace model
         return false;
     }
 
+    // Default implementation of Batch doesn't know how to compute more than one example at a time
+    bool Node::Batch(ModelTransformer&) const
+    {
+        return false;
+    }
+
     void Node::Print(std::ostream& os) const
     {
         bool isFirstInputPort = true;
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelMapCompiler.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelMapCompiler.h"
+#include "PipelinedCompiledMap.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ell
+{
+namespace model
+{
+    std::vector<CompiledMapSegment> CompileMapsInParallel(const std::vector<Map>& maps, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t numThreads)
+    {
+        std::vector<CompiledMapSegment> segments(maps.size());
+        if (maps.empty())
+        {
+            return segments;
+        }
+
+        // Create the compilers and copy the maps up front: setting up LLVM and copying models isn't thread-safe
+        std::vector<Map> mapCopies(maps);
+        for (size_t index = 0; index < maps.size(); ++index)
+        {
+            auto segmentSettings = settings;
+            segmentSettings.moduleName = settings.moduleName + "_" + std::to_string(index);
+            segments[index].compiler = std::make_unique<IRMapCompiler>(segmentSettings, optimizerOptions);
+        }
+
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        utilities::ThreadPool threadPool(std::min(numThreads, maps.size()));
+
+        std::atomic<size_t> numCompiled{ 0 };
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        for (size_t index = 0; index < maps.size(); ++index)
+        {
+            threadPool.Submit([&, index]() {
+                try
+                {
+                    auto& segment = segments[index];
+                    segment.compiledMap = std::make_unique<IRCompiledMap>(segment.compiler->Compile(std::move(mapCopies[index])));
+                    segment.compiledMap->FinishJitting();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                ++numCompiled;
+            });
+        }
+        threadPool.WaitUntil([&]() { return numCompiled == maps.size(); });
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        return segments;
+    }
+
+    //
+    // SegmentedCompiledMap
+    //
+    SegmentedCompiledMap::SegmentedCompiledMap(const Map& map, int numSegments, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t numThreads) :
+        _segments(CompileMapsInParallel(SplitMapIntoStages(map, numSegments), settings, optimizerOptions, numThreads))
+    {
+        for (const auto& segment : _segments)
+        {
+            const auto& compiledMap = *segment.compiledMap;
+            _buffers.emplace_back(compiledMap.GetInputSize(0) * GetPortElementSize(compiledMap.GetInputType(0)));
+        }
+
+        const auto& first = *_segments.front().compiledMap;
+        const auto& last = *_segments.back().compiledMap;
+        _buffers.emplace_back(last.GetOutputSize(0) * GetPortElementSize(last.GetOutputType(0)));
+        _inputType = first.GetInputType(0);
+        _inputSize = first.GetInputSize(0);
+        _outputType = last.GetOutputType(0);
+        _outputSize = last.GetOutputSize(0);
+    }
+
+    void SegmentedCompiledMap::Reset()
+    {
+        for (auto& segment : _segments)
+        {
+            segment.compiledMap->Reset();
+        }
+    }
+
+    void SegmentedCompiledMap::ComputeSegments()
+    {
+        for (size_t index = 0; index < _segments.size(); ++index)
+        {
+            _segments[index].compiledMap->ComputeMultiple({ _buffers[index].data() }, { _buffers[index + 1].data() });
+        }
+    }
+} // namespace model
+} // namespace ell
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelModelExecutor.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelModelExecutor.h"
+#include "CompilableCodeNode.h"
+#include "InputNodeBase.h"
+#include "Model.h"
+#include "Node.h"
+#include "OutputNodeBase.h"
+
+#include <utilities/include/Exception.h>
+
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        constexpr size_t noNode = std::numeric_limits<size_t>::max();
+
+        bool RequiresExclusiveAccess(const Node& node)
+        {
+            // CompilableCodeNode computes through the global value context, which isn't thread-safe,
+            // and source and sink nodes call into user code
+            return dynamic_cast<const CompilableCodeNode*>(&node) != nullptr ||
+                   dynamic_cast<const SourceNodeBase*>(&node) != nullptr ||
+                   dynamic_cast<const SinkNodeBase*>(&node) != nullptr;
+        }
+    } // namespace
+
+    struct ParallelModelExecutor::ExecutionState
+    {
+        ExecutionState(utilities::ThreadPool& threadPool, size_t numNodes) :
+            threadPool(threadPool),
+            numPendingParents(new std::atomic<int>[numNodes]),
+            numRemainingNodes(numNodes)
+        {
+        }
+
+        utilities::ThreadPool& threadPool;
+        std::unique_ptr<std::atomic<int>[]> numPendingParents;
+        std::atomic<size_t> numRemainingNodes;
+        std::atomic<bool> failed{ false };
+        std::mutex exclusiveMutex;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    ParallelModelExecutor::ParallelModelExecutor(const Model& model, const std::vector<const OutputPortBase*>& outputs) :
+        _outputs(outputs)
+    {
+        std::unordered_map<const Node*, size_t> nodeIndices;
+        auto iter = model.GetNodeIterator(outputs);
+        while (iter.IsValid())
+        {
+            auto node = iter.Get();
+            nodeIndices[node] = _nodes.size();
+            _nodes.push_back({ node, {}, 0, RequiresExclusiveAccess(*node) });
+            iter.Next();
+        }
+
+        for (size_t index = 0; index < _nodes.size(); ++index)
+        {
+            auto& entry = _nodes[index];
+            for (auto parent : entry.node->GetParentNodes())
+            {
+                auto parentIter = nodeIndices.find(parent);
+                if (parentIter == nodeIndices.end())
+                {
+                    throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Node's parent isn't part of the submodel being computed");
+                }
+                _nodes[parentIter->second].dependents.push_back(index);
+                ++entry.numParents;
+            }
+
+            if (entry.numParents == 0)
+            {
+                _roots.push_back(index);
+            }
+        }
+    }
+
+    void ParallelModelExecutor::Compute(utilities::ThreadPool& threadPool) const
+    {
+        const auto numNodes = _nodes.size();
+        if (numNodes == 0)
+        {
+            return;
+        }
+
+        ExecutionState state(threadPool, numNodes);
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            state.numPendingParents[index].store(_nodes[index].numParents, std::memory_order_relaxed);
+        }
+
+        for (auto root : _roots)
+        {
+            threadPool.Submit([this, &state, root]() { RunNode(state, root); });
+        }
+        threadPool.WaitUntil([&state]() { return state.numRemainingNodes.load(std::memory_order_acquire) == 0; });
+
+        if (state.error)
+        {
+            std::rethrow_exception(state.error);
+        }
+    }
+
+    void ParallelModelExecutor::RunNode(ExecutionState& state, size_t index) const
+    {
+        // After finishing a node, continue on this thread with one of the dependents it made ready and hand the rest to the pool
+        while (index != noNode)
+        {
+            const auto& entry = _nodes[index];
+            if (!state.failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    if (entry.requiresExclusiveAccess)
+                    {
+                        std::lock_guard<std::mutex> lock(state.exclusiveMutex);
+                        entry.node->Compute();
+                    }
+                    else
+                    {
+                        entry.node->Compute();
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(state.errorMutex);
+                    if (!state.error)
+                    {
+                        state.error = std::current_exception();
+                    }
+                    state.failed = true;
+                }
+            }
+
+            auto next = noNode;
+            for (auto dependent : entry.dependents)
+            {
+                if (state.numPendingParents[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (next == noNode)
+                    {
+                        next = dependent;
+                    }
+                    else
+                    {
+                        state.threadPool.Submit([this, &state, dependent]() { RunNode(state, dependent); });
+                    }
+                }
+            }
+
+            // `state` may be destroyed as soon as the last node is counted, so this must be the final access to it
+            // unless there's a dependent still to run (which keeps the count above zero)
+            state.numRemainingNodes.fetch_sub(1, std::memory_order_acq_rel);
+            index = next;
+        }
+    }
+} // namespace model
+} // namespace ell
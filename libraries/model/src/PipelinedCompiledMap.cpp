@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PipelinedCompiledMap.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PipelinedCompiledMap.h"
+#include "InputNode.h"
+#include "InputNodeBase.h"
+#include "Model.h"
+#include "ModelEditor.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        // Nodes without inputs that aren't input nodes (e.g., constants) are copied into every stage that uses them,
+        // so the ports they produce never have to cross a stage boundary
+        bool IsFreeNode(const Node& node)
+        {
+            return node.GetInputPorts().empty() && dynamic_cast<const InputNodeBase*>(&node) == nullptr;
+        }
+
+        InputNodeBase* AddInputNode(Model& model, const OutputPortBase& port)
+        {
+            auto layout = port.GetMemoryLayout();
+            switch (port.GetType())
+            {
+            case Port::PortType::boolean:
+                return model.AddNode<InputNode<bool>>(layout);
+            case Port::PortType::integer:
+                return model.AddNode<InputNode<int>>(layout);
+            case Port::PortType::bigInt:
+                return model.AddNode<InputNode<int64_t>>(layout);
+            case Port::PortType::smallReal:
+                return model.AddNode<InputNode<float>>(layout);
+            case Port::PortType::real:
+                return model.AddNode<InputNode<double>>(layout);
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+            }
+        }
+
+        // Builds the map computing the nodes between two cuts. `begin` is the port crossing the first cut, or null
+        // for the first stage.
+        Map GetStageMap(const Map& map, const OutputPortBase* begin, const OutputPortBase& end)
+        {
+            ModelTransformer transformer;
+            auto model = transformer.CopyModel(map.GetModel());
+
+            InputNodeBase* input = nullptr;
+            if (begin == nullptr)
+            {
+                input = transformer.GetCorrespondingInputNode(map.GetInput(0));
+            }
+            else
+            {
+                const auto& newBegin = transformer.GetCorrespondingOutputs(*begin);
+                std::vector<const InputPortBase*> consumers;
+                model.Visit([&](const Node& node) {
+                    for (auto port : node.GetInputPorts())
+                    {
+                        if (&port->GetReferencedPort() == &newBegin)
+                        {
+                            consumers.push_back(port);
+                        }
+                    }
+                });
+
+                input = AddInputNode(model, newBegin);
+                for (auto port : consumers)
+                {
+                    ModelEditor::ResetInputPort(port, input->GetOutputPort());
+                }
+            }
+
+            const auto& output = transformer.GetCorrespondingOutputs(end);
+            return Map(std::move(model), { { "input", input } }, { { "output", output } });
+        }
+    } // namespace
+
+    std::vector<Map> SplitMapIntoStages(const Map& map, int numStages)
+    {
+        if (numStages < 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "SplitMapIntoStages needs at least one stage");
+        }
+        if (map.NumInputs() != 1 || map.NumOutputs() != 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "SplitMapIntoStages can only split maps with a single input and output");
+        }
+        if (!map.GetSourceNodes().empty() || !map.GetSinkNodes().empty())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "SplitMapIntoStages can't split maps with source or sink nodes");
+        }
+
+        const auto& mapOutput = map.GetOutput(0);
+        std::vector<const Node*> nodes;
+        std::unordered_map<const Node*, size_t> positions;
+        map.GetModel().VisitSubmodel(map.GetOutputs(), [&](const Node& node) {
+            positions[&node] = nodes.size();
+            nodes.push_back(&node);
+        });
+        const auto numNodes = nodes.size();
+
+        // The position of the last node reading each port. The map's output is read by whatever comes after the map.
+        std::unordered_map<const OutputPortBase*, size_t> lastUse;
+        lastUse[&mapOutput] = numNodes;
+        for (size_t position = 0; position < numNodes; ++position)
+        {
+            for (auto input : nodes[position]->GetInputPorts())
+            {
+                auto& use = lastUse[&input->GetReferencedPort()];
+                use = std::max(use, position);
+            }
+        }
+
+        // A cut after position `p` is allowed if exactly one port produced at or before `p` is read after it
+        std::vector<const OutputPortBase*> cutPorts(numNodes, nullptr);
+        std::vector<int> numCrossingPorts(numNodes, 0);
+        for (const auto& entry : lastUse)
+        {
+            auto producer = entry.first->GetNode();
+            if (IsFreeNode(*producer))
+            {
+                continue;
+            }
+            for (auto cut = positions[producer]; cut < entry.second && cut < numNodes; ++cut)
+            {
+                ++numCrossingPorts[cut];
+                cutPorts[cut] = entry.first;
+            }
+        }
+
+        // Balance the stages by the number of nodes that do work in each of them
+        std::vector<size_t> weight(numNodes, 0);
+        size_t totalWeight = 0;
+        for (size_t position = 0; position < numNodes; ++position)
+        {
+            if (!IsFreeNode(*nodes[position]) && dynamic_cast<const InputNodeBase*>(nodes[position]) == nullptr)
+            {
+                ++totalWeight;
+            }
+            weight[position] = totalWeight;
+        }
+
+        std::vector<const OutputPortBase*> boundaries;
+        size_t previousWeight = 0;
+        size_t previousCut = 0;
+        for (int stage = 1; stage < numStages; ++stage)
+        {
+            const auto target = static_cast<double>(totalWeight) * stage / numStages;
+            auto bestCut = numNodes;
+            auto bestDistance = std::numeric_limits<double>::max();
+            for (auto cut = previousCut; cut + 1 < numNodes; ++cut)
+            {
+                if (numCrossingPorts[cut] != 1 || weight[cut] <= previousWeight || weight[cut] >= totalWeight)
+                {
+                    continue;
+                }
+                auto distance = std::abs(static_cast<double>(weight[cut]) - target);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestCut = cut;
+                }
+            }
+
+            if (bestCut == numNodes)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "SplitMapIntoStages can't split the map into " + std::to_string(numStages) + " stages");
+            }
+            boundaries.push_back(cutPorts[bestCut]);
+            previousWeight = weight[bestCut];
+            previousCut = bestCut + 1;
+        }
+
+        std::vector<Map> stages;
+        const OutputPortBase* begin = nullptr;
+        for (auto end : boundaries)
+        {
+            stages.push_back(GetStageMap(map, begin, *end));
+            begin = end;
+        }
+        stages.push_back(GetStageMap(map, begin, mapOutput));
+        return stages;
+    }
+
+    //
+    // PipelinedCompiledMap
+    //
+    PipelinedCompiledMap::PipelinedCompiledMap(const Map& map, int numStages, const MapCompilerOptions& settings, const ModelOptimizerOptions& optimizerOptions, size_t queueCapacity)
+    {
+        if (queueCapacity == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "PipelinedCompiledMap queue capacity must be greater than zero");
+        }
+
+        _stages = CompileMapsInParallel(SplitMapIntoStages(map, numStages), settings, optimizerOptions);
+        for (const auto& stage : _stages)
+        {
+            const auto& stageMap = *stage.compiledMap;
+            auto frameSize = stageMap.GetInputSize(0) * GetPortElementSize(stageMap.GetInputType(0));
+            _queues.push_back(std::make_unique<utilities::LockFreeQueue<Frame>>(queueCapacity, Frame(frameSize)));
+        }
+
+        const auto& firstStage = *_stages.front().compiledMap;
+        const auto& lastStage = *_stages.back().compiledMap;
+        auto outputFrameSize = lastStage.GetOutputSize(0) * GetPortElementSize(lastStage.GetOutputType(0));
+        _queues.push_back(std::make_unique<utilities::LockFreeQueue<Frame>>(queueCapacity, Frame(outputFrameSize)));
+
+        _inputType = firstStage.GetInputType(0);
+        _inputSize = firstStage.GetInputSize(0);
+        _outputType = lastStage.GetOutputType(0);
+        _outputSize = lastStage.GetOutputSize(0);
+
+        for (size_t stage = 0; stage < _stages.size(); ++stage)
+        {
+            _threads.emplace_back([this, stage]() { RunStage(stage); });
+        }
+    }
+
+    PipelinedCompiledMap::~PipelinedCompiledMap()
+    {
+        _stopping = true;
+        {
+            std::lock_guard<std::mutex> lock(_progressMutex);
+            _progressChanged.notify_all();
+        }
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void PipelinedCompiledMap::Reset()
+    {
+        if (_numFramesInFlight != 0)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "PipelinedCompiledMap::Reset called with frames in flight");
+        }
+
+        for (auto& stage : _stages)
+        {
+            stage.compiledMap->Reset();
+        }
+    }
+
+    void PipelinedCompiledMap::RunStage(size_t stage)
+    {
+        auto& stageMap = *_stages[stage].compiledMap;
+        auto& inputQueue = *_queues[stage];
+        auto& outputQueue = *_queues[stage + 1];
+        while (!_stopping)
+        {
+            auto progress = GetProgress();
+            auto input = inputQueue.TryBeginRead();
+            if (input == nullptr)
+            {
+                WaitForProgress(progress);
+                continue;
+            }
+
+            Frame* output = nullptr;
+            progress = GetProgress();
+            while ((output = outputQueue.TryBeginWrite()) == nullptr)
+            {
+                if (_stopping)
+                {
+                    return;
+                }
+                WaitForProgress(progress);
+                progress = GetProgress();
+            }
+
+            try
+            {
+                stageMap.ComputeMultiple({ input->data() }, { output->data() });
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                if (!_error)
+                {
+                    _error = std::current_exception();
+                }
+                _failed = true;
+                NotifyProgress();
+                return;
+            }
+
+            outputQueue.EndWrite();
+            inputQueue.EndRead();
+            NotifyProgress();
+        }
+    }
+
+    void PipelinedCompiledMap::ThrowIfFailed()
+    {
+        if (_failed)
+        {
+            std::lock_guard<std::mutex> lock(_errorMutex);
+            std::rethrow_exception(_error);
+        }
+    }
+
+    void PipelinedCompiledMap::NotifyProgress()
+    {
+        ++_progress;
+        if (_numWaiters > 0)
+        {
+            // Taking the lock orders this notification after a waiter's check of the progress count
+            std::lock_guard<std::mutex> lock(_progressMutex);
+            _progressChanged.notify_all();
+        }
+    }
+
+    void PipelinedCompiledMap::WaitForProgress(uint64_t progress)
+    {
+        auto isDone = [this, progress]() { return _progress != progress || _stopping || _failed; };
+        for (int spin = 0; spin < _numSpinsBeforeBlocking; ++spin)
+        {
+            if (isDone())
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        ++_numWaiters;
+        {
+            std::unique_lock<std::mutex> lock(_progressMutex);
+            _progressChanged.wait(lock, isDone);
+        }
+        --_numWaiters;
+    }
+} // namespace model
+} // namespace ell
@@ -11,6 +11,7 @@
 
 #include <utilities/include/StringUtil.h>
 #include <utilities/include/Boolean.h>
+#include <utilities/include/Exception.h>
 
 #include <cctype>
 
@@ -159,5 +160,26 @@ namespace model
             return "Unknown";
         };
     }
+
+    size_t GetPortElementSize(ell::model::Port::PortType type)
+    {
+        switch (type)
+        {
+        case ell::model::Port::PortType::smallReal:
+            return sizeof(float);
+        case ell::model::Port::PortType::real:
+            return sizeof(double);
+        case ell::model::Port::PortType::integer:
+            return sizeof(int);
+        case ell::model::Port::PortType::bigInt:
+            return sizeof(int64_t);
+        case ell::model::Port::PortType::categorical:
+            return sizeof(int);
+        case ell::model::Port::PortType::boolean:
+            return sizeof(bool);
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Port type has no element size");
+        };
+    }
 } // namespace model
 } // namespace ell
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortBufferPlanner.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PortBufferPlanner.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        size_t AlignUp(size_t value, size_t alignment)
+        {
+            return ((value + alignment - 1) / alignment) * alignment;
+        }
+
+        bool LifetimesOverlap(const BufferLifetime& a, const BufferLifetime& b)
+        {
+            return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+        }
+    } // namespace
+
+    BufferPlan PlanBufferReuse(const std::vector<BufferLifetime>& buffers, size_t alignment)
+    {
+        if (alignment == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Buffer alignment must be positive");
+        }
+
+        const auto numBuffers = buffers.size();
+        BufferPlan plan;
+        plan.offsets.resize(numBuffers);
+
+        // Place the largest buffers first, breaking ties by lifetime start so the result is deterministic
+        std::vector<size_t> order(numBuffers);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&buffers](size_t a, size_t b) {
+            if (buffers[a].size != buffers[b].size)
+            {
+                return buffers[a].size > buffers[b].size;
+            }
+            return buffers[a].firstUse < buffers[b].firstUse;
+        });
+
+        std::vector<size_t> placed;
+        for (auto index : order)
+        {
+            const auto& buffer = buffers[index];
+            const auto size = AlignUp(buffer.size, alignment);
+            plan.totalSize += size;
+
+            // Collect the address ranges of the already-placed buffers that are live at the same time as this one
+            std::vector<std::pair<size_t, size_t>> conflicts;
+            for (auto other : placed)
+            {
+                if (LifetimesOverlap(buffer, buffers[other]))
+                {
+                    conflicts.emplace_back(plan.offsets[other], plan.offsets[other] + AlignUp(buffers[other].size, alignment));
+                }
+            }
+            std::sort(conflicts.begin(), conflicts.end());
+
+            // Take the first gap that's big enough
+            size_t offset = 0;
+            for (const auto& conflict : conflicts)
+            {
+                if (offset + size <= conflict.first)
+                {
+                    break;
+                }
+                offset = std::max(offset, conflict.second);
+            }
+
+            plan.offsets[index] = offset;
+            plan.arenaSize = std::max(plan.arenaSize, offset + size);
+            placed.push_back(index);
+        }
+
+        return plan;
+    }
+} // namespace model
+} // namespace ell
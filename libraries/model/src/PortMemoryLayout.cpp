@@ -45,5 +45,15 @@ namespace model
         }
         return result;
     }
+
+    PortMemoryLayout GetBatchedMemoryLayout(const PortMemoryLayout& layout, int batchSize)
+    {
+        auto result = layout.CopyWithExtraDimensions(1);
+        auto size = result.GetActiveSize().ToVector();
+        auto extent = result.GetExtent().ToVector();
+        size[0] = batchSize;
+        extent[0] = batchSize;
+        return { MemoryShape{ size }, MemoryShape{ extent }, result.GetOffset(), result.GetLogicalDimensionOrder() };
+    }
 } // namespace model
 } // namespace ell
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PreparedMap.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PreparedMap.h"
+#include "Model.h"
+
+#include <value/include/EmitterContext.h>
+
+namespace ell
+{
+namespace model
+{
+    PreparedMap::PreparedMap(Map& map)
+    {
+        const auto numInputs = map.NumInputs();
+        for (size_t index = 0; index < numInputs; ++index)
+        {
+            auto input = map.GetInput(index);
+            _inputs.push_back(input);
+            _inputSizes.push_back(input->GetOutputPort().Size());
+        }
+
+        _outputs = map.GetOutputs();
+        for (auto output : _outputs)
+        {
+            _outputSizes.push_back(output->Size());
+        }
+
+        auto iter = map.GetModel().GetNodeIterator(_outputs);
+        while (iter.IsValid())
+        {
+            _nodes.push_back(iter.Get());
+            iter.Next();
+        }
+    }
+
+    void PreparedMap::Compute() const
+    {
+        value::ContextGuard<> guard(_computeContext);
+        for (auto node : _nodes)
+        {
+            node->Compute();
+        }
+    }
+
+    void PreparedMap::Reset()
+    {
+        value::ContextGuard<> guard(_computeContext);
+        for (auto node : _nodes)
+        {
+            const_cast<Node*>(node)->Reset();
+        }
+    }
+} // namespace model
+} // namespace ell
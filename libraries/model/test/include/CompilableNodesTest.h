@@ -74,8 +74,13 @@ void TestBufferNode();
 //
 void TestMatrixVectorMultiplyNode(int m, int n, bool useBlas);
 void TestMatrixMatrixMultiplyNode(int m, int n, int k, bool useBlas);
+void TestMatrixVectorMultiplyNodeWithReducedPrecisionWeights(int m, int n);
+void TestMatrixMatrixMultiplyNodeWithReducedPrecisionWeights(int m, int n, int k);
+void TestQuantizedMatrixMatrixMultiplyNode(int m, int n, int k);
+void TestQuantizedConvolutionNode();
 void TestOrderedMatrixMatrixMultiplyNode(int m, int n, int k, bool transposeA, bool transposeB, bool transposeC, bool useBlas);
 void TestMatrixMatrixMultiplyCodeNode(int m, int n, int k, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, nodes::MatrixMatrixMultiplyImplementation gemmImpl);
+void TestMatrixMatrixMultiplyCodeNodeWithConstantInput2(int m, int n, int k);
 
 void TestBroadcasUnaryOperationNodeCompile();
 void TestBroadcasBinaryOperationNodeCompileAdd();
@@ -114,6 +119,9 @@ void TestMeanPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels,
 void TestScalingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSoftmaxLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSpatialConvolutionNode(size_t inputPadding = 1, size_t outputPadding = 0);
+void TestSpatialConvolutionNodeInterleaved(size_t numChannels);
+void TestTiledConvolutionNode(size_t stride = 1);
+void TestGroupedConvolutionalLayerNode(size_t numGroups);
 void TestFusedLinearLayerNodes(size_t rows, size_t columns, size_t channels);
 void TestRegionDetectionNode();
 void TestIRNode();
@@ -56,6 +56,13 @@ void TestMultiSourceSinkMap();
 void TestCompiledMapMove();
 void TestCompiledMapClone();
 void TestCompiledMapParallelClone();
+void TestCompiledMapReentrantClone();
+void TestReusePortBuffers();
+void TestCompiledMapComputeBatch(bool emitBatchFunction, int batchSize = 1);
+void TestCompiledMapObjectCache();
+void TestCompiledMapCpuDispatch();
+void TestPipelinedCompiledMap();
+void TestSegmentedCompiledMap();
 
 #pragma region implementation
 
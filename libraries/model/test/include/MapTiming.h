@@ -0,0 +1,12 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MapTiming.h (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+void TimeMapCompute();
+void TimeElementwiseNodeEmission();
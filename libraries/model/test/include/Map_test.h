@@ -10,6 +10,10 @@
 void TestMapCreate();
 void TestMapCompute();
 void TestMapComputeDataVector();
+void TestMapComputeParallel();
+void TestPreparedMap();
+void TestMapComputeBatch();
+void TestMapBatch();
 void TestMapRefine();
 void TestMapSerialization();
 void TestMapClockNode();
@@ -0,0 +1,13 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortBufferPlanner_test.h (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+void TestPlanBufferReuseChain();
+void TestPlanBufferReuseOverlapping();
+void TestPlanBufferReuseAlignment();
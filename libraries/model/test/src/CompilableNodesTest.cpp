@@ -57,7 +57,10 @@
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/NodeOperations.h>
 #include <nodes/include/PoolingLayerNode.h>
+#include <nodes/include/QuantizedConvolutionNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
+#include <nodes/include/ReducedPrecisionWeights.h>
 #include <nodes/include/RegionDetectionLayerNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
 #include <nodes/include/ReorderDataCodeNode.h>
@@ -67,6 +70,7 @@
 #include <nodes/include/SourceNode.h>
 #include <nodes/include/SpatialConvolutionNode.h>
 #include <nodes/include/SumNode.h>
+#include <nodes/include/TiledConvolutionNode.h>
 #include <nodes/include/TypeCastNode.h>
 #include <nodes/include/UnaryOperationNode.h>
 
@@ -98,6 +102,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -1756,6 +1761,233 @@ void TestMatrixMatrixMultiplyNode(int m, int n, int k, bool useBlas)
     });
 }
 
+void TestMatrixVectorMultiplyNodeWithReducedPrecisionWeights(int m, int n)
+{
+    using ValueType = float;
+    std::vector<ValueType> weights(m * n);
+    FillVector(weights, static_cast<ValueType>(-1), static_cast<ValueType>(0.0371));
+    std::vector<ValueType> vectorVals(n);
+    FillVector(vectorVals);
+
+    model::Model model;
+    auto inputVectorNode = model.AddNode<model::InputNode<ValueType>>(n);
+    auto weightsNode = model.AddNode<ConstantNode<ValueType>>(weights);
+    auto matVecMultNode = model.AddNode<MatrixVectorMultiplyNode<ValueType>>(weightsNode->output, m, n, n, inputVectorNode->output);
+    auto map = model::Map(model, { { "inputVector", inputVectorNode } }, { { "output", matVecMultNode->output } });
+
+    for (auto storageType : { model::WeightStorageType::float16, model::WeightStorageType::bfloat16 })
+    {
+        // The result should be exactly the product with the rounded weights, and close to the product with the original ones
+        auto roundedWeights = UnpackWeights<ValueType>(PackWeights(weights, storageType), storageType);
+        std::vector<ValueType> expected(m);
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                expected[i] += roundedWeights[i * n + j] * vectorVals[j];
+            }
+        }
+        auto tolerance = GetWeightStorageError(weights, storageType).maxAbsoluteError * std::accumulate(vectorVals.begin(), vectorVals.end(), 0.0) + 1e-5;
+
+        std::string name = "MatrixVectorMultiplyNodeWithReducedPrecisionWeights";
+        TestWithSerialization(map, name, [&](model::Map& map, int iteration) {
+            model::MapCompilerOptions settings;
+            model::ModelOptimizerOptions optimizerOptions;
+            optimizerOptions["weightStorageType"] = storageType;
+            model::IRMapCompiler compiler(settings, optimizerOptions);
+            auto compiledMap = compiler.Compile(map);
+
+            std::vector<std::vector<ValueType>> signal = { vectorVals };
+            auto message = utilities::FormatString(" with %s weights, iteration %d", model::ToString(storageType).c_str(), iteration);
+            VerifyCompiledOutput(map, compiledMap, signal, "MatrixVectorMultiplyNode", message, tolerance);
+
+            compiledMap.SetInputValue(0, vectorVals);
+            auto compiledResult = compiledMap.ComputeOutput<ValueType>(0);
+            testing::ProcessTest("Testing compiled MatrixVectorMultiplyNode" + message + " against rounded weights", testing::IsEqual(compiledResult, expected, static_cast<ValueType>(1e-5)));
+        });
+    }
+}
+
+void TestMatrixMatrixMultiplyNodeWithReducedPrecisionWeights(int m, int n, int k)
+{
+    using ValueType = float;
+    std::vector<ValueType> weights(m * k);
+    FillVector(weights, static_cast<ValueType>(-1), static_cast<ValueType>(0.0371));
+    std::vector<ValueType> matrixBVals(k * n);
+    FillVector(matrixBVals);
+
+    // Constant weights on the left and a transposed output, the way UnrolledConvolutionNode uses it
+    model::Model model;
+    auto inputMatrixNode = model.AddNode<model::InputNode<ValueType>>(k * n);
+    auto weightsNode = model.AddNode<ConstantNode<ValueType>>(weights);
+    auto matMatMultNode = model.AddNode<MatrixMatrixMultiplyNode<ValueType>>(weightsNode->output, m, n, k, k, false, inputMatrixNode->output, n, false, m, true);
+    auto map = model::Map(model, { { "inputMatrix", inputMatrixNode } }, { { "output", matMatMultNode->output } });
+
+    for (auto storageType : { model::WeightStorageType::float16, model::WeightStorageType::bfloat16 })
+    {
+        auto roundedWeights = UnpackWeights<ValueType>(PackWeights(weights, storageType), storageType);
+        std::vector<ValueType> expected(m * n);
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                for (int l = 0; l < k; ++l)
+                {
+                    expected[j * m + i] += roundedWeights[i * k + l] * matrixBVals[l * n + j];
+                }
+            }
+        }
+        auto tolerance = GetWeightStorageError(weights, storageType).maxAbsoluteError * std::accumulate(matrixBVals.begin(), matrixBVals.end(), 0.0) + 1e-4;
+
+        std::string name = "MatrixMatrixMultiplyNodeWithReducedPrecisionWeights";
+        TestWithSerialization(map, name, [&](model::Map& map, int iteration) {
+            model::MapCompilerOptions settings;
+            model::ModelOptimizerOptions optimizerOptions;
+            optimizerOptions["weightStorageType"] = storageType;
+            model::IRMapCompiler compiler(settings, optimizerOptions);
+            auto compiledMap = compiler.Compile(map);
+
+            std::vector<std::vector<ValueType>> signal = { matrixBVals };
+            auto message = utilities::FormatString(" with %s weights, iteration %d", model::ToString(storageType).c_str(), iteration);
+            VerifyCompiledOutput(map, compiledMap, signal, "MatrixMatrixMultiplyNode", message, tolerance);
+
+            compiledMap.SetInputValue(0, matrixBVals);
+            auto compiledResult = compiledMap.ComputeOutput<ValueType>(0);
+            testing::ProcessTest("Testing compiled MatrixMatrixMultiplyNode" + message + " against rounded weights", testing::IsEqual(compiledResult, expected, static_cast<ValueType>(1e-4)));
+        });
+    }
+}
+
+void TestQuantizedMatrixMatrixMultiplyNode(int m, int n, int k)
+{
+    using ValueType = float;
+
+    // Every weights row contains a 127 and the input range is 127, so the quantized product is exact
+    std::vector<ValueType> weights(m * k);
+    for (int i = 0; i < m; ++i)
+    {
+        for (int l = 0; l < k; ++l)
+        {
+            weights[i * k + l] = l == i % k ? 127 : static_cast<ValueType>((i * 7 + l * 3) % 11 - 5);
+        }
+    }
+    std::vector<ValueType> inputValues(k * n);
+    for (int index = 0; index < k * n; ++index)
+    {
+        inputValues[index] = static_cast<ValueType>(index % 9 - 4);
+    }
+    std::vector<ValueType> expected(m * n);
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int l = 0; l < k; ++l)
+            {
+                expected[j * m + i] += weights[i * k + l] * inputValues[l * n + j];
+            }
+        }
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(k * n);
+    auto matMultNode = model.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(inputNode->output, m, n, k, weights, static_cast<ValueType>(127), true, model::PortMemoryLayout(model::MemoryShape{ n, m }));
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", matMultNode->output } });
+
+    std::string name = "QuantizedMatrixMatrixMultiplyNode";
+    TestWithSerialization(map, name, [&](model::Map& map, int iteration) {
+        model::MapCompilerOptions settings;
+        model::ModelOptimizerOptions optimizerOptions;
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+
+        std::vector<std::vector<ValueType>> signal = { inputValues };
+        VerifyCompiledOutputAndResult<ValueType, ValueType>(map, compiledMap, signal, { expected }, utilities::FormatString("%s iteration %d", name.c_str(), iteration));
+    });
+}
+
+void TestQuantizedConvolutionNode()
+{
+    using ValueType = float;
+    using TensorType = math::ChannelColumnRowTensor<ValueType>;
+
+    const int numRows = 4;
+    const int numColumns = 5;
+    const int numChannels = 2;
+    const int numFilters = 3;
+    const int filterSize = 3;
+    const int padding = 1;
+
+    // Integer inputs and weights in {-2, 0, 2} quantize exactly with an input range of 127
+    TensorType inputWithPadding(numRows + 2 * padding, numColumns + 2 * padding, numChannels);
+    inputWithPadding.Fill(0);
+    for (int r = 0; r < numRows; ++r)
+    {
+        for (int c = 0; c < numColumns; ++c)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                inputWithPadding(r + padding, c + padding, ch) = static_cast<ValueType>((r * 3 + c * 2 + ch) % 7 - 3);
+            }
+        }
+    }
+    TensorType weights(numFilters * filterSize, filterSize, numChannels);
+    for (int f = 0; f < numFilters; ++f)
+    {
+        for (int i = 0; i < filterSize; ++i)
+        {
+            for (int j = 0; j < filterSize; ++j)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    weights(f * filterSize + i, j, ch) = static_cast<ValueType>(2 * ((f + i * 3 + j * 5 + ch * 7) % 3 - 1));
+                }
+            }
+        }
+    }
+
+    std::vector<ValueType> expected;
+    for (int r = 0; r < numRows; ++r)
+    {
+        for (int c = 0; c < numColumns; ++c)
+        {
+            for (int f = 0; f < numFilters; ++f)
+            {
+                ValueType sum = 0;
+                for (int i = 0; i < filterSize; ++i)
+                {
+                    for (int j = 0; j < filterSize; ++j)
+                    {
+                        for (int ch = 0; ch < numChannels; ++ch)
+                        {
+                            sum += inputWithPadding(r + i, c + j, ch) * weights(f * filterSize + i, j, ch);
+                        }
+                    }
+                }
+                expected.push_back(sum);
+            }
+        }
+    }
+
+    model::PortMemoryLayout inputLayout(model::MemoryShape{ numRows, numColumns, numChannels }, model::MemoryShape{ padding, padding, 0 });
+    model::PortMemoryLayout outputLayout(model::MemoryShape{ numRows, numColumns, numFilters });
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputWithPadding.Size());
+    auto convNode = model.AddNode<QuantizedConvolutionNode<ValueType>>(inputNode->output, inputLayout, outputLayout, weights, 1, static_cast<ValueType>(127));
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", convNode->output } });
+
+    std::string name = "QuantizedConvolutionNode";
+    TestWithSerialization(map, name, [&](model::Map& map, int iteration) {
+        model::MapCompilerOptions settings;
+        model::ModelOptimizerOptions optimizerOptions;
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+
+        std::vector<std::vector<ValueType>> signal = { inputWithPadding.ToArray() };
+        VerifyCompiledOutputAndResult<ValueType, ValueType>(map, compiledMap, signal, { expected }, utilities::FormatString("%s iteration %d", name.c_str(), iteration), "", 1e-4);
+    });
+}
+
 void TestOrderedMatrixMatrixMultiplyNode(int m, int n, int k, bool transposeA, bool transposeB, bool transposeC, bool useBlas)
 {
     using ValueType = float;
@@ -1851,6 +2083,39 @@ void TestMatrixMatrixMultiplyCodeNode(int m, int n, int k, int panelM, int panel
     });
 }
 
+void TestMatrixMatrixMultiplyCodeNodeWithConstantInput2(int m, int n, int k)
+{
+    using ValueType = float;
+    std::vector<ValueType> matrixBVals(k * n);
+    FillRandomVector(matrixBVals);
+
+    model::Model model;
+    auto inputMatrixNode = model.AddNode<model::InputNode<ValueType>>(m * k);
+    auto matrixBNode = model.AddNode<ConstantNode<ValueType>>(matrixBVals);
+    auto matMatMultNode = model.AddNode<MatrixMatrixMultiplyCodeNode<ValueType>>(inputMatrixNode->output, m, n, k, k, matrixBNode->output, n, n, MatrixMatrixMultiplyImplementation::Mlas_Loopnest_Value);
+    auto map = model::Map(model, { { "inputMatrix", inputMatrixNode } }, { { "output", matMatMultNode->output } });
+
+    std::string name = "MatrixMatrixMultiplyCodeNodeWithConstantInput2";
+    TestWithSerialization(map, name, [&](model::Map& map, int iteration) {
+        model::MapCompilerOptions settings;
+        model::ModelOptimizerOptions optimizerOptions;
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+
+        // The constant matrix should be packed into the cache layout at compile time rather than copied into a cache at runtime
+        std::ostringstream buffer;
+        compiledMap.WriteCode(buffer, emitters::ModuleOutputFormat::ir);
+        auto ir = buffer.str();
+        auto message = utilities::FormatString("(m = %d, n = %d, k = %d) iteration %d", m, n, k, iteration);
+        testing::ProcessTest("Testing MatrixMatrixMultiplyCodeNode prepacks constant input " + message, ir.find("prepackedInput2_") != std::string::npos && ir.find("BLASTCopyCache") == std::string::npos);
+
+        std::vector<ValueType> matrixAVals(m * k);
+        FillRandomVector(matrixAVals);
+        std::vector<std::vector<ValueType>> signal = { matrixAVals };
+        VerifyCompiledOutput(map, compiledMap, signal, "MatrixMatrixMultiplyCodeNode", message, 1e-4);
+    });
+}
+
 // C callback (called by emitted code)
 static int lagNotificationCallbackCount = 0;
 extern "C" {
@@ -3933,3 +4198,184 @@ void TestSpatialConvolutionNode(size_t inputPaddingSize, size_t outputPaddingSiz
     // Test archiving / unarchiving produces same result
     VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output, info);
 }
+
+void TestTiledConvolutionNode(size_t stride)
+{
+    // Sizes chosen so that no dimension divides evenly into the tile sizes passed to the node
+    using ElementType = double;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using TensorReferenceType = typename Layer<ElementType>::TensorReferenceType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    const size_t inputPaddingSize = 1;
+    const size_t numRows = 7;
+    const size_t numCols = 9;
+    const size_t numChannels = 5;
+    const size_t numFilters = 6;
+    const size_t filterSize = 3;
+    const size_t numOutputRows = (numRows - 1) / stride + 1;
+    const size_t numOutputCols = (numCols - 1) / stride + 1;
+
+    auto rng = utilities::GetRandomEngine("123");
+    auto rand = [&rng]() { return (double)rng() / (double)(rng.max() - rng.min()); };
+
+    TensorType inputWithPadding(numRows + 2 * inputPaddingSize, numCols + 2 * inputPaddingSize, numChannels);
+    inputWithPadding.Fill(0);
+    TensorReferenceType input = inputWithPadding.GetSubTensor(inputPaddingSize, inputPaddingSize, 0, numRows, numCols, numChannels);
+    input.Generate(rand);
+
+    Shape outputShape = { numOutputRows, numOutputCols, numFilters };
+    LayerParameters parameters{ inputWithPadding, ZeroPadding(inputPaddingSize), outputShape, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ filterSize, stride, ConvolutionMethod::simple, 1 };
+    TensorType weights(filterSize * numFilters, filterSize, numChannels);
+    weights.Generate(rand);
+
+    ConvolutionalLayer<ElementType> layer(parameters, convolutionalParams, weights);
+    layer.Compute();
+    auto output = layer.GetOutput();
+
+    // Create model
+    model::Model model;
+    auto inputMemoryLayout = utilities::MemoryLayout(
+        utilities::MemoryShape{ static_cast<int>(numRows), static_cast<int>(numCols), static_cast<int>(numChannels) },
+        utilities::MemoryShape{ static_cast<int>(inputPaddingSize), static_cast<int>(inputPaddingSize), 0 });
+    auto outputMemoryLayout = utilities::MemoryLayout(utilities::MemoryShape{ static_cast<int>(numOutputRows), static_cast<int>(numOutputCols), static_cast<int>(numFilters) });
+    auto inputNode = model.AddNode<model::InputNode<double>>(inputMemoryLayout);
+    auto computeNode = model.AddNode<TiledConvolutionNode<double>>(inputNode->output, inputMemoryLayout, outputMemoryLayout, weights, stride, 2, 4, 2, 4);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+    const auto info = "(TestTiledConvolutionNode, stride = " + std::to_string(stride) + ")";
+
+    VerifyLayerMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+
+    // Test archiving / unarchiving produces same result
+    VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+}
+
+void TestGroupedConvolutionalLayerNode(size_t numGroups)
+{
+    // With as many groups as channels, the layer is depthwise separable
+    using ElementType = double;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using TensorReferenceType = typename Layer<ElementType>::TensorReferenceType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    const size_t inputPaddingSize = 1;
+    const size_t numRows = 6;
+    const size_t numCols = 7;
+    const size_t numChannels = 12;
+    const size_t numFilters = 12;
+    const size_t filterSize = 3;
+    const size_t groupChannels = numChannels / numGroups;
+    const size_t groupFilters = numFilters / numGroups;
+
+    auto rng = utilities::GetRandomEngine("123");
+    auto rand = [&rng]() { return (double)rng() / (double)(rng.max() - rng.min()); };
+
+    TensorType inputWithPadding(numRows + 2 * inputPaddingSize, numCols + 2 * inputPaddingSize, numChannels);
+    inputWithPadding.Fill(0);
+    TensorReferenceType input = inputWithPadding.GetSubTensor(inputPaddingSize, inputPaddingSize, 0, numRows, numCols, numChannels);
+    input.Generate(rand);
+
+    Shape outputShape = { numRows, numCols, numFilters };
+    LayerParameters parameters{ inputWithPadding, ZeroPadding(inputPaddingSize), outputShape, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ filterSize, 1, ConvolutionMethod::simple, 1 };
+    TensorType weights(filterSize * numFilters, filterSize, groupChannels);
+    weights.Generate(rand);
+
+    ConvolutionalLayer<ElementType> layer(parameters, convolutionalParams, weights);
+    layer.Compute();
+    auto output = layer.GetOutput();
+
+    // Each filter only sees the input channels of its own group
+    TensorType expectedOutput(numRows, numCols, numFilters);
+    for (size_t filter = 0; filter < numFilters; ++filter)
+    {
+        const size_t firstChannel = (filter / groupFilters) * groupChannels;
+        for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+        {
+            for (size_t colIndex = 0; colIndex < numCols; ++colIndex)
+            {
+                double sum = 0;
+                for (size_t windowRow = 0; windowRow < filterSize; ++windowRow)
+                {
+                    for (size_t windowColumn = 0; windowColumn < filterSize; ++windowColumn)
+                    {
+                        for (size_t channel = 0; channel < groupChannels; ++channel)
+                        {
+                            sum += inputWithPadding(rowIndex + windowRow, colIndex + windowColumn, firstChannel + channel) * weights(filter * filterSize + windowRow, windowColumn, channel);
+                        }
+                    }
+                }
+                expectedOutput(rowIndex, colIndex, filter) = sum;
+            }
+        }
+    }
+
+    const auto info = "(TestGroupedConvolutionalLayerNode, groups = " + std::to_string(numGroups) + ")";
+    testing::ProcessTest("Testing grouped ConvolutionalLayer " + info, output.IsEqual(expectedOutput, 1e-10));
+
+    // Create model
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(inputWithPadding.Size());
+    auto computeNode = model.AddNode<ConvolutionalLayerNode<double>>(inputNode->output, layer);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+    VerifyLayerMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+
+    // Test archiving / unarchiving produces same result
+    VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+}
+
+void TestSpatialConvolutionNodeInterleaved(size_t numChannels)
+{
+    // Channel-interleaved data gets the tiled schedule: sizes chosen so that neither the rows, the columns nor the
+    // channels divide evenly into the node's tiles (4 rows, 8 columns, 64 channels)
+    using ElementType = double;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using TensorReferenceType = typename Layer<ElementType>::TensorReferenceType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    const size_t inputPaddingSize = 1;
+    const size_t numRows = 9;
+    const size_t numCols = 11;
+    const size_t filterSize = 3;
+
+    auto rng = utilities::GetRandomEngine("123");
+    auto rand = [&rng]() { return (double)rng() / (double)(rng.max() - rng.min()); };
+
+    TensorType inputWithPadding(numRows + 2 * inputPaddingSize, numCols + 2 * inputPaddingSize, numChannels);
+    inputWithPadding.Fill(0);
+    TensorReferenceType input = inputWithPadding.GetSubTensor(inputPaddingSize, inputPaddingSize, 0, numRows, numCols, numChannels);
+    input.Generate(rand);
+
+    Shape outputShape = { numRows, numCols, numChannels };
+    LayerParameters parameters{ inputWithPadding, ZeroPadding(inputPaddingSize), outputShape, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ filterSize, 1, ConvolutionMethod::simple, 1 };
+    TensorType weights(filterSize * numChannels, filterSize, 1);
+    weights.Generate(rand);
+
+    ConvolutionalLayer<ElementType> layer(parameters, convolutionalParams, weights);
+    layer.Compute();
+    auto output = layer.GetOutput();
+
+    // Create model
+    model::Model model;
+    auto inputMemoryLayout = utilities::MemoryLayout(
+        utilities::MemoryShape{ static_cast<int>(numRows), static_cast<int>(numCols), static_cast<int>(numChannels) },
+        utilities::MemoryShape{ static_cast<int>(inputPaddingSize), static_cast<int>(inputPaddingSize), 0 });
+    auto outputMemoryLayout = utilities::MemoryLayout(utilities::MemoryShape{ static_cast<int>(numRows), static_cast<int>(numCols), static_cast<int>(numChannels) });
+    auto inputNode = model.AddNode<model::InputNode<double>>(inputMemoryLayout);
+    auto computeNode = model.AddNode<SpatialConvolutionNode<double>>(inputNode->output, layer, outputMemoryLayout);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+    const auto info = "(TestSpatialConvolutionNodeInterleaved, channels = " + std::to_string(numChannels) + ")";
+
+    VerifyLayerMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+
+    // Test archiving / unarchiving produces same result
+    VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output, info);
+}
@@ -16,6 +16,8 @@
 #include <model/include/InputNode.h>
 #include <model/include/Map.h>
 #include <model/include/Model.h>
+#include <model/include/ParallelMapCompiler.h>
+#include <model/include/PipelinedCompiledMap.h>
 
 #include <nodes/include/AccumulatorNode.h>
 #include <nodes/include/ClockNode.h>
@@ -34,6 +36,7 @@
 
 #include <emitters/include/EmitterException.h>
 #include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRCpuDispatch.h>
 #include <emitters/include/IREmitter.h>
 #include <emitters/include/IRFunctionEmitter.h>
 #include <emitters/include/IRModuleEmitter.h>
@@ -43,6 +46,7 @@
 #include <predictors/include/LinearPredictor.h>
 #include <predictors/include/ProtoNNPredictor.h>
 
+#include <utilities/include/Files.h>
 #include <utilities/include/Logger.h>
 #include <utilities/include/RandomEngines.h>
 
@@ -50,11 +54,13 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <ostream>
 #include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -421,6 +427,386 @@ void TestCompiledMapParallelClone()
     }
 }
 
+void TestCompiledMapReentrantClone()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto delayNode = model.AddNode<nodes::DelayNode<double>>(accumNode->output, 2);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", delayNode->output } });
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 }, { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+
+    // get original map output as gold standard
+    std::vector<std::vector<double>> expected;
+    for (const auto& input : signal)
+    {
+        map.SetInputValue(0, input);
+        expected.push_back(map.ComputeOutput<double>(0));
+    }
+
+    model::MapCompilerOptions settings;
+    settings.compilerSettings.reentrant = true;
+    settings.compilerSettings.parallelize = false;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    PrintIR(compiledMap);
+
+    // all the clones share the jitted code, but each one has its own accumulator and delay state
+    std::vector<std::unique_ptr<model::IRCompiledMap>> compiledMaps;
+    const int numParallelComputations = 16;
+    for (int i = 0; i < numParallelComputations; ++i)
+    {
+        compiledMaps.push_back(std::make_unique<model::IRCompiledMap>(compiledMap.Clone()));
+    }
+
+    std::vector<std::future<bool>> futures;
+    for (const auto& mapRef : compiledMaps)
+    {
+        futures.push_back(std::async(std::launch::async,
+                                     [&](model::IRCompiledMap* map) {
+                                         VerifyMapOutput(*map, signal, expected, "Reentrant map test");
+                                         return true;
+                                     },
+                                     mapRef.get()));
+    }
+
+    for (auto& fut : futures)
+    {
+        [[maybe_unused]] auto x = fut.get();
+    }
+
+    // the original map's state must be untouched by the clones
+    VerifyMapOutput(compiledMap, signal, expected, "Reentrant map original state");
+}
+
+void TestReusePortBuffers()
+{
+    // A chain of accumulators: each intermediate port buffer is only live between two neighboring nodes
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(8);
+    const model::OutputPort<double>* previous = &inputNode->output;
+    for (int i = 0; i < 5; ++i)
+    {
+        previous = &model.AddNode<nodes::AccumulatorNode<double>>(*previous)->output;
+    }
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", *previous } });
+
+    model::MapCompilerOptions settings;
+    settings.reusePortBuffers = true;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    PrintIR(compiledMap);
+
+    const auto& plan = compiler.GetPortBufferPlan();
+    testing::ProcessTest("Testing TestReusePortBuffers packs the port buffers", plan.arenaSize < plan.totalSize);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4, 5, 6, 7, 8 }, { 4, 5, 6, 7, 8, 9, 1, 2 }, { 7, 8, 9, 1, 2, 3, 4, 5 }, { 3, 4, 5, 6, 7, 8, 9, 1 } };
+    VerifyCompiledOutput(map, compiledMap, signal, "TestReusePortBuffers");
+}
+
+void TestCompiledMapComputeBatch(bool emitBatchFunction, int batchSize)
+{
+    math::RowMatrix<double> m{
+        { 1.2, 1.1, 0.8 },
+        { 0.6, 0.9, 1.3 },
+        { 0.3, 1.0, 0.4 },
+        { -.4, 0.2, -.7 }
+    };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(inputNode->output, m);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+
+    model::MapCompilerOptions settings;
+    settings.emitBatchFunction = emitBatchFunction;
+    settings.batchSize = batchSize;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    PrintIR(compiledMap);
+
+    // 5 examples with a batch size of 2 exercise both whole batches and the per-example remainder
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 } };
+    auto outputs = compiledMap.ComputeBatch<double>(signal);
+
+    bool ok = outputs.size() == signal.size();
+    for (size_t index = 0; ok && index < signal.size(); ++index)
+    {
+        ok = testing::IsEqual(outputs[index], map.Compute<double>(signal[index]), 1e-8);
+    }
+    testing::ProcessTest(std::string("Testing TestCompiledMapComputeBatch(") + (emitBatchFunction ? "emitBatchFunction" : "default") + ", batchSize = " + std::to_string(batchSize) + ")", ok);
+}
+
+void TestCompiledMapObjectCache()
+{
+    math::RowMatrix<double> m{
+        { 1.2, 1.1, 0.8 },
+        { 0.6, 0.9, 1.3 },
+        { 0.3, 1.0, 0.4 },
+        { -.4, 0.2, -.7 }
+    };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(inputNode->output, m);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 } };
+
+    model::MapCompilerOptions settings;
+    settings.objectCacheDirectory = OutputPath("objectCache");
+    model::ModelOptimizerOptions optimizerOptions;
+
+    // Remove whatever a previous run of the test left in the cache
+    std::string key;
+    {
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+        key = compiledMap.GetObjectCache()->GetKey();
+    }
+    std::remove(utilities::JoinPaths(settings.objectCacheDirectory, key + ".o").c_str());
+    std::remove(utilities::JoinPaths(settings.objectCacheDirectory, key + ".time").c_str());
+    std::remove(utilities::JoinPaths(settings.objectCacheDirectory, key + ".key").c_str());
+
+    model::IRMapCompiler compiler1(settings, optimizerOptions);
+    auto compiledMap1 = compiler1.Compile(map);
+    testing::ProcessTest("Testing TestCompiledMapObjectCache first compile misses", !compiledMap1.GetObjectCache()->IsHit());
+    VerifyCompiledOutput(map, compiledMap1, signal, "TestCompiledMapObjectCache miss");
+
+    model::IRMapCompiler compiler2(settings, optimizerOptions);
+    auto compiledMap2 = compiler2.Compile(map);
+    testing::ProcessTest("Testing TestCompiledMapObjectCache second compile hits", compiledMap2.GetObjectCache()->IsHit() && compiledMap2.GetObjectCache()->GetKey() == key);
+    VerifyCompiledOutput(map, compiledMap2, signal, "TestCompiledMapObjectCache hit");
+
+    // An entry whose stored key material doesn't match (as with a digest collision) is a miss, and gets replaced
+    {
+        auto stream = utilities::OpenOfstream(utilities::JoinPaths(settings.objectCacheDirectory, key + ".key"));
+        stream << "some other module";
+    }
+    model::IRMapCompiler compiler3(settings, optimizerOptions);
+    auto compiledMap3 = compiler3.Compile(map);
+    testing::ProcessTest("Testing TestCompiledMapObjectCache mismatched key material misses", !compiledMap3.GetObjectCache()->IsHit());
+    VerifyCompiledOutput(map, compiledMap3, signal, "TestCompiledMapObjectCache mismatch");
+
+    model::IRMapCompiler compiler4(settings, optimizerOptions);
+    auto compiledMap4 = compiler4.Compile(map);
+    testing::ProcessTest("Testing TestCompiledMapObjectCache replaced entry hits", compiledMap4.GetObjectCache()->IsHit());
+}
+
+void TestCompiledMapCpuDispatch()
+{
+    const int numRows = 16;
+    const int numColumns = 32;
+    math::RowMatrix<float> m(numRows, numColumns);
+    for (int i = 0; i < numRows; ++i)
+    {
+        for (int j = 0; j < numColumns; ++j)
+        {
+            m(i, j) = static_cast<float>((i + 2 * j) % 7) - 3;
+        }
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<float>>(numColumns);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<float, math::MatrixLayout::rowMajor>>(inputNode->output, m);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+
+    std::vector<std::vector<float>> signal;
+    for (int example = 0; example < 4; ++example)
+    {
+        std::vector<float> input(numColumns);
+        for (int j = 0; j < numColumns; ++j)
+        {
+            input[j] = static_cast<float>((example + j) % 5);
+        }
+        signal.push_back(input);
+    }
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler defaultCompiler(settings, optimizerOptions);
+    auto defaultMap = defaultCompiler.Compile(map);
+
+    // The first CPU is picked if the host has AVX-512, else the baseline x86-64 one, which every x86-64 CPU runs,
+    // so the dispatcher always calls one of the CPU-specific versions
+    std::vector<std::string> cpus = { "skylake-avx512", "x86-64" };
+    std::vector<std::unique_ptr<model::IRMapCompiler>> cpuSpecificCompilers;
+    std::vector<std::unique_ptr<model::IRCompiledMap>> cpuSpecificMaps;
+    std::vector<emitters::IRModuleEmitter*> cpuSpecificModules;
+    try
+    {
+        for (const auto& cpu : cpus)
+        {
+            auto cpuSettings = settings;
+            cpuSettings.compilerSettings.targetDevice = emitters::GetCpuSpecificTargetDevice(settings.compilerSettings.targetDevice, cpu);
+            cpuSettings.moduleName = emitters::GetCpuSpecificModuleName(settings.moduleName, cpu);
+            cpuSettings.mapFunctionName = emitters::GetCpuSpecificFunctionName(settings.mapFunctionName, settings.moduleName, cpu);
+            cpuSpecificCompilers.push_back(std::make_unique<model::IRMapCompiler>(cpuSettings, optimizerOptions));
+            cpuSpecificMaps.push_back(std::make_unique<model::IRCompiledMap>(cpuSpecificCompilers.back()->Compile(map)));
+            cpuSpecificModules.push_back(&cpuSpecificMaps.back()->GetModule());
+        }
+    }
+    catch (const emitters::EmitterException& exception)
+    {
+        if (exception.GetErrorCode() != emitters::EmitterError::targetNotSupported)
+        {
+            throw;
+        }
+        std::cout << "Skipping TestCompiledMapCpuDispatch: " << exception.GetMessage() << std::endl;
+        return;
+    }
+
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    emitters::LinkCpuSpecificModules(compiledMap.GetModule(), cpuSpecificModules);
+    PrintIR(compiledMap);
+
+    std::stringstream ir;
+    compiledMap.WriteCode(ir, emitters::ModuleOutputFormat::ir);
+    testing::ProcessTest("Testing TestCompiledMapCpuDispatch emits a dispatcher", ir.str().find("cpuid") != std::string::npos);
+
+    bool ok = true;
+    for (const auto& input : signal)
+    {
+        defaultMap.SetInputValue(0, input);
+        auto expectedOutput = defaultMap.ComputeOutput<float>(0);
+        compiledMap.SetInputValue(0, input);
+        auto dispatchedOutput = compiledMap.ComputeOutput<float>(0);
+        ok = ok && testing::IsEqual(dispatchedOutput, expectedOutput, 1e-5f) && testing::IsEqual(dispatchedOutput, map.Compute<float>(input), 1e-5f);
+    }
+    testing::ProcessTest("Testing TestCompiledMapCpuDispatch output matches the default version", ok);
+
+    // The CPU-specific versions and the dispatch helper are private, so the header only declares the original functions
+    std::stringstream header;
+    compiledMap.WriteCodeHeader(header, emitters::ModuleOutputFormat::cHeader);
+    std::stringstream defaultHeader;
+    defaultMap.WriteCodeHeader(defaultHeader, emitters::ModuleOutputFormat::cHeader);
+    bool headerOk = header.str() == defaultHeader.str() && header.str().find("GetCpuSpecificModuleIndex") == std::string::npos;
+    for (const auto& cpu : cpus)
+    {
+        headerOk = headerOk && header.str().find(emitters::GetCpuSpecificModuleName(settings.moduleName, cpu)) == std::string::npos;
+    }
+    testing::ProcessTest("Testing TestCompiledMapCpuDispatch header lists only the public functions", headerOk);
+}
+
+void TestPipelinedCompiledMap()
+{
+    math::RowMatrix<double> m{
+        { 1.2, 1.1, 0.8 },
+        { 0.6, 0.9, 1.3 },
+        { 0.3, 1.0, 0.4 },
+        { -.4, 0.2, -.7 }
+    };
+
+    // Stateful nodes in every stage, so the output is only right if each stage sees the frames in order
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode1 = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(accumNode1->output, m);
+    auto accumNode2 = model.AddNode<nodes::AccumulatorNode<double>>(productNode->output);
+    auto delayNode = model.AddNode<nodes::DelayNode<double>>(accumNode2->output, 2);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", delayNode->output } });
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 }, { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+    std::vector<std::vector<double>> expected;
+    for (const auto& input : signal)
+    {
+        expected.push_back(map.Compute<double>(input));
+    }
+    map.Reset();
+
+    // Chaining the stage maps by hand computes the original map
+    auto stages = model::SplitMapIntoStages(map, 3);
+    bool stagesOk = stages.size() == 3;
+    for (size_t index = 0; stagesOk && index < signal.size(); ++index)
+    {
+        auto values = signal[index];
+        for (auto& stage : stages)
+        {
+            values = stage.Compute<double>(values);
+        }
+        stagesOk = testing::IsEqual(values, expected[index], 1e-8);
+    }
+    testing::ProcessTest("Testing SplitMapIntoStages", stagesOk);
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::PipelinedCompiledMap pipelinedMap(map, 3, settings, optimizerOptions, 2);
+    auto outputs = pipelinedMap.ComputeStream<double, double>(signal);
+    bool ok = pipelinedMap.NumStages() == 3 && outputs.size() == expected.size();
+    for (size_t index = 0; ok && index < expected.size(); ++index)
+    {
+        ok = testing::IsEqual(outputs[index], expected[index], 1e-8);
+    }
+    testing::ProcessTest("Testing PipelinedCompiledMap", ok);
+
+    // Resetting clears every stage's state, so the same stream gives the same outputs again. The queues only
+    // hold a few frames, so keep a fixed number of them in flight: pop one frame for each one pushed, then drain.
+    pipelinedMap.Reset();
+    const size_t maxFramesInFlight = 4;
+    size_t numPopped = 0;
+    bool resetOk = true;
+    for (const auto& input : signal)
+    {
+        if (pipelinedMap.NumFramesInFlight() == maxFramesInFlight)
+        {
+            resetOk = testing::IsEqual(pipelinedMap.Pop<double>(), expected[numPopped++], 1e-8) && resetOk;
+        }
+        pipelinedMap.Push(input);
+    }
+    while (numPopped < expected.size())
+    {
+        resetOk = testing::IsEqual(pipelinedMap.Pop<double>(), expected[numPopped++], 1e-8) && resetOk;
+    }
+    resetOk = resetOk && pipelinedMap.NumFramesInFlight() == 0;
+    testing::ProcessTest("Testing PipelinedCompiledMap after Reset", resetOk);
+}
+
+void TestSegmentedCompiledMap()
+{
+    math::RowMatrix<double> m{
+        { 1.2, 1.1, 0.8 },
+        { 0.6, 0.9, 1.3 },
+        { 0.3, 1.0, 0.4 },
+        { -.4, 0.2, -.7 }
+    };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode1 = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(accumNode1->output, m);
+    auto accumNode2 = model.AddNode<nodes::AccumulatorNode<double>>(productNode->output);
+    auto delayNode = model.AddNode<nodes::DelayNode<double>>(accumNode2->output, 2);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", delayNode->output } });
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 } };
+    std::vector<std::vector<double>> expected;
+    for (const auto& input : signal)
+    {
+        expected.push_back(map.Compute<double>(input));
+    }
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::SegmentedCompiledMap segmentedMap(map, 3, settings, optimizerOptions, 2);
+    bool ok = segmentedMap.NumSegments() == 3;
+    for (size_t index = 0; ok && index < signal.size(); ++index)
+    {
+        ok = testing::IsEqual(segmentedMap.Compute<double>(signal[index]), expected[index], 1e-8);
+    }
+    testing::ProcessTest("Testing SegmentedCompiledMap", ok);
+
+    segmentedMap.Reset();
+    bool resetOk = true;
+    for (size_t index = 0; index < signal.size(); ++index)
+    {
+        resetOk = testing::IsEqual(segmentedMap.Compute<double>(signal[index]), expected[index], 1e-8) && resetOk;
+    }
+    testing::ProcessTest("Testing SegmentedCompiledMap after Reset", resetOk);
+}
+
 typedef void (*MapPredictFunction)(void* context, double*, double*);
 
 void TestBinaryVector(bool expanded, bool runJit)
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MapTiming.cpp (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MapTiming.h"
+
+#include <emitters/include/TargetDevice.h>
+
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputNode.h>
+#include <model/include/Map.h>
+#include <model/include/MapCompilerOptions.h>
+#include <model/include/Model.h>
+#include <model/include/OutputNode.h>
+#include <model/include/PreparedMap.h>
+
+#include <nodes/include/BinaryOperationNode.h>
+#include <nodes/include/BroadcastFunctionNode.h>
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/DotProductNode.h>
+#include <nodes/include/UnaryOperationNode.h>
+
+#include <testing/include/testing.h>
+
+#include <utilities/include/MillisecondTimer.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ell;
+
+namespace
+{
+// A linear predictor: output = dot(input, weights) + bias. Small enough that graph traversal dominates the cost of computing it.
+model::Map GetLinearPredictorMap(size_t inputSize)
+{
+    model::Model model;
+    const auto& input = model::Input<double>(model, inputSize);
+    const auto& weights = nodes::Constant(model, std::vector<double>(inputSize, 0.5));
+    const auto& bias = nodes::Constant(model, 1.0);
+    const auto& prediction = nodes::Add(nodes::DotProduct(input, weights), bias);
+    const auto& output = model::Output(prediction);
+
+    auto inputNode = model.GetNodesByType<model::InputNode<double>>()[0];
+    return model::Map(model, { { "input", inputNode } }, { { "output", output } });
+}
+
+// Compiles the map with elementwise vectorization on or off and times computing it. Returns the time, in ms.
+std::chrono::milliseconds::rep TimeCompiledMap(const model::Map& map, bool vectorize, int numIterations, const std::vector<float>& input, std::vector<float>& output)
+{
+    model::MapCompilerOptions settings;
+    settings.compilerSettings.optimize = true;
+    settings.compilerSettings.parallelize = false;
+    settings.compilerSettings.vectorizeElementwiseOperations = vectorize;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    compiledMap.FinishJitting();
+
+    std::vector<float> inputCopy(input);
+    utilities::MillisecondTimer timer;
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        compiledMap.ComputeMultiple({ inputCopy.data() }, { output.data() });
+    }
+    return timer.Elapsed();
+}
+
+// A map computing a single elementwise node over an input of the given shape
+model::Map GetElementwiseMap(const model::MemoryShape& shape, std::function<const model::OutputPort<float>&(model::Model&, const model::OutputPort<float>&)> addNode)
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<float>>(shape);
+    const auto& output = addNode(model, inputNode->output);
+    return model::Map(model, { { "input", inputNode } }, { { "output", output } });
+}
+} // namespace
+
+void TimeMapCompute()
+{
+    const size_t inputSize = 4;
+    const int numIterations = 100000;
+
+    auto map = GetLinearPredictorMap(inputSize);
+    model::PreparedMap preparedMap(map);
+    std::vector<double> input(inputSize, 1.0);
+    std::vector<double> output(preparedMap.GetOutputSize());
+
+    utilities::MillisecondTimer timer;
+    double mapResult = 0;
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        input[0] = iter;
+        mapResult = map.Compute<double>(input)[0];
+    }
+    auto mapTime = timer.Elapsed();
+
+    timer.Reset();
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        input[0] = iter;
+        preparedMap.Compute(input.data(), output.data());
+    }
+    auto preparedMapTime = timer.Elapsed();
+
+    std::cout << "Linear predictor with " << preparedMap.NumNodes() << " nodes, " << numIterations << " iterations\n";
+    std::cout << "  Map::Compute:         " << mapTime << " ms (" << (1000.0 * mapTime / numIterations) << " us per call)\n";
+    std::cout << "  PreparedMap::Compute: " << preparedMapTime << " ms (" << (1000.0 * preparedMapTime / numIterations) << " us per call)\n";
+
+    testing::ProcessTest("Prepared map matches map", testing::IsEqual(mapResult, output[0]));
+}
+
+void TimeElementwiseNodeEmission()
+{
+    // The innermost dimension isn't a multiple of any vector width, so the scalar tail loop runs too
+    const model::MemoryShape shape{ 16, 64, 67 };
+    const auto size = static_cast<size_t>(shape.NumElements());
+    const int numIterations = 2000;
+
+    std::vector<std::pair<std::string, model::Map>> maps;
+    maps.emplace_back("BinaryOperationNode (add)", GetElementwiseMap(shape, [](model::Model& model, const model::OutputPort<float>& input) -> const model::OutputPort<float>& {
+                          return nodes::Add(input, nodes::Constant(model, std::vector<float>(input.Size(), 0.5f), input.GetMemoryLayout()));
+                      }));
+    maps.emplace_back("UnaryOperationNode (sqrt)", GetElementwiseMap(shape, [](model::Model&, const model::OutputPort<float>& input) -> const model::OutputPort<float>& {
+                          return nodes::Sqrt(input);
+                      }));
+    maps.emplace_back("BroadcastLinearFunctionNode", GetElementwiseMap(shape, [shape](model::Model& model, const model::OutputPort<float>& input) -> const model::OutputPort<float>& {
+                          auto numChannels = static_cast<size_t>(shape[2]);
+                          const auto& scale = nodes::Constant(model, std::vector<float>(numChannels, 2.0f));
+                          const auto& bias = nodes::Constant(model, std::vector<float>(numChannels, 1.0f));
+                          auto node = model.AddNode<nodes::BroadcastLinearFunctionNode<float>>(input, input.GetMemoryLayout(), scale, bias, 2, input.GetMemoryLayout());
+                          return node->output;
+                      }));
+
+    std::vector<float> input(size);
+    for (size_t index = 0; index < size; ++index)
+    {
+        input[index] = static_cast<float>(index % 100) + 0.25f;
+    }
+
+    std::cout << "Elementwise nodes on a " << shape[0] << "x" << shape[1] << "x" << shape[2] << " tensor, " << numIterations << " iterations, "
+              << emitters::GetTargetDevice("host").GetVectorRegisterSize() << "-byte vector registers\n";
+    for (auto& entry : maps)
+    {
+        std::vector<float> scalarOutput(size);
+        std::vector<float> vectorOutput(size);
+        auto scalarTime = TimeCompiledMap(entry.second, false, numIterations, input, scalarOutput);
+        auto vectorTime = TimeCompiledMap(entry.second, true, numIterations, input, vectorOutput);
+
+        std::cout << "  " << entry.first << ": scalar " << scalarTime << " ms, vector " << vectorTime << " ms\n";
+        testing::ProcessTest("Vectorized " + entry.first + " matches scalar", testing::IsEqual(scalarOutput, vectorOutput, 1e-5f));
+    }
+}
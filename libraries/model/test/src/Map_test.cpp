@@ -18,9 +18,14 @@
 #include <model/include/Map.h>
 #include <model/include/Model.h>
 #include <model/include/OutputNode.h>
+#include <model/include/PreparedMap.h>
 
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/ClockNode.h>
+#include <nodes/include/DelayNode.h>
 #include <nodes/include/ExtremalValueNode.h>
+#include <nodes/include/MatrixMatrixMultiplyNode.h>
+#include <nodes/include/MatrixVectorProductNode.h>
 #include <nodes/include/MovingAverageNode.h>
 #include <nodes/include/SinkNode.h>
 #include <nodes/include/SourceNode.h>
@@ -132,6 +137,166 @@ void TestMapRefine()
     testing::ProcessTest("Testing refined map compute", testing::IsEqual(resultValues1, resultValues2));
 }
 
+void TestMapComputeParallel()
+{
+    // A wide model: 8 independent moving averages of the input, summed pairwise
+    model::Model model;
+    auto in = model.AddNode<model::InputNode<double>>(4);
+    std::vector<const model::OutputPort<double>*> branches;
+    for (size_t index = 0; index < 8; ++index)
+    {
+        branches.push_back(&model.AddNode<nodes::MovingAverageNode<double>>(in->output, index + 1)->output);
+    }
+    while (branches.size() > 1)
+    {
+        std::vector<const model::OutputPort<double>*> sums;
+        for (size_t index = 0; index < branches.size(); index += 2)
+        {
+            sums.push_back(&model.AddNode<nodes::BinaryOperationNode<double>>(*branches[index], *branches[index + 1], nodes::BinaryOperationType::add)->output);
+        }
+        branches = sums;
+    }
+    auto out = model.AddNode<model::OutputNode<double>>(*branches[0]);
+
+    auto serialMap = model::Map(model, { { "input", in } }, { { "output", out->output } });
+    auto parallelMap = model::Map(model, { { "input", in } }, { { "output", out->output } });
+    parallelMap.SetNumComputeThreads(4);
+
+    bool ok = parallelMap.GetNumComputeThreads() == 4;
+    for (int iter = 0; iter < 20; ++iter)
+    {
+        std::vector<double> input = { 1.0 * iter, 2.0 - iter, 3.0, 0.5 * iter };
+        serialMap.SetInputValue("input", input);
+        parallelMap.SetInputValue("input", input);
+        ok = ok && testing::IsEqual(serialMap.ComputeOutput<double>("output"), parallelMap.ComputeOutput<double>("output"));
+    }
+
+    // Copies keep the thread count, and stateful nodes must start over after a reset
+    auto copiedMap = parallelMap;
+    ok = ok && copiedMap.GetNumComputeThreads() == 4;
+    serialMap.Reset();
+    copiedMap.Reset();
+    std::vector<double> input = { 1.0, 2.0, 3.0, 4.0 };
+    serialMap.SetInputValue("input", input);
+    copiedMap.SetInputValue("input", input);
+    ok = ok && testing::IsEqual(serialMap.ComputeOutput<double>("output"), copiedMap.ComputeOutput<double>("output"));
+
+    testing::ProcessTest("Testing parallel map compute", ok);
+}
+
+void TestPreparedMap()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto map = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto referenceMap = map;
+    model::PreparedMap preparedMap(map);
+
+    bool ok = preparedMap.GetInputSize() == 3 && preparedMap.GetOutputSize() == 2;
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 10.0, 11.0, 12.0 } };
+    std::vector<double> output(preparedMap.GetOutputSize());
+    for (const auto& inVec : input)
+    {
+        referenceMap.SetInputValue("doubleInput", inVec);
+        auto expected = referenceMap.ComputeOutput<double>("doubleOutput");
+        preparedMap.Compute(inVec.data(), output.data());
+        ok = ok && testing::IsEqual(expected, output);
+    }
+
+    testing::ProcessTest("Testing prepared map compute", ok && testing::IsEqual(output[0], 8.5) && testing::IsEqual(output[1], 10.5));
+}
+
+void TestMapComputeBatch()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto map = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto referenceMap = map;
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 10.0, 11.0, 12.0 } };
+    auto outputs = map.ComputeBatch<double>(input);
+
+    bool ok = outputs.size() == input.size();
+    for (size_t index = 0; ok && index < input.size(); ++index)
+    {
+        ok = testing::IsEqual(outputs[index], referenceMap.Compute<double>(input[index]));
+    }
+
+    bool threw = false;
+    try
+    {
+        map.ComputeBatch<float>(input);
+    }
+    catch (const utilities::InputException&)
+    {
+        threw = true;
+    }
+
+    testing::ProcessTest("Testing map compute batch", ok && threw && testing::IsEqual(outputs.back(), std::vector<double>{ 8.5, 10.5 }));
+}
+
+void TestMapBatch()
+{
+    math::RowMatrix<double> m{
+        { 1.2, 1.1, 0.8 },
+        { 0.6, 0.9, 1.3 },
+        { 0.3, 1.0, 0.4 },
+        { -.4, 0.2, -.7 }
+    };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(inputNode->output, m);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+    auto referenceMap = map;
+
+    const int batchSize = 4;
+    map.Refine();
+    map.Batch(batchSize, model::TransformContext{});
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 3.0, 4.0, 5.0 } };
+    std::vector<double> batchInput;
+    std::vector<double> expectedOutput;
+    for (const auto& example : input)
+    {
+        batchInput.insert(batchInput.end(), example.begin(), example.end());
+        auto output = referenceMap.Compute<double>(example);
+        expectedOutput.insert(expectedOutput.end(), output.begin(), output.end());
+    }
+
+    bool ok = map.GetInputSize(0) == 3 * batchSize && map.GetOutputSize(0) == 4 * batchSize;
+    ok = ok && !map.GetModel().GetNodesByType<nodes::MatrixMatrixMultiplyNode<double>>().empty();
+    ok = ok && testing::IsEqual(map.Compute<double>(batchInput), expectedOutput, 1e-8);
+
+    // A node that depends on earlier examples can't be batched, and the map is left as it was
+    model::Model statefulModel;
+    auto statefulInputNode = statefulModel.AddNode<model::InputNode<double>>(3);
+    auto delayNode = statefulModel.AddNode<nodes::DelayNode<double>>(statefulInputNode->output, 2);
+    auto statefulMap = model::Map(statefulModel, { { "input", statefulInputNode } }, { { "output", delayNode->output } });
+    bool threw = false;
+    try
+    {
+        statefulMap.Batch(batchSize, model::TransformContext{});
+    }
+    catch (const utilities::LogicException&)
+    {
+        threw = true;
+    }
+
+    testing::ProcessTest("Testing map batch", ok && threw && statefulMap.GetInputSize(0) == 3);
+}
+
 void TestMapSerialization(const model::Map& map)
 {
     std::stringstream outStream;
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortBufferPlanner_test.cpp (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PortBufferPlanner_test.h"
+
+#include <model/include/PortBufferPlanner.h>
+
+#include <testing/include/testing.h>
+
+#include <vector>
+
+using namespace ell;
+using namespace ell::model;
+
+namespace
+{
+// Checks that no two buffers that are live at the same time share memory
+bool IsValidPlan(const std::vector<BufferLifetime>& buffers, const BufferPlan& plan)
+{
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        if (plan.offsets[i] + buffers[i].size > plan.arenaSize)
+        {
+            return false;
+        }
+
+        for (size_t j = i + 1; j < buffers.size(); ++j)
+        {
+            bool liveTogether = buffers[i].firstUse <= buffers[j].lastUse && buffers[j].firstUse <= buffers[i].lastUse;
+            bool shareMemory = plan.offsets[i] < plan.offsets[j] + buffers[j].size && plan.offsets[j] < plan.offsets[i] + buffers[i].size;
+            if (liveTogether && shareMemory)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+void TestPlanBufferReuseChain()
+{
+    // A linear chain: each buffer is written by one node and read by the next
+    std::vector<BufferLifetime> buffers = { { 400, 0, 1 }, { 400, 1, 2 }, { 400, 2, 3 }, { 400, 3, 4 }, { 400, 4, 5 } };
+    auto plan = PlanBufferReuse(buffers, 4);
+
+    testing::ProcessTest("Testing PlanBufferReuse on a chain produces a valid plan", IsValidPlan(buffers, plan));
+    testing::ProcessTest("Testing PlanBufferReuse on a chain total size", testing::IsEqual(plan.totalSize, size_t{ 2000 }));
+    testing::ProcessTest("Testing PlanBufferReuse on a chain needs only two buffers", testing::IsEqual(plan.arenaSize, size_t{ 800 }));
+}
+
+void TestPlanBufferReuseOverlapping()
+{
+    // A wide buffer that stays live while a couple of smaller ones come and go
+    std::vector<BufferLifetime> buffers = { { 100, 0, 4 }, { 300, 1, 2 }, { 200, 3, 4 }, { 50, 2, 3 }, { 300, 5, 6 } };
+    auto plan = PlanBufferReuse(buffers, 1);
+
+    testing::ProcessTest("Testing PlanBufferReuse on overlapping lifetimes produces a valid plan", IsValidPlan(buffers, plan));
+    testing::ProcessTest("Testing PlanBufferReuse on overlapping lifetimes saves memory", plan.arenaSize < plan.totalSize);
+    testing::ProcessTest("Testing PlanBufferReuse on overlapping lifetimes arena size", testing::IsEqual(plan.arenaSize, size_t{ 450 }));
+}
+
+void TestPlanBufferReuseAlignment()
+{
+    std::vector<BufferLifetime> buffers = { { 10, 0, 2 }, { 20, 1, 3 }, { 30, 2, 2 } };
+    auto plan = PlanBufferReuse(buffers, 32);
+
+    bool aligned = true;
+    for (auto offset : plan.offsets)
+    {
+        aligned = aligned && (offset % 32 == 0);
+    }
+    testing::ProcessTest("Testing PlanBufferReuse produces a valid aligned plan", IsValidPlan(buffers, plan));
+    testing::ProcessTest("Testing PlanBufferReuse aligns offsets", aligned);
+    testing::ProcessTest("Testing PlanBufferReuse aligned arena size", testing::IsEqual(plan.arenaSize, size_t{ 96 }));
+}
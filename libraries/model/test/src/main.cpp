@@ -16,6 +16,7 @@
 #include "ModelOptimizerOptions_test.h"
 #include "ModelTransformerTest.h"
 #include "Model_test.h"
+#include "PortBufferPlanner_test.h"
 #include "PortElements_test.h"
 #include "Submodel_test.h"
 
@@ -49,10 +50,19 @@ int main()
         TestParsePortElements();
         TestConvertPortElements();
 
+        // PortBufferPlanner tests
+        TestPlanBufferReuseChain();
+        TestPlanBufferReuseOverlapping();
+        TestPlanBufferReuseAlignment();
+
         // Map tests
         TestMapCreate();
         TestMapCompute();
         TestMapComputeDataVector();
+        TestMapComputeParallel();
+        TestPreparedMap();
+        TestMapComputeBatch();
+        TestMapBatch();
         TestMapRefine();
         TestMapSerialization();
         TestMapClockNode();
@@ -36,6 +36,11 @@ void TestMatrixMatrixMultiplyCodeNodeImplementations()
     TestMatrixMatrixMultiplyCodeNode(4, 4, 4, fallbackPanelM, fallbackPanelN, fallbackPanelK, fallbackKernelM, fallbackKernelN, fallbackKernelK, nodes::MatrixMatrixMultiplyImplementation::SimpleForLoops);
     TestMatrixMatrixMultiplyCodeNode(4, 8, 8, fallbackPanelM, fallbackPanelN, fallbackPanelK, fallbackKernelM, fallbackKernelN, fallbackKernelK, nodes::MatrixMatrixMultiplyImplementation::SimpleForLoops);
     TestMatrixMatrixMultiplyCodeNode(4, 4, 8, fallbackPanelM, fallbackPanelN, fallbackPanelK, fallbackKernelM, fallbackKernelN, fallbackKernelK, nodes::MatrixMatrixMultiplyImplementation::SimpleForLoops);
+
+    // Loop nest implementation with a constant right-hand matrix, which gets packed at compile time
+    TestMatrixMatrixMultiplyCodeNodeWithConstantInput2(4, 64, 300); // single-threaded, with a partial block of rows
+    TestMatrixMatrixMultiplyCodeNodeWithConstantInput2(8, 256, 256); // parallelized over columns
+    TestMatrixMatrixMultiplyCodeNodeWithConstantInput2(256, 64, 32); // parallelized over rows
 }
 
 void TestIRCompiler()
@@ -71,6 +76,15 @@ void TestIRCompiler()
     TestCompiledMapMove();
     TestCompiledMapClone();
     TestCompiledMapParallelClone();
+    TestCompiledMapReentrantClone();
+    TestReusePortBuffers();
+    TestCompiledMapComputeBatch(false);
+    TestCompiledMapComputeBatch(true);
+    TestCompiledMapComputeBatch(true, 2);
+    TestCompiledMapObjectCache();
+    TestCompiledMapCpuDispatch();
+    TestPipelinedCompiledMap();
+    TestSegmentedCompiledMap();
 
     TestBinaryScalar();
     TestBinaryVector(true);
@@ -100,6 +114,12 @@ void TestIRCompiler()
 #endif
     TestMatrixMatrixMultiplyNode(4, 5, 6, false);
 
+    TestMatrixVectorMultiplyNodeWithReducedPrecisionWeights(6, 7);
+    TestMatrixMatrixMultiplyNodeWithReducedPrecisionWeights(4, 5, 6);
+    TestQuantizedMatrixMatrixMultiplyNode(4, 5, 6);
+    TestQuantizedMatrixMatrixMultiplyNode(3, 10, 37); // full and partial column blocks and k vectors
+    TestQuantizedConvolutionNode();
+
 #ifdef USE_BLAS
     // Using BLAS
     TestOrderedMatrixMatrixMultiplyNode(4, 5, 6, false, false, false, true);
@@ -270,6 +290,15 @@ void TestIRCompiler()
     TestConvolutionalLayerNode2(ConvolutionMethod::winograd, 1, 0);
     TestConvolutionalLayerNode3(ConvolutionMethod::winograd, 1, 0);
 
+    TestConvolutionalLayerNode(ConvolutionMethod::tiled, 1, 0);
+    TestConvolutionalLayerNode3(ConvolutionMethod::tiled, 1, 0);
+    TestTiledConvolutionNode(1);
+    TestTiledConvolutionNode(2);
+    TestGroupedConvolutionalLayerNode(3);
+    TestGroupedConvolutionalLayerNode(4);
+    TestGroupedConvolutionalLayerNode(12);
+    TestSpatialConvolutionNodeInterleaved(70);
+
 	//BUGBUG: This test currently fails for Compute but passes for Compile.
 	//TestSpatialConvolutionNode(1, 0);
 
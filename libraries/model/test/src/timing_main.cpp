@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     timing_main.cpp (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MapTiming.h"
+
+#include <testing/include/testing.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Unused.h>
+
+#include <iostream>
+
+using namespace ell;
+
+/// Runs all timings
+///
+int main(int argc, char** argv)
+{
+    UNUSED(argc);
+    UNUSED(argv);
+    try
+    {
+        TimeMapCompute();
+        TimeElementwiseNodeEmission();
+    }
+    catch (const utilities::Exception& exception)
+    {
+        std::cerr << "ERROR, got ELL exception. Message: " << exception.GetMessage() << std::endl;
+        throw;
+    }
+
+    if (testing::DidTestFail())
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -19,6 +19,7 @@
 #include <model/include/PortElements.h>
 #include <model/include/PortMemoryLayout.h>
 
+#include <emitters/include/IRVectorUtilities.h>
 #include <emitters/include/LLVMUtilities.h>
 
 #include <utilities/include/ArchiveVersion.h>
@@ -26,6 +27,7 @@
 #include <utilities/include/IArchivable.h>
 #include <utilities/include/TypeName.h>
 
+#include <algorithm>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -121,6 +123,7 @@ namespace nodes
 
         void CompileLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
         void CompileExpanded(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
+        int GetVectorSize(const emitters::IRFunctionEmitter& function) const;
         void EmitComputeDimensionLoop(model::IRMapCompiler& compiler,
                                       emitters::IRFunctionEmitter& function,
                                       size_t dimension,
@@ -131,10 +134,12 @@ namespace nodes
                                       emitters::LLVMValue prevInput2DimensionOffset,
                                       emitters::LLVMValue prevOutputDimensionOffset) const;
         template <typename Operation>
-        std::vector<ValueType> ComputeOutput(Operation&& function) const;
+        void ComputeOutput(Operation&& function) const;
         template <typename Operation>
         void ComputeDimensionLoop(Operation& function,
                                   size_t dimension,
+                                  const std::vector<ValueType>& input1,
+                                  const std::vector<ValueType>& input2,
                                   std::vector<ValueType>& output,
                                   size_t prevInput1DimensionOffset,
                                   size_t prevInput2DimensionOffset,
@@ -462,60 +467,59 @@ namespace nodes
 
     template <typename ValueType>
     template <typename Operation>
-    std::vector<ValueType> BinaryOperationNode<ValueType>::ComputeOutput(Operation&& function) const
+    void BinaryOperationNode<ValueType>::ComputeOutput(Operation&& function) const
     {
         auto outputLayout = _output.GetMemoryLayout();
         auto outputSize = outputLayout.GetExtent().NumElements();
-        auto output = std::vector<ValueType>(outputSize);
+
+        // Compute directly into the port's storage, which is reused from call to call
+        auto& output = _output.GetOutputBuffer(outputSize);
+        std::fill(output.begin(), output.end(), static_cast<ValueType>(0));
 
         const size_t prevInput1Offset = 0;
         const size_t prevInput2Offset = 0;
         const size_t prevOutputOffset = 0;
-        ComputeDimensionLoop(function, 0, output, prevInput1Offset, prevInput2Offset, prevOutputOffset);
-
-        return output;
+        ComputeDimensionLoop(function, 0, _input1.GetValueReference(), _input2.GetValueReference(), output, prevInput1Offset, prevInput2Offset, prevOutputOffset);
     }
 
     template <typename ValueType>
     void BinaryOperationNode<ValueType>::Compute() const
     {
-        std::vector<ValueType> output;
         switch (_operation)
         {
         case BinaryOperationType::add:
-            output = ComputeOutput(BinaryOperations::Add<ValueType>);
+            ComputeOutput(BinaryOperations::Add<ValueType>);
             break;
         case BinaryOperationType::subtract:
-            output = ComputeOutput(BinaryOperations::Subtract<ValueType>);
+            ComputeOutput(BinaryOperations::Subtract<ValueType>);
             break;
         case BinaryOperationType::multiply:
-            output = ComputeOutput(BinaryOperations::Multiply<ValueType>);
+            ComputeOutput(BinaryOperations::Multiply<ValueType>);
             break;
         case BinaryOperationType::divide:
-            output = ComputeOutput(BinaryOperations::Divide<ValueType>);
+            ComputeOutput(BinaryOperations::Divide<ValueType>);
             break;
         case BinaryOperationType::modulo:
-            output = ComputeOutput(BinaryOperations::Modulo<ValueType>);
+            ComputeOutput(BinaryOperations::Modulo<ValueType>);
             break;
         case BinaryOperationType::logicalAnd:
-            output = ComputeOutput(BinaryOperations::LogicalAnd<ValueType>);
+            ComputeOutput(BinaryOperations::LogicalAnd<ValueType>);
             break;
         case BinaryOperationType::logicalOr:
-            output = ComputeOutput(BinaryOperations::LogicalOr<ValueType>);
+            ComputeOutput(BinaryOperations::LogicalOr<ValueType>);
             break;
         case BinaryOperationType::logicalXor:
-            output = ComputeOutput(BinaryOperations::LogicalXor<ValueType>);
+            ComputeOutput(BinaryOperations::LogicalXor<ValueType>);
             break;
         case BinaryOperationType::maximum:
-            output = ComputeOutput(BinaryOperations::Maximum<ValueType>);
+            ComputeOutput(BinaryOperations::Maximum<ValueType>);
             break;
         case BinaryOperationType::minimum:
-            output = ComputeOutput(BinaryOperations::Minimum<ValueType>);
+            ComputeOutput(BinaryOperations::Minimum<ValueType>);
             break;
         default:
             throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Unknown operation type");
         }
-        _output.SetOutput(output);
     };
 
     template <typename ValueType>
@@ -564,11 +568,30 @@ namespace nodes
         emitters::LLVMValue pResult = compiler.EnsurePortEmitted(output);
 
         auto count = input1.Size();
-        function.VectorOperator(emitters::GetOperator<ValueType>(ToEmitterType(GetOperation())), count, pInput1, pInput2, [&pResult, &function](emitters::LLVMValue i, emitters::LLVMValue pValue) {
-            function.SetValueAt(pResult, i, pValue);
+        auto op = emitters::GetOperator<ValueType>(ToEmitterType(GetOperation()));
+        emitters::VectorizedFor(function, static_cast<int>(count), GetVectorSize(function), [pInput1, pInput2, pResult, op](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar i, int width) {
+            auto value1 = emitters::LoadVector(function, pInput1, i, width);
+            auto value2 = emitters::LoadVector(function, pInput2, i, width);
+            emitters::StoreVector(function, pResult, i, function.Operator(op, value1, value2));
         });
     }
 
+    template <typename ValueType>
+    int BinaryOperationNode<ValueType>::GetVectorSize(const emitters::IRFunctionEmitter& function) const
+    {
+        // Only the arithmetic operations are emitted as single LLVM instructions that work on vectors
+        switch (GetOperation())
+        {
+        case BinaryOperationType::add:
+        case BinaryOperationType::subtract:
+        case BinaryOperationType::multiply:
+        case BinaryOperationType::divide:
+            return std::is_same_v<ValueType, bool> ? 1 : emitters::GetElementwiseVectorWidth<ValueType>(function.GetCompilerOptions());
+        default:
+            return 1;
+        }
+    }
+
     template <typename ValueType>
     void BinaryOperationNode<ValueType>::CompileExpanded(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
@@ -609,6 +632,8 @@ namespace nodes
     template <typename Operation>
     void BinaryOperationNode<ValueType>::ComputeDimensionLoop(Operation& function,
                                                               size_t dimension,
+                                                              const std::vector<ValueType>& input1,
+                                                              const std::vector<ValueType>& input2,
                                                               std::vector<ValueType>& output,
                                                               size_t prevInput1DimensionOffset,
                                                               size_t prevInput2DimensionOffset,
@@ -644,13 +669,13 @@ namespace nodes
             if (static_cast<int>(dimension) < numDimensions - 1)
             {
                 // Recursive call to emit nested loop
-                ComputeDimensionLoop(function, dimension + 1, output, thisInput1DimensionOffset, thisInput2DimensionOffset, thisOutputDimensionOffset);
+                ComputeDimensionLoop(function, dimension + 1, input1, input2, output, thisInput1DimensionOffset, thisInput2DimensionOffset, thisOutputDimensionOffset);
             }
             else
             {
                 // We're in the innermost loop --- compute the value
-                auto value1 = _input1[thisInput1DimensionOffset];
-                auto value2 = _input2[thisInput2DimensionOffset];
+                auto value1 = input1[thisInput1DimensionOffset];
+                auto value2 = input2[thisInput2DimensionOffset];
                 auto outputValue = function(value1, value2);
                 output[thisOutputDimensionOffset] = outputValue;
             }
@@ -678,7 +703,9 @@ namespace nodes
         auto&& outputStride = outputLayout.GetExtent();
         auto&& outputOffset = outputLayout.GetOffset();
 
-        function.For(inputSize[dimension], [input1, input2, output, inputOffset1, inputOffset2, inputStride1, inputStride2, outputStride, outputOffset, prevInput1DimensionOffset, prevInput2DimensionOffset, prevOutputDimensionOffset, dimension, numDimensions, &compiler, this](emitters::IRFunctionEmitter& function, emitters::LLVMValue loopIndex) {
+        // The innermost dimension is contiguous, so it's processed a vector at a time
+        const int vectorSize = static_cast<int>(dimension) == numDimensions - 1 ? GetVectorSize(function) : 1;
+        emitters::VectorizedFor(function, inputSize[dimension], vectorSize, [input1, input2, output, inputOffset1, inputOffset2, inputStride1, inputStride2, outputStride, outputOffset, prevInput1DimensionOffset, prevInput2DimensionOffset, prevOutputDimensionOffset, dimension, numDimensions, &compiler, this](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar loopIndex, int width) {
             // Calculate the offset within this dimension = (loopIndex + offset[dimension])
             emitters::LLVMValue thisInput1DimensionInternalOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(inputOffset1[dimension]));
             emitters::LLVMValue thisInput2DimensionInternalOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(inputOffset2[dimension]));
@@ -717,11 +744,11 @@ namespace nodes
             }
             else
             {
-                // We're in the innermost loop --- compute the value
-                auto value1 = function.ValueAt(input1, thisInput1DimensionOffset);
-                auto value2 = function.ValueAt(input2, thisInput2DimensionOffset);
+                // We're in the innermost loop --- compute the values
+                auto value1 = emitters::LoadVector(function, input1, thisInput1DimensionOffset, width);
+                auto value2 = emitters::LoadVector(function, input2, thisInput2DimensionOffset, width);
                 auto outputValue = function.Operator(emitters::GetOperator<ValueType>(ToEmitterType(GetOperation())), value1, value2);
-                function.SetValueAt(output, thisOutputDimensionOffset, outputValue);
+                emitters::StoreVector(function, output, thisOutputDimensionOffset, outputValue);
             }
         });
     }
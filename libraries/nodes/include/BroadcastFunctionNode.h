@@ -26,6 +26,7 @@
 #include <utilities/include/Exception.h>
 #include <utilities/include/TypeName.h>
 
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <string>
@@ -248,6 +249,12 @@ namespace nodes
         size_t GetBroadcastDimension() const { return _broadcastDimension; }
         size_t NumPrimaryInputDimensions() const { return GetInputMemoryLayout().NumDimensions(); }
 
+        /// <summary> Returns the function applied to each element </summary>
+        FunctionType GetFunction() const { return _function; }
+
+        /// <summary> Returns the value the output's padding is filled with </summary>
+        ValueType GetOutputPadding() const { return _paddingValue; }
+
     protected:
         BroadcastFunctionNode(const std::vector<model::InputPortBase*>& inputs, const std::vector<model::OutputPortBase*>& outputs);
 
@@ -265,7 +272,10 @@ namespace nodes
         virtual const model::InputPort<ValueType>* GetSecondaryInput(int index) const = 0;
         virtual const model::OutputPort<ValueType>& GetOutput() const = 0;
         bool IsSecondaryInputPresent(int index) const;
-        FunctionType GetFunction() const { return _function; }
+
+        // Indicates if the node can compute a batch of examples: the primary input has to hold the batch, as examples
+        // with the input layout stored one after another, and the secondary inputs have to be shared by every example
+        bool CanBatch(const model::ModelTransformer& transformer) const;
 
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
@@ -273,19 +283,21 @@ namespace nodes
         // Helpers for generating nested loops to visit all input/output values
         void ComputeDimensionLoop(size_t dimension, std::vector<ValueType>& output, size_t prevInputDimensionOffset, size_t prevOutputDimensionOffset, std::vector<ValueType>& secondaryValues) const;
         void EmitComputeDimensionLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function, size_t dimension, emitters::IRLocalScalar begin, emitters::IRLocalScalar end, emitters::LLVMValue primaryInput, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, std::vector<emitters::LLVMValue>& secondaryValues) const;
+        void EmitVectorizedInnerLoop(emitters::IRFunctionEmitter& function, int vectorSize, emitters::LLVMValue primaryInput, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, const std::vector<emitters::LLVMValue>& secondaryValues) const;
         emitters::IRFunctionEmitter GetTaskFunction(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function, const emitters::LLVMTypeList& portTypes) const;
 
         void WriteToArchive(utilities::Archiver& archiver) const override;
         void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
-        ValueType GetOutputPadding() const { return _paddingValue; }
-
     private:
         model::PortMemoryLayout _inputLayout;
         size_t _broadcastDimension = 0;
 
         FunctionType _function;
         ValueType _paddingValue;
+
+        // Scratch space for `Compute`, kept between calls to avoid allocating
+        mutable std::vector<ValueType> _secondaryValues;
     };
 
     //
@@ -334,10 +346,10 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputMemoryLayout;
         using BroadcastFunctionNode<ValueType, FunctionType>::GetBroadcastDimension;
         using BroadcastFunctionNode<ValueType, FunctionType>::NumPrimaryInputDimensions;
-
-    protected:
         using BroadcastFunctionNode<ValueType, FunctionType>::GetFunction;
+        using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputPadding;
 
+    protected:
         utilities::ArchiveVersion GetArchiveVersion() const override;
         bool CanReadArchiveVersion(const utilities::ArchiveVersion& version) const override;
         void WriteToArchive(utilities::Archiver& archiver) const override;
@@ -352,6 +364,7 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::EmitComputeDimensionLoop;
 
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::ModelTransformer& transformer) const override;
 
         // Inputs
         model::InputPort<ValueType> _primaryInput;
@@ -408,9 +421,10 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputMemoryLayout;
         using BroadcastFunctionNode<ValueType, FunctionType>::GetBroadcastDimension;
         using BroadcastFunctionNode<ValueType, FunctionType>::NumPrimaryInputDimensions;
+        using BroadcastFunctionNode<ValueType, FunctionType>::GetFunction;
+        using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputPadding;
 
     protected:
-        using BroadcastFunctionNode<ValueType, FunctionType>::GetFunction;
         using BroadcastFunctionNode<ValueType, FunctionType>::NumElements;
 
         void WriteToArchive(utilities::Archiver& archiver) const override;
@@ -425,6 +439,7 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::EmitComputeDimensionLoop;
 
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::ModelTransformer& transformer) const override;
 
         // Inputs
         model::InputPort<ValueType> _primaryInput;
@@ -484,10 +499,10 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputMemoryLayout;
         using BroadcastFunctionNode<ValueType, FunctionType>::GetBroadcastDimension;
         using BroadcastFunctionNode<ValueType, FunctionType>::NumPrimaryInputDimensions;
-
-    protected:
         using BroadcastFunctionNode<ValueType, FunctionType>::GetFunction;
+        using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputPadding;
 
+    protected:
         void WriteToArchive(utilities::Archiver& archiver) const override;
         void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
@@ -500,6 +515,7 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::EmitComputeDimensionLoop;
 
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::ModelTransformer& transformer) const override;
 
         // Inputs
         model::InputPort<ValueType> _primaryInput;
@@ -551,6 +567,7 @@ namespace nodes
 
     private:
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::ModelTransformer& transformer) const override;
     };
 
     // Factory functions
@@ -689,6 +706,25 @@ namespace nodes
         return GetOutputPort(0)->GetMemoryLayout();
     }
 
+    template <typename ValueType, typename FunctionType>
+    bool BroadcastFunctionNode<ValueType, FunctionType>::CanBatch(const model::ModelTransformer& transformer) const
+    {
+        const auto& primaryInput = GetPrimaryInput();
+        if (!transformer.IsBatched(primaryInput) || primaryInput.Size() != GetInputMemoryLayout().GetMemorySize())
+        {
+            return false;
+        }
+
+        for (int index = 0; index < NumSecondaryInputs(); ++index)
+        {
+            if (IsSecondaryInputPresent(index) && transformer.IsBatched(*GetSecondaryInput(index)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     //
     // Arbitrary-depth nested loops are generated recursively. The EmitComputeDimensionLoop
     // function emits `numDimensions` nested loops of the form:
@@ -725,7 +761,7 @@ namespace nodes
         auto&& outputLayout = GetOutputMemoryLayout();
         auto&& outputStride = outputLayout.GetExtent();
         auto&& outputOffset = outputLayout.GetOffset();
-        auto&& primaryInput = GetPrimaryInput();
+        auto&& primaryInput = GetPrimaryInput().GetValueReference();
         const auto broadcastDimension = GetBroadcastDimension();
         const auto numSecondaryInputs = NumSecondaryInputs();
 
@@ -858,6 +894,18 @@ namespace nodes
         const auto broadcastDimension = GetBroadcastDimension();
         const auto numSecondaryInputs = NumSecondaryInputs();
 
+        // The innermost dimension is contiguous, so it's processed a vector at a time. Its loop bounds are only known
+        // at compile time when it isn't also the outermost dimension (which may be split among parallel tasks).
+        if (dimension > 0 && dimension == numDimensions - 1 && GetFunction().CanUseVectorTypes())
+        {
+            const int vectorSize = emitters::GetElementwiseVectorWidth<ValueType>(function.GetCompilerOptions());
+            if (vectorSize > 1)
+            {
+                EmitVectorizedInnerLoop(function, vectorSize, primaryInput, secondaryInputs, output, prevInputDimensionOffset, prevOutputDimensionOffset, secondaryValues);
+                return;
+            }
+        }
+
         function.For(begin, end, [dimension, numDimensions, inputSize, inputOffset, inputStride, outputOffset, outputStride, broadcastDimension, numSecondaryInputs, prevInputDimensionOffset, prevOutputDimensionOffset, primaryInput, secondaryInputs, output, &secondaryValues, &compiler, this](emitters::IRFunctionEmitter& function, auto loopIndex) {
             // Calculate the offset within this dimension = (loopIndex + offset[dimension])
             auto thisInputDimensionInternalOffset = loopIndex + inputOffset[dimension];
@@ -907,6 +955,42 @@ namespace nodes
         });
     }
 
+    template <typename ValueType, typename FunctionType>
+    void BroadcastFunctionNode<ValueType, FunctionType>::EmitVectorizedInnerLoop(emitters::IRFunctionEmitter& function, int vectorSize, emitters::LLVMValue primaryInput, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, const std::vector<emitters::LLVMValue>& secondaryValues) const
+    {
+        const auto dimension = NumPrimaryInputDimensions() - 1;
+        auto&& inputLayout = GetInputMemoryLayout();
+        auto&& inputStride = inputLayout.GetExtent();
+        auto&& inputOffset = inputLayout.GetOffset();
+        auto&& inputSize = inputLayout.GetActiveSize();
+        auto&& outputLayout = GetOutputMemoryLayout();
+        auto&& outputStride = outputLayout.GetExtent();
+        auto&& outputOffset = outputLayout.GetOffset();
+        const auto broadcastDimension = GetBroadcastDimension();
+        const auto numSecondaryInputs = NumSecondaryInputs();
+
+        emitters::VectorizedFor(function, inputSize[dimension], vectorSize, [=](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar loopIndex, int width) {
+            auto thisInputDimensionOffset = (loopIndex + inputOffset[dimension]) + (prevInputDimensionOffset * inputStride[dimension]);
+            auto thisOutputDimensionOffset = (loopIndex + outputOffset[dimension]) + (prevOutputDimensionOffset * outputStride[dimension]);
+
+            // Secondary values along the innermost dimension are contiguous too. Otherwise, an outer loop already
+            // loaded them, and they're the same for every element of the vector.
+            std::vector<emitters::LLVMValue> vectorSecondaryValues(numSecondaryInputs, nullptr);
+            for (int index = 0; index < numSecondaryInputs; ++index)
+            {
+                if (!this->IsSecondaryInputPresent(index))
+                {
+                    continue;
+                }
+                vectorSecondaryValues[index] = dimension == broadcastDimension ? emitters::LoadVector(function, secondaryInputs[index], loopIndex, width) : emitters::SplatVector(function, secondaryValues[index], width);
+            }
+
+            auto primaryValue = emitters::LoadVector(function, primaryInput, thisInputDimensionOffset, width);
+            auto outputValue = this->GetFunction().Compile(function, primaryValue, vectorSecondaryValues);
+            emitters::StoreVector(function, output, thisOutputDimensionOffset, outputValue);
+        });
+    }
+
     template <typename ValueType, typename FunctionType>
     bool BroadcastFunctionNode<ValueType, FunctionType>::IsSecondaryInputPresent(int index) const
     {
@@ -925,14 +1009,15 @@ namespace nodes
     void BroadcastFunctionNode<ValueType, FunctionType>::Compute() const
     {
         auto outputSize = GetOutputMemoryLayout().GetExtent().NumElements();
-        auto output = std::vector<ValueType>(outputSize);
+
+        // Compute directly into the port's storage, which is reused from call to call
+        auto& output = GetOutput().GetOutputBuffer(outputSize);
+        std::fill(output.begin(), output.end(), static_cast<ValueType>(0));
 
         const size_t prevInputOffset = 0;
         const size_t prevOutputOffset = 0;
-        std::vector<ValueType> secondaryValues(NumSecondaryInputs(), static_cast<ValueType>(0));
-        ComputeDimensionLoop(0, output, prevInputOffset, prevOutputOffset, secondaryValues);
-
-        GetOutput().SetOutput(output);
+        _secondaryValues.assign(NumSecondaryInputs(), static_cast<ValueType>(0));
+        ComputeDimensionLoop(0, output, prevInputOffset, prevOutputOffset, _secondaryValues);
     }
 
     template <typename ValueType, typename FunctionType>
@@ -1100,6 +1185,25 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType, typename FunctionType>
+    bool BroadcastUnaryFunctionNode<ValueType, FunctionType>::Batch(model::ModelTransformer& transformer) const
+    {
+        if (!this->CanBatch(transformer))
+        {
+            return false;
+        }
+
+        const auto& primaryInputElements = transformer.GetCorrespondingInputs(_primaryInput);
+        const auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<BroadcastUnaryFunctionNode<ValueType, FunctionType>>(primaryInputElements,
+                                                                                                model::GetBatchedMemoryLayout(this->GetInputMemoryLayout(), batchSize),
+                                                                                                model::GetBatchedMemoryLayout(this->GetOutputMemoryLayout(), batchSize),
+                                                                                                GetFunction(),
+                                                                                                GetOutputPadding());
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType, typename FunctionType>
     utilities::ArchiveVersion BroadcastUnaryFunctionNode<ValueType, FunctionType>::GetArchiveVersion() const
     {
@@ -1189,6 +1293,29 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType, typename FunctionType>
+    bool BroadcastBinaryFunctionNode<ValueType, FunctionType>::Batch(model::ModelTransformer& transformer) const
+    {
+        if (!this->CanBatch(transformer))
+        {
+            return false;
+        }
+
+        // The batch is the outermost dimension, so the secondary input lies along the next one out from where it did
+        const auto& primaryInputElements = transformer.GetCorrespondingInputs(_primaryInput);
+        const auto& secondaryInputElements = transformer.GetCorrespondingInputs(_secondaryInput);
+        const auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<BroadcastBinaryFunctionNode<ValueType, FunctionType>>(primaryInputElements,
+                                                                                                 model::GetBatchedMemoryLayout(this->GetInputMemoryLayout(), batchSize),
+                                                                                                 secondaryInputElements,
+                                                                                                 this->GetBroadcastDimension() + 1,
+                                                                                                 model::GetBatchedMemoryLayout(this->GetOutputMemoryLayout(), batchSize),
+                                                                                                 GetFunction(),
+                                                                                                 GetOutputPadding());
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType, typename FunctionType>
     void BroadcastBinaryFunctionNode<ValueType, FunctionType>::WriteToArchive(utilities::Archiver& archiver) const
     {
@@ -1278,6 +1405,30 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType, typename FunctionType>
+    bool BroadcastTernaryFunctionNode<ValueType, FunctionType>::Batch(model::ModelTransformer& transformer) const
+    {
+        if (!this->CanBatch(transformer))
+        {
+            return false;
+        }
+
+        const auto& primaryInputElements = transformer.GetCorrespondingInputs(_primaryInput);
+        const auto& secondaryInput1Elements = transformer.GetCorrespondingInputs(_secondaryInput1);
+        const auto& secondaryInput2Elements = transformer.GetCorrespondingInputs(_secondaryInput2);
+        const auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<BroadcastTernaryFunctionNode<ValueType, FunctionType>>(primaryInputElements,
+                                                                                                  model::GetBatchedMemoryLayout(this->GetInputMemoryLayout(), batchSize),
+                                                                                                  secondaryInput1Elements,
+                                                                                                  secondaryInput2Elements,
+                                                                                                  this->GetBroadcastDimension() + 1,
+                                                                                                  model::GetBatchedMemoryLayout(this->GetOutputMemoryLayout(), batchSize),
+                                                                                                  GetFunction(),
+                                                                                                  GetOutputPadding());
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType, typename FunctionType>
     void BroadcastTernaryFunctionNode<ValueType, FunctionType>::WriteToArchive(utilities::Archiver& archiver) const
     {
@@ -1341,6 +1492,29 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool BroadcastLinearFunctionNode<ValueType>::Batch(model::ModelTransformer& transformer) const
+    {
+        if (!this->CanBatch(transformer))
+        {
+            return false;
+        }
+
+        const auto& primaryInputElements = transformer.GetCorrespondingInputs(primaryInput);
+        const auto& scaleInputElements = transformer.GetCorrespondingInputs(secondaryInput1);
+        const auto& biasInputElements = transformer.GetCorrespondingInputs(secondaryInput2);
+        const auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<BroadcastLinearFunctionNode<ValueType>>(primaryInputElements,
+                                                                                   model::GetBatchedMemoryLayout(this->GetInputMemoryLayout(), batchSize),
+                                                                                   scaleInputElements,
+                                                                                   biasInputElements,
+                                                                                   this->GetBroadcastDimension() + 1,
+                                                                                   model::GetBatchedMemoryLayout(this->GetOutputMemoryLayout(), batchSize),
+                                                                                   this->GetOutputPadding());
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     // Factory functions
     template <typename FunctionType, typename ValueType>
     const model::OutputPort<ValueType>& BroadcastUnaryFunction(const model::OutputPort<ValueType>& input,
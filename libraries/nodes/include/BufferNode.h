@@ -63,6 +63,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // window of earlier inputs
+
         /// <summary> Return the window size </summary>
         ///
         /// <returns> The window size </returns>
@@ -51,6 +51,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // time of the last interval
+
         /// <summary> Sets the interval for this node. </summary>
         ///
         /// <param name="interval"> The interval to set. </param>
@@ -11,6 +11,7 @@
 #include <model/include/CompilableNode.h>
 #include <model/include/CompilableNodeUtilities.h>
 #include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
 #include <model/include/MapCompiler.h>
 #include <model/include/ModelTransformer.h>
 #include <model/include/OutputPort.h>
@@ -140,6 +141,10 @@ namespace nodes
     template <typename ValueType, typename ModelLikeType>
     const model::OutputPort<ValueType>& Constant(ModelLikeType& model, const std::vector<ValueType>& value, const model::PortMemoryLayout& layout);
 
+    /// <summary> Returns the `ConstantNode` an input port reads from, or `nullptr` if its values aren't constant. </summary>
+    template <typename ValueType>
+    const ConstantNode<ValueType>* GetConstantInputNode(const model::InputPort<ValueType>& input);
+
     /// <summary> Adds a constant node (which represents a constant predictor) to a model transformer. </summary>
     ///
     /// <param name="input"> The input to the predictor, which is ignored. </param>
@@ -274,6 +279,12 @@ namespace nodes
         auto node = model.template AddNode<ConstantNode<ValueType>>(values, layout);
         return node->output;
     }
+
+    template <typename ValueType>
+    const ConstantNode<ValueType>* GetConstantInputNode(const model::InputPort<ValueType>& input)
+    {
+        return dynamic_cast<const ConstantNode<ValueType>*>(input.GetReferencedPort().GetNode());
+    }
 } // namespace nodes
 } // namespace ell
 
@@ -67,6 +67,8 @@ namespace nodes
         /// <summary> Reset the state of the node </summary>
         void Reset() override;
 
+        bool HasRuntimeState() const override { return true; } // distances from earlier inputs
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
@@ -68,6 +68,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // calls back into user code
+
         /// <summary> Get the label of this node </summary>
         ///
         /// <returns> The node label. </returns>
@@ -57,6 +57,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // queue of earlier inputs
+
         /// <summary>Return the window size</summary>
         size_t GetWindowSize() const { return _windowSize; }
 
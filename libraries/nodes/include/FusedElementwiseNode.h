@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FusedElementwiseNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/OutputPort.h>
+#include <model/include/PortMemoryLayout.h>
+
+#include <emitters/include/IRFunctionEmitter.h>
+#include <emitters/include/IRLocalScalar.h>
+
+#include <utilities/include/TypeName.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> The operations a `FusedElementwiseNode` can apply to each element. </summary>
+    enum class FusedElementwiseOperation : int
+    {
+        linear, // scale * x + bias, with the scale and bias broadcast along one dimension
+        relu,
+        leakyReLU,
+        sigmoid,
+        hardSigmoid,
+        tanh,
+        hardTanh,
+        abs,
+        sqrt,
+        square,
+        exp,
+        log,
+        sin,
+        cos
+    };
+
+    /// <summary> One of the operations a `FusedElementwiseNode` applies, in order, to each element. </summary>
+    template <typename ValueType>
+    struct FusedElementwiseStage
+    {
+        FusedElementwiseOperation operation = FusedElementwiseOperation::linear;
+
+        /// <summary> The leaky factor, for `leakyReLU`. </summary>
+        ValueType parameter = 0;
+
+        /// <summary> The dimension of the input the scale and bias lie along, for `linear`. </summary>
+        int broadcastDimension = 0;
+
+        /// <summary> The index of the secondary input holding the scale, for `linear`, or -1 if the scale is 1. </summary>
+        int scaleInput = -1;
+
+        /// <summary> The index of the secondary input holding the bias, for `linear`, or -1 if the bias is 0. </summary>
+        int biasInput = -1;
+    };
+
+    /// <summary> A node that applies a chain of elementwise operations (linear functions broadcast along a dimension,
+    /// activation functions, and unary math functions) in a single pass over its input. It's what a chain of
+    /// `BroadcastFunctionNode`s, `ActivationLayerNode`s and `UnaryOperationNode`s turns into after fusion, so the
+    /// intermediate values never have to be written to memory. </summary>
+    template <typename ValueType>
+    class FusedElementwiseNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        static constexpr const char* secondaryInputPortNamePrefix = "secondaryInput_";
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        FusedElementwiseNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The values to operate on. </param>
+        /// <param name="inputLayout"> The layout of the input. </param>
+        /// <param name="secondaryInputs"> The scales and biases used by the linear stages. </param>
+        /// <param name="stages"> The operations to apply to each element, in order. </param>
+        /// <param name="outputLayout"> The layout of the output. Its active area must be the same size as the input's. </param>
+        /// <param name="padding"> The value the output's padding is filled with. </param>
+        FusedElementwiseNode(const model::OutputPort<ValueType>& input,
+                             const model::PortMemoryLayout& inputLayout,
+                             const std::vector<const model::OutputPort<ValueType>*>& secondaryInputs,
+                             const std::vector<FusedElementwiseStage<ValueType>>& stages,
+                             const model::PortMemoryLayout& outputLayout,
+                             ValueType padding = 0);
+
+        /// <summary> Gets the operations applied to each element. </summary>
+        ///
+        /// <returns> The operations, in the order they're applied. </returns>
+        const std::vector<FusedElementwiseStage<ValueType>>& GetStages() const { return _stages; }
+
+        /// <summary> Gets the number of secondary inputs. </summary>
+        ///
+        /// <returns> The number of secondary inputs. </returns>
+        int NumSecondaryInputs() const { return static_cast<int>(_secondaryInputs.size()); }
+
+        /// <summary> Gets one of the secondary inputs. </summary>
+        ///
+        /// <param name="index"> The index of the secondary input. </param>
+        ///
+        /// <returns> The secondary input port. </returns>
+        const model::InputPort<ValueType>& GetSecondaryInput(int index) const { return *_secondaryInputs[index]; }
+
+        /// <summary> Gets the layout of the input. </summary>
+        const model::PortMemoryLayout& GetInputMemoryLayout() const { return _inputLayout; }
+
+        /// <summary> Gets the layout of the output. </summary>
+        model::PortMemoryLayout GetOutputMemoryLayout() const { return _output.GetMemoryLayout(); }
+
+        /// <summary> Gets the value the output's padding is filled with. </summary>
+        ValueType GetOutputPadding() const { return _paddingValue; }
+
+        /// <summary> Returns true if the node can accept input with this memory layout order, else false </summary>
+        ///
+        /// <param name="order"> The memory layout order for all the input ports </summary>
+        /// <returns> If the node can accept the input memory layout order, true, else false </returns>
+        bool CanAcceptInputLayout(const utilities::DimensionOrder& order) const override
+        {
+            return GetInputMemoryLayout().GetLogicalDimensionOrder() == order;
+        }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("FusedElementwiseNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        bool HasState() const override { return true; } // stored state: stages, layouts, and padding value
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+        void AddSecondaryInput(const model::OutputPort<ValueType>& port);
+        void InitializeSecondaryInputDimensions();
+
+        ValueType ComputeStages(ValueType x, const std::vector<ValueType>& secondaryValues) const;
+        emitters::LLVMValue EmitStages(emitters::IRFunctionEmitter& function, emitters::LLVMValue x, const std::vector<emitters::LLVMValue>& secondaryValues) const;
+
+        // Helpers for generating nested loops to visit all input/output values
+        void ComputeDimensionLoop(int dimension, std::vector<ValueType>& output, size_t prevInputDimensionOffset, size_t prevOutputDimensionOffset, std::vector<ValueType>& secondaryValues) const;
+        void EmitComputeDimensionLoop(emitters::IRFunctionEmitter& function, int dimension, emitters::LLVMValue input, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, std::vector<emitters::LLVMValue>& secondaryValues) const;
+
+        // Helpers for processing the innermost dimension a vector at a time, when every stage has a vector form
+        bool CanVectorizeStages() const;
+        emitters::LLVMValue EmitVectorizedStages(emitters::IRFunctionEmitter& function, emitters::LLVMValue x, const std::vector<emitters::LLVMValue>& secondaryValues) const;
+        void EmitVectorizedInnerLoop(emitters::IRFunctionEmitter& function, int vectorSize, emitters::LLVMValue input, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, const std::vector<emitters::LLVMValue>& secondaryValues) const;
+
+        model::InputPort<ValueType> _input;
+        std::vector<std::unique_ptr<model::InputPort<ValueType>>> _secondaryInputs;
+        model::OutputPort<ValueType> _output;
+
+        model::PortMemoryLayout _inputLayout;
+        std::vector<FusedElementwiseStage<ValueType>> _stages;
+        ValueType _paddingValue = 0;
+
+        // The dimension each secondary input lies along
+        std::vector<int> _secondaryInputDimensions;
+    };
+} // namespace nodes
+} // namespace ell
@@ -74,6 +74,8 @@ namespace nodes
         /// <summary> Resets any state on the node, if any </summary>
         void Reset() override;
 
+        bool HasRuntimeState() const override { return true; } // hidden and cell state
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
@@ -212,6 +212,22 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        /// <summary> Gets the implementation of matrix-matrix multiplication this node uses. </summary>
+        ///
+        /// <returns> The implementation. </returns>
+        MatrixMatrixMultiplyImplementation GetImplementation() const { return _impl; }
+
+        /// <summary> Gets the loop-nest schedule used by the `Mlas_Loopnest_Value` implementation. </summary>
+        ///
+        /// <returns> The schedule parameters. </returns>
+        const MatrixMatrixMultiplySchedule& GetSchedule() const { return _schedule; }
+
+        /// <summary> Makes a copy of this node in the model being constructed by the transformer, using a different loop-nest schedule. </summary>
+        ///
+        /// <param name="transformer"> The `ModelTransformer` currently copying the model. </param>
+        /// <param name="schedule"> The schedule parameters for the new node. </param>
+        void CopyWithSchedule(model::ModelTransformer& transformer, const MatrixMatrixMultiplySchedule& schedule) const;
+
     protected:
         void Define(value::FunctionDeclaration& fn) override;
         utilities::ArchiveVersion GetArchiveVersion() const override;
@@ -226,8 +242,9 @@ namespace nodes
         void ZeroMatrix(value::Matrix matrix) const;
 
         void ForLoopGEMM(const value::Matrix matA, const value::Matrix matB, value::Matrix matC);
-        void Gemm(const value::Matrix mat, const value::Matrix matB, value::Matrix matC);
-        void GemmFn(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int thread_num = 0);
+        // `input2ColumnOffset` is the first column of input2 that matB holds, for finding its values when input2 is constant
+        void Gemm(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int input2ColumnOffset = 0);
+        void GemmFn(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int thread_num = 0, int input2ColumnOffset = 0);
         void ParallelizeGemmCol(const value::Matrix matA, const value::Matrix matB, value::Matrix matC, int numThreads = 2);
         void ParallelizeGemmRow(const value::Matrix matA, const value::Matrix matB, value::Matrix matC, int numThreads = 2);
         void ELLCodeGEMM(const value::Matrix matA, const value::Matrix matB, value::Matrix matC);
@@ -253,6 +270,7 @@ namespace nodes
         int _kernelN;
         int _kernelK;
         MatrixMatrixMultiplyImplementation _impl;
+        MatrixMatrixMultiplySchedule _schedule;
 
         static const int _defaultPanelM = 64;
         static const int _defaultPanelN = 64;
@@ -19,5 +19,27 @@ namespace nodes
         LAST,
         DEFAULT = Mlas_Loopnest_Value
     };
+
+    /// <summary> How the `Mlas_Loopnest_Value` implementation caches panels of the right-hand matrix. </summary>
+    enum class MatrixMatrixMultiplyCachingStrategy : int
+    {
+        BLASTCopy = 0, // packed with `value::BLASTCopy`, when the kernel width divides the number of output columns
+        GeneralCachingStrategy, // copied with `value::GeneralCachingStrategy`
+        None
+    };
+
+    /// <summary> The loop-nest schedule parameters used by the `Mlas_Loopnest_Value` implementation. A value of 0 means
+    /// "use the default for the target", so a default-constructed schedule gives the untuned behavior. </summary>
+    struct MatrixMatrixMultiplySchedule
+    {
+        int columnBlock = 0; // columns of B cached at once (default: 64)
+        int innerDimensionBlock = 0; // rows of B cached at once (default: 256)
+        int kUnroll = 0; // unroll factor of the inner dimension loop (default: 4)
+        int kernelRows = 0; // rows of C computed by the kernel (default: 2, or 12 with 16-wide vectors)
+        int kernelColumnVectors = 0; // columns of C computed by the kernel, in vector registers (default: 2)
+        MatrixMatrixMultiplyCachingStrategy cachingStrategy = MatrixMatrixMultiplyCachingStrategy::BLASTCopy;
+        int cacheElements = 0; // size of the GeneralCachingStrategy cache, in elements (default: columnBlock * innerDimensionBlock)
+        int cacheFillElements = 0; // elements GeneralCachingStrategy fills at a time, at most cacheElements (default: cacheElements)
+    };
 } // namespace nodes
 } // namespace ell
@@ -74,6 +74,7 @@ namespace nodes
 
     private:
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::ModelTransformer& transformer) const override;
 
         // Inputs
         model::InputPort<ValueType> _inputMatrix;
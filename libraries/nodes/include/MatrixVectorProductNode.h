@@ -21,6 +21,7 @@
 
 #include <utilities/include/Exception.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -198,18 +199,16 @@ namespace nodes
     template <typename ValueType, math::MatrixLayout layout>
     void MatrixVectorProductNode<ValueType, layout>::Compute() const
     {
-        math::ColumnVector<ValueType> input(_input.Size());
-        for (size_t index = 0; index < _input.Size(); ++index)
-        {
-            input[index] = _input[index];
-        }
+        // Wrap the input and output port storage directly, rather than copying into temporary vectors
+        const auto& inputValues = _input.GetValueReference();
+        math::ConstColumnVectorReference<ValueType> input(inputValues.data(), inputValues.size());
 
-        math::ColumnVector<ValueType> result(_w.NumRows());
+        auto& outputValues = _output.GetOutputBuffer(_w.NumRows());
+        std::fill(outputValues.begin(), outputValues.end(), static_cast<ValueType>(0)); // a stale infinity would turn the `0 * result` term into NaN
+        math::ColumnVectorReference<ValueType> result(outputValues.data(), outputValues.size());
 
         // result = _w * data
         math::MultiplyScaleAddUpdate(static_cast<ValueType>(1), _w, input, static_cast<ValueType>(0), result);
-
-        _output.SetOutput(result.ToArray());
     }
 
     template <typename ValueType, math::MatrixLayout layout>
@@ -56,6 +56,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // window of earlier inputs
+
         /// <summary> Refines this node in the model being constructed by the transformer </summary>
         bool Refine(model::ModelTransformer& transformer) const override;
 
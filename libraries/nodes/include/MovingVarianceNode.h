@@ -51,6 +51,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool HasRuntimeState() const override { return true; } // window of earlier inputs
+
     protected:
         void Compute() const override;
         void WriteToArchive(utilities::Archiver& archiver) const override;
@@ -302,12 +302,21 @@ namespace nodes
     template <typename DerivedType, typename LayerType, typename ValueType>
     void NeuralNetworkLayerNode<DerivedType, LayerType, ValueType>::Compute() const
     {
-        auto inputVector = _input.GetValue();
+        const auto& inputVector = _input.GetValueReference();
         auto inputTensor = typename LayerType::ConstTensorReferenceType{ inputVector.data(), _inputTensor.GetShape() };
         _inputTensor.CopyFrom(inputTensor);
         _layer.Compute();
         const auto& outputTensor = _layer.GetOutput();
-        _output.SetOutput(outputTensor.ToArray());
+        if (outputTensor.IsContiguous())
+        {
+            // Copy straight into the port's existing storage
+            auto outputData = outputTensor.GetConstDataPointer();
+            _output.SetOutput(outputData, outputData + outputTensor.Size());
+        }
+        else
+        {
+            _output.SetOutput(outputTensor.ToArray());
+        }
     }
 
     template <typename LayerType>
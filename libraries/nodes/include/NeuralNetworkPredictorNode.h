@@ -109,6 +109,8 @@ namespace nodes
         /// <summary> Reset the state of the node </summary>
         void Reset() override;
 
+        bool HasRuntimeState() const override { return true; } // state of recurrent layers
+
     protected:
         void Compute() const override;
         bool Refine(model::ModelTransformer& transformer) const override;
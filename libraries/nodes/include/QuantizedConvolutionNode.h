@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedConvolutionNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "QuantizedMatrixMatrixMultiplyNode.h"
+
+#include <math/include/Tensor.h>
+
+#include <model/include/IRMapCompiler.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/PortMemoryLayout.h>
+
+#include <string>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> A node that performs a full (not depthwise-separable) convolution with int8 weights and int8-quantized
+    /// input, accumulating in int32. It refines into a `ReceptiveFieldMatrixNode` followed by a
+    /// `QuantizedMatrixMatrixMultiplyNode`, the same way `UnrolledConvolutionNode` refines into a floating-point
+    /// matrix multiply. </summary>
+    template <typename ValueType>
+    class QuantizedConvolutionNode : public model::CompilableNode
+    {
+    public:
+        using ConstTensorReferenceType = math::ConstChannelColumnRowTensorReference<ValueType>;
+
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default constructor. </summary>
+        QuantizedConvolutionNode();
+
+        /// <summary> Constructor from floating-point weights. </summary>
+        ///
+        /// <param name="input"> The ports to get input data from. </param>
+        /// <param name="inputMemoryLayout"> The layout of the input data. </param>
+        /// <param name="outputMemoryLayout"> The layout of the output data. </param>
+        /// <param name="filterWeights"> The weights for the convolutional filters. They are quantized by the constructor. </param>
+        /// <param name="stride"> The convolution stride. </param>
+        /// <param name="inputRange"> The largest input magnitude to represent exactly, usually found by calibrating on a dataset. Larger inputs are clamped. </param>
+        QuantizedConvolutionNode(const model::OutputPort<ValueType>& input,
+                                 const model::PortMemoryLayout& inputMemoryLayout,
+                                 const model::PortMemoryLayout& outputMemoryLayout,
+                                 const ConstTensorReferenceType& filterWeights,
+                                 int stride,
+                                 ValueType inputRange);
+
+        /// <summary> Constructor from already-quantized weights. </summary>
+        ///
+        /// <param name="input"> The ports to get input data from. </param>
+        /// <param name="inputMemoryLayout"> The layout of the input data. </param>
+        /// <param name="outputMemoryLayout"> The layout of the output data. </param>
+        /// <param name="filterWeights"> The quantized weights, a matrix with one row per filter and columns in (row, column, channel) order. </param>
+        /// <param name="filterSize"> The width and height of the filters. </param>
+        /// <param name="stride"> The convolution stride. </param>
+        /// <param name="inputScale"> The scale used to quantize the input. </param>
+        QuantizedConvolutionNode(const model::OutputPort<ValueType>& input,
+                                 const model::PortMemoryLayout& inputMemoryLayout,
+                                 const model::PortMemoryLayout& outputMemoryLayout,
+                                 const QuantizedWeights<ValueType>& filterWeights,
+                                 int filterSize,
+                                 int stride,
+                                 ValueType inputScale);
+
+        /// <summary> Gets information about the input memory layout </summary>
+        const model::PortMemoryLayout& GetInputMemoryLayout() const { return _inputMemoryLayout; }
+
+        /// <summary> Gets information about the output memory layout </summary>
+        model::PortMemoryLayout GetOutputMemoryLayout() const { return _output.GetMemoryLayout(); }
+
+        /// <summary> Gets the quantized weights, a matrix with one row per filter and columns in (row, column, channel) order. </summary>
+        const QuantizedWeights<ValueType>& GetWeights() const { return _filterWeights; }
+
+        /// <summary> Returns true if the node can accept input with this memory layout order, else false </summary>
+        ///
+        /// <param name="order"> The memory layout order for all the input ports </summary>
+        /// <returns> If the node can accept the input memory layout order, true, else false </returns>
+        bool CanAcceptInputLayout(const utilities::DimensionOrder& order) const override
+        {
+            return GetInputMemoryLayout().GetLogicalDimensionOrder() == order;
+        }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("QuantizedConvolutionNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Indicates if this node is able to compile itself to code. </summary>
+        bool IsCompilable(const model::MapCompiler* compiler) const override { return false; }
+
+    protected:
+        bool Refine(model::ModelTransformer& transformer) const override;
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: convolutional parameters, quantized weights and memory layout
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        // Input
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        model::PortMemoryLayout _inputMemoryLayout;
+
+        QuantizedWeights<ValueType> _filterWeights;
+        ValueType _inputScale = 1;
+
+        int _filterSize = 0;
+        int _stride = 1;
+    };
+} // namespace nodes
+} // namespace ell
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrixMatrixMultiplyNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <emitters/include/IRFunctionEmitter.h>
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/MapCompiler.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/Node.h>
+#include <model/include/OutputPort.h>
+#include <model/include/PortMemoryLayout.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/IArchivable.h>
+#include <utilities/include/TypeName.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> A row-major weights matrix quantized to signed 8-bit integers, with one scale per row.
+    /// The original value of an entry is approximately `values[i * numColumns + j] * scales[i]`. </summary>
+    template <typename ValueType>
+    struct QuantizedWeights
+    {
+        std::vector<int8_t> values;
+        std::vector<ValueType> scales;
+    };
+
+    /// <summary> Quantizes a row-major weights matrix to int8, choosing each row's scale so that its largest
+    /// magnitude entry maps to 127. </summary>
+    ///
+    /// <param name="weights"> The weights, a row-major matrix of size numRows x numColumns. </param>
+    /// <param name="numRows"> The number of rows in the matrix. </param>
+    /// <param name="numColumns"> The number of columns in the matrix. </param>
+    ///
+    /// <returns> The quantized weights. </returns>
+    template <typename ValueType>
+    QuantizedWeights<ValueType> QuantizeWeights(const std::vector<ValueType>& weights, int numRows, int numColumns);
+
+    /// <summary> Gets the scale that maps values in the range [-range, range] onto [-127, 127]. </summary>
+    template <typename ValueType>
+    ValueType GetQuantizationScale(ValueType range);
+
+    /// <summary> Quantizes a single value to the range [-127, 127], rounding to nearest. </summary>
+    template <typename ValueType>
+    int QuantizeValue(ValueType value, ValueType scale);
+
+    /// <summary> A node that multiplies a constant int8 weights matrix by its input. The input is quantized to int8
+    /// on the way in, the products are accumulated in int32, and the result is converted back to floating-point
+    /// using the weights' per-row scales and the input's scale. </summary>
+    template <typename ValueType>
+    class QuantizedMatrixMatrixMultiplyNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        QuantizedMatrixMatrixMultiplyNode();
+
+        /// <summary> Constructor from floating-point weights. </summary>
+        ///
+        /// <param name="input"> The right-hand input of the matrix multiplication, a row-major matrix of size k x n. </param>
+        /// <param name="m"> The number of rows in the weights matrix. </param>
+        /// <param name="n"> The number of columns in the input matrix. </param>
+        /// <param name="k"> The number of columns in the weights matrix (and rows in the input matrix). </param>
+        /// <param name="weights"> The weights, a row-major matrix of size m x k. They are quantized by the constructor. </param>
+        /// <param name="inputRange"> The largest input magnitude to represent exactly, usually found by calibrating on a dataset. Larger inputs are clamped. </param>
+        /// <param name="transposeOutput"> If true, the output is stored as an n x m matrix. </param>
+        /// <param name="outputMemoryLayout"> The output memory layout to use. Must have m * n active entries and no padding. </param>
+        QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const std::vector<ValueType>& weights, ValueType inputRange, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout);
+
+        /// <summary> Constructor from already-quantized weights. </summary>
+        ///
+        /// <param name="input"> The right-hand input of the matrix multiplication, a row-major matrix of size k x n. </param>
+        /// <param name="m"> The number of rows in the weights matrix. </param>
+        /// <param name="n"> The number of columns in the input matrix. </param>
+        /// <param name="k"> The number of columns in the weights matrix (and rows in the input matrix). </param>
+        /// <param name="weights"> The quantized weights, a row-major matrix of size m x k. </param>
+        /// <param name="inputScale"> The scale used to quantize the input. </param>
+        /// <param name="transposeOutput"> If true, the output is stored as an n x m matrix. </param>
+        /// <param name="outputMemoryLayout"> The output memory layout to use. Must have m * n active entries and no padding. </param>
+        QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const QuantizedWeights<ValueType>& weights, ValueType inputScale, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout);
+
+        /// <summary> Gets the quantized weights. </summary>
+        const QuantizedWeights<ValueType>& GetWeights() const { return _weights; }
+
+        /// <summary> Gets the scale used to quantize the input. </summary>
+        ValueType GetInputScale() const { return _inputScale; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("QuantizedMatrixMatrixMultiplyNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: m, n, k, weights, scales, transposeOutput
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+        void VerifyDimensions() const;
+
+        // Input
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        // Weights are MxK, input is KxN, output is MxN
+        int _m = 0, _n = 0, _k = 0;
+        QuantizedWeights<ValueType> _weights;
+        ValueType _inputScale = 1;
+        bool _transposeOutput = false;
+    };
+} // namespace nodes
+} // namespace ell
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ReducedPrecisionWeights.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ConstantNode.h"
+
+#include <emitters/include/IRFunctionEmitter.h>
+#include <emitters/include/IRLocalScalar.h>
+
+#include <model/include/ModelOptimizerOptions.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> Converts a float to the bits of the nearest bfloat16 value, rounding ties to even. </summary>
+    uint16_t FloatToBFloat16(float value);
+
+    /// <summary> Converts the bits of a bfloat16 value to a float. </summary>
+    float BFloat16ToFloat(uint16_t bits);
+
+    /// <summary> Converts a float to the bits of the nearest IEEE half-precision value, rounding ties to even.
+    /// Values too large for half precision become infinity. </summary>
+    uint16_t FloatToFloat16(float value);
+
+    /// <summary> Converts the bits of an IEEE half-precision value to a float. </summary>
+    float Float16ToFloat(uint16_t bits);
+
+    /// <summary> Converts weights to 16-bit storage. </summary>
+    ///
+    /// <param name="weights"> The weights to convert. </param>
+    /// <param name="storageType"> The 16-bit format to store the weights in. Must not be `float32`. </param>
+    ///
+    /// <returns> The bits of the converted weights. </returns>
+    template <typename ValueType>
+    std::vector<int16_t> PackWeights(const std::vector<ValueType>& weights, model::WeightStorageType storageType);
+
+    /// <summary> Converts weights in 16-bit storage back to floating-point. </summary>
+    ///
+    /// <param name="packedWeights"> The bits of the weights, as returned by `PackWeights`. </param>
+    /// <param name="storageType"> The 16-bit format the weights are stored in. Must not be `float32`. </param>
+    ///
+    /// <returns> The weights. </returns>
+    template <typename ValueType>
+    std::vector<ValueType> UnpackWeights(const std::vector<int16_t>& packedWeights, model::WeightStorageType storageType);
+
+    /// <summary> How much precision is lost by storing a set of weights in reduced precision. </summary>
+    struct WeightStorageError
+    {
+        size_t numWeights = 0;
+        double maxAbsoluteError = 0;
+        double rmsError = 0;
+        double maxAbsoluteWeight = 0;
+    };
+
+    /// <summary> Measures the difference between a set of weights and their reduced-precision versions. </summary>
+    template <typename ValueType>
+    WeightStorageError GetWeightStorageError(const std::vector<ValueType>& weights, model::WeightStorageType storageType);
+
+    /// <summary> Emits a constant global holding weights in 16-bit storage, and logs the precision lost in doing so. </summary>
+    ///
+    /// <param name="function"> The function being emitted. </param>
+    /// <param name="weights"> The weights to store. </param>
+    /// <param name="storageType"> The 16-bit format to store the weights in. Must not be `float32`. </param>
+    /// <param name="name"> The name of the global variable. </param>
+    ///
+    /// <returns> A pointer to the first of the stored weights. </returns>
+    template <typename ValueType>
+    emitters::LLVMValue EmitPackedWeights(emitters::IRFunctionEmitter& function, const std::vector<ValueType>& weights, model::WeightStorageType storageType, const std::string& name);
+
+    /// <summary> Emits code to load a weight from 16-bit storage and convert it to floating-point. </summary>
+    ///
+    /// <param name="function"> The function being emitted. </param>
+    /// <param name="packedWeights"> A pointer to the weights, as returned by `EmitPackedWeights`. </param>
+    /// <param name="index"> The index of the weight to load. </param>
+    /// <param name="storageType"> The 16-bit format the weights are stored in. Must not be `float32`. </param>
+    ///
+    /// <returns> The weight. </returns>
+    template <typename ValueType>
+    emitters::IRLocalScalar EmitUnpackWeight(emitters::IRFunctionEmitter& function, emitters::LLVMValue packedWeights, emitters::IRLocalScalar index, model::WeightStorageType storageType);
+} // namespace nodes
+} // namespace ell
@@ -114,6 +114,7 @@ namespace nodes
         void WriteToArchive(utilities::Archiver& archiver) const override;
         void ReadFromArchive(utilities::Unarchiver& archiver) override;
         bool HasState() const override { return true; } // stored state: callback function name, shape
+        bool HasRuntimeState() const override { return true; } // calls back into user code for its output
 
     private:
         void Copy(model::ModelTransformer& transformer) const override;
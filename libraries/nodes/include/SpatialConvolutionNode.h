@@ -13,7 +13,11 @@
 #include <model/include/InputPort.h>
 #include <model/include/OutputPort.h>
 
+#include <emitters/include/IRVectorUtilities.h>
+
+#include <value/include/EmitterContext.h>
 #include <value/include/FunctionDeclaration.h>
+#include <value/include/LLVMContext.h>
 #include <value/include/Scalar.h>
 #include <value/include/ScalarOperations.h>
 #include <value/include/Tensor.h>
@@ -24,6 +28,7 @@
 #include <value/include/loopnests/Kernel.h>
 #include <value/include/loopnests/LoopNest.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -35,6 +40,9 @@ namespace nodes
     /// convolutional model. By definition, this node requires:
     /// - Number of input channels per weights filter to be 1
     /// - Number of filters must equal number of input channels
+    /// When the input and output are both channel-interleaved (channels innermost in memory), the output is computed in
+    /// spatial tiles, one block of channels at a time, and the loop over the channels in a block is vectorized, since
+    /// neighbouring channels are independent and contiguous in memory.
     /// </summary>
     template <typename ValueType>
     class SpatialConvolutionNode : public model::CompilableCodeNode
@@ -85,6 +93,9 @@ namespace nodes
         // Called with output i, j, k
         void spatial_convolutional_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar i, value::Scalar j, value::Scalar k);
 
+        // Returns true if both the input and output store channels innermost
+        bool IsChannelInterleaved() const;
+
         // Inputs
         model::InputPort<ValueType> _input;
 
@@ -93,6 +104,11 @@ namespace nodes
 
         // Convolutional layer
         LayerType _layer;
+
+        // Tile sizes for channel-interleaved layouts
+        static const int _rowBlock = 4;
+        static const int _columnBlock = 8;
+        static const int _channelBlock = 64;
     };
 
 } // namespace nodes
@@ -159,14 +175,19 @@ namespace nodes
         {
             for (int k_c = 0; k_c < receptiveFieldColumns; ++k_c)
             {
-                // Weight filters are stacked in the row dimension. For spatial convolutions, the weights channel index is always 0
-                // since there is only one channel per filter.
-                temp += input(row * rowStride + k_r, column * columnStride + k_c, channel) * weights(channel * receptiveFieldRows + k_r, k_c, 0);
+                // The weights are repacked in `Define` so the filters of neighbouring channels are contiguous
+                temp += input(row * rowStride + k_r, column * columnStride + k_c, channel) * weights(k_r, k_c, channel);
             }
         }
         output(row, column, channel) = temp;
     }
 
+    template <typename ValueType>
+    bool SpatialConvolutionNode<ValueType>::IsChannelInterleaved() const
+    {
+        return _input.GetMemoryLayout().GetLogicalDimensionOrder()[2] == 2 && _output.GetMemoryLayout().GetLogicalDimensionOrder()[2] == 2;
+    }
+
     template <typename ValueType>
     void SpatialConvolutionNode<ValueType>::Define(ell::value::FunctionDeclaration& fn)
     {
@@ -177,11 +198,24 @@ namespace nodes
             input_value.SetLayout(utilities::MemoryLayout(input_value.GetLayout().GetExtent(), input_value.GetLayout().GetLogicalDimensionOrder()));
             value::Tensor input(input_value);
 
-            // Declare constants
+            // Declare constants. Weight filters are stacked in the row dimension, one filter per channel: repack them
+            // to fw x fw x d, with the channels innermost
             const auto& w = _layer.GetWeights();
-            std::vector<ValueType> data = w.ToArray();
+            const int filterSize = static_cast<int>(w.NumColumns());
+            const int numChannels = static_cast<int>(w.NumRows()) / filterSize;
+            std::vector<ValueType> data(filterSize * filterSize * numChannels);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int k_r = 0; k_r < filterSize; ++k_r)
+                {
+                    for (int k_c = 0; k_c < filterSize; ++k_c)
+                    {
+                        data[(k_r * filterSize + k_c) * numChannels + channel] = w(channel * filterSize + k_r, k_c, 0);
+                    }
+                }
+            }
             value::Tensor weights({ data,
-                                    utilities::MemoryLayout({ static_cast<int>(w.NumRows()), static_cast<int>(w.NumColumns()), static_cast<int>(w.NumChannels()) },
+                                    utilities::MemoryLayout({ filterSize, filterSize, numChannels },
                                                             utilities::DimensionOrder(utilities::RowMajorTensorOrder)) });
 
             // Declare the indexes
@@ -198,7 +232,32 @@ namespace nodes
 
             loopnests::LoopNest loop(std::vector<loopnests::IndexRange>{ i, j, k });
             loop.AddKernel(kernel);
-            loop.SetLoopOrder({ k.GetIndex(), i.GetIndex(), j.GetIndex() });
+
+            if (IsChannelInterleaved())
+            {
+                auto iIndex = i.GetIndex();
+                auto jIndex = j.GetIndex();
+                auto kIndex = k.GetIndex();
+                auto iOuter = loop.Split(iIndex, std::min(_rowBlock, static_cast<int>(output.Rows()))).outer;
+                auto jOuter = loop.Split(jIndex, std::min(_columnBlock, static_cast<int>(output.Columns()))).outer;
+                auto kSplit = loop.Split(kIndex, std::min(_channelBlock, static_cast<int>(output.Channels())));
+                loop.SetLoopOrder({ kSplit.outer, iOuter, jOuter, iIndex, jIndex, kIndex });
+
+                int vectorSize = 1;
+                value::InvokeForContext<value::LLVMContext>([&](value::LLVMContext& context) {
+                    auto& function = context.GetFunctionEmitter();
+                    vectorSize = emitters::GetElementwiseVectorWidth<ValueType>(function.GetCompilerOptions());
+                });
+                vectorSize = std::min(vectorSize, static_cast<int>(loop.GetIndexRange(kSplit.inner).Size()));
+                if (vectorSize > 1)
+                {
+                    loop.Vectorize(kSplit.inner, vectorSize);
+                }
+            }
+            else
+            {
+                loop.SetLoopOrder({ k.GetIndex(), i.GetIndex(), j.GetIndex() });
+            }
 
             loopnests::CodeGenerator generator;
             generator.Run(loop);
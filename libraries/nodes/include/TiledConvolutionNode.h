@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TiledConvolutionNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <math/include/Tensor.h>
+
+#include <model/include/CompilableCodeNode.h>
+#include <model/include/InputPort.h>
+#include <model/include/OutputPort.h>
+#include <model/include/PortMemoryLayout.h>
+
+#include <utilities/include/IArchivable.h>
+#include <utilities/include/TypeName.h>
+
+#include <value/include/FunctionDeclaration.h>
+#include <value/include/Tensor.h>
+
+#include <string>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// If tiled convolution is specified, a ConvolutionalLayerNode will refine itself into a TiledConvolutionNode.
+    /// The convolution is computed directly, without unrolling the input into a receptive field matrix: the output
+    /// is split into tiles of rows, columns and filters, and the input channels into blocks. For each tile of output
+    /// rows and columns and each block of input channels, the region of the input the tile reads (including the
+    /// overlap, or halo, of the filter window) is copied into a small cache, which is then reused for every block of
+    /// filters. For each output element, the filters of a block are unrolled and their sums accumulate in registers
+    /// across the loop over a block of input channels, so the output is loaded and stored once per block of channels.
+    /// Grouped convolutions are also supported: the input channels and the filters are divided into groups, and each
+    /// group of filters, which reads only its own group of input channels, is convolved in turn as above.
+    /// </summary>
+    template <typename ValueType>
+    class TiledConvolutionNode : public model::CompilableCodeNode
+    {
+    public:
+        using TensorType = math::ChannelColumnRowTensor<ValueType>;
+        using ConstTensorReferenceType = math::ConstChannelColumnRowTensorReference<ValueType>;
+
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default constructor. </summary>
+        TiledConvolutionNode();
+
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="input"> The ports to get input data from. </param>
+        /// <param name="inputMemoryLayout"> The layout of the input data. </param>
+        /// <param name="outputMemoryLayout"> The layout of the output data. </param>
+        /// <param name="filterWeights"> The weights for the convolutional filters. Stored
+        ///  as a 3D tensor of dimensions (nf*fw) x fw x (d/g), where nf == # filters, fw == filter width, d == input depth,
+        ///  and g == # groups, so the number of groups is implied by the depth of the weights. </param>
+        /// <param name="stride"> The output stride. </param>
+        TiledConvolutionNode(const model::OutputPort<ValueType>& input,
+                             const model::PortMemoryLayout& inputMemoryLayout,
+                             const model::PortMemoryLayout& outputMemoryLayout,
+                             const ConstTensorReferenceType& filterWeights,
+                             size_t stride);
+
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="input"> The ports to get input data from. </param>
+        /// <param name="inputMemoryLayout"> The layout of the input data. </param>
+        /// <param name="outputMemoryLayout"> The layout of the output data. </param>
+        /// <param name="filterWeights"> The weights for the convolutional filters. Stored
+        ///  as a 3D tensor of dimensions (nf*fw) x fw x (d/g), where nf == # filters, fw == filter width, d == input depth,
+        ///  and g == # groups, so the number of groups is implied by the depth of the weights. </param>
+        /// <param name="stride"> The output stride. </param>
+        /// <param name="rowBlock"> The number of output rows in a tile. </param>
+        /// <param name="columnBlock"> The number of output columns in a tile. </param>
+        /// <param name="channelBlock"> The number of input channels in a block. </param>
+        /// <param name="filterBlock"> The number of filters (output channels) in a block, accumulated together in registers. </param>
+        TiledConvolutionNode(const model::OutputPort<ValueType>& input,
+                             const model::PortMemoryLayout& inputMemoryLayout,
+                             const model::PortMemoryLayout& outputMemoryLayout,
+                             const ConstTensorReferenceType& filterWeights,
+                             size_t stride,
+                             int rowBlock,
+                             int columnBlock,
+                             int channelBlock,
+                             int filterBlock);
+
+        /// <summary> Gets information about the input memory layout </summary>
+        const model::PortMemoryLayout& GetInputMemoryLayout() const { return _inputMemoryLayout; }
+
+        /// <summary> Gets information about the output memory layout </summary>
+        model::PortMemoryLayout GetOutputMemoryLayout() const { return _output.GetMemoryLayout(); }
+
+        /// <summary> Gets the number of groups the input channels and filters are divided into </summary>
+        int GetNumGroups() const { return _inputMemoryLayout.GetLogicalDimensionActiveSize(2) / static_cast<int>(_filterWeights.NumChannels()); }
+
+        /// <summary> Returns true if the node can accept input with this memory layout order, else false </summary>
+        ///
+        /// <param name="order"> The memory layout order for all the input ports </summary>
+        /// <returns> If the node can accept the input memory layout order, true, else false </returns>
+        bool CanAcceptInputLayout(const utilities::DimensionOrder& order) const override
+        {
+            return GetInputMemoryLayout().GetLogicalDimensionOrder() == order;
+        }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("TiledConvolutionNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Define(value::FunctionDeclaration& fn) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: convolutional parameters, memory layout and tile sizes
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        void Convolve(value::Tensor input, value::Tensor output, value::Tensor weights) const;
+
+        // Input
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        model::PortMemoryLayout _inputMemoryLayout;
+
+        TensorType _filterWeights;
+
+        int _stride = 1;
+
+        // Tile sizes
+        int _rowBlock;
+        int _columnBlock;
+        int _channelBlock;
+        int _filterBlock;
+
+        static const int _defaultRowBlock = 4;
+        static const int _defaultColumnBlock = 16;
+        static const int _defaultChannelBlock = 64;
+        static const int _defaultFilterBlock = 8;
+    };
+
+    //
+    // Explicit instantiation declarations
+    //
+    extern template class TiledConvolutionNode<float>;
+    extern template class TiledConvolutionNode<double>;
+} // namespace nodes
+} // namespace ell
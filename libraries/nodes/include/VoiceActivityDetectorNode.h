@@ -69,6 +69,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         static std::string GetTypeName() { return "VoiceActivityDetectorCodeNode"; }
 
+        bool HasRuntimeState() const override { return true; } // smoothed signal levels
+
     protected:
         void Define(ell::value::FunctionDeclaration& fn) override;
         void DefineReset(ell::value::FunctionDeclaration& fn) override;
@@ -11,6 +11,7 @@
 #include "ReorderDataCodeNode.h"
 #include "SimpleConvolutionNode.h"
 #include "SpatialConvolutionNode.h"
+#include "TiledConvolutionNode.h"
 #include "UnrolledConvolutionNode.h"
 #include "WinogradConvolutionNode.h"
 
@@ -44,7 +45,9 @@ namespace nodes
         const auto& weights = this->GetLayer().GetWeights();
 
         auto isDepthwiseSeparable = (weights.NumChannels() == 1);
-        auto shouldReorderToChannelMajor = isDepthwiseSeparable && (convParams.method == ConvolutionMethod::simple || convParams.method == ConvolutionMethod::winograd);
+        // Depthwise-separable Winograd convolutions need channel-major data. The simple depthwise-separable method,
+        // SpatialConvolutionNode, is left with interleaved channels, since that's the layout it vectorizes across channels
+        auto shouldReorderToChannelMajor = isDepthwiseSeparable && convParams.method == ConvolutionMethod::winograd;
 
         auto convInputLayout = originalInputLayout.ReorderedCopy({ shouldReorderToChannelMajor ? utilities::ChannelMajorTensorOrder : utilities::RowMajorTensorOrder });
         auto convOutputLayout = originalOutputLayout.ReorderedCopy({ shouldReorderToChannelMajor ? utilities::ChannelMajorTensorOrder : utilities::RowMajorTensorOrder });
@@ -88,6 +91,12 @@ namespace nodes
             convOutput = &convNode->output;
         }
         break;
+        case ConvolutionMethod::tiled:
+        {
+            auto convNode = transformer.AddNode<TiledConvolutionNode<ValueType>>(*newInput, convInputLayout, convOutputLayout, weights, convParams.stride);
+            convOutput = &convNode->output;
+        }
+        break;
         default:
             throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented);
         }
@@ -0,0 +1,548 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FusedElementwiseNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FusedElementwiseNode.h"
+#include "ActivationFunctions.h"
+
+#include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRMath.h>
+#include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IRVectorUtilities.h>
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    FusedElementwiseNode<ValueType>::FusedElementwiseNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    FusedElementwiseNode<ValueType>::FusedElementwiseNode(const model::OutputPort<ValueType>& input,
+                                                          const model::PortMemoryLayout& inputLayout,
+                                                          const std::vector<const model::OutputPort<ValueType>*>& secondaryInputs,
+                                                          const std::vector<FusedElementwiseStage<ValueType>>& stages,
+                                                          const model::PortMemoryLayout& outputLayout,
+                                                          ValueType padding) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputLayout),
+        _inputLayout(inputLayout),
+        _stages(stages),
+        _paddingValue(padding)
+    {
+        if (inputLayout.GetActiveSize() != outputLayout.GetActiveSize())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "FusedElementwiseNode: Input and output active area sizes don't match");
+        }
+
+        for (auto port : secondaryInputs)
+        {
+            AddSecondaryInput(*port);
+        }
+        InitializeSecondaryInputDimensions();
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::AddSecondaryInput(const model::OutputPort<ValueType>& port)
+    {
+        auto portName = std::string(secondaryInputPortNamePrefix) + std::to_string(_secondaryInputs.size());
+        _secondaryInputs.emplace_back(std::make_unique<model::InputPort<ValueType>>(this, port, portName));
+        AddInputPort(_secondaryInputs.back().get());
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::InitializeSecondaryInputDimensions()
+    {
+        const auto numDimensions = _inputLayout.NumDimensions();
+        const auto numSecondaryInputs = NumSecondaryInputs();
+        _secondaryInputDimensions.assign(numSecondaryInputs, -1);
+        auto setDimension = [&](int index, int dimension) {
+            if (index < 0)
+            {
+                return;
+            }
+            if (index >= numSecondaryInputs || _secondaryInputDimensions[index] != -1)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "FusedElementwiseNode: Each secondary input must be used by exactly one stage");
+            }
+            if (GetSecondaryInput(index).Size() != static_cast<size_t>(_inputLayout.GetActiveSize(dimension)))
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "FusedElementwiseNode: Secondary input size doesn't match the size of its dimension");
+            }
+            _secondaryInputDimensions[index] = dimension;
+        };
+
+        for (const auto& stage : _stages)
+        {
+            if (stage.operation != FusedElementwiseOperation::linear)
+            {
+                continue;
+            }
+            if (stage.broadcastDimension < 0 || stage.broadcastDimension >= numDimensions)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "FusedElementwiseNode: Broadcast dimension out of range");
+            }
+            setDimension(stage.scaleInput, stage.broadcastDimension);
+            setDimension(stage.biasInput, stage.broadcastDimension);
+        }
+
+        if (std::find(_secondaryInputDimensions.begin(), _secondaryInputDimensions.end(), -1) != _secondaryInputDimensions.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "FusedElementwiseNode: Each secondary input must be used by exactly one stage");
+        }
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInput = transformer.GetCorrespondingInputs(_input);
+        std::vector<const model::OutputPort<ValueType>*> newSecondaryInputs;
+        for (const auto& port : _secondaryInputs)
+        {
+            newSecondaryInputs.push_back(&transformer.GetCorrespondingInputs(*port));
+        }
+        auto newNode = transformer.AddNode<FusedElementwiseNode<ValueType>>(newInput, _inputLayout, newSecondaryInputs, _stages, GetOutputMemoryLayout(), _paddingValue);
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    ValueType FusedElementwiseNode<ValueType>::ComputeStages(ValueType x, const std::vector<ValueType>& secondaryValues) const
+    {
+        for (const auto& stage : _stages)
+        {
+            switch (stage.operation)
+            {
+            case FusedElementwiseOperation::linear:
+                x = (stage.scaleInput < 0 ? x : secondaryValues[stage.scaleInput] * x) + (stage.biasInput < 0 ? 0 : secondaryValues[stage.biasInput]);
+                break;
+            case FusedElementwiseOperation::relu:
+                x = ReLUActivationFunction<ValueType>().Compute(x);
+                break;
+            case FusedElementwiseOperation::leakyReLU:
+                x = LeakyReLUActivationFunction<ValueType>(stage.parameter).Compute(x);
+                break;
+            case FusedElementwiseOperation::sigmoid:
+                x = SigmoidActivationFunction<ValueType>().Compute(x);
+                break;
+            case FusedElementwiseOperation::hardSigmoid:
+                x = HardSigmoidActivationFunction<ValueType>().Compute(x);
+                break;
+            case FusedElementwiseOperation::tanh:
+                x = TanhActivationFunction<ValueType>().Compute(x);
+                break;
+            case FusedElementwiseOperation::hardTanh:
+                x = HardTanhActivationFunction<ValueType>().Compute(x);
+                break;
+            case FusedElementwiseOperation::abs:
+                x = std::abs(x);
+                break;
+            case FusedElementwiseOperation::sqrt:
+                x = std::sqrt(x);
+                break;
+            case FusedElementwiseOperation::square:
+                x = x * x;
+                break;
+            case FusedElementwiseOperation::exp:
+                x = std::exp(x);
+                break;
+            case FusedElementwiseOperation::log:
+                x = std::log(x);
+                break;
+            case FusedElementwiseOperation::sin:
+                x = std::sin(x);
+                break;
+            case FusedElementwiseOperation::cos:
+                x = std::cos(x);
+                break;
+            default:
+                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Unknown fused elementwise operation");
+            }
+        }
+        return x;
+    }
+
+    template <typename ValueType>
+    emitters::LLVMValue FusedElementwiseNode<ValueType>::EmitStages(emitters::IRFunctionEmitter& function, emitters::LLVMValue x, const std::vector<emitters::LLVMValue>& secondaryValues) const
+    {
+        for (const auto& stage : _stages)
+        {
+            switch (stage.operation)
+            {
+            case FusedElementwiseOperation::linear:
+                if (stage.scaleInput >= 0)
+                {
+                    x = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), secondaryValues[stage.scaleInput], x);
+                }
+                if (stage.biasInput >= 0)
+                {
+                    x = function.Operator(emitters::GetAddForValueType<ValueType>(), x, secondaryValues[stage.biasInput]);
+                }
+                break;
+            case FusedElementwiseOperation::relu:
+                x = ReLUActivationFunction<ValueType>().Compile(function, x);
+                break;
+            case FusedElementwiseOperation::leakyReLU:
+                x = LeakyReLUActivationFunction<ValueType>(stage.parameter).Compile(function, x);
+                break;
+            case FusedElementwiseOperation::sigmoid:
+                x = SigmoidActivationFunction<ValueType>().Compile(function, x);
+                break;
+            case FusedElementwiseOperation::hardSigmoid:
+                x = HardSigmoidActivationFunction<ValueType>().Compile(function, x);
+                break;
+            case FusedElementwiseOperation::tanh:
+                x = TanhActivationFunction<ValueType>().Compile(function, x);
+                break;
+            case FusedElementwiseOperation::hardTanh:
+                x = HardTanhActivationFunction<ValueType>().Compile(function, x);
+                break;
+            case FusedElementwiseOperation::abs:
+                x = emitters::Abs(function.LocalScalar(x));
+                break;
+            case FusedElementwiseOperation::sqrt:
+                x = emitters::Sqrt(function.LocalScalar(x));
+                break;
+            case FusedElementwiseOperation::square:
+                x = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), x, x);
+                break;
+            case FusedElementwiseOperation::exp:
+                x = emitters::Exp(function.LocalScalar(x));
+                break;
+            case FusedElementwiseOperation::log:
+                x = emitters::Log(function.LocalScalar(x));
+                break;
+            case FusedElementwiseOperation::sin:
+                x = emitters::Sin(function.LocalScalar(x));
+                break;
+            case FusedElementwiseOperation::cos:
+                x = emitters::Cos(function.LocalScalar(x));
+                break;
+            default:
+                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Unknown fused elementwise operation");
+            }
+        }
+        return x;
+    }
+
+    // Emits the same nested loops as BroadcastFunctionNode, except that the secondary values for each stage are
+    // loaded in the loop over that stage's broadcast dimension.
+    // Note: secondaryValues is passed by non-const reference to avoid copies. It doesn't function as an output parameter.
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::ComputeDimensionLoop(int dimension, std::vector<ValueType>& output, size_t prevInputDimensionOffset, size_t prevOutputDimensionOffset, std::vector<ValueType>& secondaryValues) const
+    {
+        const int numDimensions = _inputLayout.NumDimensions();
+        auto&& inputStride = _inputLayout.GetExtent();
+        auto&& inputOffset = _inputLayout.GetOffset();
+        auto&& inputSize = _inputLayout.GetActiveSize();
+        auto&& outputLayout = GetOutputMemoryLayout();
+        auto&& outputStride = outputLayout.GetExtent();
+        auto&& outputOffset = outputLayout.GetOffset();
+        auto&& primaryInput = _input.GetValueReference();
+
+        for (int loopIndex = 0; loopIndex < inputSize[dimension]; ++loopIndex)
+        {
+            size_t thisInputDimensionOffset = loopIndex + inputOffset[dimension];
+            size_t thisOutputDimensionOffset = loopIndex + outputOffset[dimension];
+            if (dimension != 0)
+            {
+                thisInputDimensionOffset += prevInputDimensionOffset * inputStride[dimension];
+                thisOutputDimensionOffset += prevOutputDimensionOffset * outputStride[dimension];
+            }
+
+            for (int index = 0; index < NumSecondaryInputs(); ++index)
+            {
+                if (_secondaryInputDimensions[index] == dimension)
+                {
+                    secondaryValues[index] = GetSecondaryInput(index)[loopIndex];
+                }
+            }
+
+            if (dimension < numDimensions - 1)
+            {
+                ComputeDimensionLoop(dimension + 1, output, thisInputDimensionOffset, thisOutputDimensionOffset, secondaryValues);
+            }
+            else
+            {
+                output[thisOutputDimensionOffset] = ComputeStages(primaryInput[thisInputDimensionOffset], secondaryValues);
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::EmitComputeDimensionLoop(emitters::IRFunctionEmitter& function, int dimension, emitters::LLVMValue input, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, std::vector<emitters::LLVMValue>& secondaryValues) const
+    {
+        const int numDimensions = _inputLayout.NumDimensions();
+        auto&& inputStride = _inputLayout.GetExtent();
+        auto&& inputOffset = _inputLayout.GetOffset();
+        auto&& inputSize = _inputLayout.GetActiveSize();
+        auto&& outputLayout = GetOutputMemoryLayout();
+        auto&& outputStride = outputLayout.GetExtent();
+        auto&& outputOffset = outputLayout.GetOffset();
+
+        // The innermost dimension is contiguous, so it's processed a vector at a time if every stage can be. Otherwise,
+        // fusing would lose the vectorization the individual elementwise nodes get.
+        if (dimension == numDimensions - 1 && CanVectorizeStages())
+        {
+            const int vectorSize = emitters::GetElementwiseVectorWidth<ValueType>(function.GetCompilerOptions());
+            if (vectorSize > 1)
+            {
+                EmitVectorizedInnerLoop(function, vectorSize, input, secondaryInputs, output, prevInputDimensionOffset, prevOutputDimensionOffset, secondaryValues);
+                return;
+            }
+        }
+
+        function.For(inputSize[dimension], [=, &secondaryValues](emitters::IRFunctionEmitter& function, auto loopIndex) {
+            auto thisInputDimensionOffset = function.LocalScalar();
+            auto thisOutputDimensionOffset = function.LocalScalar();
+            if (dimension == 0)
+            {
+                thisInputDimensionOffset = loopIndex + inputOffset[dimension];
+                thisOutputDimensionOffset = loopIndex + outputOffset[dimension];
+            }
+            else
+            {
+                thisInputDimensionOffset = (loopIndex + inputOffset[dimension]) + (prevInputDimensionOffset * inputStride[dimension]);
+                thisOutputDimensionOffset = (loopIndex + outputOffset[dimension]) + (prevOutputDimensionOffset * outputStride[dimension]);
+            }
+
+            for (int index = 0; index < this->NumSecondaryInputs(); ++index)
+            {
+                if (_secondaryInputDimensions[index] == dimension)
+                {
+                    secondaryValues[index] = function.ValueAt(secondaryInputs[index], loopIndex);
+                }
+            }
+
+            if (dimension < numDimensions - 1)
+            {
+                this->EmitComputeDimensionLoop(function, dimension + 1, input, secondaryInputs, output, thisInputDimensionOffset, thisOutputDimensionOffset, secondaryValues);
+            }
+            else
+            {
+                auto inputValue = function.ValueAt(input, thisInputDimensionOffset);
+                function.SetValueAt(output, thisOutputDimensionOffset, this->EmitStages(function, inputValue, secondaryValues));
+            }
+        });
+    }
+
+    template <typename ValueType>
+    bool FusedElementwiseNode<ValueType>::CanVectorizeStages() const
+    {
+        return std::all_of(_stages.begin(), _stages.end(), [](const FusedElementwiseStage<ValueType>& stage) {
+            switch (stage.operation)
+            {
+            case FusedElementwiseOperation::linear:
+            case FusedElementwiseOperation::relu:
+            case FusedElementwiseOperation::abs:
+            case FusedElementwiseOperation::sqrt:
+            case FusedElementwiseOperation::square:
+                return true;
+            default:
+                return false;
+            }
+        });
+    }
+
+    // Emits the stages with operations that work on vector values as well as scalars (the scalar loop that handles
+    // the leftover elements uses this too)
+    template <typename ValueType>
+    emitters::LLVMValue FusedElementwiseNode<ValueType>::EmitVectorizedStages(emitters::IRFunctionEmitter& function, emitters::LLVMValue x, const std::vector<emitters::LLVMValue>& secondaryValues) const
+    {
+        auto& builder = function.GetEmitter().GetIRBuilder();
+        for (const auto& stage : _stages)
+        {
+            switch (stage.operation)
+            {
+            case FusedElementwiseOperation::linear:
+                if (stage.scaleInput >= 0)
+                {
+                    x = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), secondaryValues[stage.scaleInput], x);
+                }
+                if (stage.biasInput >= 0)
+                {
+                    x = function.Operator(emitters::GetAddForValueType<ValueType>(), x, secondaryValues[stage.biasInput]);
+                }
+                break;
+            case FusedElementwiseOperation::relu:
+            {
+                auto zero = llvm::Constant::getNullValue(x->getType());
+                x = builder.CreateSelect(builder.CreateFCmpOGE(x, zero), x, zero);
+                break;
+            }
+            case FusedElementwiseOperation::abs:
+                x = function.Call(function.GetModule().GetIntrinsic(llvm::Intrinsic::fabs, { x->getType() }), { x });
+                break;
+            case FusedElementwiseOperation::sqrt:
+                x = function.Call(function.GetModule().GetIntrinsic(llvm::Intrinsic::sqrt, { x->getType() }), { x });
+                break;
+            case FusedElementwiseOperation::square:
+                x = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), x, x);
+                break;
+            default:
+                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Fused elementwise operation has no vector form");
+            }
+        }
+        return x;
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::EmitVectorizedInnerLoop(emitters::IRFunctionEmitter& function, int vectorSize, emitters::LLVMValue input, const std::vector<emitters::LLVMValue>& secondaryInputs, emitters::LLVMValue output, emitters::IRLocalScalar prevInputDimensionOffset, emitters::IRLocalScalar prevOutputDimensionOffset, const std::vector<emitters::LLVMValue>& secondaryValues) const
+    {
+        const int dimension = _inputLayout.NumDimensions() - 1;
+        auto&& inputStride = _inputLayout.GetExtent();
+        auto&& inputOffset = _inputLayout.GetOffset();
+        auto&& inputSize = _inputLayout.GetActiveSize();
+        auto&& outputLayout = GetOutputMemoryLayout();
+        auto&& outputStride = outputLayout.GetExtent();
+        auto&& outputOffset = outputLayout.GetOffset();
+        const int numSecondaryInputs = NumSecondaryInputs();
+
+        emitters::VectorizedFor(function, inputSize[dimension], vectorSize, [=](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar loopIndex, int width) {
+            auto thisInputDimensionOffset = function.LocalScalar();
+            auto thisOutputDimensionOffset = function.LocalScalar();
+            if (dimension == 0)
+            {
+                thisInputDimensionOffset = loopIndex + inputOffset[dimension];
+                thisOutputDimensionOffset = loopIndex + outputOffset[dimension];
+            }
+            else
+            {
+                thisInputDimensionOffset = (loopIndex + inputOffset[dimension]) + (prevInputDimensionOffset * inputStride[dimension]);
+                thisOutputDimensionOffset = (loopIndex + outputOffset[dimension]) + (prevOutputDimensionOffset * outputStride[dimension]);
+            }
+
+            // Secondary values along the innermost dimension are contiguous too. Otherwise, an outer loop already
+            // loaded them, and they're the same for every element of the vector.
+            std::vector<emitters::LLVMValue> vectorSecondaryValues(numSecondaryInputs, nullptr);
+            for (int index = 0; index < numSecondaryInputs; ++index)
+            {
+                vectorSecondaryValues[index] = _secondaryInputDimensions[index] == dimension ? emitters::LoadVector(function, secondaryInputs[index], loopIndex, width) : emitters::SplatVector(function, secondaryValues[index], width);
+            }
+
+            auto inputValue = emitters::LoadVector(function, input, thisInputDimensionOffset, width);
+            emitters::StoreVector(function, output, thisOutputDimensionOffset, this->EmitVectorizedStages(function, inputValue, vectorSecondaryValues));
+        });
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::Compute() const
+    {
+        auto outputSize = GetOutputMemoryLayout().GetExtent().NumElements();
+
+        // Compute directly into the port's storage, which is reused from call to call
+        auto& output = _output.GetOutputBuffer(outputSize);
+        std::fill(output.begin(), output.end(), _paddingValue);
+
+        std::vector<ValueType> secondaryValues(NumSecondaryInputs(), 0);
+        ComputeDimensionLoop(0, output, 0, 0, secondaryValues);
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        emitters::LLVMValue pInput = compiler.EnsurePortEmitted(_input);
+        std::vector<emitters::LLVMValue> secondaryInputs;
+        for (const auto& port : _secondaryInputs)
+        {
+            secondaryInputs.push_back(compiler.EnsurePortEmitted(*port));
+        }
+        emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(_output, _paddingValue);
+
+        std::vector<emitters::LLVMValue> secondaryValues(NumSecondaryInputs(), nullptr);
+        auto prevInputDimensionOffset = function.LocalScalar();
+        auto prevOutputDimensionOffset = function.LocalScalar();
+        EmitComputeDimensionLoop(function, 0, pInput, secondaryInputs, pOutput, prevInputDimensionOffset, prevOutputDimensionOffset, secondaryValues);
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        model::CompilableNode::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["numSecondaryInputs"] << NumSecondaryInputs();
+        for (int index = 0; index < NumSecondaryInputs(); ++index)
+        {
+            archiver[std::string(secondaryInputPortNamePrefix) + std::to_string(index)] << GetSecondaryInput(index);
+        }
+        archiver["inputLayout"] << _inputLayout;
+        archiver["outputLayout"] << GetOutputMemoryLayout();
+        archiver["paddingValue"] << _paddingValue;
+
+        std::vector<int> operations;
+        std::vector<ValueType> parameters;
+        std::vector<int> broadcastDimensions;
+        std::vector<int> scaleInputs;
+        std::vector<int> biasInputs;
+        for (const auto& stage : _stages)
+        {
+            operations.push_back(static_cast<int>(stage.operation));
+            parameters.push_back(stage.parameter);
+            broadcastDimensions.push_back(stage.broadcastDimension);
+            scaleInputs.push_back(stage.scaleInput);
+            biasInputs.push_back(stage.biasInput);
+        }
+        archiver["operations"] << operations;
+        archiver["parameters"] << parameters;
+        archiver["broadcastDimensions"] << broadcastDimensions;
+        archiver["scaleInputs"] << scaleInputs;
+        archiver["biasInputs"] << biasInputs;
+    }
+
+    template <typename ValueType>
+    void FusedElementwiseNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        model::CompilableNode::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        int numSecondaryInputs = 0;
+        archiver["numSecondaryInputs"] >> numSecondaryInputs;
+        _secondaryInputs.clear();
+        for (int index = 0; index < numSecondaryInputs; ++index)
+        {
+            model::InputPort<ValueType> port;
+            archiver[std::string(secondaryInputPortNamePrefix) + std::to_string(index)] >> port;
+            AddSecondaryInput(port.GetReferencedPort());
+        }
+        archiver["inputLayout"] >> _inputLayout;
+        model::PortMemoryLayout outputLayout;
+        archiver["outputLayout"] >> outputLayout;
+        _output.SetMemoryLayout(outputLayout);
+        archiver["paddingValue"] >> _paddingValue;
+
+        std::vector<int> operations;
+        std::vector<ValueType> parameters;
+        std::vector<int> broadcastDimensions;
+        std::vector<int> scaleInputs;
+        std::vector<int> biasInputs;
+        archiver["operations"] >> operations;
+        archiver["parameters"] >> parameters;
+        archiver["broadcastDimensions"] >> broadcastDimensions;
+        archiver["scaleInputs"] >> scaleInputs;
+        archiver["biasInputs"] >> biasInputs;
+        _stages.clear();
+        for (size_t index = 0; index < operations.size(); ++index)
+        {
+            _stages.push_back({ static_cast<FusedElementwiseOperation>(operations[index]), parameters[index], broadcastDimensions[index], scaleInputs[index], biasInputs[index] });
+        }
+        InitializeSecondaryInputDimensions();
+    }
+
+    // Explicit specialization
+    template class FusedElementwiseNode<float>;
+    template class FusedElementwiseNode<double>;
+} // namespace nodes
+} // namespace ell
@@ -8,6 +8,7 @@
 
 #include <model/include/ModelTransformer.h>
 
+#include <nodes/include/ConstantNode.h>
 #include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
 
 #include <utilities/include/ArchiveVersion.h>
@@ -35,6 +36,23 @@ namespace ell
 {
 namespace nodes
 {
+    namespace
+    {
+        // Returns the given range of columns of a row-major matrix
+        template <typename ValueType>
+        std::vector<ValueType> GetMatrixColumns(const std::vector<ValueType>& matrix, int numRows, int numColumns, int firstColumn, int numColumnsToGet)
+        {
+            std::vector<ValueType> result;
+            result.reserve(numRows * numColumnsToGet);
+            for (int row = 0; row < numRows; ++row)
+            {
+                auto rowBegin = matrix.begin() + row * numColumns + firstColumn;
+                result.insert(result.end(), rowBegin, rowBegin + numColumnsToGet);
+            }
+            return result;
+        }
+    } // namespace
+
     template <typename ValueType>
     MatrixMatrixMultiplyCodeNode<ValueType>::MatrixMatrixMultiplyCodeNode() :
         CompilableCodeNode("MatrixMatrixMultiplyCodeNode", { &_input1, &_input2 }, { &_output }),
@@ -217,7 +235,7 @@ namespace nodes
     }
 
     template <typename ValueType>
-    void MatrixMatrixMultiplyCodeNode<ValueType>::Gemm(value::Matrix A, value::Matrix B, value::Matrix C)
+    void MatrixMatrixMultiplyCodeNode<ValueType>::Gemm(value::Matrix A, value::Matrix B, value::Matrix C, int input2ColumnOffset)
     {
         using namespace value;
 
@@ -245,13 +263,23 @@ namespace nodes
             NumRowsInKernel *= 2;
         }
 
+        // Nonzero schedule parameters (e.g., from autotuning) override the defaults
+        if (_schedule.kernelRows > 0)
+        {
+            NumRowsInKernel = _schedule.kernelRows;
+        }
+        if (_schedule.kernelColumnVectors > 0)
+        {
+            NumColumnsInKernel = _schedule.kernelColumnVectors * vectorSize;
+        }
+
         // Declare and/or calculate constants
         const int OutputRows = (int)(A.Rows());
         const int OutputColumns = (int)(B.Columns());
         const int InnerDimension = (int)(A.Columns());
-        const int kUnroll = 4;
-        int columnBlock = std::min(64, OutputColumns);
-        int innerDimensionBlock = std::min(256, InnerDimension);    
+        const int kUnroll = _schedule.kUnroll > 0 ? _schedule.kUnroll : 4;
+        int columnBlock = std::min(_schedule.columnBlock > 0 ? _schedule.columnBlock : 64, OutputColumns);
+        int innerDimensionBlock = std::min(_schedule.innerDimensionBlock > 0 ? _schedule.innerDimensionBlock : 256, InnerDimension);
 
         // Declare indexes
         loopnests::Index i("i"), j("j"), k("k");
@@ -280,16 +308,58 @@ namespace nodes
         // Set the order
         schedule.SetOrder({ jCache, kCache, iKernelOuter, jKernelOuter2, kBlock, k, i, jKernelOuter, j });
 
-        // Set up caching    
-        if ((OutputColumns > NumColumnsInKernel) && ((OutputColumns % NumColumnsInKernel) == 0))
+        // Set up caching
+        const bool canUseBLASTCopy = (OutputColumns > NumColumnsInKernel) && ((OutputColumns % NumColumnsInKernel) == 0);
+        auto constantInput2 = GetConstantInputNode(_input2);
+        if (constantInput2 != nullptr && static_cast<int>(constantInput2->GetValues().size()) == _k * _n && canUseBLASTCopy && _schedule.cachingStrategy != MatrixMatrixMultiplyCachingStrategy::None)
         {
-            auto extraCacheBParams = std::make_tuple(NumColumnsInKernel, jKernelOuter2, BoundaryConditionHandling::ZeroPadding);
-            schedule.template Cache<BLASTCopy>(B,
-                                    { topLevelK, topLevelJ },
-                                    { innerDimensionBlock, columnBlock },
-                                    { kCache, jCache },
-                                    std::nullopt, // Order isn't used by BLASTCopy
-                                    extraCacheBParams);
+            // B is constant (e.g., weights), so pack it into BLASTCopy's cache layout at compile time instead of copying it on every call.
+            // The threads of a row-parallelized GEMM all see the same B, so they share a single packed copy.
+            auto input2Values = GetMatrixColumns(constantInput2->GetValues(), _k, _n, input2ColumnOffset, OutputColumns);
+            auto packedValues = PackForBLASTCopy(input2Values, InnerDimension, OutputColumns, { innerDimensionBlock, columnBlock }, NumColumnsInKernel);
+            auto packedName = "prepackedInput2_" + GetInternalStateIdentifier() + "_" + std::to_string(input2ColumnOffset) + "_" + std::to_string(OutputColumns);
+            auto packedB = GlobalAllocate(packedName, packedValues);
+            auto extraCacheBParams = std::make_tuple(NumColumnsInKernel, jKernelOuter2, packedB);
+            schedule.template Cache<PrepackedBLASTCopy>(B,
+                                                        { topLevelK, topLevelJ },
+                                                        { innerDimensionBlock, columnBlock },
+                                                        { kCache, jCache },
+                                                        std::nullopt, // Order isn't used by PrepackedBLASTCopy
+                                                        extraCacheBParams);
+        }
+        else
+        {
+            switch (_schedule.cachingStrategy)
+            {
+            case MatrixMatrixMultiplyCachingStrategy::BLASTCopy:
+                if (canUseBLASTCopy)
+                {
+                    auto extraCacheBParams = std::make_tuple(NumColumnsInKernel, jKernelOuter2, BoundaryConditionHandling::ZeroPadding);
+                    schedule.template Cache<BLASTCopy>(B,
+                                            { topLevelK, topLevelJ },
+                                            { innerDimensionBlock, columnBlock },
+                                            { kCache, jCache },
+                                            std::nullopt, // Order isn't used by BLASTCopy
+                                            extraCacheBParams);
+                }
+                break;
+            case MatrixMatrixMultiplyCachingStrategy::GeneralCachingStrategy:
+            {
+                size_t maxCacheElements = static_cast<size_t>(_schedule.cacheElements > 0 ? _schedule.cacheElements : innerDimensionBlock * columnBlock);
+                size_t fillThreshold = _schedule.cacheFillElements > 0 ? std::min(static_cast<size_t>(_schedule.cacheFillElements), maxCacheElements) : maxCacheElements;
+                std::function<ReduceFunctionType> reduceFunction = CopyReduce;
+                auto extraCacheBParams = std::make_tuple(ArgumentType::Input, std::string("cacheBInput"), maxCacheElements, fillThreshold, reduceFunction, false);
+                schedule.template Cache<GeneralCachingStrategy>(B,
+                                        { topLevelK, topLevelJ },
+                                        {},
+                                        {},
+                                        std::nullopt,
+                                        extraCacheBParams);
+                break;
+            }
+            case MatrixMatrixMultiplyCachingStrategy::None:
+                break;
+            }
         }
         auto extraZeroInputReduceOutputParams = std::make_tuple(vectorSize);
         schedule.template Cache<ZeroInputReduceOutput>(C,
@@ -309,12 +379,12 @@ namespace nodes
     }
 
     template <typename ValueType>
-    void MatrixMatrixMultiplyCodeNode<ValueType>::GemmFn(value::Matrix A, value::Matrix B, value::Matrix C, int thread_num)
+    void MatrixMatrixMultiplyCodeNode<ValueType>::GemmFn(value::Matrix A, value::Matrix B, value::Matrix C, int thread_num, int input2ColumnOffset)
     {
         value::DeclareFunction("InnerMatMul" + std::to_string(thread_num))
             .Parameters(A, B, C)
-            .Define([this](value::Matrix A, value::Matrix B, value::Matrix C) {
-                Gemm(A, B, C);
+            .Define([this, input2ColumnOffset](value::Matrix A, value::Matrix B, value::Matrix C) {
+                Gemm(A, B, C, input2ColumnOffset);
             })(A, B, C);
     }
 
@@ -338,7 +408,8 @@ namespace nodes
                             A,
                             B.SubMatrix(value::Scalar{0}, colStart, (int)B.Rows(), columns),
                             C.SubMatrix(value::Scalar{0}, colStart, (int)C.Rows(), columns),
-                            thread_seq);
+                            thread_seq,
+                            thread_seq * columns);
                 });
                 
                 thread_seq++;
@@ -353,7 +424,8 @@ namespace nodes
                                 A,
                                 B.SubMatrix(value::Scalar{0}, colStart, (int)B.Rows(), actualColumns),
                                 C.SubMatrix(value::Scalar{0}, colStart, (int)C.Rows(), actualColumns),
-                                i);
+                                i,
+                                i * columns);
                     });
                 }
             }); 
@@ -468,10 +540,17 @@ namespace nodes
 
     template <typename ValueType>
     void MatrixMatrixMultiplyCodeNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        CopyWithSchedule(transformer, _schedule);
+    }
+
+    template <typename ValueType>
+    void MatrixMatrixMultiplyCodeNode<ValueType>::CopyWithSchedule(model::ModelTransformer& transformer, const MatrixMatrixMultiplySchedule& schedule) const
     {
         const auto& newInput1 = transformer.GetCorrespondingInputs(_input1);
         const auto& newInput2 = transformer.GetCorrespondingInputs(_input2);
         auto newNode = transformer.AddNode<MatrixMatrixMultiplyCodeNode<ValueType>>(newInput1, _m, _n, _k, _lda, _transpose1, newInput2, _ldb, _transpose2, _ldc, _transposeOutput, _panelM, _panelN, _panelK, _kernelM, _kernelN, _kernelK, _impl);
+        newNode->_schedule = schedule;
         transformer.MapNodeOutput(output, newNode->output);
     }
 
@@ -511,6 +590,14 @@ namespace nodes
         archiver["kernelN"] << _kernelN;
         archiver["kernelK"] << _kernelK;
         archiver["gemmImpl"] << static_cast<int>(_impl);
+        archiver["scheduleColumnBlock"] << _schedule.columnBlock;
+        archiver["scheduleInnerDimensionBlock"] << _schedule.innerDimensionBlock;
+        archiver["scheduleKUnroll"] << _schedule.kUnroll;
+        archiver["scheduleKernelRows"] << _schedule.kernelRows;
+        archiver["scheduleKernelColumnVectors"] << _schedule.kernelColumnVectors;
+        archiver["scheduleCachingStrategy"] << static_cast<int>(_schedule.cachingStrategy);
+        archiver["scheduleCacheElements"] << _schedule.cacheElements;
+        archiver["scheduleCacheFillElements"] << _schedule.cacheFillElements;
     }
 
     template <typename ValueType>
@@ -538,6 +625,16 @@ namespace nodes
         int gemmImpl = 0;
         archiver["gemmImpl"] >> gemmImpl;
         _impl = static_cast<MatrixMatrixMultiplyImplementation>(gemmImpl);
+        archiver.OptionalProperty("scheduleColumnBlock", 0) >> _schedule.columnBlock;
+        archiver.OptionalProperty("scheduleInnerDimensionBlock", 0) >> _schedule.innerDimensionBlock;
+        archiver.OptionalProperty("scheduleKUnroll", 0) >> _schedule.kUnroll;
+        archiver.OptionalProperty("scheduleKernelRows", 0) >> _schedule.kernelRows;
+        archiver.OptionalProperty("scheduleKernelColumnVectors", 0) >> _schedule.kernelColumnVectors;
+        int cachingStrategy = 0;
+        archiver.OptionalProperty("scheduleCachingStrategy", 0) >> cachingStrategy;
+        _schedule.cachingStrategy = static_cast<MatrixMatrixMultiplyCachingStrategy>(cachingStrategy);
+        archiver.OptionalProperty("scheduleCacheElements", 0) >> _schedule.cacheElements;
+        archiver.OptionalProperty("scheduleCacheFillElements", 0) >> _schedule.cacheFillElements;
     }
 
     //
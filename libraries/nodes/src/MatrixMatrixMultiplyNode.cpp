@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MatrixMatrixMultiplyNode.h"
+#include "ReducedPrecisionWeights.h"
 
 #include <math/include/Matrix.h>
 #include <math/include/MatrixOperations.h>
@@ -92,6 +93,32 @@ namespace nodes
                 }
             }
         }
+
+        // Constant inputs can be stored in 16 bits. They're converted into a buffer of full-precision values the first
+        // time the function runs, so the GEMM call stays the same and later calls don't pay for the conversion. The
+        // flag and the buffer are both model state, so with reentrant code each state converts its own copy.
+        template <typename ValueType>
+        emitters::LLVMValue EnsureInputEmitted(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function, const model::InputPort<ValueType>& input, model::WeightStorageType storageType, const std::string& nameSuffix)
+        {
+            auto constantNode = GetConstantInputNode(input);
+            if (storageType == model::WeightStorageType::float32 || constantNode == nullptr)
+            {
+                return compiler.EnsurePortEmitted(input);
+            }
+
+            auto& module = function.GetModule();
+            const auto& values = constantNode->GetValues();
+            auto packedValues = EmitPackedWeights(function, values, storageType, "packedValues" + nameSuffix);
+            auto unpackedValues = function.PointerOffset(module.GlobalArray<ValueType>("unpackedValues" + nameSuffix, values.size()), 0);
+            auto isUnpacked = module.Global(llvm::Type::getInt1Ty(module.GetLLVMContext()), "isUnpacked" + nameSuffix);
+            function.If(function.LogicalNot(function.Load(isUnpacked)), [packedValues, unpackedValues, isUnpacked, storageType, numValues = static_cast<int>(values.size())](emitters::IRFunctionEmitter& function) {
+                function.For(numValues, [packedValues, unpackedValues, storageType](emitters::IRFunctionEmitter& function, auto index) {
+                    function.SetValueAt(unpackedValues, index, EmitUnpackWeight<ValueType>(function, packedValues, index, storageType));
+                });
+                function.Store(isUnpacked, function.TrueBit());
+            });
+            return unpackedValues;
+        }
     } // namespace
 
     template <typename ValueType>
@@ -234,8 +261,9 @@ namespace nodes
     template <typename ValueType>
     void MatrixMatrixMultiplyNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
-        emitters::LLVMValue pInput1 = compiler.EnsurePortEmitted(input1);
-        emitters::LLVMValue pInput2 = compiler.EnsurePortEmitted(input2);
+        auto storageType = compiler.GetModelOptimizerOptions(*this).template GetEntry<model::WeightStorageType>("weightStorageType", model::WeightStorageType::float32);
+        emitters::LLVMValue pInput1 = EnsureInputEmitted(compiler, function, input1, storageType, "1_" + GetInternalStateIdentifier());
+        emitters::LLVMValue pInput2 = EnsureInputEmitted(compiler, function, input2, storageType, "2_" + GetInternalStateIdentifier());
         emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
 
         if (_transposeOutput)
@@ -7,6 +7,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MatrixVectorMultiplyNode.h"
+#include "MatrixMatrixMultiplyNode.h"
+#include "ReducedPrecisionWeights.h"
 
 #include <math/include/Matrix.h>
 #include <math/include/MatrixOperations.h>
@@ -15,6 +17,26 @@ namespace ell
 {
 namespace nodes
 {
+    namespace
+    {
+        // Computes y = Ax for a constant A stored in 16 bits, converting each weight to floating-point as it's loaded.
+        // A GEMV reads each weight once, so halving the size of the weights halves the memory traffic.
+        template <typename ValueType>
+        void EmitPackedGEMV(emitters::IRFunctionEmitter& function, int m, int n, emitters::LLVMValue pPackedMatrix, int lda, emitters::LLVMValue pVector, int incx, emitters::LLVMValue pOutput, model::WeightStorageType storageType)
+        {
+            function.For(m, [=](emitters::IRFunctionEmitter& function, auto i) {
+                auto sum = function.Variable(emitters::GetVariableType<ValueType>());
+                function.StoreZero(sum);
+                function.For(n, [=](emitters::IRFunctionEmitter& function, auto j) {
+                    auto weight = EmitUnpackWeight<ValueType>(function, pPackedMatrix, i * lda + j, storageType);
+                    auto value = function.LocalScalar(function.ValueAt(pVector, j * incx));
+                    function.Store(sum, function.LocalScalar(function.Load(sum)) + weight * value);
+                });
+                function.SetValueAt(pOutput, i, function.Load(sum));
+            });
+        }
+    } // namespace
+
     template <typename ValueType>
     MatrixVectorMultiplyNode<ValueType>::MatrixVectorMultiplyNode() :
         CompilableNode({ &_inputMatrix, &_inputVector }, { &_output }),
@@ -77,9 +99,39 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool MatrixVectorMultiplyNode<ValueType>::Batch(model::ModelTransformer& transformer) const
+    {
+        // A batch of vectors is a matrix with one example per row, so y = Ax for every example is Y = XA'.
+        // That reads each element of A once per batch, rather than once per example.
+        if (transformer.IsBatched(_inputMatrix) || _lda != _n || _incx != 1)
+        {
+            return false;
+        }
+
+        const auto& matrixElements = transformer.GetCorrespondingInputs(_inputMatrix);
+        const auto& vectorElements = transformer.GetCorrespondingInputs(_inputVector);
+        const auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<MatrixMatrixMultiplyNode<ValueType>>(vectorElements, batchSize, (int)_m, (int)_n, (int)_n, false, matrixElements, (int)_lda, true, (int)_m);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void MatrixVectorMultiplyNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
+        auto storageType = compiler.GetModelOptimizerOptions(*this).template GetEntry<model::WeightStorageType>("weightStorageType", model::WeightStorageType::float32);
+        auto weightsNode = GetConstantInputNode(inputMatrix);
+        if (storageType != model::WeightStorageType::float32 && weightsNode != nullptr)
+        {
+            using namespace std::string_literals;
+            emitters::LLVMValue pPackedMatrix = EmitPackedWeights(function, weightsNode->GetValues(), storageType, "packedWeights_"s + GetInternalStateIdentifier());
+            emitters::LLVMValue pInputVector = compiler.EnsurePortEmitted(inputVector);
+            emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
+            EmitPackedGEMV<ValueType>(function, (int)_m, (int)_n, pPackedMatrix, (int)_lda, pInputVector, (int)_incx, pOutput, storageType);
+            return;
+        }
+
         emitters::LLVMValue pInputMatrix = compiler.EnsurePortEmitted(inputMatrix);
         emitters::LLVMValue pInputVector = compiler.EnsurePortEmitted(inputVector);
         emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedConvolutionNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizedConvolutionNode.h"
+#include "ReceptiveFieldMatrixNode.h"
+#include "ReorderDataCodeNode.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        // Reshapes the filter weights to a (numFilters) x (filterSize * filterSize * inputDepth) matrix with columns in (row, column, channel) order
+        template <typename ValueType>
+        std::vector<ValueType> GetWeightsMatrix(const math::ConstChannelColumnRowTensorReference<ValueType>& weightsTensor, int numFilters)
+        {
+            const auto filterSize = static_cast<int>(weightsTensor.NumColumns());
+            auto flattened = weightsTensor.ReferenceAsMatrix();
+            const auto rowSize = static_cast<int>(flattened.NumColumns());
+            std::vector<ValueType> weightsMatrix(numFilters * filterSize * rowSize);
+            for (int filter = 0; filter < numFilters; ++filter)
+            {
+                for (int row = 0; row < filterSize; ++row)
+                {
+                    auto weightsVector = flattened.GetMajorVector(filter * filterSize + row);
+                    for (int i = 0; i < rowSize; ++i)
+                    {
+                        weightsMatrix[(filter * filterSize + row) * rowSize + i] = weightsVector[i];
+                    }
+                }
+            }
+            return weightsMatrix;
+        }
+    } // namespace
+
+    template <typename ValueType>
+    QuantizedConvolutionNode<ValueType>::QuantizedConvolutionNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    QuantizedConvolutionNode<ValueType>::QuantizedConvolutionNode(const model::OutputPort<ValueType>& input,
+                                                                  const model::PortMemoryLayout& inputMemoryLayout,
+                                                                  const model::PortMemoryLayout& outputMemoryLayout,
+                                                                  const ConstTensorReferenceType& filterWeights,
+                                                                  int stride,
+                                                                  ValueType inputRange) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputMemoryLayout),
+        _inputMemoryLayout(inputMemoryLayout),
+        _inputScale(GetQuantizationScale(inputRange)),
+        _filterSize(static_cast<int>(filterWeights.NumColumns())),
+        _stride(stride)
+    {
+        const auto inputDepth = inputMemoryLayout.GetLogicalDimensionActiveSize(2);
+        const auto numFilters = outputMemoryLayout.GetLogicalDimensionActiveSize(2);
+        if (static_cast<int>(filterWeights.NumChannels()) != inputDepth)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "QuantizedConvolutionNode doesn't support depthwise-separable convolutions");
+        }
+
+        _filterWeights = QuantizeWeights(GetWeightsMatrix(filterWeights, numFilters), numFilters, _filterSize * _filterSize * inputDepth);
+    }
+
+    template <typename ValueType>
+    QuantizedConvolutionNode<ValueType>::QuantizedConvolutionNode(const model::OutputPort<ValueType>& input,
+                                                                  const model::PortMemoryLayout& inputMemoryLayout,
+                                                                  const model::PortMemoryLayout& outputMemoryLayout,
+                                                                  const QuantizedWeights<ValueType>& filterWeights,
+                                                                  int filterSize,
+                                                                  int stride,
+                                                                  ValueType inputScale) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputMemoryLayout),
+        _inputMemoryLayout(inputMemoryLayout),
+        _filterWeights(filterWeights),
+        _inputScale(inputScale),
+        _filterSize(filterSize),
+        _stride(stride)
+    {
+    }
+
+    template <typename ValueType>
+    void QuantizedConvolutionNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInput = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<QuantizedConvolutionNode<ValueType>>(newInput, _inputMemoryLayout, GetOutputMemoryLayout(), _filterWeights, _filterSize, _stride, _inputScale);
+        transformer.MapNodeOutput(this->output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void QuantizedConvolutionNode<ValueType>::Compute() const
+    {
+        const auto& inputLayout = GetInputMemoryLayout();
+        const auto outputLayout = GetOutputMemoryLayout();
+        const auto inputIncrement = inputLayout.GetLogicalDimensionIncrement();
+        const auto outputIncrement = outputLayout.GetLogicalDimensionIncrement();
+        const auto outputOffset = outputLayout.GetLogicalDimensionOffset();
+        const auto inputDepth = inputLayout.GetLogicalDimensionActiveSize(2);
+        const auto outputRows = outputLayout.GetLogicalDimensionActiveSize(0);
+        const auto outputColumns = outputLayout.GetLogicalDimensionActiveSize(1);
+        const auto numFilters = outputLayout.GetLogicalDimensionActiveSize(2);
+        const auto fieldVolume = _filterSize * _filterSize * inputDepth;
+
+        // The input buffer includes its padding, so the receptive field for output (r, c) starts at (r * stride, c * stride)
+        auto inputValues = _input.GetValue();
+        std::vector<int> quantizedInput(inputValues.size());
+        std::transform(inputValues.begin(), inputValues.end(), quantizedInput.begin(), [this](ValueType value) { return QuantizeValue(value, _inputScale); });
+
+        std::vector<ValueType> outputValues(outputLayout.GetMemorySize());
+        for (int outputRow = 0; outputRow < outputRows; ++outputRow)
+        {
+            for (int outputColumn = 0; outputColumn < outputColumns; ++outputColumn)
+            {
+                for (int filter = 0; filter < numFilters; ++filter)
+                {
+                    int32_t sum = 0;
+                    for (int filterRow = 0; filterRow < _filterSize; ++filterRow)
+                    {
+                        for (int filterColumn = 0; filterColumn < _filterSize; ++filterColumn)
+                        {
+                            for (int channel = 0; channel < inputDepth; ++channel)
+                            {
+                                auto inputIndex = (outputRow * _stride + filterRow) * inputIncrement[0] + (outputColumn * _stride + filterColumn) * inputIncrement[1] + channel * inputIncrement[2];
+                                auto weightIndex = filter * fieldVolume + (filterRow * _filterSize + filterColumn) * inputDepth + channel;
+                                sum += static_cast<int32_t>(_filterWeights.values[weightIndex]) * quantizedInput[inputIndex];
+                            }
+                        }
+                    }
+                    auto outputIndex = (outputRow + outputOffset[0]) * outputIncrement[0] + (outputColumn + outputOffset[1]) * outputIncrement[1] + (filter + outputOffset[2]) * outputIncrement[2];
+                    outputValues[outputIndex] = static_cast<ValueType>(sum) * _filterWeights.scales[filter] * _inputScale;
+                }
+            }
+        }
+        _output.SetOutput(outputValues);
+    }
+
+    template <typename ValueType>
+    bool QuantizedConvolutionNode<ValueType>::Refine(model::ModelTransformer& transformer) const
+    {
+        const auto& inputLayout = GetInputMemoryLayout();
+        const auto outputLayout = GetOutputMemoryLayout();
+
+        const auto inputDepth = inputLayout.GetLogicalDimensionActiveSize(2);
+        const auto inputPadding = inputLayout.GetLogicalDimensionOffset(0);
+        const auto outputImageHeight = outputLayout.GetLogicalDimensionActiveSize(0);
+        const auto outputImageWidth = outputLayout.GetLogicalDimensionActiveSize(1);
+        const auto outputPadding = outputLayout.GetLogicalDimensionOffset(0);
+        const auto numFilters = outputLayout.GetLogicalDimensionActiveSize(2);
+        const auto& newInput = transformer.GetCorrespondingInputs(this->input);
+
+        // weights: numFilters x fieldVolumeSize == m x k
+        // ShapedInput: fieldVolumeSize x outputRows == k x n
+        // Matrix multiply output: (numFilters x outputRows)' == n x m
+        const auto m = numFilters;
+        const auto n = outputImageWidth * outputImageHeight;
+        const auto k = _filterSize * _filterSize * inputDepth;
+        const auto rcdOrder = utilities::RowMajorTensorOrder;
+
+        auto receptiveFieldMatrixNode = transformer.AddNode<ReceptiveFieldMatrixNode<ValueType>>(newInput, inputLayout, _filterSize, _stride, inputPadding, rcdOrder, outputImageWidth, outputImageHeight);
+        model::PortMemoryLayout unpaddedOutputLayout(model::MemoryShape{ outputImageHeight, outputImageWidth, numFilters });
+        auto matrixMultNode = transformer.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(receptiveFieldMatrixNode->output, m, n, k, _filterWeights, _inputScale, true, unpaddedOutputLayout);
+        if (outputPadding != 0)
+        {
+            // Add padding
+            model::PortMemoryLayout paddedOutputLayout(model::MemoryShape{ outputImageHeight, outputImageWidth, numFilters }, model::MemoryShape{ outputPadding, outputPadding, 0 });
+            const auto& reorderedOutput = ReorderDataWithCodeNode(matrixMultNode->output, unpaddedOutputLayout, paddedOutputLayout);
+            transformer.MapNodeOutput(this->output, reorderedOutput);
+        }
+        else
+        {
+            transformer.MapNodeOutput(this->output, matrixMultNode->output);
+        }
+        return true;
+    }
+
+    template <typename ValueType>
+    void QuantizedConvolutionNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "QuantizedConvolutionNode must be refined before compiling");
+    }
+
+    template <typename ValueType>
+    void QuantizedConvolutionNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        model::CompilableNode::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["inputLayout"] << _inputMemoryLayout;
+        archiver["outputLayout"] << GetOutputMemoryLayout();
+        archiver["filterSize"] << _filterSize;
+        archiver["stride"] << _stride;
+        archiver["weights"] << std::vector<int>(_filterWeights.values.begin(), _filterWeights.values.end());
+        archiver["weightScales"] << _filterWeights.scales;
+        archiver["inputScale"] << _inputScale;
+    }
+
+    template <typename ValueType>
+    void QuantizedConvolutionNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        model::CompilableNode::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["inputLayout"] >> _inputMemoryLayout;
+        model::PortMemoryLayout outputMemoryLayout;
+        archiver["outputLayout"] >> outputMemoryLayout;
+        _output.SetMemoryLayout(outputMemoryLayout);
+        archiver["filterSize"] >> _filterSize;
+        archiver["stride"] >> _stride;
+        std::vector<int> weightValues;
+        archiver["weights"] >> weightValues;
+        _filterWeights.values.assign(weightValues.begin(), weightValues.end());
+        archiver["weightScales"] >> _filterWeights.scales;
+        archiver["inputScale"] >> _inputScale;
+    }
+
+    // Explicit specializations
+    template class QuantizedConvolutionNode<float>;
+    template class QuantizedConvolutionNode<double>;
+} // namespace nodes
+} // namespace ell
@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrixMatrixMultiplyNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizedMatrixMatrixMultiplyNode.h"
+
+#include <emitters/include/IRMath.h>
+#include <emitters/include/IRVectorUtilities.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        constexpr int maxQuantizedValue = 127;
+
+        // The number of input columns the compiled kernel multiplies each row of weights by at once
+        constexpr int numColumnsInKernel = 4;
+    } // namespace
+
+    template <typename ValueType>
+    ValueType GetQuantizationScale(ValueType range)
+    {
+        return range > 0 ? range / maxQuantizedValue : static_cast<ValueType>(1);
+    }
+
+    template <typename ValueType>
+    int QuantizeValue(ValueType value, ValueType scale)
+    {
+        auto scaled = std::max(std::min(value / scale, static_cast<ValueType>(maxQuantizedValue)), static_cast<ValueType>(-maxQuantizedValue));
+        return static_cast<int>(std::round(scaled));
+    }
+
+    template <typename ValueType>
+    QuantizedWeights<ValueType> QuantizeWeights(const std::vector<ValueType>& weights, int numRows, int numColumns)
+    {
+        if (static_cast<int>(weights.size()) != numRows * numColumns)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Weights matrix has the wrong number of entries");
+        }
+
+        QuantizedWeights<ValueType> result;
+        result.values.resize(weights.size());
+        result.scales.resize(numRows);
+        for (int i = 0; i < numRows; ++i)
+        {
+            auto rowBegin = weights.begin() + i * numColumns;
+            auto rowEnd = rowBegin + numColumns;
+            ValueType range = 0;
+            std::for_each(rowBegin, rowEnd, [&range](ValueType value) { range = std::max(range, std::abs(value)); });
+            auto scale = GetQuantizationScale(range);
+            result.scales[i] = scale;
+            for (int j = 0; j < numColumns; ++j)
+            {
+                result.values[i * numColumns + j] = static_cast<int8_t>(QuantizeValue(weights[i * numColumns + j], scale));
+            }
+        }
+        return result;
+    }
+
+    template <typename ValueType>
+    QuantizedMatrixMatrixMultiplyNode<ValueType>::QuantizedMatrixMatrixMultiplyNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    QuantizedMatrixMatrixMultiplyNode<ValueType>::QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const std::vector<ValueType>& weights, ValueType inputRange, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout) :
+        QuantizedMatrixMatrixMultiplyNode(input, m, n, k, QuantizeWeights(weights, m, k), GetQuantizationScale(inputRange), transposeOutput, outputMemoryLayout)
+    {
+    }
+
+    template <typename ValueType>
+    QuantizedMatrixMatrixMultiplyNode<ValueType>::QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const QuantizedWeights<ValueType>& weights, ValueType inputScale, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputMemoryLayout),
+        _m(m),
+        _n(n),
+        _k(k),
+        _weights(weights),
+        _inputScale(inputScale),
+        _transposeOutput(transposeOutput)
+    {
+        VerifyDimensions();
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::VerifyDimensions() const
+    {
+        if (static_cast<int>(_input.Size()) != _k * _n)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Input must be a k x n matrix");
+        }
+        if (static_cast<int>(_weights.values.size()) != _m * _k || static_cast<int>(_weights.scales.size()) != _m)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Weights must be an m x k matrix with one scale per row");
+        }
+        const auto& outputLayout = _output.GetMemoryLayout();
+        if (static_cast<int>(outputLayout.GetMemorySize()) != _m * _n || outputLayout.HasPadding())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Output layout must hold an unpadded m x n matrix");
+        }
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::Compute() const
+    {
+        auto inputValues = _input.GetValue();
+
+        // Quantize the input, transposing it so each dot product reads contiguous memory
+        std::vector<int> quantizedInput(_k * _n);
+        for (int l = 0; l < _k; ++l)
+        {
+            for (int j = 0; j < _n; ++j)
+            {
+                quantizedInput[j * _k + l] = QuantizeValue(inputValues[l * _n + j], _inputScale);
+            }
+        }
+
+        std::vector<ValueType> outputValues(_m * _n);
+        for (int i = 0; i < _m; ++i)
+        {
+            const auto outputScale = _weights.scales[i] * _inputScale;
+            for (int j = 0; j < _n; ++j)
+            {
+                int32_t sum = 0;
+                for (int l = 0; l < _k; ++l)
+                {
+                    sum += static_cast<int32_t>(_weights.values[i * _k + l]) * quantizedInput[j * _k + l];
+                }
+                auto outputIndex = _transposeOutput ? j * _m + i : i * _n + j;
+                outputValues[outputIndex] = static_cast<ValueType>(sum) * outputScale;
+            }
+        }
+        _output.SetOutput(outputValues);
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        using namespace std::string_literals;
+
+        auto& module = function.GetModule();
+        const auto m = _m;
+        const auto n = _n;
+        const auto k = _k;
+        const auto transposeOutput = _transposeOutput;
+        const auto inputScale = _inputScale;
+        const auto inverseInputScale = 1 / _inputScale;
+
+        std::vector<char> weightValues(_weights.values.begin(), _weights.values.end());
+        auto weights = module.ConstantArray("quantizedWeights_"s + GetInternalStateIdentifier(), weightValues);
+        auto weightScales = module.ConstantArray("quantizedWeightScales_"s + GetInternalStateIdentifier(), _weights.scales);
+        auto quantizedInput = module.GlobalArray<char>("quantizedInput_"s + GetInternalStateIdentifier(), static_cast<size_t>(k * n));
+
+        // Get port variables
+        emitters::LLVMValue pInput = compiler.EnsurePortEmitted(input);
+        emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
+
+        // Quantize the input into a transposed n x k buffer, rounding half away from zero
+        function.For(k, [pInput, quantizedInput, n, k, inverseInputScale](emitters::IRFunctionEmitter& function, auto l) {
+            function.For(n, [pInput, quantizedInput, n, k, inverseInputScale, l](emitters::IRFunctionEmitter& function, auto j) {
+                auto value = function.LocalScalar(function.ValueAt(pInput, l * n + j)) * inverseInputScale;
+                auto clamped = emitters::Max(emitters::Min(value, static_cast<ValueType>(maxQuantizedValue)), static_cast<ValueType>(-maxQuantizedValue));
+                auto half = function.LocalScalar<ValueType>(0.5);
+                auto rounded = function.Select(clamped >= function.LocalScalar<ValueType>(0), clamped + half, clamped - half);
+                function.SetValueAt(quantizedInput, j * k + l, function.CastValue<char>(function.CastValue<int>(rounded)));
+            });
+        });
+
+        // Accumulate in int32, then rescale to floating-point. Each row of weights is multiplied by a block of input
+        // columns at once, so every vector of weights loaded is reused for each column in the block. Along k, the int8
+        // values are loaded a vector at a time and widened to int32, which the backend turns into multiply-add
+        // instructions (e.g., pmaddwd on x86).
+        const int vectorSize = emitters::GetElementwiseVectorWidth<int32_t>(function.GetCompilerOptions());
+        const int numVectorBlocks = vectorSize > 1 ? k / vectorSize : 0;
+        const int tailBegin = numVectorBlocks * vectorSize;
+        auto emitColumnBlock = [=](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar i, emitters::IRLocalScalar outputScale, emitters::IRLocalScalar firstColumn, int numColumns) {
+            auto& emitter = function.GetEmitter();
+            std::vector<emitters::LLVMValue> sums(numColumns);
+            for (int column = 0; column < numColumns; ++column)
+            {
+                sums[column] = function.Variable(emitters::GetVariableType<int>());
+                function.StoreZero(sums[column]);
+            }
+
+            if (numVectorBlocks > 0)
+            {
+                auto vectorType = llvm::VectorType::get(emitter.Type(emitters::GetVariableType<int>()), vectorSize);
+                std::vector<emitters::LLVMValue> vectorSums(numColumns);
+                for (int column = 0; column < numColumns; ++column)
+                {
+                    vectorSums[column] = function.Variable(vectorType);
+                    function.Store(vectorSums[column], llvm::Constant::getNullValue(vectorType));
+                }
+                function.For(numVectorBlocks, [=](emitters::IRFunctionEmitter& function, auto block) {
+                    auto& builder = function.GetEmitter().GetIRBuilder();
+                    auto l = block * vectorSize;
+                    auto weightVector = builder.CreateSExt(emitters::LoadVector(function, weights, i * k + l, vectorSize), vectorType);
+                    for (int column = 0; column < numColumns; ++column)
+                    {
+                        auto inputVector = builder.CreateSExt(emitters::LoadVector(function, quantizedInput, (firstColumn + column) * k + l, vectorSize), vectorType);
+                        function.Store(vectorSums[column], builder.CreateAdd(function.Load(vectorSums[column]), builder.CreateMul(weightVector, inputVector)));
+                    }
+                });
+                for (int column = 0; column < numColumns; ++column)
+                {
+                    function.Store(sums[column], emitters::HorizontalVectorSum<int>(function, function.Load(vectorSums[column])));
+                }
+            }
+
+            if (tailBegin < k)
+            {
+                function.For(tailBegin, k, [=](emitters::IRFunctionEmitter& function, auto l) {
+                    auto weight = function.LocalScalar(function.CastValue<int>(function.ValueAt(weights, i * k + l)));
+                    for (int column = 0; column < numColumns; ++column)
+                    {
+                        auto value = function.LocalScalar(function.CastValue<int>(function.ValueAt(quantizedInput, (firstColumn + column) * k + l)));
+                        function.Store(sums[column], function.LocalScalar(function.Load(sums[column])) + weight * value);
+                    }
+                });
+            }
+
+            for (int column = 0; column < numColumns; ++column)
+            {
+                auto j = firstColumn + column;
+                auto result = function.LocalScalar(function.CastValue<ValueType>(function.Load(sums[column]))) * outputScale;
+                auto outputIndex = transposeOutput ? j * m + i : i * n + j;
+                function.SetValueAt(pOutput, outputIndex, result);
+            }
+        };
+
+        const int numColumnBlocks = n / numColumnsInKernel;
+        const int columnTailBegin = numColumnBlocks * numColumnsInKernel;
+        function.For(m, [=](emitters::IRFunctionEmitter& function, auto i) {
+            auto outputScale = function.LocalScalar(function.ValueAt(weightScales, i)) * inputScale;
+            if (numColumnBlocks > 0)
+            {
+                function.For(numColumnBlocks, [=](emitters::IRFunctionEmitter& function, auto columnBlock) {
+                    emitColumnBlock(function, i, outputScale, columnBlock * numColumnsInKernel, numColumnsInKernel);
+                });
+            }
+            if (columnTailBegin < n)
+            {
+                function.For(columnTailBegin, n, [=](emitters::IRFunctionEmitter& function, auto j) {
+                    emitColumnBlock(function, i, outputScale, j, 1);
+                });
+            }
+        });
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInput = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(newInput, _m, _n, _k, _weights, _inputScale, _transposeOutput, _output.GetMemoryLayout());
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver[defaultOutputPortName] << _output;
+        archiver["m"] << _m;
+        archiver["n"] << _n;
+        archiver["k"] << _k;
+        archiver["weights"] << std::vector<int>(_weights.values.begin(), _weights.values.end());
+        archiver["weightScales"] << _weights.scales;
+        archiver["inputScale"] << _inputScale;
+        archiver["transposeOutput"] << _transposeOutput;
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver[defaultOutputPortName] >> _output;
+        archiver["m"] >> _m;
+        archiver["n"] >> _n;
+        archiver["k"] >> _k;
+        std::vector<int> weightValues;
+        archiver["weights"] >> weightValues;
+        _weights.values.assign(weightValues.begin(), weightValues.end());
+        archiver["weightScales"] >> _weights.scales;
+        archiver["inputScale"] >> _inputScale;
+        archiver["transposeOutput"] >> _transposeOutput;
+        VerifyDimensions();
+    }
+
+    // Explicit instantiations
+    template float GetQuantizationScale(float range);
+    template double GetQuantizationScale(double range);
+    template int QuantizeValue(float value, float scale);
+    template int QuantizeValue(double value, double scale);
+    template QuantizedWeights<float> QuantizeWeights(const std::vector<float>& weights, int numRows, int numColumns);
+    template QuantizedWeights<double> QuantizeWeights(const std::vector<double>& weights, int numRows, int numColumns);
+
+    template class QuantizedMatrixMatrixMultiplyNode<float>;
+    template class QuantizedMatrixMatrixMultiplyNode<double>;
+} // namespace nodes
+} // namespace ell
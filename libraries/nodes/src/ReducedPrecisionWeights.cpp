@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ReducedPrecisionWeights.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ReducedPrecisionWeights.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace ell
+{
+namespace nodes
+{
+    using namespace utilities::logging;
+
+    namespace
+    {
+        uint32_t GetBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        float FromBits(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void VerifyStorageType(model::WeightStorageType storageType)
+        {
+            if (storageType != model::WeightStorageType::float16 && storageType != model::WeightStorageType::bfloat16)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Weights can only be packed as float16 or bfloat16");
+            }
+        }
+    } // namespace
+
+    uint16_t FloatToBFloat16(float value)
+    {
+        auto bits = GetBits(value);
+        if ((bits & 0x7fffffff) > 0x7f800000)
+        {
+            // NaN: truncating could clear all the mantissa bits that survive, so force a quiet NaN
+            return static_cast<uint16_t>((bits >> 16) | 0x0040);
+        }
+        bits += 0x7fff + ((bits >> 16) & 1);
+        return static_cast<uint16_t>(bits >> 16);
+    }
+
+    float BFloat16ToFloat(uint16_t bits)
+    {
+        return FromBits(static_cast<uint32_t>(bits) << 16);
+    }
+
+    uint16_t FloatToFloat16(float value)
+    {
+        const auto bits = GetBits(value);
+        const auto sign = (bits >> 16) & 0x8000;
+        const auto magnitude = bits & 0x7fffffff;
+        if (magnitude > 0x7f800000) // NaN
+        {
+            return static_cast<uint16_t>(sign | 0x7e00);
+        }
+        if (magnitude >= 0x477ff000) // 65520 and above round to infinity
+        {
+            return static_cast<uint16_t>(sign | 0x7c00);
+        }
+        if (magnitude <= 0x33000000) // 2^-25 and below round to zero
+        {
+            return static_cast<uint16_t>(sign);
+        }
+        if (magnitude < 0x38800000) // below 2^-14, the smallest normal half-precision value
+        {
+            const auto exponent = magnitude >> 23;
+            const auto mantissa = (magnitude & 0x7fffff) | 0x800000;
+            const auto shift = 126 - exponent;
+            auto result = mantissa >> shift;
+            const auto remainder = mantissa & ((1u << shift) - 1);
+            const auto halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (result & 1)))
+            {
+                ++result;
+            }
+            return static_cast<uint16_t>(sign | result);
+        }
+
+        // Rebias the exponent from 127 to 15, then round the mantissa from 23 to 10 bits
+        auto result = magnitude - 0x38000000;
+        result += 0xfff + ((result >> 13) & 1);
+        return static_cast<uint16_t>(sign | (result >> 13));
+    }
+
+    float Float16ToFloat(uint16_t bits)
+    {
+        const auto sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+        const auto exponent = (bits >> 10) & 0x1f;
+        const auto mantissa = static_cast<uint32_t>(bits & 0x3ff);
+        if (exponent == 0x1f) // infinity or NaN
+        {
+            return FromBits(sign | 0x7f800000 | (mantissa << 13));
+        }
+        if (exponent == 0) // zero or subnormal
+        {
+            auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -magnitude : magnitude;
+        }
+        return FromBits(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    template <typename ValueType>
+    std::vector<int16_t> PackWeights(const std::vector<ValueType>& weights, model::WeightStorageType storageType)
+    {
+        VerifyStorageType(storageType);
+        auto convert = storageType == model::WeightStorageType::float16 ? FloatToFloat16 : FloatToBFloat16;
+        std::vector<int16_t> result(weights.size());
+        std::transform(weights.begin(), weights.end(), result.begin(), [convert](ValueType value) {
+            return static_cast<int16_t>(convert(static_cast<float>(value)));
+        });
+        return result;
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> UnpackWeights(const std::vector<int16_t>& packedWeights, model::WeightStorageType storageType)
+    {
+        VerifyStorageType(storageType);
+        auto convert = storageType == model::WeightStorageType::float16 ? Float16ToFloat : BFloat16ToFloat;
+        std::vector<ValueType> result(packedWeights.size());
+        std::transform(packedWeights.begin(), packedWeights.end(), result.begin(), [convert](int16_t bits) {
+            return static_cast<ValueType>(convert(static_cast<uint16_t>(bits)));
+        });
+        return result;
+    }
+
+    template <typename ValueType>
+    WeightStorageError GetWeightStorageError(const std::vector<ValueType>& weights, model::WeightStorageType storageType)
+    {
+        auto unpackedWeights = UnpackWeights<ValueType>(PackWeights(weights, storageType), storageType);
+
+        WeightStorageError result;
+        result.numWeights = weights.size();
+        double sumSquaredError = 0;
+        for (size_t index = 0; index < weights.size(); ++index)
+        {
+            auto error = std::abs(static_cast<double>(unpackedWeights[index]) - static_cast<double>(weights[index]));
+            result.maxAbsoluteError = std::max(result.maxAbsoluteError, error);
+            result.maxAbsoluteWeight = std::max(result.maxAbsoluteWeight, std::abs(static_cast<double>(weights[index])));
+            sumSquaredError += error * error;
+        }
+        if (!weights.empty())
+        {
+            result.rmsError = std::sqrt(sumSquaredError / weights.size());
+        }
+        return result;
+    }
+
+    template <typename ValueType>
+    emitters::LLVMValue EmitPackedWeights(emitters::IRFunctionEmitter& function, const std::vector<ValueType>& weights, model::WeightStorageType storageType, const std::string& name)
+    {
+        auto error = GetWeightStorageError(weights, storageType);
+        Log() << "Storing " << error.numWeights << " weights in " << name << " as " << model::ToString(storageType)
+              << ": max |weight| " << error.maxAbsoluteWeight << ", max error " << error.maxAbsoluteError << ", RMS error " << error.rmsError << EOL;
+
+        auto packedWeights = function.GetModule().ConstantArray(name, PackWeights(weights, storageType));
+        return function.PointerOffset(packedWeights, 0); // Convert LLVM array to pointer
+    }
+
+    template <typename ValueType>
+    emitters::IRLocalScalar EmitUnpackWeight(emitters::IRFunctionEmitter& function, emitters::LLVMValue packedWeights, emitters::IRLocalScalar index, model::WeightStorageType storageType)
+    {
+        VerifyStorageType(storageType);
+        auto bits = function.ValueAt(packedWeights, index);
+        if (storageType == model::WeightStorageType::float16)
+        {
+            // LLVM lowers the half-to-float extension to a single instruction where the target has one (F16C, NEON)
+            auto halfValue = function.BitCast(bits, llvm::Type::getHalfTy(function.GetLLVMContext()));
+            return function.LocalScalar(function.CastValue<ValueType>(halfValue));
+        }
+
+        // A bfloat16 value is the top half of a float
+        auto floatBits = function.LocalScalar(function.CastUnsignedValue(bits, emitters::VariableType::Int32)) << function.LocalScalar<int>(16);
+        auto floatValue = function.BitCast(floatBits, emitters::VariableType::Float);
+        return function.LocalScalar(function.CastValue<ValueType>(floatValue));
+    }
+
+    // Explicit instantiations
+    template std::vector<int16_t> PackWeights(const std::vector<float>& weights, model::WeightStorageType storageType);
+    template std::vector<int16_t> PackWeights(const std::vector<double>& weights, model::WeightStorageType storageType);
+    template std::vector<float> UnpackWeights(const std::vector<int16_t>& packedWeights, model::WeightStorageType storageType);
+    template std::vector<double> UnpackWeights(const std::vector<int16_t>& packedWeights, model::WeightStorageType storageType);
+    template WeightStorageError GetWeightStorageError(const std::vector<float>& weights, model::WeightStorageType storageType);
+    template WeightStorageError GetWeightStorageError(const std::vector<double>& weights, model::WeightStorageType storageType);
+    template emitters::LLVMValue EmitPackedWeights(emitters::IRFunctionEmitter& function, const std::vector<float>& weights, model::WeightStorageType storageType, const std::string& name);
+    template emitters::LLVMValue EmitPackedWeights(emitters::IRFunctionEmitter& function, const std::vector<double>& weights, model::WeightStorageType storageType, const std::string& name);
+    template emitters::IRLocalScalar EmitUnpackWeight<float>(emitters::IRFunctionEmitter& function, emitters::LLVMValue packedWeights, emitters::IRLocalScalar index, model::WeightStorageType storageType);
+    template emitters::IRLocalScalar EmitUnpackWeight<double>(emitters::IRFunctionEmitter& function, emitters::LLVMValue packedWeights, emitters::IRLocalScalar index, model::WeightStorageType storageType);
+} // namespace nodes
+} // namespace ell
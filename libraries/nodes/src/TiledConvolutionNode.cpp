@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TiledConvolutionNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TiledConvolutionNode.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <utilities/include/Exception.h>
+
+#include <value/include/EmitterContext.h>
+#include <value/include/Scalar.h>
+#include <value/include/ScalarOperations.h>
+#include <value/include/TensorOperations.h>
+
+#include <value/include/loopnests/CodeGenerator.h>
+#include <value/include/loopnests/CodePositionConstraints.h>
+#include <value/include/loopnests/Kernel.h>
+#include <value/include/loopnests/LoopNest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    TiledConvolutionNode<ValueType>::TiledConvolutionNode() :
+        CompilableCodeNode("TiledConvolutionNode", { &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0),
+        _rowBlock(_defaultRowBlock),
+        _columnBlock(_defaultColumnBlock),
+        _channelBlock(_defaultChannelBlock),
+        _filterBlock(_defaultFilterBlock)
+    {
+    }
+
+    template <typename ValueType>
+    TiledConvolutionNode<ValueType>::TiledConvolutionNode(const model::OutputPort<ValueType>& input,
+                                                          const model::PortMemoryLayout& inputMemoryLayout,
+                                                          const model::PortMemoryLayout& outputMemoryLayout,
+                                                          const ConstTensorReferenceType& filterWeights,
+                                                          size_t stride) :
+        TiledConvolutionNode<ValueType>(input, inputMemoryLayout, outputMemoryLayout, filterWeights, stride, _defaultRowBlock, _defaultColumnBlock, _defaultChannelBlock, _defaultFilterBlock)
+    {
+    }
+
+    template <typename ValueType>
+    TiledConvolutionNode<ValueType>::TiledConvolutionNode(const model::OutputPort<ValueType>& input,
+                                                          const model::PortMemoryLayout& inputMemoryLayout,
+                                                          const model::PortMemoryLayout& outputMemoryLayout,
+                                                          const ConstTensorReferenceType& filterWeights,
+                                                          size_t stride,
+                                                          int rowBlock,
+                                                          int columnBlock,
+                                                          int channelBlock,
+                                                          int filterBlock) :
+        CompilableCodeNode("TiledConvolutionNode", { &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputMemoryLayout),
+        _inputMemoryLayout(inputMemoryLayout),
+        _filterWeights(filterWeights),
+        _stride(static_cast<int>(stride)),
+        _rowBlock(rowBlock),
+        _columnBlock(columnBlock),
+        _channelBlock(channelBlock),
+        _filterBlock(filterBlock)
+    {
+        if (rowBlock < 1 || columnBlock < 1 || channelBlock < 1 || filterBlock < 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Error: tile sizes for tiled convolution must be positive");
+        }
+
+        const int filterSize = static_cast<int>(filterWeights.NumColumns());
+        if (inputMemoryLayout.GetLogicalDimensionOffset(0) < filterSize / 2 || inputMemoryLayout.GetLogicalDimensionOffset(1) < filterSize / 2)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Error: input padding for tiled convolution must be at least filterSize/2");
+        }
+
+        const int numChannels = inputMemoryLayout.GetLogicalDimensionActiveSize(2);
+        const int groupChannels = static_cast<int>(filterWeights.NumChannels());
+        if (groupChannels == 0 || numChannels % groupChannels != 0 || outputMemoryLayout.GetLogicalDimensionActiveSize(2) % (numChannels / groupChannels) != 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Error: the input channels and filters of a tiled convolution must divide evenly into groups");
+        }
+    }
+
+    template <typename ValueType>
+    void TiledConvolutionNode<ValueType>::Convolve(value::Tensor input, value::Tensor output, value::Tensor weights) const
+    {
+        namespace loopnests = value::loopnests;
+        using value::Scalar;
+        using value::Tensor;
+
+        // Terminology:
+        // fw: filter width
+        // d: # input channels
+        // f: # filters (== output channels)
+        // g: # groups. Each group of f/g filters reads only its own group of d/g input channels
+        const int filterSize = static_cast<int>(_filterWeights.NumColumns());
+        const int numTaps = filterSize * filterSize;
+        const int stride = _stride;
+        const int outputRows = output.Rows();
+        const int outputColumns = output.Columns();
+        const int numGroups = GetNumGroups();
+        const int groupChannels = static_cast<int>(_filterWeights.NumChannels());
+        const int groupFilters = static_cast<int>(output.Channels()) / numGroups;
+
+        // `input` is indexed from the start of its padding, which may be wider than the filter needs
+        const int inputRowOffset = _inputMemoryLayout.GetLogicalDimensionOffset(0) - filterSize / 2;
+        const int inputColumnOffset = _inputMemoryLayout.GetLogicalDimensionOffset(1) - filterSize / 2;
+
+        const int rowBlock = std::min(_rowBlock, outputRows);
+        const int columnBlock = std::min(_columnBlock, outputColumns);
+        const int channelBlock = std::min(_channelBlock, groupChannels);
+        const int filterBlock = std::min(_filterBlock, groupFilters);
+
+        // The input region read by one tile of output: its rows and columns, plus the filter's halo
+        const int haloRows = (rowBlock - 1) * stride + filterSize;
+        const int haloColumns = (columnBlock - 1) * stride + filterSize;
+        Tensor halo(value::StaticAllocate(value::UniqueName("tiledConvolutionHalo"), value::GetValueType<ValueType>(), utilities::MemoryLayout({ haloRows, haloColumns, channelBlock })));
+
+        value::For(output, [&](Scalar row, Scalar column, Scalar channel) {
+            output(row, column, channel) = static_cast<ValueType>(0);
+        });
+
+        // `c` and `b` index the blocks of input channels and of filters within group `g`
+        const int numChannelBlocks = (groupChannels + channelBlock - 1) / channelBlock;
+        const int numFilterBlocks = (groupFilters + filterBlock - 1) / filterBlock;
+        const int lastFilterBlockSize = groupFilters - (numFilterBlocks - 1) * filterBlock;
+        loopnests::Index g("g"), i("i"), j("j"), c("c"), b("b");
+        loopnests::LoopNest loop(std::vector<loopnests::IndexRange>{ { g, { 0, numGroups } },
+                                                                     { i, { 0, outputRows } },
+                                                                     { j, { 0, outputColumns } },
+                                                                     { c, { 0, numChannelBlocks } },
+                                                                     { b, { 0, numFilterBlocks } } });
+        auto iOuter = loop.Split(i, rowBlock).outer;
+        auto jOuter = loop.Split(j, columnBlock).outer;
+        loop.SetLoopOrder({ g, iOuter, jOuter, c, b, i, j });
+
+        // Copies the input region of the current tile into the halo cache, once per tile and block of input channels.
+        // Tiles at the bottom and right edges of the output read less of the input.
+        auto haloKernel = loopnests::Kernel("copy_halo")
+                              .Inputs(input.GetValue(), halo.GetValue())
+                              .Indices(g, iOuter, jOuter, c)
+                              .Define([=](Tensor input, Tensor halo, Scalar group, Scalar rowTile, Scalar columnTile, Scalar channelBlockIndex) {
+                                  auto rows = (value::Min(Scalar(rowBlock), outputRows - rowTile) - 1) * stride + filterSize;
+                                  auto columns = (value::Min(Scalar(columnBlock), outputColumns - columnTile) - 1) * stride + filterSize;
+                                  auto channelTile = channelBlockIndex * channelBlock;
+                                  auto channels = value::Min(Scalar(channelBlock), groupChannels - channelTile);
+                                  auto firstChannel = group * groupChannels + channelTile;
+                                  value::ForRange(rows, [&](Scalar haloRow) {
+                                      value::ForRange(columns, [&](Scalar haloColumn) {
+                                          value::ForRange(channels, [&](Scalar haloChannel) {
+                                              halo(haloRow, haloColumn, haloChannel) = input(rowTile * stride + haloRow + inputRowOffset,
+                                                                                             columnTile * stride + haloColumn + inputColumnOffset,
+                                                                                             firstChannel + haloChannel);
+                                          });
+                                      });
+                                  });
+                              });
+        loop.AddKernel(haloKernel, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::prologue, { g, iOuter, jOuter, c }, {} });
+
+        // Accumulates a block of input channels' contribution to a block of filters of one output element. The filters
+        // are unrolled, and each one's sum stays in a local (so, after optimization, a register) for the whole loop over
+        // the channels, so the output is only loaded and stored once per block of channels.
+        auto kernel = loopnests::Kernel("tiled_convolution_kernel")
+                          .Inputs(output.GetValue(), halo.GetValue(), weights.GetValue())
+                          .Indices(g, iOuter, jOuter, c, b, i, j)
+                          .Define([=](Tensor output, Tensor halo, Tensor weights, Scalar group, Scalar rowTile, Scalar columnTile, Scalar channelBlockIndex, Scalar filterBlockIndex, Scalar row, Scalar column) {
+                              auto channelTile = channelBlockIndex * channelBlock;
+                              auto channels = value::Min(Scalar(channelBlock), groupChannels - channelTile);
+                              auto firstOutputChannel = group * groupFilters + filterBlockIndex * filterBlock;
+                              auto firstWeightFilter = filterBlockIndex * filterBlock;
+                              auto haloRow = (row - rowTile) * stride;
+                              auto haloColumn = (column - columnTile) * stride;
+                              auto firstTap = group * numTaps;
+
+                              auto accumulate = [&](int numFilters) {
+                                  std::vector<Scalar> sums;
+                                  for (int filter = 0; filter < numFilters; ++filter)
+                                  {
+                                      sums.emplace_back(value::Allocate(output.GetValue().GetBaseType(), utilities::ScalarLayout));
+                                      sums.back() = output(row, column, firstOutputChannel + filter);
+                                  }
+
+                                  value::ForRange(channels, [&](Scalar haloChannel) {
+                                      auto channel = channelTile + haloChannel;
+                                      for (int windowRow = 0; windowRow < filterSize; ++windowRow)
+                                      {
+                                          for (int windowColumn = 0; windowColumn < filterSize; ++windowColumn)
+                                          {
+                                              Scalar x = halo(haloRow + windowRow, haloColumn + windowColumn, haloChannel);
+                                              auto tap = firstTap + windowRow * filterSize + windowColumn;
+                                              for (int filter = 0; filter < numFilters; ++filter)
+                                              {
+                                                  sums[filter] += x * weights(tap, channel, firstWeightFilter + filter);
+                                              }
+                                          }
+                                      }
+                                  });
+
+                                  for (int filter = 0; filter < numFilters; ++filter)
+                                  {
+                                      output(row, column, firstOutputChannel + filter) = sums[filter];
+                                  }
+                              };
+
+                              if (lastFilterBlockSize == filterBlock)
+                              {
+                                  accumulate(filterBlock);
+                              }
+                              else
+                              {
+                                  // The last block of filters is smaller
+                                  value::If(filterBlockIndex < numFilterBlocks - 1, [&] {
+                                      accumulate(filterBlock);
+                                  }).Else([&] {
+                                      accumulate(lastFilterBlockSize);
+                                  });
+                              }
+                          });
+        loop.AddKernel(kernel);
+
+        loopnests::CodeGenerator generator;
+        generator.Run(loop);
+    }
+
+    template <typename ValueType>
+    void TiledConvolutionNode<ValueType>::Define(value::FunctionDeclaration& fn)
+    {
+        (void)fn.Define([this](const value::Value inputValue, value::Value outputValue) {
+            // View the input in padded coordinates
+            value::Value paddedInput = inputValue;
+            paddedInput.SetLayout(utilities::MemoryLayout(inputValue.GetLayout().GetExtent(), inputValue.GetLayout().GetLogicalDimensionOrder()));
+
+            // Repack the weights so each filter tap of each group is a (d/g) x (f/g) matrix, with the filters innermost
+            const int filterSize = static_cast<int>(_filterWeights.NumColumns());
+            const int numTaps = filterSize * filterSize;
+            const int numGroups = GetNumGroups();
+            const int groupChannels = static_cast<int>(_filterWeights.NumChannels());
+            const int groupFilters = static_cast<int>(_filterWeights.NumRows()) / filterSize / numGroups;
+            std::vector<ValueType> packedWeights(numGroups * numTaps * groupChannels * groupFilters);
+            for (int group = 0; group < numGroups; ++group)
+            {
+                for (int filter = 0; filter < groupFilters; ++filter)
+                {
+                    for (int windowRow = 0; windowRow < filterSize; ++windowRow)
+                    {
+                        for (int windowColumn = 0; windowColumn < filterSize; ++windowColumn)
+                        {
+                            for (int channel = 0; channel < groupChannels; ++channel)
+                            {
+                                auto tap = group * numTaps + windowRow * filterSize + windowColumn;
+                                packedWeights[(tap * groupChannels + channel) * groupFilters + filter] = _filterWeights((group * groupFilters + filter) * filterSize + windowRow, windowColumn, channel);
+                            }
+                        }
+                    }
+                }
+            }
+            value::Tensor weights(value::Value(packedWeights, utilities::MemoryLayout({ numGroups * numTaps, groupChannels, groupFilters })));
+
+            Convolve(value::Tensor(paddedInput), value::Tensor(outputValue), weights);
+        });
+    }
+
+    template <typename ValueType>
+    void TiledConvolutionNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInput = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<TiledConvolutionNode<ValueType>>(newInput, _inputMemoryLayout, GetOutputMemoryLayout(), _filterWeights, _stride, _rowBlock, _columnBlock, _channelBlock, _filterBlock);
+        transformer.MapNodeOutput(this->output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void TiledConvolutionNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["inputLayout"] << _inputMemoryLayout;
+        archiver["outputLayout"] << GetOutputMemoryLayout();
+        archiver["stride"] << _stride;
+        math::TensorArchiver::Write(_filterWeights, "weights", archiver);
+        archiver["rowBlock"] << _rowBlock;
+        archiver["columnBlock"] << _columnBlock;
+        archiver["channelBlock"] << _channelBlock;
+        archiver["filterBlock"] << _filterBlock;
+    }
+
+    template <typename ValueType>
+    void TiledConvolutionNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["inputLayout"] >> _inputMemoryLayout;
+        model::PortMemoryLayout outputMemoryLayout;
+        archiver["outputLayout"] >> outputMemoryLayout;
+        _output.SetMemoryLayout(outputMemoryLayout);
+        archiver["stride"] >> _stride;
+        math::TensorArchiver::Read(_filterWeights, "weights", archiver);
+        archiver["rowBlock"] >> _rowBlock;
+        archiver["columnBlock"] >> _columnBlock;
+        archiver["channelBlock"] >> _channelBlock;
+        archiver["filterBlock"] >> _filterBlock;
+    }
+
+    //
+    // Explicit instantiation definitions
+    //
+    template class TiledConvolutionNode<float>;
+    template class TiledConvolutionNode<double>;
+} // namespace nodes
+} // namespace ell
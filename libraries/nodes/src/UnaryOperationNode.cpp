@@ -10,16 +10,21 @@
 #include "NodeOperations.h"
 
 #include <value/include/EmitterContext.h>
+#include <value/include/LLVMContext.h>
 #include <value/include/Scalar.h>
 #include <value/include/Value.h>
 #include <value/include/ValueOperations.h>
 
 #include <emittable_functions/include/LogisticFunctions.h>
 
+#include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IRVectorUtilities.h>
+
 #include <utilities/include/Boolean.h>
 #include <utilities/include/TypeTraits.h>
 
 #include <cmath>
+#include <type_traits>
 
 namespace ell
 {
@@ -28,6 +33,68 @@ using namespace value;
 
 namespace nodes
 {
+    namespace
+    {
+        // Emits the operation with explicit vector instructions, if it maps to a single LLVM instruction or intrinsic
+        // that works on vectors. Returns `false` if it doesn't, or if vectors aren't worthwhile for the target.
+        template <typename ValueType>
+        bool EmitVectorizedOperation(UnaryOperationType op, const Vector& data, Vector& result)
+        {
+            if constexpr (!std::is_floating_point_v<ValueType>)
+            {
+                return false;
+            }
+            else
+            {
+                if (op != UnaryOperationType::abs && op != UnaryOperationType::sqrt && op != UnaryOperationType::square)
+                {
+                    return false;
+                }
+
+                auto isFlat = [](const Vector& v) {
+                    const auto& layout = v.GetValue().GetLayout();
+                    return layout.IsContiguous() && layout.GetFirstEntryOffset() == 0;
+                };
+                if (!isFlat(data) || !isFlat(result))
+                {
+                    return false;
+                }
+
+                bool emitted = false;
+                InvokeForContext<LLVMContext>([&](LLVMContext& context) {
+                    auto& function = context.GetFunctionEmitter();
+                    const int vectorSize = emitters::GetElementwiseVectorWidth<ValueType>(function.GetCompilerOptions());
+                    if (vectorSize <= 1)
+                    {
+                        return;
+                    }
+
+                    auto input = ToLLVMValue(data.GetValue());
+                    auto output = ToLLVMValue(result.GetValue());
+                    emitters::VectorizedFor(function, static_cast<int>(data.Size()), vectorSize, [op, input, output](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar index, int width) {
+                        auto x = emitters::LoadVector(function, input, index, width);
+                        emitters::LLVMValue y = nullptr;
+                        switch (op)
+                        {
+                        case UnaryOperationType::abs:
+                            y = function.Call(function.GetModule().GetIntrinsic(llvm::Intrinsic::fabs, { x->getType() }), { x });
+                            break;
+                        case UnaryOperationType::sqrt:
+                            y = function.Call(function.GetModule().GetIntrinsic(llvm::Intrinsic::sqrt, { x->getType() }), { x });
+                            break;
+                        default: // square
+                            y = function.Operator(emitters::GetMultiplyForValueType<ValueType>(), x, x);
+                            break;
+                        }
+                        emitters::StoreVector(function, output, index, y);
+                    });
+                    emitted = true;
+                });
+                return emitted;
+            }
+        }
+    } // namespace
+
     template <typename ValueType>
     UnaryOperationNode<ValueType>::UnaryOperationNode() :
         CompilableCodeNode("UnaryOperationNode", { &_input }, { &_output }),
@@ -71,7 +138,7 @@ namespace nodes
             {
                 result = Maximize(data);
             }
-            else
+            else if (!EmitVectorizedOperation<ValueType>(op, data, result))
             {
                 For(data, [&](Scalar index) {
                     auto v = data(index);
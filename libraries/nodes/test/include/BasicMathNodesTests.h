@@ -14,6 +14,7 @@ void TestBasicMathNodes();
 // Sub-tests called by main driver
 void TestBinaryOperationNodeCompute();
 void TestBinaryOperationNodeCompute2();
+void TestBinaryOperationNodeComputeInPlace();
 void TestUnaryOperationNodeCompute();
 void TestLogicalUnaryOperationNodeCompute();
 void TestBroadcastLinearFunctionNodeCompute();
@@ -67,6 +67,7 @@ void TestBasicMathNodes()
 {
     TestBinaryOperationNodeCompute();
     TestBinaryOperationNodeCompute2();
+    TestBinaryOperationNodeComputeInPlace();
     TestUnaryOperationNodeCompute();
     TestLogicalUnaryOperationNodeCompute();
 
@@ -205,6 +206,26 @@ void TestBinaryOperationNodeCompute2()
     testing::ProcessTest("TestBinaryOperationNodeCompute2", testing::IsEqual(result, expected));
 }
 
+void TestBinaryOperationNodeComputeInPlace()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(4);
+    auto constantNode = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1.0, 2.0, 3.0, 4.0 });
+    auto outputNode = model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, constantNode->output, BinaryOperationType::multiply);
+
+    // The output should be written into the port's existing storage rather than a newly-allocated vector
+    inputNode->SetInput(std::vector<double>{ 1.0, 1.0, 1.0, 1.0 });
+    auto result1 = model.ComputeOutput(outputNode->output);
+    auto outputData = outputNode->output.GetOutput().data();
+    inputNode->SetInput(std::vector<double>{ 2.0, 2.0, 2.0, 2.0 });
+    auto result2 = model.ComputeOutput(outputNode->output);
+
+    testing::ProcessTest("TestBinaryOperationNodeComputeInPlace",
+                         testing::IsEqual(result1, std::vector<double>{ 1.0, 2.0, 3.0, 4.0 }) &&
+                             testing::IsEqual(result2, std::vector<double>{ 2.0, 4.0, 6.0, 8.0 }) &&
+                             outputNode->output.GetOutput().data() == outputData);
+}
+
 void TestBroadcastLinearFunctionNodeCompute()
 {
     model::Model model;
@@ -22,6 +22,8 @@
 
 #include <nodes/include/DiagonalConvolutionNode.h>
 #include <nodes/include/SimpleConvolutionNode.h>
+#include <nodes/include/SpatialConvolutionNode.h>
+#include <nodes/include/TiledConvolutionNode.h>
 #include <nodes/include/UnrolledConvolutionNode.h>
 #include <nodes/include/WinogradConvolutionNode.h>
 
@@ -245,6 +247,86 @@ static void TimeConvolutionNode(ImageShape inputShape, FiltersShape filterShape,
               << "(reference: " << referenceTime << " ms)\n";
 }
 
+// Times a 3x3 convolution whose input channels and filters are divided into `numGroups` groups, on a SpatialConvolutionNode if
+// it's depthwise-separable, else on a TiledConvolutionNode. The reference is the ConvolutionalLayer it's built from.
+template <typename ValueType>
+static void TimeGroupedConvolutionNode(ImageShape inputShape, int numFilters, int numGroups, int numIterations, bool channelMajor = false)
+{
+    using Tensor = math::ChannelColumnRowTensor<ValueType>;
+    using LayerType = predictors::neural::ConvolutionalLayer<ValueType>;
+
+    const int inputRows = inputShape.numRows;
+    const int inputColumns = inputShape.numColumns;
+    const int numChannels = inputShape.numChannels;
+    const int filterSize = 3;
+    const int inputPadding = 1;
+    const int outputPadding = 0;
+    const int stride = 1;
+
+    auto randomEngine = utilities::GetRandomEngine("123");
+    std::uniform_real_distribution<ValueType> uniform(-1, 1);
+    auto rand = [&randomEngine, &uniform]() { return uniform(randomEngine); };
+
+    Tensor paddedDataTensor(inputRows + 2 * inputPadding, inputColumns + 2 * inputPadding, numChannels);
+    paddedDataTensor.Fill(0);
+    paddedDataTensor.GetSubTensor(inputPadding, inputPadding, 0, inputRows, inputColumns, numChannels).Generate(rand);
+    auto paddedDataArray = paddedDataTensor.ToArray();
+
+    Tensor filterWeights(numFilters * filterSize, filterSize, numChannels / numGroups);
+    filterWeights.Generate(rand);
+
+    typename LayerType::LayerParameters layerParameters{ paddedDataTensor, predictors::neural::ZeroPadding(inputPadding), { static_cast<size_t>(inputRows), static_cast<size_t>(inputColumns), static_cast<size_t>(numFilters) }, predictors::neural::NoPadding() };
+    predictors::neural::ConvolutionalParameters convolutionalParameters{ filterSize, stride, predictors::neural::ConvolutionMethod::simple, 1 };
+    LayerType layer(layerParameters, convolutionalParameters, filterWeights);
+
+    auto inputMemoryLayout = CalculateMemoryLayout(inputRows, inputColumns, numChannels, inputPadding);
+    auto outputMemoryLayout = CalculateMemoryLayout(inputRows, inputColumns, numFilters, outputPadding);
+    if (channelMajor)
+    {
+        inputMemoryLayout = inputMemoryLayout.ReorderedCopy(utilities::ChannelMajorTensorOrder);
+        outputMemoryLayout = outputMemoryLayout.ReorderedCopy(utilities::ChannelMajorTensorOrder);
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputMemoryLayout);
+    const model::OutputPort<ValueType>* output = nullptr;
+    if (layer.IsDepthwiseSeparable())
+    {
+        output = &model.AddNode<nodes::SpatialConvolutionNode<ValueType>>(inputNode->output, layer, outputMemoryLayout)->output;
+    }
+    else
+    {
+        output = &model.AddNode<nodes::TiledConvolutionNode<ValueType>>(inputNode->output, inputMemoryLayout, outputMemoryLayout, filterWeights, stride)->output;
+    }
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", *output } });
+
+    model::MapCompilerOptions settings;
+    settings.compilerSettings.optimize = true;
+    settings.compilerSettings.parallelize = false;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    utilities::MillisecondTimer timer;
+    for (int index = 0; index < numIterations; ++index)
+    {
+        compiledMap.SetInputValue(0, paddedDataArray);
+        volatile auto compiledResult = compiledMap.ComputeOutput<ValueType>(0);
+    }
+    auto compiledTime = timer.Elapsed();
+
+    timer.Reset();
+    for (int index = 0; index < numIterations; ++index)
+    {
+        layer.Compute();
+    }
+    auto referenceTime = timer.Elapsed();
+
+    auto layoutName = channelMajor ? "channel-major" : "interleaved";
+    std::cout << "Total time for " << numIterations << " iterations of " << inputRows << " x " << inputColumns << " x " << numChannels << " -> " << numFilters << " convolutions with " << numGroups << " groups (" << layoutName << "): " << compiledTime << " ms\t"
+              << "(reference: " << referenceTime << " ms)\n";
+}
+
 //
 // Main driver function to call all the timing functions
 //
@@ -334,4 +416,21 @@ void TimeDSPNodes()
     TimeConvolutionNode<float>({ 127, 127, 8 }, { 8, 3, 3, 1 }, 100, dsp::ConvolutionMethodOption::winograd, { 2, dsp::WinogradFilterOrder::filtersFirst });
     TimeConvolutionNode<float>({ 127, 127, 16 }, { 16, 3, 3, 1 }, 100, dsp::ConvolutionMethodOption::winograd, { 2, dsp::WinogradFilterOrder::filtersFirst });
     TimeConvolutionNode<float>({ 127, 127, 32 }, { 32, 3, 3, 1 }, 100, dsp::ConvolutionMethodOption::winograd, { 2, dsp::WinogradFilterOrder::filtersFirst });
+
+    // Depthwise-separable layers of MobileNet
+    std::cout << "\n";
+    std::cout << "Depthwise-separable (MobileNet shapes)\n";
+    for (auto shape : std::vector<ImageShape>{ { 112, 112, 32 }, { 56, 56, 128 }, { 28, 28, 256 }, { 14, 14, 512 }, { 7, 7, 1024 } })
+    {
+        TimeGroupedConvolutionNode<float>(shape, shape.numChannels, shape.numChannels, 10);
+        TimeGroupedConvolutionNode<float>(shape, shape.numChannels, shape.numChannels, 10, true);
+    }
+
+    // Grouped layers of ResNeXt (32 groups) and ShuffleNet (3 groups)
+    std::cout << "\n";
+    std::cout << "Grouped (ResNeXt and ShuffleNet shapes)\n";
+    TimeGroupedConvolutionNode<float>({ 56, 56, 128 }, 128, 32, 10);
+    TimeGroupedConvolutionNode<float>({ 28, 28, 256 }, 256, 32, 10);
+    TimeGroupedConvolutionNode<float>({ 28, 28, 240 }, 240, 3, 10);
+    TimeGroupedConvolutionNode<float>({ 14, 14, 480 }, 480, 3, 10);
 }
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LoopNestTiming.cpp (nodes_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LoopNestTiming.h"
+
+#include <emitters/include/CompilerOptions.h>
+#include <emitters/include/IRExecutionEngine.h>
+#include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IROptimizer.h>
+
+#include <value/include/ComputeContext.h>
+#include <value/include/EmitterContext.h>
+#include <value/include/FunctionDeclaration.h>
+#include <value/include/LLVMContext.h>
+#include <value/include/LoopNests.h>
+#include <value/include/Matrix.h>
+#include <value/include/Scalar.h>
+#include <value/include/Value.h>
+#include <value/include/Vector.h>
+#include <value/include/loopnests/CodeGenerator.h>
+#include <value/include/loopnests/Kernel.h>
+#include <value/include/loopnests/LoopNest.h>
+#include <value/include/loopnests/LoopNestInterpreter.h>
+
+#include <utilities/include/MillisecondTimer.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ell;
+using namespace ell::value;
+
+//
+// Helpers
+//
+namespace
+{
+using ThreeArrayFunction = void (*)(float*, float*, float*);
+
+// Jits `defineFunction` as a function of three float arrays with the given layouts, and returns the time taken
+// to call it `numIterations` times
+template <typename DefineFunction>
+double TimeJittedFunction(const std::string& name, const std::vector<utilities::MemoryLayout>& layouts, DefineFunction&& defineFunction, int numIterations)
+{
+    emitters::CompilerOptions options;
+    options.optimize = true;
+    options.parallelize = false;
+    options.useBlas = false;
+    emitters::IRModuleEmitter module(name, options);
+
+    std::string functionName;
+    {
+        ContextGuard<LLVMContext> guard(module);
+        auto function = DeclareFunction(name)
+                            .Parameters(
+                                Value(ValueType::Float, layouts[0]),
+                                Value(ValueType::Float, layouts[1]),
+                                Value(ValueType::Float, layouts[2]));
+        function.Define(defineFunction);
+        functionName = function.GetFunctionName();
+    }
+
+    emitters::IROptimizer optimizer(module);
+    optimizer.AddStandardPasses();
+    module.Optimize(optimizer);
+
+    emitters::IRExecutionEngine engine(std::move(module));
+    auto jittedFunction = reinterpret_cast<ThreeArrayFunction>(engine.ResolveFunctionAddress(functionName));
+
+    std::vector<std::vector<float>> data;
+    for (const auto& layout : layouts)
+    {
+        data.emplace_back(layout.GetMemorySize(), 1.0f);
+    }
+
+    utilities::MillisecondTimer timer;
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        jittedFunction(data[0].data(), data[1].data(), data[2].data());
+    }
+    return static_cast<double>(timer.Elapsed());
+}
+
+//
+// Timing functions
+//
+
+void TimeElementwiseLoopNest(int size, int vectorWidth, int numIterations)
+{
+    auto timeSchedule = [=](bool vectorize) {
+        utilities::MemoryLayout layout{ { size } };
+        return TimeJittedFunction(
+            vectorize ? "elementwise_vectorized" : "elementwise",
+            { layout, layout, layout },
+            [=](Vector A, Vector B, Vector C) {
+                Index i("i");
+                auto nest = Using({ A, B }, ArgumentType::Input)
+                                .Using({ C }, ArgumentType::InputOutput)
+                                .ForAll(i, 0, size)
+                                .Do([](Vector A_, Vector B_, Vector C_, Scalar i_) {
+                                    C_(i_) += A_(i_) * B_(i_);
+                                });
+                if (vectorize)
+                {
+                    nest.GetSchedule().Vectorize(i, vectorWidth);
+                }
+                nest.Run();
+            },
+            numIterations);
+    };
+
+    auto scalarTime = timeSchedule(false);
+    auto vectorizedTime = timeSchedule(true);
+    std::cout << "Total time for " << numIterations << " iterations of " << size << "-element multiply-add: " << vectorizedTime << " ms with vector width " << vectorWidth << "\t"
+              << "(not vectorized: " << scalarTime << " ms)\n";
+}
+
+void TimeGemmLoopNest(int M, int N, int K, int vectorWidth, int numIterations)
+{
+    auto timeSchedule = [=](bool vectorize) {
+        return TimeJittedFunction(
+            vectorize ? "gemm_vectorized" : "gemm",
+            { utilities::MemoryLayout{ { M, K } }, utilities::MemoryLayout{ { K, N } }, utilities::MemoryLayout{ { M, N } } },
+            [=](Matrix A, Matrix B, Matrix C) {
+                Index i("i"), j("j"), k("k");
+                auto nest = Using({ A, B }, ArgumentType::Input)
+                                .Using({ C }, ArgumentType::InputOutput)
+                                .ForAll(i, 0, M)
+                                .ForAll(j, 0, N)
+                                .ForAll(k, 0, K)
+                                .Do([](Matrix A_, Matrix B_, Matrix C_, Scalar i_, Scalar j_, Scalar k_) {
+                                    C_(i_, j_) += A_(i_, k_) * B_(k_, j_);
+                                });
+                auto& schedule = nest.GetSchedule();
+                schedule.SetOrder({ i, k, j });
+                if (vectorize)
+                {
+                    schedule.Vectorize(j, vectorWidth);
+                }
+                nest.Run();
+            },
+            numIterations);
+    };
+
+    auto scalarTime = timeSchedule(false);
+    auto vectorizedTime = timeSchedule(true);
+    std::cout << "Total time for " << numIterations << " iterations of " << M << " x " << K << " * " << K << " x " << N << " GEMM: " << vectorizedTime << " ms with vector width " << vectorWidth << "\t"
+              << "(not vectorized: " << scalarTime << " ms)\n";
+}
+
+void TimeComputeContextLoopNest(int size, int splitSize, int numIterations)
+{
+    ContextGuard<ComputeContext> guard("LoopNestTiming");
+
+    auto A = MakeMatrix<float>(size, size, "A");
+    auto B = MakeMatrix<float>(size, size, "B");
+    auto C = MakeMatrix<float>(size, size, "C");
+
+    Index i("i"), j("j"), k("k");
+    auto kernel = loopnests::Kernel("gemm")
+                      .Inputs(A.GetValue(), B.GetValue(), C.GetValue())
+                      .Indices(i, j, k)
+                      .Define([](Matrix A_, Matrix B_, Matrix C_, Scalar i_, Scalar j_, Scalar k_) {
+                          C_(i_, j_) += A_(i_, k_) * B_(k_, j_);
+                      });
+    loopnests::LoopNest nest({ { i, { 0, size } },
+                               { j, { 0, size } },
+                               { k, { 0, size } } });
+    nest.AddKernel(kernel);
+    nest.Split(j, splitSize);
+    nest.Split(k, splitSize);
+
+    // Kernel bodies run through the compute context either way, so this only measures the loop control overhead
+    utilities::MillisecondTimer timer;
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        loopnests::CodeGenerator{}.Run(nest);
+    }
+    auto codeGeneratorTime = timer.Elapsed();
+
+    timer.Reset();
+    for (int iter = 0; iter < numIterations; ++iter)
+    {
+        loopnests::LoopNestInterpreter{ nest }.Run();
+    }
+    auto interpreterTime = timer.Elapsed();
+
+    std::cout << "Total time for " << numIterations << " iterations of " << size << " x " << size << " compute-context GEMM loop nest: " << interpreterTime << " ms with LoopNestInterpreter loop control\t"
+              << "(CodeGenerator: " << codeGeneratorTime << " ms)\n";
+}
+} // namespace
+
+//
+// Main driver function to call all the timing functions
+//
+void TimeLoopNests()
+{
+    TimeElementwiseLoopNest(4096, 8, 10000);
+    TimeElementwiseLoopNest(4099, 8, 10000);
+    std::cout << std::endl;
+
+    TimeGemmLoopNest(64, 64, 64, 8, 1000);
+    TimeGemmLoopNest(128, 128, 128, 8, 100);
+    TimeGemmLoopNest(100, 100, 100, 8, 100);
+    std::cout << std::endl;
+
+    TimeComputeContextLoopNest(16, 4, 10);
+    TimeComputeContextLoopNest(32, 8, 10);
+    std::cout << std::endl;
+}
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DSPNodesTiming.h"
+#include "LoopNestTiming.h"
 
 #include <testing/include/testing.h>
 
@@ -26,6 +27,7 @@ int main(int argc, char** argv)
     try
     {
         TimeDSPNodes();
+        TimeLoopNests();
     }
     catch (const utilities::Exception& exception)
     {
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FoldConstantsTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/ModelTransformer.h>
+#include <model/include/Submodel.h>
+#include <model/include/Transformation.h>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> A transformation that evaluates the parts of a model computed only from `ConstantNode`s (e.g.,
+    /// reshaped or rescaled weights) and replaces them with `ConstantNode`s holding the result. Nodes with runtime
+    /// state are never folded. The folded nodes are left unused, so the model should be pruned afterwards.
+    /// Controlled by the "foldConstants" optimizer option. </summary>
+    class FoldConstantsTransformation : public ell::model::Transformation
+    {
+    public:
+        ell::model::Submodel Transform(const ell::model::Submodel& submodel, ell::model::ModelTransformer& transformer, const ell::model::TransformContext& context) const override;
+
+        std::string GetRuntimeTypeName() const override
+        {
+            return "FoldConstantsTransformation";
+        }
+    };
+} // namespace passes
+} // namespace ell
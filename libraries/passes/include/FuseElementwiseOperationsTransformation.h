@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseElementwiseOperationsTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/ModelTransformer.h>
+#include <model/include/Submodel.h>
+#include <model/include/Transformation.h>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> A transformation that replaces chains of elementwise nodes (`BroadcastLinearFunctionNode`s, activation
+    /// `BroadcastUnaryFunctionNode`s, `ActivationLayerNode`s and `UnaryOperationNode`s) with a single
+    /// `FusedElementwiseNode`, which computes the whole chain in one loop. A node is only fused with the node
+    /// producing its input if nothing else reads that node's output. Controlled by the "fuseElementwiseNodes"
+    /// optimizer option. </summary>
+    class FuseElementwiseOperationsTransformation : public ell::model::Transformation
+    {
+    public:
+        ell::model::Submodel Transform(const ell::model::Submodel& submodel, ell::model::ModelTransformer& transformer, const ell::model::TransformContext& context) const override;
+
+        std::string GetRuntimeTypeName() const override
+        {
+            return "FuseElementwiseOperationsTransformation";
+        }
+    };
+} // namespace passes
+} // namespace ell
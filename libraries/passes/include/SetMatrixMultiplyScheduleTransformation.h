@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SetMatrixMultiplyScheduleTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Transformation.h>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> A transformation that sets the loop-nest schedule (block sizes, unrolling, kernel size and caching
+    /// strategy) of each `MatrixMatrixMultiplyCodeNode`. Schedules are looked up by shape and target in the database
+    /// named by the "matrixMultiplyTuningDatabase" option. If the "autotuneMatrixMultiply" option is set and the target
+    /// is the host, shapes missing from the database are tuned by timing candidate schedules, and the results are
+    /// saved back to the database. </summary>
+    class SetMatrixMultiplyScheduleTransformation : public model::Transformation
+    {
+    public:
+        /// <summary> Set the schedule for the `MatrixMatrixMultiplyCodeNode`s if there's a tuned one. </summary>
+        model::Submodel Transform(const model::Submodel& submodel, model::ModelTransformer& transformer, const ell::model::TransformContext& context) const override;
+
+        /// <summary> Returns the ID for this transformation </summary>
+        std::string GetRuntimeTypeName() const override { return { "SetMatrixMultiplyScheduleTransformation" }; };
+    };
+} // namespace passes
+} // namespace ell
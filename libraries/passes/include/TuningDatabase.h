@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningDatabase.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <utilities/include/Archiver.h>
+#include <utilities/include/IArchivable.h>
+
+#include <map>
+#include <string>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> The best implementation choice found for each operation shape and target, as measured by an
+    /// autotuning transformation (e.g., `SetConvolutionMethodTransformation` or `SetMatrixMultiplyScheduleTransformation`).
+    /// Each transformation describes its keys and encodes its choices as strings. Stored as JSON, so the timing only
+    /// has to happen once per shape. </summary>
+    class TuningDatabase : public utilities::IArchivable
+    {
+    public:
+        /// <summary> Loads a database from a JSON file. Returns an empty database if the file doesn't exist. </summary>
+        ///
+        /// <param name="filename"> The file to read. </param>
+        static TuningDatabase Load(const std::string& filename);
+
+        /// <summary> Saves the database to a JSON file. </summary>
+        ///
+        /// <param name="filename"> The file to write. </param>
+        void Save(const std::string& filename) const;
+
+        /// <summary> Checks if the database has an entry for the given key. </summary>
+        bool HasEntry(const std::string& key) const;
+
+        /// <summary> Gets the value stored for the given key. Throws an exception if there isn't one. </summary>
+        std::string GetEntry(const std::string& key) const;
+
+        /// <summary> Sets the value stored for the given key. </summary>
+        void SetEntry(const std::string& key, const std::string& value);
+
+        /// <summary> Gets the number of entries in the database. </summary>
+        size_t Size() const { return _entries.size(); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        static std::string GetTypeName() { return "TuningDatabase"; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        std::map<std::string, std::string> _entries;
+    };
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningUtilities.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <emitters/include/TargetDevice.h>
+
+#include <utilities/include/TypeName.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> Checks if code compiled for the given target can be timed on this machine. </summary>
+    bool IsHostTarget(const emitters::TargetDevice& target);
+
+    /// <summary> Gets a tuning database key for an operation. The key identifies everything that affects which
+    /// implementation is fastest: the element type, the target, and the operation's shape. </summary>
+    ///
+    /// <typeparam name="ValueType"> The element type of the operation. </typeparam>
+    /// <param name="target"> The target device. A "host" target is resolved to this machine's triple and CPU. </param>
+    /// <param name="shape"> A description of the operation's shape, e.g. "m=8;n=16;k=32". </param>
+    template <typename ValueType>
+    std::string GetTuningKey(const emitters::TargetDevice& target, const std::string& shape);
+
+    /// <summary> Gets deterministic input values in [0, 1] to time an operation with. </summary>
+    template <typename ValueType>
+    std::vector<ValueType> GetTuningInput(size_t size);
+
+    /// <summary> Runs a function several times and returns the fastest time, in seconds. The caller should run the
+    /// function once first to warm up. </summary>
+    ///
+    /// <param name="function"> The function to time. </param>
+    /// <param name="numIterations"> The number of times to run it. </param>
+    double GetBestTime(const std::function<void()>& function, int numIterations = 5);
+
+    namespace detail
+    {
+        std::string GetTuningKey(const std::string& typeName, const emitters::TargetDevice& target, const std::string& shape);
+    }
+} // namespace passes
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace passes
+{
+    template <typename ValueType>
+    std::string GetTuningKey(const emitters::TargetDevice& target, const std::string& shape)
+    {
+        return detail::GetTuningKey(utilities::TypeName<ValueType>::GetName(), target, shape);
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> GetTuningInput(size_t size)
+    {
+        std::vector<ValueType> input(size);
+        for (size_t index = 0; index < input.size(); ++index)
+        {
+            input[index] = static_cast<ValueType>(index % 17) / 16;
+        }
+        return input;
+    }
+} // namespace passes
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FoldConstantsTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FoldConstantsTransformation.h"
+
+#include <model/include/InputNodeBase.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/OutputNodeBase.h>
+
+#include <nodes/include/ConstantNode.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/StlVectorUtil.h>
+
+#include <value/include/ComputeContext.h>
+#include <value/include/EmitterContext.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+
+using namespace ell;
+using namespace ell::model;
+
+//
+// Implementation
+//
+namespace
+{
+std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+{
+    return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+}
+
+bool IsConstantNode(const Node& node)
+{
+    return dynamic_cast<const nodes::ConstantNode<bool>*>(&node) != nullptr ||
+           dynamic_cast<const nodes::ConstantNode<int>*>(&node) != nullptr ||
+           dynamic_cast<const nodes::ConstantNode<int64_t>*>(&node) != nullptr ||
+           dynamic_cast<const nodes::ConstantNode<float>*>(&node) != nullptr ||
+           dynamic_cast<const nodes::ConstantNode<double>*>(&node) != nullptr;
+}
+
+// Returns true if the node's output can be computed once, at transform time, from the given constant nodes
+bool CanFoldNode(const Node& node, const std::unordered_set<const Node*>& constantNodes)
+{
+    const auto& inputs = node.GetInputPorts();
+    if (inputs.empty() || node.HasRuntimeState())
+    {
+        return false;
+    }
+
+    // The map's inputs and outputs have to stay where they are
+    if (dynamic_cast<const InputNodeBase*>(&node) != nullptr || dynamic_cast<const OutputNodeBase*>(&node) != nullptr)
+    {
+        return false;
+    }
+
+    return std::all_of(inputs.begin(), inputs.end(), [&constantNodes](auto input) {
+        return constantNodes.count(input->GetReferencedPort().GetNode()) != 0;
+    });
+}
+
+template <typename ValueType>
+void ReplaceWithConstantNode(const OutputPortBase& port, ModelTransformer& transformer)
+{
+    const auto& typedPort = static_cast<const OutputPort<ValueType>&>(port);
+    auto newNode = transformer.AddNode<nodes::ConstantNode<ValueType>>(typedPort.GetOutput(), typedPort.GetMemoryLayout());
+    transformer.MapNodeOutput(typedPort, newNode->output);
+}
+
+void ReplaceWithConstantNode(const OutputPortBase& port, ModelTransformer& transformer)
+{
+    switch (port.GetType())
+    {
+    case Port::PortType::boolean:
+        ReplaceWithConstantNode<bool>(port, transformer);
+        break;
+    case Port::PortType::integer:
+        ReplaceWithConstantNode<int>(port, transformer);
+        break;
+    case Port::PortType::bigInt:
+        ReplaceWithConstantNode<int64_t>(port, transformer);
+        break;
+    case Port::PortType::smallReal:
+        ReplaceWithConstantNode<float>(port, transformer);
+        break;
+    case Port::PortType::real:
+        ReplaceWithConstantNode<double>(port, transformer);
+        break;
+    default:
+        throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+    }
+}
+} // namespace
+
+//
+// FoldConstantsTransformation methods
+//
+namespace ell
+{
+namespace passes
+{
+    Submodel FoldConstantsTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        auto compiler = context.GetCompiler();
+        if (!compiler)
+        {
+            return submodel;
+        }
+
+        // Evaluate the constant parts of the submodel, in dependency order
+        std::unordered_set<const Node*> constantNodes;
+        std::unordered_set<const Node*> foldedNodes;
+        {
+            value::ComputeContext computeContext("fold_constants");
+            value::ContextGuard<> guard(computeContext);
+            submodel.Visit([&](const Node& node) {
+                if (IsConstantNode(node))
+                {
+                    node.Compute();
+                    constantNodes.insert(&node);
+                }
+                else if (CanFoldNode(node, constantNodes) && compiler->GetModelOptimizerOptions(node).GetEntry<bool>("foldConstants", true))
+                {
+                    node.Compute();
+                    constantNodes.insert(&node);
+                    foldedNodes.insert(&node);
+                }
+            });
+        }
+
+        if (foldedNodes.empty())
+        {
+            return submodel;
+        }
+
+        // Only the folded ports that something else reads need to be replaced
+        std::unordered_set<const OutputPortBase*> replacedPorts;
+        submodel.Visit([&](const Node& node) {
+            if (foldedNodes.count(&node) != 0)
+            {
+                return;
+            }
+            for (auto input : node.GetInputPorts())
+            {
+                const auto& port = input->GetReferencedPort();
+                if (foldedNodes.count(port.GetNode()) != 0)
+                {
+                    replacedPorts.insert(&port);
+                }
+            }
+        });
+        for (auto output : submodel.GetOutputs())
+        {
+            if (foldedNodes.count(output->GetNode()) != 0)
+            {
+                replacedPorts.insert(output);
+            }
+        }
+
+        auto onto = GetReferencedPorts(submodel.GetInputs());
+        auto destModel = submodel.GetModel().ShallowCopy();
+        auto result = transformer.TransformSubmodelOnto(submodel, destModel, onto, context, [&foldedNodes, &replacedPorts](const Node& node, ModelTransformer& transformer) {
+            if (foldedNodes.count(&node) == 0)
+            {
+                transformer.CopyNode(node);
+                return;
+            }
+
+            for (auto output : node.GetOutputPorts())
+            {
+                if (replacedPorts.count(output) != 0)
+                {
+                    ReplaceWithConstantNode(*output, transformer);
+                }
+            }
+        });
+
+        return result;
+    }
+} // namespace passes
+} // namespace ell
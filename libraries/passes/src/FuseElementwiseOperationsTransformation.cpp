@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseElementwiseOperationsTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FuseElementwiseOperationsTransformation.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <nodes/include/ActivationFunctions.h>
+#include <nodes/include/ActivationLayerNode.h>
+#include <nodes/include/BroadcastFunctionNode.h>
+#include <nodes/include/FusedElementwiseNode.h>
+#include <nodes/include/UnaryOperationNode.h>
+
+#include <predictors/neural/include/HardSigmoidActivation.h>
+#include <predictors/neural/include/HardTanhActivation.h>
+#include <predictors/neural/include/LeakyReLUActivation.h>
+#include <predictors/neural/include/ReLUActivation.h>
+#include <predictors/neural/include/SigmoidActivation.h>
+#include <predictors/neural/include/TanhActivation.h>
+
+#include <utilities/include/StlVectorUtil.h>
+
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace ell;
+using namespace ell::model;
+
+//
+// Implementation
+//
+namespace
+{
+using nodes::FusedElementwiseOperation;
+
+std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+{
+    return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+}
+
+//
+// Data structures
+//
+
+// What a node that can be fused does, in terms of the node's own ports
+template <typename ValueType>
+struct ElementwiseNodeInfo
+{
+    nodes::FusedElementwiseStage<ValueType> stage; // the secondary input indices refer to `secondaryInputs`
+    const InputPort<ValueType>* input = nullptr;
+    std::vector<const InputPort<ValueType>*> secondaryInputs;
+    const OutputPort<ValueType>* output = nullptr;
+    PortMemoryLayout inputLayout;
+    PortMemoryLayout outputLayout;
+    ValueType padding = 0;
+};
+
+//
+// Functions
+//
+template <typename ValueType>
+ElementwiseNodeInfo<ValueType> GetUnaryNodeInfo(FusedElementwiseOperation operation, const InputPort<ValueType>& input, const OutputPort<ValueType>& output, const PortMemoryLayout& inputLayout, const PortMemoryLayout& outputLayout, ValueType padding)
+{
+    ElementwiseNodeInfo<ValueType> info;
+    info.stage.operation = operation;
+    info.input = &input;
+    info.output = &output;
+    info.inputLayout = inputLayout;
+    info.outputLayout = outputLayout;
+    info.padding = padding;
+    return info;
+}
+
+template <typename ValueType, typename FunctionType>
+std::optional<ElementwiseNodeInfo<ValueType>> TryGetActivationNodeInfo(const Node& node, FusedElementwiseOperation operation)
+{
+    auto thisNode = dynamic_cast<const nodes::BroadcastUnaryFunctionNode<ValueType, FunctionType>*>(&node);
+    if (thisNode == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    auto info = GetUnaryNodeInfo(operation, thisNode->primaryInput, thisNode->output, thisNode->GetInputMemoryLayout(), thisNode->GetOutputMemoryLayout(), thisNode->GetOutputPadding());
+    if constexpr (std::is_same_v<FunctionType, nodes::LeakyReLUActivationFunction<ValueType>>)
+    {
+        info.stage.parameter = thisNode->GetFunction().GetLeakyFactor();
+    }
+    return info;
+}
+
+template <typename ValueType>
+std::optional<ElementwiseNodeInfo<ValueType>> TryGetLinearNodeInfo(const Node& node)
+{
+    auto thisNode = dynamic_cast<const nodes::BroadcastLinearFunctionNode<ValueType>*>(&node);
+    if (thisNode == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    auto info = GetUnaryNodeInfo(FusedElementwiseOperation::linear, thisNode->primaryInput, thisNode->output, thisNode->GetInputMemoryLayout(), thisNode->GetOutputMemoryLayout(), thisNode->GetOutputPadding());
+    const auto dimension = static_cast<int>(thisNode->GetBroadcastDimension());
+    info.stage.broadcastDimension = dimension;
+    for (auto secondaryInput : { &thisNode->secondaryInput1, &thisNode->secondaryInput2 })
+    {
+        if (secondaryInput->Size() == 0)
+        {
+            continue;
+        }
+        if (secondaryInput->Size() != static_cast<size_t>(info.inputLayout.GetActiveSize(dimension)))
+        {
+            return std::nullopt;
+        }
+        auto& index = secondaryInput == &thisNode->secondaryInput1 ? info.stage.scaleInput : info.stage.biasInput;
+        index = static_cast<int>(info.secondaryInputs.size());
+        info.secondaryInputs.push_back(secondaryInput);
+    }
+    return info;
+}
+
+template <typename ValueType>
+std::optional<ElementwiseNodeInfo<ValueType>> TryGetActivationLayerNodeInfo(const Node& node)
+{
+    auto thisNode = dynamic_cast<const nodes::ActivationLayerNode<ValueType>*>(&node);
+    if (thisNode == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    auto impl = thisNode->GetLayer().GetActivationFunction().GetImpl();
+    ElementwiseNodeInfo<ValueType> info = GetUnaryNodeInfo(FusedElementwiseOperation::relu, thisNode->input, thisNode->output, thisNode->GetInputMemoryLayout(), thisNode->GetOutputMemoryLayout(), ValueType{ 0 });
+    if (dynamic_cast<predictors::neural::ReLUActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::relu;
+    }
+    else if (auto leakyReLU = dynamic_cast<predictors::neural::LeakyReLUActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::leakyReLU;
+        info.stage.parameter = leakyReLU->GetLeakyFactor();
+    }
+    else if (dynamic_cast<predictors::neural::SigmoidActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::sigmoid;
+    }
+    else if (dynamic_cast<predictors::neural::HardSigmoidActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::hardSigmoid;
+    }
+    else if (dynamic_cast<predictors::neural::TanhActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::tanh;
+    }
+    else if (dynamic_cast<predictors::neural::HardTanhActivation<ValueType>*>(impl))
+    {
+        info.stage.operation = FusedElementwiseOperation::hardTanh;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+    return info;
+}
+
+template <typename ValueType>
+std::optional<ElementwiseNodeInfo<ValueType>> TryGetUnaryOperationNodeInfo(const Node& node)
+{
+    auto thisNode = dynamic_cast<const nodes::UnaryOperationNode<ValueType>*>(&node);
+    if (thisNode == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    // UnaryOperationNode treats its input as a flat vector, padding and all
+    auto layout = thisNode->input.GetMemoryLayout();
+    if (layout.HasPadding())
+    {
+        return std::nullopt;
+    }
+
+    using nodes::UnaryOperationType;
+    static const std::unordered_map<UnaryOperationType, FusedElementwiseOperation> operations = {
+        { UnaryOperationType::abs, FusedElementwiseOperation::abs },
+        { UnaryOperationType::cos, FusedElementwiseOperation::cos },
+        { UnaryOperationType::exp, FusedElementwiseOperation::exp },
+        { UnaryOperationType::hardSigmoid, FusedElementwiseOperation::hardSigmoid },
+        { UnaryOperationType::hardTanh, FusedElementwiseOperation::hardTanh },
+        { UnaryOperationType::log, FusedElementwiseOperation::log },
+        { UnaryOperationType::sigmoid, FusedElementwiseOperation::sigmoid },
+        { UnaryOperationType::sin, FusedElementwiseOperation::sin },
+        { UnaryOperationType::sqrt, FusedElementwiseOperation::sqrt },
+        { UnaryOperationType::square, FusedElementwiseOperation::square },
+        { UnaryOperationType::tanh, FusedElementwiseOperation::tanh },
+    };
+    auto operation = operations.find(thisNode->GetOperation());
+    if (operation == operations.end())
+    {
+        return std::nullopt;
+    }
+    return GetUnaryNodeInfo(operation->second, thisNode->input, thisNode->output, layout, layout, ValueType{ 0 });
+}
+
+// Returns a description of the node's operation if it's one that can be fused
+template <typename ValueType>
+std::optional<ElementwiseNodeInfo<ValueType>> GetElementwiseNodeInfo(const Node& node)
+{
+    std::optional<ElementwiseNodeInfo<ValueType>> info;
+    (info = TryGetLinearNodeInfo<ValueType>(node)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::ReLUActivationFunction<ValueType>>(node, FusedElementwiseOperation::relu)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::LeakyReLUActivationFunction<ValueType>>(node, FusedElementwiseOperation::leakyReLU)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::SigmoidActivationFunction<ValueType>>(node, FusedElementwiseOperation::sigmoid)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::HardSigmoidActivationFunction<ValueType>>(node, FusedElementwiseOperation::hardSigmoid)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::TanhActivationFunction<ValueType>>(node, FusedElementwiseOperation::tanh)) ||
+        (info = TryGetActivationNodeInfo<ValueType, nodes::HardTanhActivationFunction<ValueType>>(node, FusedElementwiseOperation::hardTanh)) ||
+        (info = TryGetActivationLayerNodeInfo<ValueType>(node)) ||
+        (info = TryGetUnaryOperationNodeInfo<ValueType>(node));
+    return info;
+}
+
+// Returns the node producing this node's input if the two can be fused, else null
+template <typename ValueType>
+const Node* GetFusableInputNode(const Node& node, const std::unordered_map<const OutputPortBase*, int>& numReaders)
+{
+    auto info = GetElementwiseNodeInfo<ValueType>(node);
+    if (!info)
+    {
+        return nullptr;
+    }
+
+    const auto& inputPort = info->input->GetReferencedPort();
+    auto inputInfo = GetElementwiseNodeInfo<ValueType>(*inputPort.GetNode());
+    if (!inputInfo)
+    {
+        return nullptr;
+    }
+
+    // The intermediate values must not be needed anywhere else, and must be laid out the same way the node reads them
+    auto readers = numReaders.find(&inputPort);
+    if (readers == numReaders.end() || readers->second != 1)
+    {
+        return nullptr;
+    }
+    if (inputInfo->outputLayout != info->inputLayout)
+    {
+        return nullptr;
+    }
+    return inputPort.GetNode();
+}
+
+// Adds a FusedElementwiseNode computing the given node. If `extendChain` is true, the node producing the node's input
+// has already been replaced by a FusedElementwiseNode, and the new node performs that node's stages, too.
+// Returns 'true' if we handled the situation, else 'false'. If we return 'false', keep trying other ValueTypes
+template <typename ValueType>
+bool TryAddFusedNode(const Node& node, bool extendChain, ModelTransformer& transformer)
+{
+    auto info = GetElementwiseNodeInfo<ValueType>(node);
+    if (!info)
+    {
+        return false;
+    }
+
+    const auto& newInput = transformer.GetCorrespondingInputs(*info->input);
+    auto prevNode = extendChain ? dynamic_cast<const nodes::FusedElementwiseNode<ValueType>*>(newInput.GetNode()) : nullptr;
+
+    const OutputPort<ValueType>* input = &newInput;
+    PortMemoryLayout inputLayout = info->inputLayout;
+    std::vector<const OutputPort<ValueType>*> secondaryInputs;
+    std::vector<nodes::FusedElementwiseStage<ValueType>> stages;
+    if (prevNode != nullptr)
+    {
+        input = &prevNode->input.GetReferencedPort();
+        inputLayout = prevNode->GetInputMemoryLayout();
+        stages = prevNode->GetStages();
+        for (int index = 0; index < prevNode->NumSecondaryInputs(); ++index)
+        {
+            secondaryInputs.push_back(&prevNode->GetSecondaryInput(index).GetReferencedPort());
+        }
+    }
+
+    auto stage = info->stage;
+    const auto secondaryInputOffset = static_cast<int>(secondaryInputs.size());
+    if (stage.scaleInput >= 0)
+    {
+        stage.scaleInput += secondaryInputOffset;
+    }
+    if (stage.biasInput >= 0)
+    {
+        stage.biasInput += secondaryInputOffset;
+    }
+    for (auto secondaryInput : info->secondaryInputs)
+    {
+        secondaryInputs.push_back(&transformer.GetCorrespondingInputs(*secondaryInput));
+    }
+    stages.push_back(stage);
+
+    auto newNode = transformer.AddNode<nodes::FusedElementwiseNode<ValueType>>(*input, inputLayout, secondaryInputs, stages, info->outputLayout, info->padding);
+    transformer.MapNodeOutput(*info->output, newNode->output);
+    return true;
+}
+} // namespace
+
+//
+// FuseElementwiseOperationsTransformation methods
+//
+namespace ell
+{
+namespace passes
+{
+    Submodel FuseElementwiseOperationsTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        auto compiler = context.GetCompiler();
+        if (!compiler)
+        {
+            return submodel;
+        }
+
+        auto canFuseNode = [compiler](const Node& node) {
+            return compiler->GetModelOptimizerOptions(node).GetEntry<bool>("fuseElementwiseNodes", true);
+        };
+
+        // Count the readers of each port. Nodes left unused by earlier transformations aren't visited, so they don't
+        // count. The submodel's outputs are read by whatever comes after it.
+        std::unordered_map<const OutputPortBase*, int> numReaders;
+        submodel.Visit([&numReaders](const Node& node) {
+            for (auto input : node.GetInputPorts())
+            {
+                ++numReaders[&input->GetReferencedPort()];
+            }
+        });
+        for (auto output : submodel.GetOutputs())
+        {
+            ++numReaders[output];
+        }
+
+        // Find the chains of nodes to fuse
+        std::unordered_set<const Node*> extendsChain;
+        std::unordered_set<const Node*> startsChain;
+        submodel.Visit([&](const Node& node) {
+            auto inputNode = GetFusableInputNode<float>(node, numReaders);
+            if (inputNode == nullptr)
+            {
+                inputNode = GetFusableInputNode<double>(node, numReaders);
+            }
+            if (inputNode != nullptr && canFuseNode(node) && canFuseNode(*inputNode))
+            {
+                extendsChain.insert(&node);
+                if (extendsChain.count(inputNode) == 0)
+                {
+                    startsChain.insert(inputNode);
+                }
+            }
+        });
+
+        if (extendsChain.empty())
+        {
+            return submodel;
+        }
+
+        auto onto = GetReferencedPorts(submodel.GetInputs());
+        auto destModel = submodel.GetModel().ShallowCopy();
+        auto result = transformer.TransformSubmodelOnto(submodel, destModel, onto, context, [&extendsChain, &startsChain](const Node& node, ModelTransformer& transformer) {
+            const bool extendChain = extendsChain.count(&node) != 0;
+            if (extendChain || startsChain.count(&node) != 0)
+            {
+                if (TryAddFusedNode<float>(node, extendChain, transformer) || TryAddFusedNode<double>(node, extendChain, transformer))
+                {
+                    return;
+                }
+            }
+            transformer.CopyNode(node);
+        });
+
+        return result;
+    }
+} // namespace passes
+} // namespace ell
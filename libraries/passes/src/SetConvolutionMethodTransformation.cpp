@@ -7,7 +7,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SetConvolutionMethodTransformation.h"
+#include "TuningDatabase.h"
+#include "TuningUtilities.h"
 
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputNode.h>
+#include <model/include/Map.h>
 #include <model/include/ModelTransformer.h>
 #include <model/include/RefineTransformation.h>
 
@@ -19,6 +25,9 @@
 #include <utilities/include/Logger.h>
 #include <utilities/include/StlVectorUtil.h>
 
+#include <limits>
+#include <optional>
+#include <sstream>
 #include <vector>
 
 namespace ell
@@ -64,6 +73,8 @@ namespace passes
                 return predictors::neural::ConvolutionMethod::diagonal;
             case model::PreferredConvolutionMethod::winograd:
                 return predictors::neural::ConvolutionMethod::winograd;
+            case model::PreferredConvolutionMethod::tiled:
+                return predictors::neural::ConvolutionMethod::tiled;
             default:
                 throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument);
             }
@@ -119,6 +130,113 @@ namespace passes
             return true;
         }
 
+        //
+        // Autotuning
+        //
+
+        // Describes everything about a convolution's shape that affects which method is fastest
+        template <typename ValueType>
+        std::string GetTuningShape(const predictors::neural::ConvolutionalLayer<ValueType>& layer)
+        {
+            auto inputShape = layer.GetInputShape();
+            auto outputShape = layer.GetOutputShape();
+            auto layerParameters = layer.GetLayerParameters();
+            auto convolutionalParameters = layer.GetConvolutionalParameters();
+
+            std::stringstream shape;
+            shape << "input=" << inputShape.NumRows() << "x" << inputShape.NumColumns() << "x" << inputShape.NumChannels()
+                  << ";inputPadding=" << layerParameters.inputPaddingParameters.paddingSize
+                  << ";output=" << outputShape.NumRows() << "x" << outputShape.NumColumns() << "x" << outputShape.NumChannels()
+                  << ";outputPadding=" << layerParameters.outputPaddingParameters.paddingSize
+                  << ";receptiveField=" << convolutionalParameters.receptiveField
+                  << ";stride=" << convolutionalParameters.stride;
+            return shape.str();
+        }
+
+        // Returns the fastest time, in seconds, to compute a map holding just this convolution with the given method
+        template <typename ValueType>
+        double TimeConvolutionMethod(const nodes::ConvolutionalLayerNode<ValueType>& node, const model::MapCompiler& compiler, model::PreferredConvolutionMethod method)
+        {
+            const auto& layer = node.GetLayer();
+            auto convolutionalParameters = layer.GetConvolutionalParameters();
+            convolutionalParameters.method = GetConvolutionMethod(method);
+            predictors::neural::ConvolutionalLayer<ValueType> newLayer = { layer.GetLayerParameters(), convolutionalParameters, layer.GetWeights() };
+
+            model::Model model;
+            auto inputNode = model.AddNode<model::InputNode<ValueType>>(node.input.Size());
+            auto convolutionNode = model.AddNode<nodes::ConvolutionalLayerNode<ValueType>>(inputNode->output, newLayer);
+            model::Map map(model, { { "input", inputNode } }, { { "output", convolutionNode->output } });
+
+            auto optimizerOptions = compiler.GetModelOptimizerOptions(node);
+            optimizerOptions["preferredConvolutionMethod"] = method;
+            model::IRMapCompiler tuningCompiler(compiler.GetMapCompilerOptions(node), optimizerOptions);
+            auto compiledMap = tuningCompiler.Compile(map);
+
+            compiledMap.SetInputValue(0, GetTuningInput<ValueType>(node.input.Size()));
+            compiledMap.ComputeOutput<ValueType>(0); // warm up
+            return GetBestTime([&compiledMap]() { compiledMap.ComputeOutput<ValueType>(0); });
+        }
+
+        // Returns the fastest method for the node if it's a ConvolutionalLayerNode<ValueType>, else an empty optional
+        template <typename ValueType>
+        std::optional<model::PreferredConvolutionMethod> TryTuneConvolutionMethod(const model::Node& node, const model::MapCompiler& compiler, TuningDatabase& database, bool& databaseChanged)
+        {
+            auto thisNode = dynamic_cast<const nodes::ConvolutionalLayerNode<ValueType>*>(&node);
+            if (thisNode == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            const auto& target = compiler.GetMapCompilerOptions(node).compilerSettings.targetDevice;
+            auto key = GetTuningKey<ValueType>(target, GetTuningShape(thisNode->GetLayer()));
+            if (database.HasEntry(key))
+            {
+                return utilities::FromString<model::PreferredConvolutionMethod>(database.GetEntry(key));
+            }
+
+            if (!IsHostTarget(target))
+            {
+                Log() << "Can't autotune convolution for node " << thisNode->GetId() << ": target isn't the host, and the tuning database has no entry for " << key << std::endl;
+                return model::PreferredConvolutionMethod::automatic;
+            }
+
+            auto bestMethod = model::PreferredConvolutionMethod::automatic;
+            auto bestTime = std::numeric_limits<double>::max();
+            auto convolutionalParameters = thisNode->GetLayer().GetConvolutionalParameters();
+            for (auto method : { model::PreferredConvolutionMethod::simple, model::PreferredConvolutionMethod::unrolled, model::PreferredConvolutionMethod::diagonal, model::PreferredConvolutionMethod::winograd, model::PreferredConvolutionMethod::tiled })
+            {
+                if (!IsMethodCompatible(GetConvolutionMethod(method), convolutionalParameters))
+                {
+                    continue;
+                }
+
+                auto time = TimeConvolutionMethod(*thisNode, compiler, method);
+                Log() << "Convolution method " << model::ToString(method) << " takes " << time * 1000 << " ms for node " << thisNode->GetId() << std::endl;
+                if (time < bestTime)
+                {
+                    bestTime = time;
+                    bestMethod = method;
+                }
+            }
+
+            database.SetEntry(key, model::ToString(bestMethod));
+            databaseChanged = true;
+            return bestMethod;
+        }
+
+        model::PreferredConvolutionMethod TuneConvolutionMethod(const model::Node& node, const model::MapCompiler& compiler, TuningDatabase& database, bool& databaseChanged)
+        {
+            if (auto method = TryTuneConvolutionMethod<float>(node, compiler, database, databaseChanged))
+            {
+                return *method;
+            }
+            if (auto method = TryTuneConvolutionMethod<double>(node, compiler, database, databaseChanged))
+            {
+                return *method;
+            }
+            return model::PreferredConvolutionMethod::automatic;
+        }
+
         void SetConvolutionMethod(const model::Node& node, model::ModelTransformer& transformer, model::PreferredConvolutionMethod preferredMethod)
         {
             if (preferredMethod != model::PreferredConvolutionMethod::automatic)
@@ -154,20 +272,42 @@ namespace passes
         RefineTransformation refineTransformation;
         auto result1 = refineTransformation.Transform(submodel, transformer, refineNNPredictorContext);
 
+        // Methods chosen by autotuning are cached in a database file, if one was given
+        TuningDatabase tuningDatabase;
+        std::string tuningDatabaseFilename;
+        bool tuningDatabaseChanged = false;
+        if (auto compiler = context.GetCompiler())
+        {
+            tuningDatabaseFilename = compiler->GetModelOptimizerOptions(result1.GetModel()).GetEntry<std::string>("convolutionTuningDatabase", "");
+            if (!tuningDatabaseFilename.empty())
+            {
+                tuningDatabase = TuningDatabase::Load(tuningDatabaseFilename);
+            }
+        }
+
         // Now set the method on any ConvolutionalLayerNodes, using an in-place transformation
         auto onto = transformer.GetCorrespondingOutputs(GetReferencedPorts(result1.GetInputs()));
         model::Model destModel = result1.GetModel().ShallowCopy();
-        auto result2 = transformer.TransformSubmodelOnto(result1, destModel, onto, context, [context](const Node& node, ModelTransformer& transformer) {
+        auto result2 = transformer.TransformSubmodelOnto(result1, destModel, onto, context, [context, &tuningDatabase, &tuningDatabaseChanged](const Node& node, ModelTransformer& transformer) {
             model::PreferredConvolutionMethod preferredMethod = model::PreferredConvolutionMethod::automatic;
             auto compiler = context.GetCompiler();
             if (compiler)
             {
                 preferredMethod = compiler->GetModelOptimizerOptions(node).GetEntry<PreferredConvolutionMethod>("preferredConvolutionMethod", PreferredConvolutionMethod::automatic);
+                if (preferredMethod == PreferredConvolutionMethod::autotune)
+                {
+                    preferredMethod = TuneConvolutionMethod(node, *compiler, tuningDatabase, tuningDatabaseChanged);
+                }
             }
 
             SetConvolutionMethod(node, transformer, preferredMethod);
         });
 
+        if (tuningDatabaseChanged && !tuningDatabaseFilename.empty())
+        {
+            tuningDatabase.Save(tuningDatabaseFilename);
+        }
+
         // Finally, refine any ConvolutionalLayerNodes
         auto refineConvLayerFn = [](const model::Node& node) {
             return IsConvolutionalLayerNode(node) ? model::NodeAction::refine : model::NodeAction::compile;
@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SetMatrixMultiplyScheduleTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SetMatrixMultiplyScheduleTransformation.h"
+#include "TuningDatabase.h"
+#include "TuningUtilities.h"
+
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputNode.h>
+#include <model/include/Map.h>
+#include <model/include/ModelTransformer.h>
+
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Logger.h>
+#include <utilities/include/StlVectorUtil.h>
+#include <utilities/include/StringUtil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    using namespace model;
+    using namespace utilities::logging;
+    using utilities::logging::Log;
+
+    namespace
+    {
+        std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+        {
+            return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+        }
+
+        // Describes everything about a matrix multiplication's shape that affects which schedule is fastest
+        template <typename ValueType>
+        std::string GetTuningShape(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node)
+        {
+            auto outputShape = node.output.GetMemoryLayout().GetActiveSize();
+            auto m = outputShape[0];
+            auto n = outputShape[1];
+            auto k = static_cast<int>(node.input1.Size()) / m;
+
+            std::stringstream shape;
+            shape << "m=" << m << ";n=" << n << ";k=" << k;
+            return shape.str();
+        }
+
+        // Schedules are stored in the tuning database as "name=value" pairs separated by semicolons
+        std::string ScheduleToString(const nodes::MatrixMatrixMultiplySchedule& schedule)
+        {
+            std::stringstream value;
+            value << "columnBlock=" << schedule.columnBlock
+                  << ";innerDimensionBlock=" << schedule.innerDimensionBlock
+                  << ";kUnroll=" << schedule.kUnroll
+                  << ";kernelRows=" << schedule.kernelRows
+                  << ";kernelColumnVectors=" << schedule.kernelColumnVectors
+                  << ";cachingStrategy=" << static_cast<int>(schedule.cachingStrategy)
+                  << ";cacheElements=" << schedule.cacheElements
+                  << ";cacheFillElements=" << schedule.cacheFillElements;
+            return value.str();
+        }
+
+        nodes::MatrixMatrixMultiplySchedule ScheduleFromString(const std::string& value)
+        {
+            const std::map<std::string, int nodes::MatrixMatrixMultiplySchedule::*> intFields = {
+                { "columnBlock", &nodes::MatrixMatrixMultiplySchedule::columnBlock },
+                { "innerDimensionBlock", &nodes::MatrixMatrixMultiplySchedule::innerDimensionBlock },
+                { "kUnroll", &nodes::MatrixMatrixMultiplySchedule::kUnroll },
+                { "kernelRows", &nodes::MatrixMatrixMultiplySchedule::kernelRows },
+                { "kernelColumnVectors", &nodes::MatrixMatrixMultiplySchedule::kernelColumnVectors },
+                { "cacheElements", &nodes::MatrixMatrixMultiplySchedule::cacheElements },
+                { "cacheFillElements", &nodes::MatrixMatrixMultiplySchedule::cacheFillElements }
+            };
+
+            nodes::MatrixMatrixMultiplySchedule schedule;
+            for (const auto& field : utilities::Split(value, ';'))
+            {
+                auto nameAndValue = utilities::Split(field, '=');
+                if (nameAndValue.size() != 2)
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::badData, "Bad matrix multiply schedule " + value);
+                }
+
+                const auto& name = nameAndValue[0];
+                auto fieldValue = std::stoi(nameAndValue[1]);
+                if (name == "cachingStrategy")
+                {
+                    schedule.cachingStrategy = static_cast<nodes::MatrixMatrixMultiplyCachingStrategy>(fieldValue);
+                    continue;
+                }
+
+                auto intField = intFields.find(name);
+                if (intField == intFields.end())
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::badData, "Unknown matrix multiply schedule parameter " + name);
+                }
+                schedule.*(intField->second) = fieldValue;
+            }
+            return schedule;
+        }
+
+        template <typename ValueType>
+        bool IsClose(const std::vector<ValueType>& output, const std::vector<ValueType>& reference)
+        {
+            const double tolerance = 1e-4;
+            if (output.size() != reference.size())
+            {
+                return false;
+            }
+            for (size_t index = 0; index < output.size(); ++index)
+            {
+                if (std::abs(output[index] - reference[index]) > tolerance * std::max(1.0, std::abs(static_cast<double>(reference[index]))))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Returns the fastest time, in seconds, to compute a map holding just this matrix multiplication with the given schedule
+        template <typename ValueType>
+        double TimeSchedule(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node, const model::MapCompiler& compiler, const nodes::MatrixMatrixMultiplySchedule& schedule, std::vector<ValueType>& output)
+        {
+            model::Model model;
+            auto input1Node = model.AddNode<model::InputNode<ValueType>>(node.input1.Size());
+
+            // If B is constant (e.g., weights), keep it constant, so the candidate is timed with B packed at compile
+            // time, the way the node will be compiled
+            const OutputPort<ValueType>* input2 = nullptr;
+            model::InputNode<ValueType>* input2Node = nullptr;
+            auto constantInput2 = nodes::GetConstantInputNode(node.input2);
+            if (constantInput2 != nullptr && constantInput2->GetValues().size() == node.input2.Size())
+            {
+                input2 = &model.AddNode<nodes::ConstantNode<ValueType>>(constantInput2->GetValues(), constantInput2->output.GetMemoryLayout())->output;
+            }
+            else
+            {
+                input2Node = model.AddNode<model::InputNode<ValueType>>(node.input2.Size());
+                input2 = &input2Node->output;
+            }
+
+            model::ModelTransformer transformer;
+            model::Submodel nodeSubmodel({ &node.input1, &node.input2 }, { &node.output });
+            auto tuningSubmodel = transformer.TransformSubmodelOnto(nodeSubmodel, model, { &input1Node->output, input2 }, model::TransformContext{}, [&node, &schedule](const Node&, ModelTransformer& transformer) {
+                node.CopyWithSchedule(transformer, schedule);
+            });
+            std::vector<std::pair<std::string, InputNodeBase*>> inputs = { { "input1", input1Node } };
+            if (input2Node != nullptr)
+            {
+                inputs.push_back({ "input2", input2Node });
+            }
+            model::Map map(model, inputs, { { "output", *tuningSubmodel.GetOutputs()[0] } });
+
+            // Don't tune recursively when compiling the candidate
+            auto optimizerOptions = compiler.GetModelOptimizerOptions(node);
+            optimizerOptions["autotuneMatrixMultiply"] = false;
+            optimizerOptions["matrixMultiplyTuningDatabase"] = std::string{};
+            model::IRMapCompiler tuningCompiler(compiler.GetMapCompilerOptions(node), optimizerOptions);
+            auto compiledMap = tuningCompiler.Compile(map);
+
+            compiledMap.SetInputValue(0, GetTuningInput<ValueType>(node.input1.Size()));
+            if (input2Node != nullptr)
+            {
+                compiledMap.SetInputValue(1, GetTuningInput<ValueType>(node.input2.Size()));
+            }
+            output = compiledMap.ComputeOutput<ValueType>(0); // warm up
+            return GetBestTime([&compiledMap]() { compiledMap.ComputeOutput<ValueType>(0); });
+        }
+
+        // Searches one schedule parameter at a time, starting from the default schedule and keeping each improvement.
+        // Candidates that fail to compile or give different results from the default schedule are skipped.
+        template <typename ValueType>
+        nodes::MatrixMatrixMultiplySchedule SearchSchedule(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node, const model::MapCompiler& compiler)
+        {
+            auto outputShape = node.output.GetMemoryLayout().GetActiveSize();
+            auto m = outputShape[0];
+            auto n = outputShape[1];
+            auto k = static_cast<int>(node.input1.Size()) / m;
+
+            nodes::MatrixMatrixMultiplySchedule bestSchedule;
+            std::vector<ValueType> referenceOutput;
+            auto bestTime = TimeSchedule(node, compiler, bestSchedule, referenceOutput);
+
+            auto tryCandidate = [&](const nodes::MatrixMatrixMultiplySchedule& candidate) {
+                std::vector<ValueType> output;
+                double time = 0;
+                try
+                {
+                    time = TimeSchedule(node, compiler, candidate, output);
+                }
+                catch (const std::exception& exception)
+                {
+                    Log() << "Skipping matrix multiply schedule for node " << node.GetId() << ": " << exception.what() << std::endl;
+                    return;
+                }
+
+                if (!IsClose(output, referenceOutput))
+                {
+                    Log() << "Skipping matrix multiply schedule for node " << node.GetId() << ": incorrect result" << std::endl;
+                    return;
+                }
+                if (time < bestTime)
+                {
+                    bestTime = time;
+                    bestSchedule = candidate;
+                }
+            };
+
+            for (auto columnBlock : { 16, 32, 128, 256 })
+            {
+                if (columnBlock <= n)
+                {
+                    auto candidate = bestSchedule;
+                    candidate.columnBlock = columnBlock;
+                    tryCandidate(candidate);
+                }
+            }
+            for (auto innerDimensionBlock : { 32, 64, 128, 512 })
+            {
+                if (innerDimensionBlock <= k)
+                {
+                    auto candidate = bestSchedule;
+                    candidate.innerDimensionBlock = innerDimensionBlock;
+                    tryCandidate(candidate);
+                }
+            }
+            for (auto kUnroll : { 1, 2, 8 })
+            {
+                if (kUnroll <= k)
+                {
+                    auto candidate = bestSchedule;
+                    candidate.kUnroll = kUnroll;
+                    tryCandidate(candidate);
+                }
+            }
+            for (auto kernelRows : { 1, 2, 4, 6 })
+            {
+                if (kernelRows <= m)
+                {
+                    auto candidate = bestSchedule;
+                    candidate.kernelRows = kernelRows;
+                    tryCandidate(candidate);
+                }
+            }
+            for (auto kernelColumnVectors : { 1, 2, 4 })
+            {
+                auto candidate = bestSchedule;
+                candidate.kernelColumnVectors = kernelColumnVectors;
+                tryCandidate(candidate);
+            }
+            for (auto cachingStrategy : { nodes::MatrixMatrixMultiplyCachingStrategy::GeneralCachingStrategy, nodes::MatrixMatrixMultiplyCachingStrategy::None })
+            {
+                auto candidate = bestSchedule;
+                candidate.cachingStrategy = cachingStrategy;
+                tryCandidate(candidate);
+            }
+
+            // GeneralCachingStrategy has parameters of its own: the size of its cache, and how much of it is filled at a
+            // time. Try them even if the strategy lost with its defaults.
+            const auto defaultColumnBlock = std::min(bestSchedule.columnBlock > 0 ? bestSchedule.columnBlock : 64, n);
+            const auto defaultInnerDimensionBlock = std::min(bestSchedule.innerDimensionBlock > 0 ? bestSchedule.innerDimensionBlock : 256, k);
+            const auto defaultCacheElements = defaultColumnBlock * defaultInnerDimensionBlock;
+            const auto baseSchedule = bestSchedule;
+            for (auto cacheElements : { defaultCacheElements / 4, defaultCacheElements / 2, defaultCacheElements, 2 * defaultCacheElements })
+            {
+                if (cacheElements < n || cacheElements > k * n)
+                {
+                    continue;
+                }
+                for (auto cacheFillElements : { cacheElements, cacheElements / 2 })
+                {
+                    auto candidate = baseSchedule;
+                    candidate.cachingStrategy = nodes::MatrixMatrixMultiplyCachingStrategy::GeneralCachingStrategy;
+                    candidate.cacheElements = cacheElements;
+                    candidate.cacheFillElements = cacheFillElements;
+                    tryCandidate(candidate);
+                }
+            }
+
+            Log() << "Best matrix multiply schedule takes " << bestTime * 1000 << " ms for node " << node.GetId() << std::endl;
+            return bestSchedule;
+        }
+
+        // Returns 'true' if we handled the node, else 'false'. If we return 'false', keep trying other ValueTypes.
+        template <typename ValueType>
+        bool TrySetSchedule(const model::Node& node, model::ModelTransformer& transformer, const model::MapCompiler& compiler, TuningDatabase& database, bool& databaseChanged)
+        {
+            auto thisNode = dynamic_cast<const nodes::MatrixMatrixMultiplyCodeNode<ValueType>*>(&node);
+            if (thisNode == nullptr || thisNode->GetImplementation() != nodes::MatrixMatrixMultiplyImplementation::Mlas_Loopnest_Value)
+            {
+                return false;
+            }
+
+            const auto& target = compiler.GetMapCompilerOptions(node).compilerSettings.targetDevice;
+            auto key = GetTuningKey<ValueType>(target, GetTuningShape(*thisNode));
+            if (!database.HasEntry(key))
+            {
+                if (!compiler.GetModelOptimizerOptions(node).GetEntry<bool>("autotuneMatrixMultiply", false))
+                {
+                    return false;
+                }
+                if (!IsHostTarget(target))
+                {
+                    Log() << "Can't autotune matrix multiply for node " << thisNode->GetId() << ": target isn't the host, and the tuning database has no entry for " << key << std::endl;
+                    return false;
+                }
+
+                database.SetEntry(key, ScheduleToString(SearchSchedule(*thisNode, compiler)));
+                databaseChanged = true;
+            }
+
+            thisNode->CopyWithSchedule(transformer, ScheduleFromString(database.GetEntry(key)));
+            return true;
+        }
+
+        void SetSchedule(const model::Node& node, model::ModelTransformer& transformer, const model::MapCompiler& compiler, TuningDatabase& database, bool& databaseChanged)
+        {
+            if (TrySetSchedule<float>(node, transformer, compiler, database, databaseChanged))
+            {
+                return;
+            }
+            if (TrySetSchedule<double>(node, transformer, compiler, database, databaseChanged))
+            {
+                return;
+            }
+
+            transformer.CopyNode(node);
+        }
+    } // namespace
+
+    //
+    // SetMatrixMultiplyScheduleTransformation methods
+    //
+    Submodel SetMatrixMultiplyScheduleTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        auto compiler = context.GetCompiler();
+        if (!compiler)
+        {
+            return submodel;
+        }
+
+        auto tuningDatabaseFilename = compiler->GetModelOptimizerOptions(submodel.GetModel()).GetEntry<std::string>("matrixMultiplyTuningDatabase", "");
+        auto autotune = compiler->GetModelOptimizerOptions(submodel.GetModel()).GetEntry<bool>("autotuneMatrixMultiply", false);
+        if (tuningDatabaseFilename.empty() && !autotune)
+        {
+            return submodel;
+        }
+
+        auto tuningDatabase = tuningDatabaseFilename.empty() ? TuningDatabase{} : TuningDatabase::Load(tuningDatabaseFilename);
+        bool tuningDatabaseChanged = false;
+
+        auto onto = GetReferencedPorts(submodel.GetInputs());
+        auto destModel = submodel.GetModel().ShallowCopy();
+        auto result = transformer.TransformSubmodelOnto(submodel, destModel, onto, context, [compiler, &tuningDatabase, &tuningDatabaseChanged](const Node& node, ModelTransformer& transformer) {
+            SetSchedule(node, transformer, *compiler, tuningDatabase, tuningDatabaseChanged);
+        });
+
+        if (tuningDatabaseChanged && !tuningDatabaseFilename.empty())
+        {
+            tuningDatabase.Save(tuningDatabaseFilename);
+        }
+        return result;
+    }
+} // namespace passes
+} // namespace ell
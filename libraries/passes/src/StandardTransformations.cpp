@@ -7,10 +7,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DetectLowPrecisionConvolutionTransformation.h"
+#include "FoldConstantsTransformation.h"
 #include "StandardTransformations.h"
+#include "FuseElementwiseOperationsTransformation.h"
 #include "FuseLinearOperationsTransformation.h"
 #include "OptimizeReorderDataNodesTransformation.h"
 #include "SetConvolutionMethodTransformation.h"
+#include "SetMatrixMultiplyScheduleTransformation.h"
 
 #include <model/include/RefineTransformation.h>
 
@@ -36,7 +39,10 @@ namespace passes
             registry.AddTransformation<DetectLowPrecisionConvolutionTransformation>();
             registry.AddTransformation<SetConvolutionMethodTransformation>();
             registry.AddTransformation<model::RefineTransformation>();
+            registry.AddTransformation<FoldConstantsTransformation>();
+            registry.AddTransformation<SetMatrixMultiplyScheduleTransformation>();
             registry.AddTransformation<FuseLinearOperationsTransformation>();
+            registry.AddTransformation<FuseElementwiseOperationsTransformation>();
             registry.AddTransformation<OptimizeReorderDataNodesTransformation>();
             done = true;
         }
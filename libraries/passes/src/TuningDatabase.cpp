@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningDatabase.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TuningDatabase.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
+#include <utilities/include/JsonArchiver.h>
+
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    TuningDatabase TuningDatabase::Load(const std::string& filename)
+    {
+        TuningDatabase database;
+        if (!utilities::FileExists(filename))
+        {
+            return database;
+        }
+
+        auto stream = utilities::OpenIfstream(filename);
+        utilities::SerializationContext context;
+        utilities::JsonUnarchiver unarchiver(stream, context);
+        unarchiver.Unarchive(database);
+        return database;
+    }
+
+    void TuningDatabase::Save(const std::string& filename) const
+    {
+        auto stream = utilities::OpenOfstream(filename);
+        utilities::JsonArchiver archiver(stream);
+        archiver.Archive(*this);
+    }
+
+    bool TuningDatabase::HasEntry(const std::string& key) const
+    {
+        return _entries.find(key) != _entries.end();
+    }
+
+    std::string TuningDatabase::GetEntry(const std::string& key) const
+    {
+        auto entry = _entries.find(key);
+        if (entry == _entries.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "No tuning entry for " + key);
+        }
+        return entry->second;
+    }
+
+    void TuningDatabase::SetEntry(const std::string& key, const std::string& value)
+    {
+        _entries[key] = value;
+    }
+
+    void TuningDatabase::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (const auto& entry : _entries)
+        {
+            keys.push_back(entry.first);
+            values.push_back(entry.second);
+        }
+        archiver["keys"] << keys;
+        archiver["values"] << values;
+    }
+
+    void TuningDatabase::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        archiver["keys"] >> keys;
+        archiver["values"] >> values;
+        if (keys.size() != values.size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::badData, "Tuning database has a different number of keys and values");
+        }
+
+        _entries.clear();
+        for (size_t index = 0; index < keys.size(); ++index)
+        {
+            _entries[keys[index]] = values[index];
+        }
+    }
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningUtilities.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TuningUtilities.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace ell
+{
+namespace passes
+{
+    bool IsHostTarget(const emitters::TargetDevice& target)
+    {
+        if (target.deviceName == "host")
+        {
+            return true;
+        }
+        auto host = emitters::GetTargetDevice("host");
+        return target.triple == host.triple && target.cpu == host.cpu;
+    }
+
+    double GetBestTime(const std::function<void()>& function, int numIterations)
+    {
+        auto bestTime = std::numeric_limits<double>::max();
+        for (int iteration = 0; iteration < numIterations; ++iteration)
+        {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            bestTime = std::min(bestTime, elapsed.count());
+        }
+        return bestTime;
+    }
+
+    namespace detail
+    {
+        std::string GetTuningKey(const std::string& typeName, const emitters::TargetDevice& target, const std::string& shape)
+        {
+            auto device = target.deviceName == "host" ? emitters::GetTargetDevice("host") : target;
+            return typeName + ";" + device.triple + ";" + device.cpu + ";" + shape;
+        }
+    } // namespace detail
+} // namespace passes
+} // namespace ell
@@ -15,5 +15,9 @@
 void TestTransformations();
 
 void TestFuseLinearOperationsTransformation();
+void TestFuseElementwiseOperationsTransformation();
+void TestFoldConstantsTransformation();
 void TestSetConvolutionMethodTransformation();
+void TestAutotuneConvolutionMethodTransformation();
+void TestAutotuneMatrixMultiplyScheduleTransformation();
 void TestOptimizeReorderDataNodesTransformation();
@@ -489,4 +489,5 @@ void TestSetConvolutionMethodPass()
     TestSetConvolutionMethodPass(model::PreferredConvolutionMethod::simple, "SimpleConvolutionComputeNode<float>");
     TestSetConvolutionMethodPass(model::PreferredConvolutionMethod::winograd, "WinogradConvolutionComputeNode<float>");
     TestSetConvolutionMethodPass(model::PreferredConvolutionMethod::unrolled, "ReceptiveFieldMatrixNode<float>");
+    TestSetConvolutionMethodPass(model::PreferredConvolutionMethod::tiled, "TiledConvolutionNode<float>");
 }
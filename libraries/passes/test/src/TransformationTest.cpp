@@ -8,19 +8,31 @@
 
 #include "TransformationTest.h"
 
+#include <passes/include/FoldConstantsTransformation.h>
+#include <passes/include/FuseElementwiseOperationsTransformation.h>
 #include <passes/include/FuseLinearOperationsTransformation.h>
 #include <passes/include/OptimizeReorderDataNodesTransformation.h>
 #include <passes/include/SetConvolutionMethodTransformation.h>
+#include <passes/include/SetMatrixMultiplyScheduleTransformation.h>
+#include <passes/include/StandardTransformations.h>
+#include <passes/include/TuningDatabase.h>
 
+#include <model/include/IRMapCompiler.h>
 #include <model/include/InputNode.h>
 #include <model/include/TransformContext.h>
 #include <model/include/Transformation.h>
 
+#include <nodes/include/ActivationFunctions.h>
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/BroadcastFunctionNode.h>
 #include <nodes/include/ConstantNode.h>
 #include <nodes/include/ConvolutionalLayerNode.h>
+#include <nodes/include/FusedElementwiseNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
 #include <nodes/include/MatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReorderDataCodeNode.h>
+#include <nodes/include/SinkNode.h>
+#include <nodes/include/UnaryOperationNode.h>
 
 #include <predictors/neural/include/ConvolutionalLayer.h>
 
@@ -28,7 +40,9 @@
 
 #include <utilities/include/JsonArchiver.h>
 
+#include <cstdio>
 #include <iostream>
+#include <string>
 
 #define PRINT_MODELS 0
 
@@ -128,7 +142,11 @@ model::Map GenerateLinearOpsTestModel(const model::PortMemoryLayout& inputLayout
 void TestTransformations()
 {
     TestFuseLinearOperationsTransformation();
+    TestFuseElementwiseOperationsTransformation();
+    TestFoldConstantsTransformation();
     TestSetConvolutionMethodTransformation();
+    TestAutotuneConvolutionMethodTransformation();
+    TestAutotuneMatrixMultiplyScheduleTransformation();
     TestOptimizeReorderDataNodesTransformation();
 }
 
@@ -228,6 +246,130 @@ void TestFuseLinearOperationsTransformation()
     TestFuseLinearOperationsTransformation({ linear, bias, bias });
 }
 
+void TestFuseElementwiseOperationsTransformation()
+{
+    using ValueType = float;
+    const int numRows = 3;
+    const int numColumns = 4;
+    const int numChannels = 11; // not a multiple of the vector size, so the compiled loop has a leftover part
+    model::PortMemoryLayout layout(model::MemoryShape{ numRows, numColumns, numChannels });
+
+    // input -> linear -> ReLU -> sqrt
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(numRows * numColumns * numChannels);
+    std::vector<ValueType> scaleValues(numChannels);
+    std::vector<ValueType> biasValues(numChannels);
+    std::generate(scaleValues.begin(), scaleValues.end(), Increment<ValueType>(-2, 1));
+    std::generate(biasValues.begin(), biasValues.end(), Increment<ValueType>(1, 1));
+    auto scaleNode = model.AddNode<nodes::ConstantNode<ValueType>>(scaleValues, model::MemoryShape{ 1, 1, numChannels });
+    auto biasNode = model.AddNode<nodes::ConstantNode<ValueType>>(biasValues, model::MemoryShape{ 1, 1, numChannels });
+    auto linearNode = model.AddNode<nodes::BroadcastLinearFunctionNode<ValueType>>(inputNode->output, layout, scaleNode->output, biasNode->output, 2, layout);
+    auto reluNode = model.AddNode<nodes::BroadcastUnaryFunctionNode<ValueType, nodes::ReLUActivationFunction<ValueType>>>(linearNode->output, layout, layout);
+    auto sqrtNode = model.AddNode<nodes::UnaryOperationNode<ValueType>>(reluNode->output, nodes::UnaryOperationType::sqrt);
+    model::Map map(model, { { "input", inputNode } }, { { "output", sqrtNode->output } });
+
+    std::vector<ValueType> testInput(numRows * numColumns * numChannels);
+    std::generate(testInput.begin(), testInput.end(), Increment<ValueType>(-10, 0.5));
+    map.SetInputValue("input", testInput);
+    auto referenceOutput = map.ComputeOutput<ValueType>("output");
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    optimizerOptions["fuseElementwiseNodes"] = true;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    model::TransformContext context(&compiler);
+    FuseElementwiseOperationsTransformation fuseOps;
+    map.Transform(fuseOps, context);
+    map.Refine();
+    map.Prune();
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    // input, scale, bias, and the fused node
+    testing::ProcessTest("Testing FuseElementwiseOperationsTransformation node count", map.GetModel().Size() == 4 && HasNodeWithTypeName(map.GetModel(), nodes::FusedElementwiseNode<ValueType>::GetTypeName()));
+
+    map.SetInputValue("input", testInput);
+    auto fusedOutput = map.ComputeOutput<ValueType>("output");
+    testing::ProcessTest("Testing FuseElementwiseOperationsTransformation result", testing::IsEqual(referenceOutput, fusedOutput));
+
+    // Every stage has a vector form, so the compiled fused node should process the channels a vector at a time
+    for (bool vectorize : { true, false })
+    {
+        model::MapCompilerOptions compiledSettings;
+        compiledSettings.compilerSettings.vectorizeElementwiseOperations = vectorize;
+        model::IRMapCompiler fusedCompiler(compiledSettings, optimizerOptions);
+        auto compiledMap = fusedCompiler.Compile(map);
+        compiledMap.SetInputValue("input", testInput);
+        auto compiledOutput = compiledMap.ComputeOutput<ValueType>("output");
+        testing::ProcessTest(std::string("Testing compiled FusedElementwiseNode result, vectorize = ") + (vectorize ? "true" : "false"), testing::IsEqual(referenceOutput, compiledOutput));
+    }
+}
+
+void TestFoldConstantsTransformation()
+{
+    using ValueType = float;
+    const int size = 10;
+
+    // input + square(constant)
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(size);
+    std::vector<ValueType> constantValues(size);
+    std::generate(constantValues.begin(), constantValues.end(), Increment<ValueType>(-3, 0.5));
+    auto constantNode = model.AddNode<nodes::ConstantNode<ValueType>>(constantValues);
+    auto squareNode = model.AddNode<nodes::UnaryOperationNode<ValueType>>(constantNode->output, nodes::UnaryOperationType::square);
+    auto addNode = model.AddNode<nodes::BinaryOperationNode<ValueType>>(inputNode->output, squareNode->output, nodes::BinaryOperationType::add);
+    model::Map map(model, { { "input", inputNode } }, { { "output", addNode->output } });
+
+    std::vector<ValueType> testInput(size);
+    std::generate(testInput.begin(), testInput.end(), Increment<ValueType>(0));
+    map.SetInputValue("input", testInput);
+    auto referenceOutput = map.ComputeOutput<ValueType>("output");
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    optimizerOptions["foldConstants"] = true;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    model::TransformContext context(&compiler);
+    FoldConstantsTransformation foldConstants;
+    map.Transform(foldConstants, context);
+    map.Prune();
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    // input, the folded constant, and the add
+    testing::ProcessTest("Testing FoldConstantsTransformation node count", map.GetModel().Size() == 3 && !HasNodeWithTypeName(map.GetModel(), nodes::UnaryOperationNode<ValueType>::GetTypeName()));
+
+    map.SetInputValue("input", testInput);
+    auto foldedOutput = map.ComputeOutput<ValueType>("output");
+    testing::ProcessTest("Testing FoldConstantsTransformation result", testing::IsEqual(referenceOutput, foldedOutput));
+
+    // A sink fed by constants still has to call back into user code each time the map is computed
+    {
+        model::Model sinkModel;
+        auto sinkInputNode = sinkModel.AddNode<model::InputNode<ValueType>>(size);
+        auto sinkConstantNode = sinkModel.AddNode<nodes::ConstantNode<ValueType>>(constantValues);
+        auto triggerNode = sinkModel.AddNode<nodes::ConstantNode<bool>>(true);
+        int numSinkCalls = 0;
+        auto sinkNode = sinkModel.AddNode<nodes::SinkNode<ValueType>>(sinkConstantNode->output, triggerNode->output, "FoldConstantsTestSink", [&numSinkCalls](const std::vector<ValueType>&) { ++numSinkCalls; });
+        auto sinkAddNode = sinkModel.AddNode<nodes::BinaryOperationNode<ValueType>>(sinkInputNode->output, sinkNode->output, nodes::BinaryOperationType::add);
+        model::Map sinkMap(sinkModel, { { "input", sinkInputNode } }, { { "output", sinkAddNode->output } });
+
+        sinkMap.Transform(foldConstants, context);
+        sinkMap.Prune();
+        testing::ProcessTest("Testing FoldConstantsTransformation keeps constant-fed sink", HasNodeWithTypeName(sinkMap.GetModel(), nodes::SinkNode<ValueType>::GetTypeName()));
+
+        numSinkCalls = 0;
+        sinkMap.SetInputValue("input", testInput);
+        sinkMap.ComputeOutput<ValueType>("output");
+        sinkMap.ComputeOutput<ValueType>("output");
+        testing::ProcessTest("Testing FoldConstantsTransformation constant-fed sink callback", numSinkCalls == 2);
+    }
+}
+
 void TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod convolutionMethod, std::string expectedNodeTypeName)
 {
     using namespace predictors::neural;
@@ -289,6 +431,188 @@ void TestSetConvolutionMethodTransformation()
     TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod::simple, "SimpleConvolutionNode<float>");
     TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod::winograd, "WinogradConvolutionNode<float>");
     TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod::unrolled, "UnrolledConvolutionNode<float>");
+    TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod::tiled, "TiledConvolutionNode<float>");
+}
+
+void TestAutotuneConvolutionMethodTransformation()
+{
+    using namespace predictors::neural;
+
+    using ElementType = float;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    const size_t inputPaddingSize = 1;
+    const size_t numRows = 6;
+    const size_t numColumns = 6;
+    const size_t numChannels = 4;
+    const size_t numFilters = 8;
+    TensorType inputWithPadding(numRows + 2 * inputPaddingSize, numColumns + 2 * inputPaddingSize, numChannels);
+    inputWithPadding.Fill(0);
+
+    Shape outputShape = { numRows, numColumns, numFilters };
+    LayerParameters parameters{ inputWithPadding, ZeroPadding(inputPaddingSize), outputShape, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ 3, 1, ConvolutionMethod::automatic, 2 };
+    TensorType weights(convolutionalParams.receptiveField * numFilters, convolutionalParams.receptiveField, numChannels);
+    weights.Fill(1);
+    ConvolutionalLayer<ElementType> layer(parameters, convolutionalParams, weights);
+
+    const std::string databaseFilename = "autotune_convolution_test.json";
+    std::remove(databaseFilename.c_str());
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    optimizerOptions["preferredConvolutionMethod"] = model::PreferredConvolutionMethod::autotune;
+    optimizerOptions["convolutionTuningDatabase"] = databaseFilename;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    model::TransformContext context(&compiler);
+    passes::SetConvolutionMethodTransformation setConvMethod;
+
+    // Returns the type of the convolution node the transformation picked
+    auto getTunedNodeTypeName = [&]() {
+        model::Model model;
+        auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputWithPadding.Size());
+        auto computeNode = model.AddNode<nodes::ConvolutionalLayerNode<ElementType>>(inputNode->output, layer);
+        auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+        map.Transform(setConvMethod, context);
+        map.Prune();
+
+#if PRINT_MODELS
+        PrintModel(map.GetModel());
+#endif
+
+        for (std::string typeName : { "DiagonalConvolutionNode<float>", "SimpleConvolutionNode<float>", "WinogradConvolutionNode<float>", "UnrolledConvolutionNode<float>" })
+        {
+            if (HasNodeWithTypeName(map.GetModel(), typeName))
+            {
+                return typeName;
+            }
+        }
+        return std::string{};
+    };
+
+    auto tunedNodeTypeName = getTunedNodeTypeName();
+    auto database = passes::TuningDatabase::Load(databaseFilename);
+    testing::ProcessTest("Testing autotuned convolution method", !tunedNodeTypeName.empty() && database.Size() == 1);
+
+    // The second time, the method comes from the database
+    auto cachedNodeTypeName = getTunedNodeTypeName();
+    testing::ProcessTest("Testing cached autotuned convolution method", cachedNodeTypeName == tunedNodeTypeName);
+
+    // Autotuning from inside IRMapCompiler::Compile, which compiles and times maps while it refines the outer one
+    std::remove(databaseFilename.c_str());
+    passes::AddStandardTransformationsToRegistry();
+    {
+        model::Model model;
+        auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputWithPadding.Size());
+        auto computeNode = model.AddNode<nodes::ConvolutionalLayerNode<ElementType>>(inputNode->output, layer);
+        auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+        TensorType testInputTensor(numRows + 2 * inputPaddingSize, numColumns + 2 * inputPaddingSize, numChannels);
+        testInputTensor.Fill(0);
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            for (size_t column = 0; column < numColumns; ++column)
+            {
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    testInputTensor(row + inputPaddingSize, column + inputPaddingSize, channel) = static_cast<ElementType>((row + column + channel) % 7);
+                }
+            }
+        }
+        auto testInput = testInputTensor.ToArray();
+        map.SetInputValue("input", testInput);
+        auto referenceOutput = map.ComputeOutput<ElementType>("output");
+
+        model::IRMapCompiler autotuneCompiler(settings, optimizerOptions);
+        auto compiledMap = autotuneCompiler.Compile(map);
+        compiledMap.SetInputValue("input", testInput);
+        auto compiledOutput = compiledMap.ComputeOutput<ElementType>("output");
+        testing::ProcessTest("Testing compiled autotuned convolution result", testing::IsEqual(referenceOutput, compiledOutput) && passes::TuningDatabase::Load(databaseFilename).Size() == 1);
+    }
+
+    std::remove(databaseFilename.c_str());
+}
+
+void TestAutotuneMatrixMultiplyScheduleTransformation()
+{
+    using ValueType = float;
+    const int m = 8;
+    const int n = 16;
+    const int k = 32;
+
+    // Small integer values, so the result is exact whatever the summation order
+    std::vector<ValueType> matrixA(m * k);
+    for (size_t index = 0; index < matrixA.size(); ++index)
+    {
+        matrixA[index] = static_cast<ValueType>(index % 5);
+    }
+    std::vector<ValueType> matrixB(k * n);
+    for (size_t index = 0; index < matrixB.size(); ++index)
+    {
+        matrixB[index] = static_cast<ValueType>(index % 3);
+    }
+    std::vector<ValueType> expectedOutput(m * n);
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            for (int kIndex = 0; kIndex < k; ++kIndex)
+            {
+                expectedOutput[i * n + j] += matrixA[i * k + kIndex] * matrixB[kIndex * n + j];
+            }
+        }
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(m * k);
+    auto matrixBNode = model.AddNode<nodes::ConstantNode<ValueType>>(matrixB);
+    auto multiplyNode = model.AddNode<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>(inputNode->output, m, n, k, k, matrixBNode->output, n, n);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", multiplyNode->output } });
+
+    const std::string databaseFilename = "autotune_matrix_multiply_test.json";
+    std::remove(databaseFilename.c_str());
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    optimizerOptions["autotuneMatrixMultiply"] = true;
+    optimizerOptions["matrixMultiplyTuningDatabase"] = databaseFilename;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    model::TransformContext context(&compiler);
+    passes::SetMatrixMultiplyScheduleTransformation setSchedule;
+    map.Transform(setSchedule, context);
+
+    auto database = passes::TuningDatabase::Load(databaseFilename);
+    testing::ProcessTest("Testing autotuned matrix multiply schedule", database.Size() == 1);
+
+    // Compiling with the database alone picks up the tuned schedule
+    model::ModelOptimizerOptions databaseOptions;
+    databaseOptions["matrixMultiplyTuningDatabase"] = databaseFilename;
+    model::IRMapCompiler databaseCompiler(settings, databaseOptions);
+    auto compiledMap = databaseCompiler.Compile(map);
+    compiledMap.SetInputValue(0, matrixA);
+    auto compiledOutput = compiledMap.ComputeOutput<ValueType>(0);
+    testing::ProcessTest("Testing autotuned matrix multiply result", testing::IsEqual(compiledOutput, expectedOutput));
+
+    // Autotuning from inside IRMapCompiler::Compile, which compiles and times maps while it refines the outer one
+    std::remove(databaseFilename.c_str());
+    passes::AddStandardTransformationsToRegistry();
+    {
+        model::Model autotuneModel;
+        auto autotuneInputNode = autotuneModel.AddNode<model::InputNode<ValueType>>(m * k);
+        auto autotuneMatrixBNode = autotuneModel.AddNode<nodes::ConstantNode<ValueType>>(matrixB);
+        auto autotuneMultiplyNode = autotuneModel.AddNode<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>(autotuneInputNode->output, m, n, k, k, autotuneMatrixBNode->output, n, n);
+        auto autotuneMap = model::Map(autotuneModel, { { "input", autotuneInputNode } }, { { "output", autotuneMultiplyNode->output } });
+
+        model::IRMapCompiler autotuneCompiler(settings, optimizerOptions);
+        auto autotunedMap = autotuneCompiler.Compile(autotuneMap);
+        autotunedMap.SetInputValue(0, matrixA);
+        auto autotunedOutput = autotunedMap.ComputeOutput<ValueType>(0);
+        testing::ProcessTest("Testing compiled autotuned matrix multiply result", testing::IsEqual(autotunedOutput, expectedOutput) && passes::TuningDatabase::Load(databaseFilename).Size() == 1);
+    }
+
+    std::remove(databaseFilename.c_str());
 }
 
 void TestOptimizeReorderDataNodesTransformation1()
@@ -31,7 +31,9 @@ namespace predictors
             /// <summary> An implementation that performs convolution with fewer arithmetic operations. </summary>
             winograd,
             /// <summary> Normal method of doing convolution via reshaping input into columns and performing a gemm operation. </summary>
-            unrolled
+            unrolled,
+            /// <summary> A direct convolution, blocked over rows, columns and channels so the input a tile needs stays in cache. </summary>
+            tiled
         };
 
         /// <summary> Specifies the hyper parameters of the convolutional layer. </summary>
@@ -110,6 +112,12 @@ namespace predictors
             /// <returns> `true` if this layer represents a depthwise-separable convolution. </returns>
             bool IsDepthwiseSeparable() const;
 
+            /// <summary> Gets the number of groups the input channels and filters are divided into. Each group of filters
+            /// reads only its own group of input channels. </summary>
+            ///
+            /// <returns> The number of groups: 1 for an ordinary convolution, and the number of input channels for a depthwise-separable one. </returns>
+            size_t NumGroups() const;
+
         protected:
             void WriteToArchive(utilities::Archiver& archiver) const override;
             void ReadFromArchive(utilities::Unarchiver& archiver) override;
@@ -127,6 +135,7 @@ namespace predictors
             void ComputeWinogradMethod();
             void ComputeDiagonalMethod();
             void ComputeDepthwiseSeparable();
+            void ComputeGroupedMethod();
 
             using Layer<ElementType>::_layerParameters;
             using Layer<ElementType>::_output;
@@ -170,11 +179,20 @@ namespace predictors
         template <typename ElementType>
         void ConvolutionalLayer<ElementType>::Compute()
         {
-            if (!IsDepthwiseSeparable())
+            if (IsDepthwiseSeparable())
+            {
+                ComputeDepthwiseSeparable();
+            }
+            else if (NumGroups() > 1)
+            {
+                ComputeGroupedMethod();
+            }
+            else
             {
                 switch (_convolutionalParameters.method)
                 {
                 case ConvolutionMethod::simple:
+                case ConvolutionMethod::tiled: // fallthrough
                     ComputeSimpleMethod();
                     break;
 
@@ -194,10 +212,6 @@ namespace predictors
                     throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "Convolution method not supported");
                 }
             }
-            else
-            {
-                ComputeDepthwiseSeparable();
-            }
         }
 
         template <typename ElementType>
@@ -327,6 +341,26 @@ namespace predictors
             }
         }
 
+        template <typename ElementType>
+        void ConvolutionalLayer<ElementType>::ComputeGroupedMethod()
+        {
+            auto output = GetOutputMinusPadding();
+            auto& input = _layerParameters.input;
+            auto stride = static_cast<int>(_convolutionalParameters.stride);
+            const size_t numGroups = NumGroups();
+            const size_t groupChannels = _weights.NumChannels();
+            const size_t groupFilters = output.NumChannels() / numGroups;
+            const size_t filterRows = _convolutionalParameters.receptiveField;
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                auto inputGroupTensor = input.GetSubTensor(0, 0, group * groupChannels, input.NumRows(), input.NumColumns(), groupChannels);
+                auto weights = _weights.GetSubTensor(group * groupFilters * filterRows, 0, 0, groupFilters * filterRows, filterRows, groupChannels);
+                auto outputGroupTensor = output.GetSubTensor(0, 0, group * groupFilters, output.NumRows(), output.NumColumns(), groupFilters);
+                dsp::Convolve2DSimple(inputGroupTensor, weights, static_cast<int>(groupFilters), stride, outputGroupTensor);
+            }
+        }
+
         template <typename ElementType>
         void ConvolutionalLayer<ElementType>::WriteToArchive(utilities::Archiver& archiver) const
         {
@@ -378,10 +412,15 @@ namespace predictors
                 throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Input and output channel sizes must match for a depthwise-separable convolutional layer");
             }
 
-            if ((_weights.NumRows() != _output.NumChannels() * _convolutionalParameters.receptiveField) || (_weights.NumColumns() != _convolutionalParameters.receptiveField) || (!IsDepthwiseSeparable() && (_weights.NumChannels() != _layerParameters.input.NumChannels())))
+            if ((_weights.NumRows() != _output.NumChannels() * _convolutionalParameters.receptiveField) || (_weights.NumColumns() != _convolutionalParameters.receptiveField) || (_weights.NumChannels() == 0) || (_layerParameters.input.NumChannels() % _weights.NumChannels() != 0))
             {
                 throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Weights tensor size mismatch");
             }
+
+            if (_output.NumChannels() % NumGroups() != 0)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Output channel size must be a multiple of the number of groups for a grouped convolutional layer");
+            }
         }
 
         template <typename ElementType>
@@ -394,7 +433,8 @@ namespace predictors
                 _convolutionalParameters.method = IsDepthwiseSeparable() ? ConvolutionMethod::simple : ConvolutionMethod::unrolled;
                 break;
             case ConvolutionMethod::simple:
-            case ConvolutionMethod::unrolled: // fallthrough
+            case ConvolutionMethod::unrolled:
+            case ConvolutionMethod::tiled: // fallthrough
                 // do nothing
                 break;
             case ConvolutionMethod::diagonal:
@@ -422,6 +462,11 @@ namespace predictors
                     _convolutionalParameters.method = ConvolutionMethod::simple;
                 }
             }
+            else if (NumGroups() > 1)
+            {
+                // Grouped convolutions are only implemented by the tiled method
+                _convolutionalParameters.method = ConvolutionMethod::tiled;
+            }
         }
 
         template <typename ElementType>
@@ -429,6 +474,12 @@ namespace predictors
         {
             return (_weights.NumChannels() == 1) && (_layerParameters.input.NumChannels() > 1);
         }
+
+        template <typename ElementType>
+        size_t ConvolutionalLayer<ElementType>::NumGroups() const
+        {
+            return _layerParameters.input.NumChannels() / _weights.NumChannels();
+        }
     } // namespace neural
 } // namespace predictors
 } // namespace ell
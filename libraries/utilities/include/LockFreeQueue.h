@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LockFreeQueue.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A fixed-capacity FIFO queue shared by exactly one producer thread and one consumer thread, without locks.
+    /// The slots are allocated once, at construction, and are written and read in place, so the element type can own
+    /// a buffer that is reused from one item to the next. </summary>
+    template <typename T>
+    class LockFreeQueue
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="capacity"> The maximum number of items the queue can hold. Must be greater than zero. </param>
+        /// <param name="initialValue"> The value each slot is initialized with. </param>
+        LockFreeQueue(size_t capacity, const T& initialValue = T{});
+
+        LockFreeQueue(const LockFreeQueue&) = delete;
+        LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+        /// <summary> Gets the maximum number of items the queue can hold. </summary>
+        ///
+        /// <returns> The capacity of the queue. </returns>
+        size_t Capacity() const { return _slots.size(); }
+
+        /// <summary> Producer only: gets the next free slot to write into, if there is one. The item is not visible to the
+        /// consumer until `EndWrite` is called. </summary>
+        ///
+        /// <returns> A pointer to the slot, or `nullptr` if the queue is full. </returns>
+        T* TryBeginWrite();
+
+        /// <summary> Producer only: publishes the slot returned by the last successful call to `TryBeginWrite`. </summary>
+        void EndWrite();
+
+        /// <summary> Consumer only: gets the oldest item in the queue, if there is one. The slot stays owned by the
+        /// consumer until `EndRead` is called. </summary>
+        ///
+        /// <returns> A pointer to the item, or `nullptr` if the queue is empty. </returns>
+        T* TryBeginRead();
+
+        /// <summary> Consumer only: releases the slot returned by the last successful call to `TryBeginRead`. </summary>
+        void EndRead();
+
+        /// <summary> Indicates if the queue is empty. Only exact when called from the producer or consumer thread while the other is idle. </summary>
+        ///
+        /// <returns> `true` if the queue holds no items. </returns>
+        bool IsEmpty() const;
+
+    private:
+        std::vector<T> _slots;
+
+        // Both counters only ever increase; the slot index is the counter modulo the capacity. They are kept on
+        // separate cache lines so the producer and consumer don't contend for the same line.
+        alignas(64) std::atomic<size_t> _readCount{ 0 };
+        alignas(64) std::atomic<size_t> _writeCount{ 0 };
+    };
+} // namespace utilities
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace utilities
+{
+    template <typename T>
+    LockFreeQueue<T>::LockFreeQueue(size_t capacity, const T& initialValue) :
+        _slots(capacity, initialValue)
+    {
+    }
+
+    template <typename T>
+    T* LockFreeQueue<T>::TryBeginWrite()
+    {
+        auto writeCount = _writeCount.load(std::memory_order_relaxed);
+        if (writeCount - _readCount.load(std::memory_order_acquire) == _slots.size())
+        {
+            return nullptr;
+        }
+        return &_slots[writeCount % _slots.size()];
+    }
+
+    template <typename T>
+    void LockFreeQueue<T>::EndWrite()
+    {
+        _writeCount.store(_writeCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template <typename T>
+    T* LockFreeQueue<T>::TryBeginRead()
+    {
+        auto readCount = _readCount.load(std::memory_order_relaxed);
+        if (readCount == _writeCount.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &_slots[readCount % _slots.size()];
+    }
+
+    template <typename T>
+    void LockFreeQueue<T>::EndRead()
+    {
+        _readCount.store(_readCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template <typename T>
+    bool LockFreeQueue<T>::IsEmpty() const
+    {
+        return _readCount.load(std::memory_order_acquire) == _writeCount.load(std::memory_order_acquire);
+    }
+} // namespace utilities
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A fixed-size pool of worker threads with per-thread work-stealing task queues.
+    /// Tasks submitted from a worker thread go onto that worker's own queue, which it services in LIFO order;
+    /// idle workers steal the oldest tasks from other workers' queues. Tasks must not throw. </summary>
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads. If zero, the number of hardware threads is used. </param>
+        ThreadPool(size_t numThreads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// <summary> Destructor. Finishes all queued tasks and then joins the worker threads. </summary>
+        ~ThreadPool();
+
+        /// <summary> Gets the number of worker threads in the pool. </summary>
+        ///
+        /// <returns> The number of worker threads. </returns>
+        size_t NumThreads() const { return _workers.size(); }
+
+        /// <summary> Adds a task to the pool. </summary>
+        ///
+        /// <param name="task"> The task to run. </param>
+        void Submit(Task task);
+
+        /// <summary> Blocks until the given condition is true. While waiting, the calling thread helps run queued tasks,
+        /// so it is safe to wait from inside a task running on this pool. The condition is re-evaluated each time a task completes. </summary>
+        ///
+        /// <param name="isDone"> A function that returns `true` when the wait should end. </param>
+        void WaitUntil(const std::function<bool()>& isDone);
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void WorkerThread(size_t index);
+        bool TryPopTask(size_t queueIndex, Task& task);
+        bool TryStealTask(size_t thiefIndex, Task& task);
+        bool TryGetTask(size_t queueIndex, Task& task);
+        void RunTask(Task& task);
+        size_t GetCurrentQueueIndex() const;
+
+        std::vector<std::unique_ptr<WorkQueue>> _queues;
+        std::vector<std::thread> _workers;
+        std::atomic<size_t> _numQueuedTasks{ 0 };
+        std::atomic<size_t> _nextQueue{ 0 };
+
+        std::mutex _wakeMutex;
+        std::condition_variable _workAvailable;
+        std::condition_variable _taskCompleted;
+        bool _stopping = false;
+    };
+} // namespace utilities
+} // namespace ell
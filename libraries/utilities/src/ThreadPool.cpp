@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace ell
+{
+namespace utilities
+{
+    namespace
+    {
+        // The pool (if any) that owns the current thread, and the index of its queue
+        thread_local const ThreadPool* currentPool = nullptr;
+        thread_local size_t currentQueueIndex = 0;
+    } // namespace
+
+    ThreadPool::ThreadPool(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (size_t index = 0; index < numThreads; ++index)
+        {
+            _queues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        _workers.reserve(numThreads);
+        for (size_t index = 0; index < numThreads; ++index)
+        {
+            _workers.emplace_back([this, index]() { WorkerThread(index); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _stopping = true;
+        }
+        _workAvailable.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::Submit(Task task)
+    {
+        auto queueIndex = GetCurrentQueueIndex();
+        if (queueIndex >= _queues.size())
+        {
+            queueIndex = _nextQueue++ % _queues.size();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_queues[queueIndex]->mutex);
+            _queues[queueIndex]->tasks.push_back(std::move(task));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            ++_numQueuedTasks;
+        }
+        _workAvailable.notify_one();
+
+        // Threads blocked in `WaitUntil` may be the only ones free to run this task
+        _taskCompleted.notify_all();
+    }
+
+    void ThreadPool::WaitUntil(const std::function<bool()>& isDone)
+    {
+        const auto queueIndex = GetCurrentQueueIndex();
+        while (!isDone())
+        {
+            Task task;
+            if (TryGetTask(queueIndex, task))
+            {
+                RunTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _taskCompleted.wait(lock, [this, &isDone]() { return _numQueuedTasks > 0 || isDone(); });
+        }
+    }
+
+    void ThreadPool::WorkerThread(size_t index)
+    {
+        currentPool = this;
+        currentQueueIndex = index;
+
+        while (true)
+        {
+            Task task;
+            if (TryGetTask(index, task))
+            {
+                RunTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _workAvailable.wait(lock, [this]() { return _stopping || _numQueuedTasks > 0; });
+            if (_stopping && _numQueuedTasks == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::TryPopTask(size_t queueIndex, Task& task)
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        --_numQueuedTasks;
+        return true;
+    }
+
+    bool ThreadPool::TryStealTask(size_t thiefIndex, Task& task)
+    {
+        const auto numQueues = _queues.size();
+        for (size_t offset = 1; offset <= numQueues; ++offset)
+        {
+            const auto victimIndex = (thiefIndex + offset) % numQueues;
+            if (victimIndex == thiefIndex)
+            {
+                continue;
+            }
+
+            auto& queue = *_queues[victimIndex];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --_numQueuedTasks;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::TryGetTask(size_t queueIndex, Task& task)
+    {
+        if (queueIndex < _queues.size() && TryPopTask(queueIndex, task))
+        {
+            return true;
+        }
+        return TryStealTask(queueIndex, task);
+    }
+
+    void ThreadPool::RunTask(Task& task)
+    {
+        task();
+        task = nullptr;
+
+        {
+            // Taking the lock orders this notification after any waiter's check of its condition
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+        }
+        _taskCompleted.notify_all();
+    }
+
+    size_t ThreadPool::GetCurrentQueueIndex() const
+    {
+        // Threads that don't belong to this pool don't have a queue of their own
+        return currentPool == this ? currentQueueIndex : _queues.size();
+    }
+} // namespace utilities
+} // namespace ell
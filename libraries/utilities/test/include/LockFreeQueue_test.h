@@ -0,0 +1,15 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LockFreeQueue_test.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace ell
+{
+void TestLockFreeQueue();
+void TestLockFreeQueueConcurrent();
+} // namespace ell
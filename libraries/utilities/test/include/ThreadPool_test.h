@@ -0,0 +1,15 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace ell
+{
+void TestThreadPool();
+void TestThreadPoolNestedWait();
+} // namespace ell
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LockFreeQueue_test.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LockFreeQueue_test.h"
+
+#include <utilities/include/LockFreeQueue.h>
+
+#include <testing/include/testing.h>
+
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+using namespace utilities;
+
+void TestLockFreeQueue()
+{
+    LockFreeQueue<int> queue(2);
+    bool ok = queue.IsEmpty() && queue.TryBeginRead() == nullptr;
+
+    *queue.TryBeginWrite() = 1;
+    queue.EndWrite();
+    *queue.TryBeginWrite() = 2;
+    queue.EndWrite();
+    ok = ok && queue.TryBeginWrite() == nullptr; // full
+
+    ok = ok && *queue.TryBeginRead() == 1;
+    queue.EndRead();
+    *queue.TryBeginWrite() = 3; // wraps around
+    queue.EndWrite();
+    ok = ok && *queue.TryBeginRead() == 2;
+    queue.EndRead();
+    ok = ok && *queue.TryBeginRead() == 3;
+    queue.EndRead();
+    ok = ok && queue.IsEmpty();
+
+    testing::ProcessTest("TestLockFreeQueue", ok);
+}
+
+void TestLockFreeQueueConcurrent()
+{
+    const int numItems = 100000;
+    LockFreeQueue<std::vector<int>> queue(4, std::vector<int>(2));
+
+    std::thread producer([&queue]() {
+        for (int index = 0; index < numItems; ++index)
+        {
+            std::vector<int>* slot;
+            while ((slot = queue.TryBeginWrite()) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+            (*slot)[0] = index;
+            (*slot)[1] = 2 * index;
+            queue.EndWrite();
+        }
+    });
+
+    bool ok = true;
+    for (int index = 0; index < numItems; ++index)
+    {
+        std::vector<int>* slot;
+        while ((slot = queue.TryBeginRead()) == nullptr)
+        {
+            std::this_thread::yield();
+        }
+        ok = ok && (*slot)[0] == index && (*slot)[1] == 2 * index;
+        queue.EndRead();
+    }
+    producer.join();
+
+    testing::ProcessTest("TestLockFreeQueueConcurrent", ok && queue.IsEmpty());
+}
+} // namespace ell
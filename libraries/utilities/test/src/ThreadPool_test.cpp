@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool_test.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <testing/include/testing.h>
+
+#include <atomic>
+#include <vector>
+
+namespace ell
+{
+using namespace utilities;
+
+void TestThreadPool()
+{
+    ThreadPool pool(4);
+    const int numTasks = 1000;
+    std::vector<int> results(numTasks, 0);
+    std::atomic<int> numFinished{ 0 };
+    for (int index = 0; index < numTasks; ++index)
+    {
+        pool.Submit([&results, &numFinished, index]() {
+            results[index] = index * index;
+            ++numFinished;
+        });
+    }
+    pool.WaitUntil([&numFinished]() { return numFinished == numTasks; });
+
+    bool ok = pool.NumThreads() == 4;
+    for (int index = 0; index < numTasks; ++index)
+    {
+        ok = ok && results[index] == index * index;
+    }
+    testing::ProcessTest("TestThreadPool", ok);
+}
+
+void TestThreadPoolNestedWait()
+{
+    // Every worker blocks waiting on tasks it spawns, which only works if waiting threads help run queued tasks
+    ThreadPool pool(2);
+    const int numOuterTasks = 8;
+    const int numInnerTasks = 16;
+    std::atomic<int> numInnerFinished{ 0 };
+    std::atomic<int> numOuterFinished{ 0 };
+    for (int outer = 0; outer < numOuterTasks; ++outer)
+    {
+        pool.Submit([&]() {
+            std::atomic<int> numFinished{ 0 };
+            for (int inner = 0; inner < numInnerTasks; ++inner)
+            {
+                pool.Submit([&]() {
+                    ++numInnerFinished;
+                    ++numFinished;
+                });
+            }
+            pool.WaitUntil([&]() { return numFinished == numInnerTasks; });
+            ++numOuterFinished;
+        });
+    }
+    pool.WaitUntil([&]() { return numOuterFinished == numOuterTasks; });
+
+    testing::ProcessTest("TestThreadPoolNestedWait", numInnerFinished == numOuterTasks * numInnerTasks);
+}
+} // namespace ell
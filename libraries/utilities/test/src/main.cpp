@@ -12,10 +12,12 @@
 #include "FunctionUtils_test.h"
 #include "Hash_test.h"
 #include "Iterator_test.h"
+#include "LockFreeQueue_test.h"
 #include "MemoryLayout_test.h"
 #include "ObjectArchive_test.h"
 #include "PropertyBag_test.h"
 #include "RingBuffer_test.h"
+#include "ThreadPool_test.h"
 #include "TunableParameters_test.h"
 #include "TypeFactory_test.h"
 #include "TypeName_test.h"
@@ -46,6 +48,14 @@ int main(int argc, char* argv[])
 
         TestRingBuffer();
 
+        // ThreadPool tests
+        TestThreadPool();
+        TestThreadPoolNestedWait();
+
+        // LockFreeQueue tests
+        TestLockFreeQueue();
+        TestLockFreeQueueConcurrent();
+
         // Format tests
         TestMatchFormat();
 
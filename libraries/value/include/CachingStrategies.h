@@ -10,6 +10,8 @@
 
 #include "CachingProvider.h"
 
+#include <vector>
+
 namespace ell
 {
 namespace value
@@ -46,6 +48,28 @@ namespace value
         Value _rawCache;
     };
 
+    /// <summary> Caches a matrix in the same layout as `BLASTCopy`, but reads the cache blocks from data packed ahead of time by
+    /// `PackForBLASTCopy` instead of copying them at runtime. Only applicable when the matrix being cached is constant. The extra
+    /// parameters are a tuple of the stripe size, the index to set up the stripe view at, and the packed data. </summary>
+    class PrepackedBLASTCopy : public CachingProvider
+    {
+    public:
+        void HandleCachingImpl(LoopNest&) override;
+    };
+
+    /// <summary> Lays out a constant row-major matrix as the sequence of cache blocks `BLASTCopy` would copy it into,
+    /// in block row-major order, for use with `PrepackedBLASTCopy`. </summary>
+    ///
+    /// <param name="matrix"> The matrix values, in row-major order. </param>
+    /// <param name="rows"> The number of rows in the matrix. </param>
+    /// <param name="columns"> The number of columns in the matrix. </param>
+    /// <param name="cacheShape"> The shape of a cache block. </param>
+    /// <param name="stripeSize"> The number of columns in a cache stripe. Must divide the number of cache block columns. </param>
+    ///
+    /// <returns> The packed values, with every cache block taking up the same amount of space. </returns>
+    template <typename T>
+    std::vector<T> PackForBLASTCopy(const std::vector<T>& matrix, int rows, int columns, const utilities::MemoryShape& cacheShape, int stripeSize);
+
     class GeneralCachingStrategy : public CachingProvider
     {
     public:
@@ -58,6 +82,7 @@ namespace value
     using ZeroInputCopyOutMatrixCache = CachingStrategyType<ZeroInputReduceOutput>;
 
     using BLASTCopyCache = CachingStrategyType<BLASTCopy>;
+    using PrepackedBLASTCopyCache = CachingStrategyType<PrepackedBLASTCopy>;
 
 } // namespace value
 } // namespace ell
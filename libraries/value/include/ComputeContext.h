@@ -13,6 +13,7 @@
 #include "Scalar.h"
 
 #include <atomic>
+#include <cstddef>
 #include <forward_list>
 #include <map>
 #include <optional>
@@ -35,6 +36,16 @@ namespace value
 
         const ConstantData& GetConstantData(Value value) const;
 
+        /// <summary> Sets the number of threads in the pool that runs the tasks of parallelized loops. The pool is shared
+        /// by all compute contexts and is created on first use. Calls to `Parallelize` that are already running keep
+        /// the pool they started with. </summary>
+        /// <param name="numThreads"> The number of threads. If zero, the number of hardware threads is used. </param>
+        static void SetNumParallelThreads(size_t numThreads);
+
+        /// <summary> Gets the number of threads in the pool that runs the tasks of parallelized loops. </summary>
+        /// <returns> The number of threads. </returns>
+        static size_t GetNumParallelThreads();
+
     private:
         Value AllocateImpl(ValueType type, MemoryLayout layout, size_t alignment, AllocateFlags flags) override;
 
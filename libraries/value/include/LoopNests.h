@@ -77,6 +77,24 @@ namespace value
         /// <returns> The index which represents the outer loop, now unrolled </returns>
         Index Unroll(Index index, int factor);
 
+        /// <summary> Vectorizes the loop represented by the index. The loop body is emitted for `width` consecutive values of the
+        /// index at a time, so the resulting loads, stores and arithmetic can be combined into vector instructions, followed by
+        /// the values that don't fill a vector. Works best on the innermost loop, over an index that addresses contiguous memory </summary>
+        /// <param name="index"> Represents the loop to vectorize </param>
+        /// <param name="width"> The number of values of the index to compute together. Ideally, the number of elements in a vector register </param>
+        void Vectorize(Index index, int width);
+
+        /// <summary> Prefetches the data of a view that the loop represented by the index will access `distance` iterations
+        /// from now. At the start of each iteration of the loop, before any of the loops inside it, the cache line holding the
+        /// view's element at the current position, advanced by `distance` steps of the loop, is prefetched. Positions past the
+        /// end of the view are skipped. Must be called after the loop order is set </summary>
+        /// <param name="view"> The view to prefetch from </param>
+        /// <param name="viewIndices"> The logical index addressing each dimension of the view, for instance `{ i, k }` for `A(i, k)` </param>
+        /// <param name="index"> Represents the loop to prefetch for. It must step through a dimension in `viewIndices` </param>
+        /// <param name="distance"> The number of iterations of the loop to prefetch ahead </param>
+        /// <param name="locality"> How long the prefetched data is expected to stay useful </param>
+        void Prefetch(ViewAdapter view, std::vector<Index> viewIndices, Index index, int distance, PrefetchLocality locality = PrefetchLocality::Extreme);
+
         void Cache(std::unique_ptr<CachingProvider> provider);
 
         template <typename CachingStrategyType>
@@ -21,6 +21,7 @@
 
 #include <ostream>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace ell
@@ -203,6 +204,10 @@ namespace value
             void Unroll(Index index);
             [[maybe_unused]] SplitIndex Unroll(Index index, int factor);
 
+            /// <summary> Emits the loop represented by the index so that `width` consecutive iterations are adjacent and can
+            /// be combined into vector instructions, followed by the iterations that don't fill a vector </summary>
+            void Vectorize(Index index, int width);
+
             [[maybe_unused]] SplitIndex Split(Index index, int size);
 
             void SetLoopOrder(const std::vector<Index>& order);
@@ -228,6 +233,11 @@ namespace value
 
             bool IsUnrolled(const Index& index) const;
 
+            bool IsVectorized(const Index& index) const;
+
+            /// <summary> Gets the number of iterations of a loop to emit together, or 1 if the loop isn't vectorized </summary>
+            int GetVectorizationWidth(const Index& index) const;
+
             /// <summary> See if an Index is used as a parameter to a kernel </summary>
             bool IsUsed(const Index& index, const std::vector<ScheduledKernel>& activeKernels) const;
 
@@ -261,6 +271,7 @@ namespace value
             std::vector<RenameAction> _renameActions;
             std::vector<Index> _parallelizedIndices;
             std::vector<Index> _unrolledIndices;
+            std::vector<std::pair<Index, int>> _vectorizedIndices;
             std::string _name = UniqueName("LoopNest");
         };
 
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LoopNestInterpreter.h (value)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "LoopNest.h"
+#include "LoopNestVisitor.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ell
+{
+namespace value
+{
+    namespace loopnests
+    {
+        /// <summary>
+        /// Takes a loop nest and runs its loop control in the compute context. The interpreter visits the nest once, when it
+        /// is created, and lowers the loops, split indices and kernel predicates into a tree of closures over native counters.
+        /// Kernel bodies are not lowered: each call still runs through the compute context, exactly as with `CodeGenerator`,
+        /// so this only removes the cost of revisiting the nest on every loop iteration.
+        /// </summary>
+        /// <remarks>
+        /// Parallelized, unrolled and vectorized loops all run as plain sequential loops, so `value::LoopNest::Run` keeps
+        /// using `CodeGenerator`. In any other context, `Run` emits the loop nest with `CodeGenerator`.
+        /// </remarks>
+        class LoopNestInterpreter : public LoopNestVisitor
+        {
+        public:
+            /// <summary> Lowers a loop nest. The loop nest and the values its kernels use must outlive the interpreter </summary>
+            LoopNestInterpreter(const LoopNest& loopNest);
+
+            void Run() const;
+
+        private:
+            using Statement = std::function<void()>;
+            using Block = std::vector<Statement>;
+            using Test = std::function<bool()>;
+
+            // RAII struct to direct the statements being lowered into a block
+            struct BlockRecorder
+            {
+                BlockRecorder(const LoopNestInterpreter& interpreter, Block& block) :
+                    interpreter(interpreter),
+                    outerBlock(interpreter._currentBlock) { interpreter._currentBlock = &block; }
+                ~BlockRecorder() { interpreter._currentBlock = outerBlock; }
+                const LoopNestInterpreter& interpreter;
+                Block* outerBlock;
+            };
+
+            void GenerateLoopRangeOld(const LoopRange& range, const RecursionState& state, const LoopVisitSchedule& schedule, std::function<void(Scalar)> codegenFn) const override;
+            void GenerateLoopRangeNew(const LoopRange& range, const RecursionStateNew& state, const LoopVisitSchedule& schedule, std::function<void(Scalar)> codegenFn) const override;
+            Scalar EmitIndexExpression(const Index& index, const IndexExpression& expr, const LoopIndexSymbolTable& indexVariables) const override;
+            void InvokeKernel(const Kernel& kernel, const KernelPredicate& predicate, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const override;
+            bool InvokeKernelGroup(const ScheduledKernelGroup& kernelGroup, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const override;
+
+            void GenerateLoopRange(const LoopRange& range, int* indexVariable, std::function<void(Scalar)> codegenFn) const;
+            Statement GetKernelCall(const Kernel& kernel, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const;
+            Test GetKernelPredicateTest(const KernelPredicate& predicate, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const;
+
+            int* AddIndexVariable(int initialValue) const;
+            int* FindIndexVariable(Scalar value) const;
+            int* FindIndexVariable(const Index& index, const LoopIndexSymbolTable& indexVariables) const;
+            int* GetIndexVariable(Scalar value) const;
+            Scalar GetIndexVariableScalar(int* indexVariable) const;
+            void Emit(Statement statement) const;
+
+            static void RunBlock(const Block& block);
+
+            const LoopNest& _loopNest;
+            bool _lowered = false;
+            Block _statements;
+            mutable Block* _currentBlock = nullptr;
+            mutable std::vector<std::unique_ptr<int>> _indexVariables;
+        };
+    } // namespace loopnests
+} // namespace value
+} // namespace ell
@@ -28,6 +28,8 @@
 #include <llvm/CodeGen/TargetPassConfig.h>
 #include <llvm/Target/TargetMachine.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <queue>
 #include <set>
@@ -352,6 +354,107 @@ namespace value
         underlyingNest.RenameVariable(_value, cacheRef, _atIndices, { kernel2, kernel3 });
     } // namespace value
 
+    // The layouts of a BLASTCopy cache block and of the kernel's view of one of its stripes, for each of the
+    // boundary conditions described in BLASTCopy::HandleCachingImpl (boundary condition N is at index N - 1)
+    struct BLASTCopyLayouts
+    {
+        std::array<MemoryLayout, 4> cacheLayouts;
+        std::array<MemoryLayout, 4> cacheViewLayouts;
+    };
+
+    static BLASTCopyLayouts GetBLASTCopyLayouts(const MemoryShape& shape, int stripeSize, int inputRows, int inputCols)
+    {
+        int remainingRows = inputRows % shape[0];
+        int remainingCols = inputCols % shape[1];
+        int roundedRemainingCols = RoundUpToMultiple(remainingCols, stripeSize);
+        // we don't need to round up remainingRows since stripe size only applies to columns in BLASTCopy
+
+        auto generateTCOPYCacheLayout = [stripeSize](int rows, int cols) {
+            auto cacheDimOrder = DimensionOrder{ 0, 1, 2 };
+            auto liftedShape = MemoryShape{ cols / stripeSize, rows, stripeSize };
+            auto cacheLayout = MemoryLayout{ liftedShape, cacheDimOrder };
+            return cacheLayout;
+        };
+        auto generateTCOPYCacheViewLayout = [stripeSize](int rows, int cols) {
+            auto cacheViewLayout = MemoryLayout{ { rows, stripeSize }, RowMajorMatrixOrder };
+            return cacheViewLayout;
+        };
+
+        BLASTCopyLayouts layouts;
+
+        // "Boundary" condition 1 is the general case (i.e. non-boundary case), and its cache layout is the non-boundary-case 3D lifted shape
+        layouts.cacheLayouts[0] = generateTCOPYCacheLayout(shape[0], shape[1]);
+        layouts.cacheViewLayouts[0] = generateTCOPYCacheViewLayout(shape[0], shape[1]);
+
+        // Boundary condition 2, re-view to M' x remainingColumns
+        layouts.cacheLayouts[1] = generateTCOPYCacheLayout(shape[0], roundedRemainingCols);
+        layouts.cacheViewLayouts[1] = generateTCOPYCacheViewLayout(shape[0], roundedRemainingCols);
+
+        // Boundary condition 3, re-view to remainingRows x N'
+        layouts.cacheLayouts[2] = generateTCOPYCacheLayout(remainingRows, shape[1]);
+        layouts.cacheViewLayouts[2] = generateTCOPYCacheViewLayout(remainingRows, shape[1]);
+
+        // Boundary condition 4, re-view to remainingRows x remainingColumns
+        layouts.cacheLayouts[3] = generateTCOPYCacheLayout(remainingRows, roundedRemainingCols);
+        layouts.cacheViewLayouts[3] = generateTCOPYCacheViewLayout(remainingRows, roundedRemainingCols);
+
+        return layouts;
+    }
+
+    // Points cacheRef at the cached stripe holding column jStripe of the cache block that starts at (i, j)
+    static void SetBLASTCopyView(Value cacheBlock, Value cacheRef, Scalar i, Scalar j, Scalar jStripe, const MemoryShape& shape, int stripeSize, int inputRows, int inputCols, const BLASTCopyLayouts& layouts)
+    {
+        // To set up the view for the kernel to use, we need to set up the cacheRef reference
+        // so that a kernel indexing with (i, j) winds up in the right spot, pointing into the
+        // cached row-major submatrix that is the (j / stripeSize, ALL, ALL) slice of the cache array
+
+        // We may need to re-view the cache view to a smaller layout if we are in one of the boundary conditions
+        Scalar remainingRows = inputRows - i;
+        Scalar remainingCols = inputCols - j;
+        Scalar notEnoughRows = shape[0] > remainingRows;
+        Scalar notEnoughCols = shape[1] > remainingCols;
+
+        auto cacheViewFn = [&](MemoryLayout cacheLayout, MemoryLayout viewLayout) {
+            // Re-View the cache so we can index into the correct cached stripe
+            auto cacheView = cacheBlock;
+            cacheView.SetLayout(cacheLayout);
+            auto cacheStripe = jStripe % shape[1]; // If N > N', make sure we index into the re-initialized cache position
+            auto indexedCacheView = cacheView.Offset({ cacheStripe / stripeSize, 0, 0 });
+
+            // Re-View the indexed cache as a 2-D matrix so we can position the offset pointer for use in the inner kernels
+            indexedCacheView.SetLayout(viewLayout);
+            auto offsetIndexedCacheView = indexedCacheView.Offset({ -1 * i, -1 * j });
+            offsetIndexedCacheView.SetLayout(viewLayout);
+            cacheRef.SetLayout(viewLayout);
+            cacheRef = offsetIndexedCacheView.Reference();
+        };
+
+        // Emit all of the views and offsets individually since the cache layouts are set at emit-time
+        If(notEnoughRows,
+           [&]() {
+               If(notEnoughCols,
+                  [&]() {
+                      // Boundary condition 4
+                      cacheViewFn(layouts.cacheLayouts[3], layouts.cacheViewLayouts[3]);
+                  })
+                   .Else(
+                       [&]() {
+                           // Boundary condition 3
+                           cacheViewFn(layouts.cacheLayouts[2], layouts.cacheViewLayouts[2]);
+                       });
+           })
+            .ElseIf(notEnoughCols,
+                    [&]() {
+                        // Boundary condition 2
+                        cacheViewFn(layouts.cacheLayouts[1], layouts.cacheViewLayouts[1]);
+                    })
+            .Else(
+                [&]() {
+                    // Boundary condition 1
+                    cacheViewFn(layouts.cacheLayouts[0], layouts.cacheViewLayouts[0]);
+                });
+    }
+
     void BLASTCopy::HandleCachingImpl(LoopNest& nest)
     {
         /* BLAS T COPY:
@@ -426,51 +529,21 @@ namespace value
         int inputCols = inputMatrix.Columns();
         int remainingRows = inputRows % _shape[0];
         int remainingCols = inputCols % _shape[1];
-        int roundedRemainingCols = RoundUpToMultiple(remainingCols, stripeSize);
-        // we don't need to round up remainingRows since stripe size only applies to columns in BLASTCopy
-
-        auto generateTCOPYCacheLayout = [stripeSize](int rows, int cols) {
-            auto cacheDimOrder = DimensionOrder{ 0, 1, 2 };
-            auto liftedShape = MemoryShape{ cols / stripeSize, rows, stripeSize };
-            auto cacheLayout = MemoryLayout{ liftedShape, cacheDimOrder };
-            return cacheLayout;
-        };
-        auto generateTCOPYCacheViewLayout = [stripeSize](int rows, int cols) {
-            auto cacheViewLayout = MemoryLayout{ { rows, stripeSize }, RowMajorMatrixOrder };
-            return cacheViewLayout;
-        };
-
-        auto baseCacheLayout = generateTCOPYCacheLayout(_shape[0], _shape[1]); // The non-boundary-case 3D lifted shape
-        auto baseCacheViewLayout = generateTCOPYCacheViewLayout(_shape[0], _shape[1]);
-
-        // "Boundary" condition 1 is the general case (i.e. non-boundary case)
-        auto boundaryConditionCacheLayout1 = baseCacheLayout;
-        auto cacheViewLayout1 = baseCacheViewLayout;
-
-        // Boundary condition 2, re-view to M' x remainingColumns
-        auto boundaryConditionCacheLayout2 = generateTCOPYCacheLayout(_shape[0], roundedRemainingCols);
-        auto cacheViewLayout2 = generateTCOPYCacheViewLayout(_shape[0], roundedRemainingCols);
-
-        // Boundary condition 3, re-view to remainingRows x N'
-        auto boundaryConditionCacheLayout3 = generateTCOPYCacheLayout(remainingRows, _shape[1]);
-        auto cacheViewLayout3 = generateTCOPYCacheViewLayout(remainingRows, _shape[1]);
 
-        // Boundary condition 4, re-view to remainingRows x remainingColumns
-        auto boundaryConditionCacheLayout4 = generateTCOPYCacheLayout(remainingRows, roundedRemainingCols);
-        auto cacheViewLayout4 = generateTCOPYCacheViewLayout(remainingRows, roundedRemainingCols);
+        auto layouts = GetBLASTCopyLayouts(_shape, stripeSize, inputRows, inputCols);
 
         auto cacheName = UniqueName("BLASTCopyCache");
-        _rawCache = StaticAllocate(cacheName, _value.GetBaseType(), baseCacheLayout);
+        _rawCache = StaticAllocate(cacheName, _value.GetBaseType(), layouts.cacheLayouts[0]);
         Array liftedCache(_rawCache);
 
         auto cacheRef = _rawCache.Reference();
-        cacheRef.SetLayout(baseCacheViewLayout);
+        cacheRef.SetLayout(layouts.cacheViewLayouts[0]);
         cacheRef.SetName(cacheName + "_Ref");
 
         auto cacheFillKernel = loopnests::Kernel(cacheName + "_Fill_Cache_Kernel")
                                    .Inputs(_value, liftedCache)
                                    .Indices(_kernelIndices)
-                                   .Define([remainingRows, remainingCols, stripeSize, shape = _shape, inputRows, inputCols, boundaryConditionCacheLayout1, boundaryConditionCacheLayout2, boundaryConditionCacheLayout3, boundaryConditionCacheLayout4](value::Matrix input, value::Array cache, value::Scalar i, value::Scalar j) {
+                                   .Define([remainingRows, remainingCols, stripeSize, shape = _shape, inputRows, inputCols, layouts](value::Matrix input, value::Array cache, value::Scalar i, value::Scalar j) {
                                        // We may need to re-view the cache to a smaller layout if we have less
                                        // data to cache than we have available space in the cache.
                                        // If we re-view the cache then we can keep the smaller cached data
@@ -508,23 +581,23 @@ namespace value
                                               If(notEnoughCols,
                                                  [&]() {
                                                      // Boundary condition 4
-                                                     cacheFillLoop(boundaryConditionCacheLayout4, remainingRows, remainingCols);
+                                                     cacheFillLoop(layouts.cacheLayouts[3], remainingRows, remainingCols);
                                                  })
                                                   .Else(
                                                       [&]() {
                                                           // Boundary condition 3
-                                                          cacheFillLoop(boundaryConditionCacheLayout3, remainingRows, shape[1]);
+                                                          cacheFillLoop(layouts.cacheLayouts[2], remainingRows, shape[1]);
                                                       });
                                           })
                                            .ElseIf(notEnoughCols,
                                                    [&]() {
                                                        // Boundary condition 2
-                                                       cacheFillLoop(boundaryConditionCacheLayout2, shape[0], remainingCols);
+                                                       cacheFillLoop(layouts.cacheLayouts[1], shape[0], remainingCols);
                                                    })
                                            .Else(
                                                [&]() {
                                                    // Boundary condition 1
-                                                   cacheFillLoop(boundaryConditionCacheLayout1, shape[0], shape[1]);
+                                                   cacheFillLoop(layouts.cacheLayouts[0], shape[0], shape[1]);
                                                });
                                    });
 
@@ -537,61 +610,109 @@ namespace value
         auto viewInitKernel = loopnests::Kernel(cacheName + "_View_Init_Kernel")
                                   .Inputs(liftedCache, cacheRef)
                                   .Indices(viewInitKernelIndices)
-                                  .Define([shape = _shape, stripeSize, inputRows, inputCols, cacheViewLayout1, cacheViewLayout2, cacheViewLayout3, cacheViewLayout4, boundaryConditionCacheLayout1, boundaryConditionCacheLayout2, boundaryConditionCacheLayout3, boundaryConditionCacheLayout4](value::Array cache, value::Value cacheRef, value::Scalar i, value::Scalar j, value::Scalar jStripe) {
-                                      // To set up the view for the kernel to use, we need to set up the cacheRef reference
-                                      // so that a kernel indexing with (i, j) winds up in the right spot, pointing into the
-                                      // cached row-major submatrix that is the (j / stripeSize, ALL, ALL) slice of the cache array
-
-                                      // We may need to re-view the cache view to a smaller layout if we are in one of the boundary conditions
-                                      Scalar remainingRows = inputRows - i;
-                                      Scalar remainingCols = inputCols - j;
-                                      Scalar notEnoughRows = shape[0] > remainingRows;
-                                      Scalar notEnoughCols = shape[1] > remainingCols;
-
-                                      auto cacheViewFn = [&](MemoryLayout cacheLayout, MemoryLayout viewLayout) {
-                                          // Re-View the cache so we can index into the correct cached stripe
-                                          auto cacheView = cache.GetValue();
-                                          cacheView.SetLayout(cacheLayout);
-                                          auto cacheStripe = jStripe % shape[1]; // If N > N', make sure we index into the re-initialized cache position
-                                          auto indexedCacheView = cacheView.Offset({ cacheStripe / stripeSize, 0, 0 });
-
-                                          // Re-View the indexed cache as a 2-D matrix so we can position the offset pointer for use in the inner kernels
-                                          indexedCacheView.SetLayout(viewLayout);
-                                          auto offsetIndexedCacheView = indexedCacheView.Offset({ -1 * i, -1 * j });
-                                          offsetIndexedCacheView.SetLayout(viewLayout);
-                                          cacheRef.SetLayout(viewLayout);
-                                          cacheRef = offsetIndexedCacheView.Reference();
-                                      };
-
-                                      // Emit all of the views and offsets individually since the cache layouts are set at emit-time
-                                      If(notEnoughRows,
-                                         [&]() {
-                                             If(notEnoughCols,
-                                                [&]() {
-                                                    // Boundary condition 4
-                                                    cacheViewFn(boundaryConditionCacheLayout4, cacheViewLayout4);
-                                                })
-                                                 .Else(
-                                                     [&]() {
-                                                         // Boundary condition 3
-                                                         cacheViewFn(boundaryConditionCacheLayout3, cacheViewLayout3);
-                                                     });
-                                         })
-                                          .ElseIf(notEnoughCols,
-                                                  [&]() {
-                                                      // Boundary condition 2
-                                                      cacheViewFn(boundaryConditionCacheLayout2, cacheViewLayout2);
-                                                  })
-                                          .Else(
-                                              [&]() {
-                                                  // Boundary condition 1
-                                                  cacheViewFn(boundaryConditionCacheLayout1, cacheViewLayout1);
-                                              });
+                                  .Define([shape = _shape, stripeSize, inputRows, inputCols, layouts](value::Array cache, value::Value cacheRef, value::Scalar i, value::Scalar j, value::Scalar jStripe) {
+                                      SetBLASTCopyView(cache.GetValue(), cacheRef, i, j, jStripe, shape, stripeSize, inputRows, inputCols, layouts);
                                   });
         underlyingNest.AddKernel(viewInitKernel, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::prologue, { stripeSplitIndex }, {} });
         underlyingNest.RenameVariable(_value, cacheRef, _atIndices, { cacheFillKernel, viewInitKernel });
     }
 
+    void PrepackedBLASTCopy::HandleCachingImpl(LoopNest& nest)
+    {
+        // Same cache layout as BLASTCopy, but every cache block was filled ahead of time by PackForBLASTCopy,
+        // so there's no fill kernel: the view kernel just locates the current block in the packed data
+
+        ValidateInputDimensionality(_value, _shape, _order);
+
+        auto extraParams = std::any_cast<std::tuple<int, Index, Value>>(_extra);
+        int stripeSize;
+        Index stripeSplitIndex;
+        Value packedData;
+        std::tie(stripeSize, stripeSplitIndex, packedData) = extraParams;
+
+        if (_shape[1] % stripeSize != 0)
+        {
+            throw InputException(InputExceptionErrors::invalidSize, "The number of cache columns must be a multiple of the cache stripe size");
+        }
+
+        auto inputMatrix = Matrix(_value);
+        int inputRows = inputMatrix.Rows();
+        int inputCols = inputMatrix.Columns();
+        int numBlockColumns = (inputCols + _shape[1] - 1) / _shape[1];
+        int blockSize = _shape[0] * _shape[1];
+        if (static_cast<int>(packedData.GetLayout().GetMemorySize()) != ((inputRows + _shape[0] - 1) / _shape[0]) * numBlockColumns * blockSize)
+        {
+            throw InputException(InputExceptionErrors::sizeMismatch, "Prepacked data doesn't match the cache shape");
+        }
+
+        auto layouts = GetBLASTCopyLayouts(_shape, stripeSize, inputRows, inputCols);
+
+        auto cacheName = UniqueName("PrepackedBLASTCopy");
+        auto cacheRef = packedData.Reference();
+        cacheRef.SetLayout(layouts.cacheViewLayouts[0]);
+        cacheRef.SetName(cacheName + "_Ref");
+
+        std::vector<Index> viewInitKernelIndices;
+        viewInitKernelIndices.assign(_kernelIndices.begin(), _kernelIndices.end());
+        viewInitKernelIndices.push_back(stripeSplitIndex);
+        auto viewInitKernel = loopnests::Kernel(cacheName + "_View_Init_Kernel")
+                                  .Inputs(packedData, cacheRef)
+                                  .Indices(viewInitKernelIndices)
+                                  .Define([shape = _shape, stripeSize, inputRows, inputCols, numBlockColumns, blockSize, layouts](value::Value packed, value::Value cacheRef, value::Scalar i, value::Scalar j, value::Scalar jStripe) {
+                                      auto blockIndex = (i / shape[0]) * numBlockColumns + (j / shape[1]);
+                                      auto cacheBlock = packed.Offset(blockIndex * blockSize);
+                                      SetBLASTCopyView(cacheBlock, cacheRef, i, j, jStripe, shape, stripeSize, inputRows, inputCols, layouts);
+                                  });
+
+        auto& underlyingNest = nest.GetUnderlyingLoopNest();
+        underlyingNest.AddKernel(viewInitKernel, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::prologue, { stripeSplitIndex }, {} });
+        underlyingNest.RenameVariable(_value, cacheRef, _atIndices, { viewInitKernel });
+    }
+
+    template <typename T>
+    std::vector<T> PackForBLASTCopy(const std::vector<T>& matrix, int rows, int columns, const MemoryShape& cacheShape, int stripeSize)
+    {
+        if (static_cast<int>(matrix.size()) != rows * columns)
+        {
+            throw InputException(InputExceptionErrors::sizeMismatch, "Matrix has the wrong number of entries");
+        }
+        if (cacheShape.NumDimensions() != 2 || cacheShape[1] % stripeSize != 0)
+        {
+            throw InputException(InputExceptionErrors::invalidSize, "The number of cache columns must be a multiple of the cache stripe size");
+        }
+
+        const int cacheRows = cacheShape[0];
+        const int cacheCols = cacheShape[1];
+        const int numBlockRows = (rows + cacheRows - 1) / cacheRows;
+        const int numBlockColumns = (columns + cacheCols - 1) / cacheCols;
+        const int blockSize = cacheRows * cacheCols;
+
+        // Each block is laid out the way BLASTCopy's fill kernel lays out its cache, including the
+        // smaller re-viewed layouts and zero padding at the bottom and right edges of the matrix
+        std::vector<T> result(numBlockRows * numBlockColumns * blockSize, 0);
+        for (int blockRow = 0; blockRow < numBlockRows; ++blockRow)
+        {
+            const int blockRows = std::min(cacheRows, rows - blockRow * cacheRows);
+            for (int blockColumn = 0; blockColumn < numBlockColumns; ++blockColumn)
+            {
+                const int blockColumns = std::min(cacheCols, columns - blockColumn * cacheCols);
+                auto block = result.begin() + (blockRow * numBlockColumns + blockColumn) * blockSize;
+                for (int row = 0; row < blockRows; ++row)
+                {
+                    for (int column = 0; column < blockColumns; ++column)
+                    {
+                        auto cacheIndex = (column / stripeSize) * blockRows * stripeSize + row * stripeSize + column % stripeSize;
+                        block[cacheIndex] = matrix[(blockRow * cacheRows + row) * columns + blockColumn * cacheCols + column];
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    template std::vector<float> PackForBLASTCopy(const std::vector<float>& matrix, int rows, int columns, const MemoryShape& cacheShape, int stripeSize);
+    template std::vector<double> PackForBLASTCopy(const std::vector<double>& matrix, int rows, int columns, const MemoryShape& cacheShape, int stripeSize);
+
    // namespace value
 
   
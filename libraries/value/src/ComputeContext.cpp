@@ -11,6 +11,7 @@
 #include "Scalar.h"
 #include "Value.h"
 
+#include <utilities/include/ThreadPool.h>
 #include <utilities/include/TypeAliases.h>
 #include <utilities/include/TypeName.h>
 #include <utilities/include/TypeTraits.h>
@@ -19,8 +20,9 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
-#include <future>
+#include <exception>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 
@@ -60,6 +62,37 @@ namespace value
             int _nextThreadId = 0;
         } ThreadIds;
 
+        // The thread pool shared by all compute contexts for running parallelized loops. A running `Parallelize`
+        // holds a reference to its pool, so resizing replaces the pool without disturbing it.
+        struct
+        {
+            std::shared_ptr<ThreadPool> Get()
+            {
+                std::lock_guard lock{ _mutex };
+                if (!_pool)
+                {
+                    _pool = std::make_shared<ThreadPool>(_numThreads);
+                }
+                return _pool;
+            }
+
+            void SetNumThreads(size_t numThreads)
+            {
+                std::lock_guard lock{ _mutex };
+                _numThreads = numThreads;
+                _pool.reset();
+            }
+
+            size_t GetNumThreads()
+            {
+                return Get()->NumThreads();
+            }
+
+            std::mutex _mutex;
+            std::shared_ptr<ThreadPool> _pool;
+            size_t _numThreads = 0;
+        } ParallelThreadPool;
+
         // TODO: Make this the basis of an iterator for MemoryLayout
         bool IncrementMemoryCoordinateImpl(int dimension, std::vector<int>& coordinate, const std::vector<int>& maxCoordinate)
         {
@@ -84,6 +117,35 @@ namespace value
             return IncrementMemoryCoordinateImpl(static_cast<int>(maxCoordinate.size()) - 1, coordinate, maxCoordinate);
         }
 
+        // __builtin_prefetch needs its read/write and locality arguments to be compile-time constants
+        template <int ReadWrite>
+        void HostPrefetch(const void* address, PrefetchLocality locality)
+        {
+#if defined(_MSC_VER)
+            // MSVC has no portable prefetch intrinsic, and prefetching is only a hint
+            (void)address;
+            (void)locality;
+#else
+            switch (locality)
+            {
+            case PrefetchLocality::None:
+                __builtin_prefetch(address, ReadWrite, 0);
+                break;
+            case PrefetchLocality::Low:
+                __builtin_prefetch(address, ReadWrite, 1);
+                break;
+            case PrefetchLocality::Moderate:
+                __builtin_prefetch(address, ReadWrite, 2);
+                break;
+            case PrefetchLocality::Extreme:
+                __builtin_prefetch(address, ReadWrite, 3);
+                break;
+            default:
+                throw LogicException(LogicExceptionErrors::illegalState);
+            }
+#endif // defined(_MSC_VER)
+        }
+
         Value ConstantDataToValue(ConstantData& data, std::optional<MemoryLayout> layout = {})
         {
             return std::visit(
@@ -1475,25 +1537,72 @@ namespace value
         throw InputException(InputExceptionErrors::invalidArgument, "Specified function is not defined for this context");
     }
 
-    void ComputeContext::PrefetchImpl(Value, PrefetchType, PrefetchLocality)
-    {}
+    void ComputeContext::PrefetchImpl(Value data, PrefetchType type, PrefetchLocality locality)
+    {
+        // The data lives in host memory, so it can be prefetched by the host directly
+        std::visit(
+            [type, locality](auto&& data) {
+                using Type = std::decay_t<decltype(data)>;
+                if constexpr (!std::is_same_v<Type, Emittable>)
+                {
+                    if (type == PrefetchType::Read)
+                    {
+                        HostPrefetch<0>(data, locality);
+                    }
+                    else
+                    {
+                        HostPrefetch<1>(data, locality);
+                    }
+                }
+            },
+            data.GetUnderlyingData());
+    }
 
     void ComputeContext::ParallelizeImpl(int numTasks, std::vector<Value> captured, std::function<void(Scalar, std::vector<Value>)> fn)
     {
         ThreadIds.Clear();
 
-        std::vector<std::future<void>> futures;
-        futures.reserve(numTasks);
+        auto pool = ParallelThreadPool.Get();
+        std::atomic<int> numRemainingTasks{ numTasks };
+        std::mutex errorMutex;
+        std::exception_ptr error;
         for (int i = 0; i < numTasks; ++i)
         {
-            futures.push_back(std::async(fn, Scalar{ i }, captured));
+            pool->Submit([&, i]() {
+                try
+                {
+                    fn(Scalar{ i }, captured);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock{ errorMutex };
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                --numRemainingTasks;
+            });
         }
-        for (auto& future : futures)
+
+        // The calling thread runs tasks too while it waits
+        pool->WaitUntil([&numRemainingTasks]() { return numRemainingTasks == 0; });
+        if (error)
         {
-            future.wait();
+            std::rethrow_exception(error);
         }
     }
 
+    void ComputeContext::SetNumParallelThreads(size_t numThreads)
+    {
+        ParallelThreadPool.SetNumThreads(numThreads);
+    }
+
+    size_t ComputeContext::GetNumParallelThreads()
+    {
+        return ParallelThreadPool.GetNumThreads();
+    }
+
     namespace
     {
         void PrintValue(const Value& value, std::ostream& stream)
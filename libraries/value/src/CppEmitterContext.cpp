@@ -1447,7 +1447,33 @@ namespace value
 
     void CppEmitterContext::PrefetchImpl(Value data, PrefetchType type, PrefetchLocality locality)
     {
-        // no-op for now
+        if (data.IsConstant())
+        {
+            return;
+        }
+
+        int localityNum = 0;
+        switch (locality)
+        {
+        case PrefetchLocality::None:
+            localityNum = 0;
+            break;
+        case PrefetchLocality::Low:
+            localityNum = 1;
+            break;
+        case PrefetchLocality::Moderate:
+            localityNum = 2;
+            break;
+        case PrefetchLocality::Extreme:
+            localityNum = 3;
+            break;
+        default:
+            throw LogicException(LogicExceptionErrors::illegalState);
+        }
+
+        int typeNum = type == PrefetchType::Read ? 0 : 1;
+
+        Out() << "__builtin_prefetch(&" << ScalarToString(data) << ", " << typeNum << ", " << localityNum << ");\n";
     }
 
     void CppEmitterContext::ParallelizeImpl(int numTasks, std::vector<Value> captured, std::function<void(Scalar, std::vector<Value>)> fn)
@@ -14,6 +14,7 @@
 #include "loopnests/Kernel.h"
 #include "loopnests/LoopNest.h"
 
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <tuple>
@@ -129,6 +130,12 @@ namespace value
             _nest->Unroll(index);
         }
 
+        void Vectorize(Index index, int width)
+        {
+            EnsureCreated();
+            _nest->Vectorize(index, width);
+        }
+
         void SetOrder(std::vector<Index> indices)
         {
             EnsureCreated();
@@ -302,6 +309,53 @@ namespace value
         return outer;
     }
 
+    void Schedule::Vectorize(Index index, int width)
+    {
+        _impl.get().Vectorize(index, width);
+    }
+
+    void Schedule::Prefetch(ViewAdapter view, std::vector<Index> viewIndices, Index index, int distance, PrefetchLocality locality)
+    {
+        auto& underlyingNest = _nest.get().GetUnderlyingLoopNest();
+        Value data = view;
+        if (static_cast<int>(viewIndices.size()) != data.GetLayout().NumDimensions())
+        {
+            throw InputException(InputExceptionErrors::sizeMismatch, "Prefetch() --- must pass in one index per dimension of the view");
+        }
+        if (distance < 1)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Prefetch() --- distance must be positive");
+        }
+        if (!underlyingNest.IsLoopIndex(index))
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Prefetch() --- index " + index.GetName() + " doesn't represent a loop");
+        }
+
+        auto dimensionIter = std::find(viewIndices.begin(), viewIndices.end(), underlyingNest.GetBaseIndex(index));
+        if (dimensionIter == viewIndices.end())
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "Prefetch() --- index " + index.GetName() + " doesn't step through the view");
+        }
+        auto dimension = static_cast<int>(dimensionIter - viewIndices.begin());
+        auto prefetchOffset = distance * underlyingNest.GetIndexRange(index).Increment();
+        auto dimensionSize = data.GetLayout().GetLogicalDimensionActiveSize(dimension);
+
+        // Run the prefetch kernel in every iteration of the loop and of the loops outside it
+        const auto& loopSequence = underlyingNest.GetLoopSequence();
+        std::vector<Index> prefetchPosition(loopSequence.begin(), std::find(loopSequence.begin(), loopSequence.end(), index) + 1);
+
+        auto prefetchKernel = loopnests::Kernel(UniqueName("prefetch"))
+                                  .Inputs(data)
+                                  .Indices(viewIndices)
+                                  .DefineEx([=](std::vector<Value> values, std::vector<Scalar> indices) {
+                                      indices[dimension] += prefetchOffset;
+                                      If(indices[dimension] < dimensionSize, [&] {
+                                          value::Prefetch(values[0].Offset(indices), PrefetchType::Read, locality);
+                                      });
+                                  });
+        underlyingNest.AddKernel(prefetchKernel, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::prologue, prefetchPosition, {} });
+    }
+
     void Schedule::Cache(std::unique_ptr<CachingProvider> provider)
     {
         provider->HandleCaching(_nest.get());
@@ -29,6 +29,27 @@ namespace value
             {
                 return (a - 1) / b + 1;
             }
+
+            // Emits `width` consecutive iterations at a time, so their loads, stores and arithmetic are next to each other and
+            // LLVM's SLP vectorizer can combine them into vector instructions. The iterations left over are emitted unrolled.
+            void GenerateVectorizedLoop(const std::string& name, int start, int stop, int step, int width, std::function<void(Scalar)> codegenFn)
+            {
+                const int vectorStep = step * width;
+                const int vectorStop = start + ((stop - start) / vectorStep) * vectorStep;
+                if (vectorStop > start)
+                {
+                    ForRange(name, start, vectorStop, vectorStep, [&](Scalar index) {
+                        for (int lane = 0; lane < width; ++lane)
+                        {
+                            codegenFn(index + lane * step);
+                        }
+                    });
+                }
+                for (int i = vectorStop; i < stop; i += step)
+                {
+                    codegenFn(i);
+                }
+            }
         } // namespace
 
         void CodeGenerator::Run(const LoopNest& loopNest) const
@@ -43,7 +64,9 @@ namespace value
 
             bool isParallelized = loopNest.IsParallelized(loopIndex);
             bool isUnrolled = loopNest.IsUnrolled(loopIndex);
+            bool isVectorized = loopNest.IsVectorized(loopIndex);
             assert(!(isParallelized && isUnrolled) && "An index cannot be both unrolled and parallelized");
+            assert(!(isVectorized && (isParallelized || isUnrolled)) && "A vectorized index cannot be unrolled or parallelized");
 
             const int startInt = r.start.Get<int>();
             const int stopInt = r.stop.Get<int>();
@@ -55,7 +78,11 @@ namespace value
                 isParallelized = false;
             }
 
-            if (!(isParallelized || isUnrolled))
+            if (isVectorized)
+            {
+                GenerateVectorizedLoop(UniqueName(loopNest.Name()), startInt, stopInt, stepInt, loopNest.GetVectorizationWidth(loopIndex), codegenFn);
+            }
+            else if (!(isParallelized || isUnrolled))
             {
                 ForRange(UniqueName(loopNest.Name()), r.start, r.stop, r.step, codegenFn);
             }
@@ -109,7 +136,9 @@ namespace value
 
             bool isParallelized = loopNest.IsParallelized(loopIndex);
             bool isUnrolled = loopNest.IsUnrolled(loopIndex);
+            bool isVectorized = loopNest.IsVectorized(loopIndex);
             assert(!(isParallelized && isUnrolled) && "An index cannot be both unrolled and parallelized");
+            assert(!(isVectorized && (isParallelized || isUnrolled)) && "A vectorized index cannot be unrolled or parallelized");
 
             const int startInt = r.start.Get<int>();
             const int stopInt = r.stop.Get<int>();
@@ -121,7 +150,11 @@ namespace value
                 isParallelized = false;
             }
 
-            if (!(isParallelized || isUnrolled))
+            if (isVectorized)
+            {
+                GenerateVectorizedLoop(UniqueName(loopNest.Name()), startInt, stopInt, stepInt, loopNest.GetVectorizationWidth(loopIndex), codegenFn);
+            }
+            else if (!(isParallelized || isUnrolled))
             {
                 ForRange(UniqueName(loopNest.Name()), r.start, r.stop, r.step, codegenFn);
             }
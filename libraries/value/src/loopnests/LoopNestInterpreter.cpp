@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     LoopNestInterpreter.cpp (value)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "loopnests/LoopNestInterpreter.h"
+#include "loopnests/CodeGenerator.h"
+#include "loopnests/KernelPredicate.h"
+
+#include "ComputeContext.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <utility>
+#include <variant>
+
+namespace ell
+{
+namespace value
+{
+    namespace loopnests
+    {
+        LoopNestInterpreter::LoopNestInterpreter(const LoopNest& loopNest) :
+            _loopNest(loopNest)
+        {
+            InvokeForContext<ComputeContext>([&] {
+                BlockRecorder recorder(*this, _statements);
+                Visit(loopNest);
+                _lowered = true;
+            });
+        }
+
+        void LoopNestInterpreter::Run() const
+        {
+            if (!_lowered)
+            {
+                CodeGenerator{}.Run(_loopNest);
+                return;
+            }
+
+            RunBlock(_statements);
+        }
+
+        void LoopNestInterpreter::GenerateLoopRangeOld(const LoopRange& r, const RecursionState& state, const LoopVisitSchedule& schedule, std::function<void(Scalar)> codegenFn) const
+        {
+            GenerateLoopRange(r, FindIndexVariable(schedule.CurrentLoopIndex(), state.loopIndices), codegenFn);
+        }
+
+        void LoopNestInterpreter::GenerateLoopRangeNew(const LoopRange& r, const RecursionStateNew& state, const LoopVisitSchedule& schedule, std::function<void(Scalar)> codegenFn) const
+        {
+            GenerateLoopRange(r, FindIndexVariable(schedule.CurrentLoopIndex(), state.loopIndices), codegenFn);
+        }
+
+        void LoopNestInterpreter::GenerateLoopRange(const LoopRange& r, int* indexVariable, std::function<void(Scalar)> codegenFn) const
+        {
+            const int startInt = r.start.Get<int>();
+            const int stopInt = r.stop.Get<int>();
+            const int stepInt = r.step.Get<int>();
+
+            // Lower the loop body once, with the loop counter as its index
+            if (indexVariable == nullptr)
+            {
+                indexVariable = AddIndexVariable(startInt);
+            }
+            Block body;
+            {
+                BlockRecorder recorder(*this, body);
+                codegenFn(GetIndexVariableScalar(indexVariable));
+            }
+
+            Emit([indexVariable, startInt, stopInt, stepInt, body = std::move(body)] {
+                for (int i = startInt; i < stopInt; i += stepInt)
+                {
+                    *indexVariable = i;
+                    RunBlock(body);
+                }
+            });
+        }
+
+        Scalar LoopNestInterpreter::EmitIndexExpression(const Index& index, const IndexExpression& expr, const LoopIndexSymbolTable& indexVariables) const
+        {
+            if (expr.indices.empty())
+            {
+                return 0;
+            }
+
+            std::vector<std::pair<int*, int>> scaledIndices;
+            for (auto scaledIndex : expr.indices)
+            {
+                if (auto it = indexVariables.find(scaledIndex.index); it != indexVariables.end())
+                {
+                    scaledIndices.emplace_back(GetIndexVariable(it->second.value), scaledIndex.scale);
+                }
+            }
+
+            auto result = FindIndexVariable(index, indexVariables);
+            if (result == nullptr)
+            {
+                result = AddIndexVariable(expr.begin);
+            }
+            Emit([result, begin = expr.begin, scaledIndices = std::move(scaledIndices)] {
+                int sum = begin;
+                for (const auto& [indexVariable, scale] : scaledIndices)
+                {
+                    sum += *indexVariable * scale;
+                }
+                *result = sum;
+            });
+            return GetIndexVariableScalar(result);
+        }
+
+        void LoopNestInterpreter::InvokeKernel(const Kernel& kernel, const KernelPredicate& predicate, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const
+        {
+            auto call = GetKernelCall(kernel, runtimeIndexVariables, schedule);
+            if (predicate.IsAlwaysTrue())
+            {
+                Emit(std::move(call));
+            }
+            else
+            {
+                Emit([test = GetKernelPredicateTest(predicate, runtimeIndexVariables, schedule), call = std::move(call)] {
+                    if (test())
+                    {
+                        call();
+                    }
+                });
+            }
+        }
+
+        bool LoopNestInterpreter::InvokeKernelGroup(const ScheduledKernelGroup& kernelGroup, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const
+        {
+            // preprocess to get only valid kernels
+            auto validKernels = GetValidKernels(kernelGroup, runtimeIndexVariables, schedule);
+
+            if (validKernels.empty())
+            {
+                return false;
+            }
+
+            // The kernels form an if / else-if cascade: the first one whose predicate holds is called
+            std::vector<std::pair<Test, Statement>> cases;
+            for (const auto& kernel : validKernels)
+            {
+                auto predicate = schedule.GetKernelPredicate(kernel).Simplify(runtimeIndexVariables, schedule);
+                if (predicate.IsAlwaysFalse())
+                {
+                    throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Always-false predicates should have been removed here");
+                }
+
+                if (predicate.IsAlwaysTrue())
+                {
+                    cases.emplace_back(Test{}, GetKernelCall(kernel.kernel, runtimeIndexVariables, schedule));
+                    break;
+                }
+                cases.emplace_back(GetKernelPredicateTest(predicate, runtimeIndexVariables, schedule), GetKernelCall(kernel.kernel, runtimeIndexVariables, schedule));
+            }
+
+            Emit([cases = std::move(cases)] {
+                for (const auto& [test, call] : cases)
+                {
+                    if (!test || test())
+                    {
+                        call();
+                        return;
+                    }
+                }
+            });
+            return true;
+        }
+
+        LoopNestInterpreter::Statement LoopNestInterpreter::GetKernelCall(const Kernel& kernel, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const
+        {
+            const auto& kernelArgs = kernel.GetArgs();
+            const auto& kernelIndices = kernel.GetIndices();
+
+            const auto& renameActions = schedule.GetLoopNest().GetRenameActions();
+
+            // Create argument list
+            std::vector<Value> kernelArgValues;
+            kernelArgValues.reserve(kernelArgs.size());
+
+            auto rename = [&](const Value& arg) {
+                for (const auto& action : renameActions)
+                {
+                    const auto& excludedKernels = action.excludedKernels;
+                    if (std::find(excludedKernels.begin(), excludedKernels.end(), kernel.GetId()) == excludedKernels.end() &&
+                        std::equal_to<Value>{}(arg, action.oldValue) &&
+                        AreAllFullyDefined(action.where, schedule))
+                    {
+                        return action.newValue;
+                    }
+                }
+                return arg;
+            };
+
+            for (const auto& arg : kernelArgs)
+            {
+                kernelArgValues.push_back(rename(arg));
+            }
+
+            std::vector<Value> kernelIndexValues;
+            kernelIndexValues.reserve(kernelIndices.size());
+            for (auto index : kernelIndices)
+            {
+                kernelIndexValues.push_back(GetIndexVariableScalar(GetIndexVariable(runtimeIndexVariables.at(index).value)).GetValue());
+            }
+
+            return [kernel, kernelArgValues = std::move(kernelArgValues), kernelIndexValues = std::move(kernelIndexValues)] {
+                kernel.Call(kernelArgValues, kernelIndexValues);
+            };
+        }
+
+        LoopNestInterpreter::Test LoopNestInterpreter::GetKernelPredicateTest(const KernelPredicate& predicate, const LoopIndexSymbolTable& runtimeIndexVariables, const LoopVisitSchedule& schedule) const
+        {
+            const auto& domain = schedule.GetLoopNest().GetDomain();
+
+            // Mirrors `CodeGenerator::EmitKernelPredicate`: the terms of a conjunction must all hold, and the terms of a disjunction
+            // need only one to hold, including the loop indices a fragment predicate depends on
+            auto getTest = [this, &domain, &runtimeIndexVariables, &schedule](const auto& getTest, const KernelPredicate& p, bool defaultIsTrue) -> Test {
+                if (p.IsAlwaysTrue())
+                {
+                    return [] { return true; };
+                }
+                if (p.IsAlwaysFalse())
+                {
+                    return [] { return false; };
+                }
+                if (auto simplePredicate = p.As<FragmentTypePredicate>(); simplePredicate != nullptr)
+                {
+                    auto condition = simplePredicate->GetCondition();
+                    if (condition == Fragment::all)
+                    {
+                        return [defaultIsTrue] { return defaultIsTrue; };
+                    }
+
+                    auto index = simplePredicate->GetIndex();
+                    const auto range = domain.GetDimensionRange(index);
+
+                    auto loopIndices = range.GetDependentLoopIndices(index);
+                    if (loopIndices.empty())
+                    {
+                        loopIndices = { index };
+                    }
+
+                    std::vector<std::pair<int*, int>> indexTests;
+                    for (auto loopIndex : loopIndices)
+                    {
+                        auto range = GetLoopRange(loopIndex, runtimeIndexVariables, schedule);
+
+                        int testVal = 0;
+                        bool valid = true;
+                        switch (condition)
+                        {
+                        case Fragment::first:
+                            testVal = range.Begin();
+                            break;
+                        case Fragment::last:
+                            testVal = range.End() - (range.Size() % range.Increment());
+                            if (testVal == range.End()) // not a boundary
+                            {
+                                testVal = range.End() - range.Increment();
+                            }
+                            break;
+                        case Fragment::endBoundary:
+                            testVal = range.End() - (range.Size() % range.Increment());
+                            if (testVal == range.End())
+                            {
+                                valid = false;
+                            }
+                            break;
+                        default:
+                            valid = false;
+                            break;
+                        }
+
+                        if (valid)
+                        {
+                            // if loop index not present, assume 0
+                            auto indexVariable = runtimeIndexVariables.count(loopIndex) != 0 ? GetIndexVariable(runtimeIndexVariables.at(loopIndex).value) : AddIndexVariable(0);
+                            indexTests.emplace_back(indexVariable, testVal);
+                        }
+                    }
+
+                    return [defaultIsTrue, indexTests = std::move(indexTests)] {
+                        auto isAtTestValue = [](const std::pair<int*, int>& indexTest) { return *indexTest.first == indexTest.second; };
+                        return defaultIsTrue ? std::all_of(indexTests.begin(), indexTests.end(), isAtTestValue) : std::any_of(indexTests.begin(), indexTests.end(), isAtTestValue);
+                    };
+                }
+                if (p.Is<IndexDefinedPredicate>())
+                {
+                    throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "IsDefined predicate not implemented");
+                }
+                if (auto conjunction = p.As<KernelPredicateConjunction>(); conjunction != nullptr)
+                {
+                    std::vector<Test> termTests;
+                    for (const auto& t : conjunction->GetTerms())
+                    {
+                        termTests.push_back(getTest(getTest, *t, true));
+                    }
+                    return [termTests = std::move(termTests)] {
+                        return std::all_of(termTests.begin(), termTests.end(), [](const Test& test) { return test(); });
+                    };
+                }
+                if (auto disjunction = p.As<KernelPredicateDisjunction>(); disjunction != nullptr)
+                {
+                    std::vector<Test> termTests;
+                    for (const auto& t : disjunction->GetTerms())
+                    {
+                        termTests.push_back(getTest(getTest, *t, false));
+                    }
+                    return [termTests = std::move(termTests)] {
+                        return std::any_of(termTests.begin(), termTests.end(), [](const Test& test) { return test(); });
+                    };
+                }
+                throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Unknown predicate type");
+            };
+
+            return getTest(getTest, predicate, true);
+        }
+
+        int* LoopNestInterpreter::AddIndexVariable(int initialValue) const
+        {
+            _indexVariables.push_back(std::make_unique<int>(initialValue));
+            return _indexVariables.back().get();
+        }
+
+        int* LoopNestInterpreter::FindIndexVariable(Scalar value) const
+        {
+            const auto& data = value.GetValue().GetUnderlyingData();
+            if (auto ptr = std::get_if<int*>(&data); ptr != nullptr)
+            {
+                auto it = std::find_if(_indexVariables.begin(), _indexVariables.end(), [ptr](const auto& indexVariable) { return indexVariable.get() == *ptr; });
+                if (it != _indexVariables.end())
+                {
+                    return *ptr;
+                }
+            }
+            return nullptr;
+        }
+
+        int* LoopNestInterpreter::FindIndexVariable(const Index& index, const LoopIndexSymbolTable& indexVariables) const
+        {
+            // The visitor stores a new value for an index over its previous entry in the symbol table, which copies the value
+            // into the previous entry's variable. That copy only happens once, while lowering, so the new value has to be
+            // computed into the previous variable instead.
+            if (auto it = indexVariables.find(index); it != indexVariables.end())
+            {
+                return FindIndexVariable(it->second.value);
+            }
+            return nullptr;
+        }
+
+        int* LoopNestInterpreter::GetIndexVariable(Scalar value) const
+        {
+            if (auto indexVariable = FindIndexVariable(value); indexVariable != nullptr)
+            {
+                return indexVariable;
+            }
+
+            // Any other value was computed while lowering the loop nest, so it's a constant
+            return AddIndexVariable(value.Get<int>());
+        }
+
+        Scalar LoopNestInterpreter::GetIndexVariableScalar(int* indexVariable) const
+        {
+            return Value(indexVariable, utilities::ScalarLayout);
+        }
+
+        void LoopNestInterpreter::Emit(Statement statement) const
+        {
+            _currentBlock->push_back(std::move(statement));
+        }
+
+        void LoopNestInterpreter::RunBlock(const Block& block)
+        {
+            for (const auto& statement : block)
+            {
+                statement();
+            }
+        }
+    } // namespace loopnests
+} // namespace value
+} // namespace ell
@@ -68,6 +68,10 @@ namespace value
             {
                 properties.push_back("unrolled");
             }
+            if (loopNest.IsVectorized(loopIndex))
+            {
+                properties.push_back("vectorized(" + std::to_string(loopNest.GetVectorizationWidth(loopIndex)) + ")");
+            }
             if (numIterations == 1)
             {
                 properties.push_back("single");
@@ -110,6 +114,10 @@ namespace value
             {
                 properties.push_back("unrolled");
             }
+            if (loopNest.IsVectorized(loopIndex))
+            {
+                properties.push_back("vectorized(" + std::to_string(loopNest.GetVectorizationWidth(loopIndex)) + ")");
+            }
 
             auto currentLoopHasPrologue = r.currentLoopFragmentFlags.GetFlag(LoopFragmentType::prologue);
             auto currentLoopHasEpilogue = r.currentLoopFragmentFlags.GetFlag(LoopFragmentType::epilogue);
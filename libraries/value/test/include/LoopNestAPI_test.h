@@ -22,6 +22,12 @@ value::Scalar LoopNest_api_test5();
 value::Scalar LoopNest_api_Parallelized_test1();
 value::Scalar LoopNest_api_Parallelized_test2();
 value::Scalar LoopNest_api_Unrolled_test1();
+value::Scalar LoopNest_api_Vectorized_Elementwise_test();
+value::Scalar LoopNest_api_Vectorized_GEMM_test();
+void LoopNest_api_Vectorized_IR_test();
+value::Scalar LoopNest_api_Prefetch_GEMM_test();
+value::Scalar LoopNest_api_Prefetch_AllKinds_test();
+void LoopNest_api_Prefetch_Emitted_test();
 value::Scalar LoopNest_api_SetOrder_test1();
 value::Scalar LoopNest_api_CachedMatrix_test1();
 value::Scalar LoopNest_api_SlidingCachedMatrix_test();
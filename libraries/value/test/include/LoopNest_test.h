@@ -86,4 +86,6 @@ value::Scalar LoopNestFuse_test2();
 value::Scalar LoopNestFuse_test3();
 value::Scalar ConvertedConstraint_test1();
 value::Scalar ConvertedConstraint_test2();
+value::Scalar LoopNestInterpreter_test1();
+value::Scalar LoopNestInterpreter_test2();
 } // namespace ell
@@ -11,6 +11,9 @@
 #include "TestUtil.h"
 
 #include <value/include/CachingStrategies.h>
+#include <value/include/CppEmitterContext.h>
+#include <value/include/EmitterContext.h>
+#include <value/include/FunctionDeclaration.h>
 #include <value/include/LLVMContext.h>
 #include <value/include/LoopNests.h>
 #include <value/include/Matrix.h>
@@ -19,6 +22,12 @@
 #include <value/include/Value.h>
 #include <value/include/loopnests/LoopNest.h>
 
+#include <emitters/include/CompilerOptions.h>
+#include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IROptimizer.h>
+
+#include <testing/include/testing.h>
+
 #include <utilities/include/Logger.h>
 #include <utilities/include/TunableParameters.h>
 
@@ -26,6 +35,9 @@
 
 #include <llvm/IR/Value.h>
 
+#include <sstream>
+#include <string>
+
 #if 0 // DEBUGGING
 #include <value/include/loopnests/LoopNest.h>
 #endif
@@ -265,6 +277,217 @@ Scalar LoopNest_api_Unrolled_test1()
     return matrix(2, 3) - 19; // will return 0 if calculation is correct
 }
 
+Scalar LoopNest_api_Vectorized_Elementwise_test()
+{
+    const int N = 37; // not a multiple of the vector width, to exercise the remainder
+    const int vectorWidth = 8;
+    auto A = MakeIncrementingVector<float>(N, "A");
+    auto B = MakeIncrementingVector<float>(N, "B");
+    auto C = MakeIncrementingVector<float>(N, "C");
+
+    auto expected = MakeVector<float>(N, "expected");
+    ForRange(N, [&](Scalar i) {
+        expected(i) = A(i) * B(i) + C(i);
+    });
+
+    Index i("i");
+    auto nest = Using({ A, B }, ArgumentType::Input)
+                    .Using({ C }, ArgumentType::InputOutput)
+                    .ForAll(i, 0, N)
+                    .Do([](Vector A_, Vector B_, Vector C_, Scalar i_) {
+                        C_(i_) += A_(i_) * B_(i_);
+                    });
+
+    auto& schedule = nest.GetSchedule();
+    schedule.Vectorize(i, vectorWidth);
+
+    nest.Run();
+
+    return VerifySame(C, expected);
+}
+
+Scalar LoopNest_api_Vectorized_GEMM_test()
+{
+    const int M = 6;
+    const int N = 20; // not a multiple of the vector width, to exercise the remainder
+    const int K = 12;
+    const int vectorWidth = 8;
+    auto A = MakeIncrementingMatrix<float>(M, K, "A");
+    auto B = MakeIncrementingMatrix<float>(K, N, "B");
+    auto C = MakeMatrix<float>(M, N, "C");
+    auto expected = MakeMatrix<float>(M, N, "expected");
+    MultiplyMatrices(A, B, expected);
+
+    Index i("i"), j("j"), k("k");
+    auto nest = Using({ A, B }, ArgumentType::Input)
+                    .Using({ C }, ArgumentType::Output)
+                    .ForAll(i, 0, M)
+                    .ForAll(j, 0, N)
+                    .ForAll(k, 0, K)
+                    .Do([](Matrix A_, Matrix B_, Matrix C_, Scalar i_, Scalar j_, Scalar k_) {
+                        C_(i_, j_) += A_(i_, k_) * B_(k_, j_);
+                    });
+
+    // Broadcast A(i, k) across a vector of consecutive columns of B and C
+    auto& schedule = nest.GetSchedule();
+    schedule.SetOrder({ i, k, j });
+    schedule.Vectorize(j, vectorWidth);
+
+    nest.Run();
+
+    return VerifySame(C, expected);
+}
+
+void LoopNest_api_Vectorized_IR_test()
+{
+    const int N = 64;
+    const int vectorWidth = 8;
+
+    emitters::CompilerOptions options;
+    options.optimize = true;
+    options.parallelize = false;
+    options.useBlas = false;
+    emitters::IRModuleEmitter module("LoopNest_api_Vectorized_IR_test", options);
+    {
+        ContextGuard<LLVMContext> guard(module);
+        DeclareFunction("LoopNest_api_Vectorized_IR_test_fn")
+            .Parameters(
+                Value(ValueType::Float, MemoryLayout{ { N } }),
+                Value(ValueType::Float, MemoryLayout{ { N } }),
+                Value(ValueType::Float, MemoryLayout{ { N } }))
+            .Define([=](Vector A, Vector B, Vector C) {
+                Index i("i");
+                auto nest = Using({ A, B }, ArgumentType::Input)
+                                .Using({ C }, ArgumentType::InputOutput)
+                                .ForAll(i, 0, N)
+                                .Do([](Vector A_, Vector B_, Vector C_, Scalar i_) {
+                                    C_(i_) += A_(i_) * B_(i_);
+                                });
+                nest.GetSchedule().Vectorize(i, vectorWidth);
+                nest.Run();
+            });
+    }
+
+    emitters::IROptimizer optimizer(module);
+    optimizer.AddStandardPasses();
+    module.Optimize(optimizer);
+
+    std::stringstream stream;
+    module.WriteToStream(stream, emitters::ModuleOutputFormat::ir);
+    auto ir = stream.str();
+    auto contains = [&ir](const std::string& text) { return ir.find(text) != std::string::npos; };
+
+    // The lanes of each vector step must come out as vector instructions, not as `vectorWidth` scalar ones
+    testing::ProcessTest("LoopNest_api_Vectorized_IR_test: vector loads", contains("load <"));
+    testing::ProcessTest("LoopNest_api_Vectorized_IR_test: vector stores", contains("store <"));
+    testing::ProcessTest("LoopNest_api_Vectorized_IR_test: vector multiply-adds",
+                         (contains("fmul <") && contains("fadd <")) || contains("@llvm.fmuladd.v") || contains("@llvm.fma.v"));
+}
+
+Scalar LoopNest_api_Prefetch_GEMM_test()
+{
+    const int M = 10;
+    const int N = 8;
+    const int K = 12;
+    auto A = MakeIncrementingMatrix<float>(M, K, "A");
+    auto B = MakeIncrementingMatrix<float>(K, N, "B");
+    auto C = MakeMatrix<float>(M, N, "C");
+    auto expected = MakeMatrix<float>(M, N, "expected");
+    MultiplyMatrices(A, B, expected);
+
+    Index i("i"), j("j"), k("k");
+    auto nest = Using({ A, B }, ArgumentType::Input)
+                    .Using({ C }, ArgumentType::Output)
+                    .ForAll(i, 0, M)
+                    .ForAll(j, 0, N)
+                    .ForAll(k, 0, K)
+                    .Do([](Matrix A_, Matrix B_, Matrix C_, Scalar i_, Scalar j_, Scalar k_) {
+                        C_(i_, j_) += A_(i_, k_) * B_(k_, j_);
+                    });
+
+    // Fetch the next block of rows of B and a later row of A while the current ones are being used.
+    // The prefetches that would run past the end of A and B are skipped
+    auto& schedule = nest.GetSchedule();
+    auto kOuter = schedule.Split(k, 4);
+    schedule.SetOrder({ i, kOuter, j, k });
+    schedule.Prefetch(B, { k, j }, kOuter, 1);
+    schedule.Prefetch(A, { i, k }, i, 2, PrefetchLocality::Low);
+
+    nest.Run();
+
+    return VerifySame(C, expected);
+}
+
+Scalar LoopNest_api_Prefetch_AllKinds_test()
+{
+    const int N = 20;
+    auto data = MakeIncrementingVector<float>(N, "data");
+    auto expected = MakeIncrementingVector<float>(N, "expected");
+
+    // Prefetching is only a hint, so every kind of prefetch must leave the data alone, including at its last element
+    for (auto type : { PrefetchType::Read, PrefetchType::Write })
+    {
+        for (auto locality : { PrefetchLocality::None, PrefetchLocality::Low, PrefetchLocality::Moderate, PrefetchLocality::Extreme })
+        {
+            Prefetch(data[0], type, locality);
+            Prefetch(data[N / 2], type, locality);
+            Prefetch(data[N - 1], type, locality);
+        }
+    }
+
+    return VerifySame(data, expected);
+}
+
+void LoopNest_api_Prefetch_Emitted_test()
+{
+    const int M = 10;
+    const int N = 8;
+    const int K = 12;
+
+    std::stringstream stream;
+    {
+        ContextGuard<CppEmitterContext> guard("LoopNest_api_Prefetch_Emitted_test", stream);
+        DeclareFunction("LoopNest_api_Prefetch_Emitted_test_fn")
+            .Parameters(
+                Value(ValueType::Float, MemoryLayout{ { M, K } }),
+                Value(ValueType::Float, MemoryLayout{ { K, N } }),
+                Value(ValueType::Float, MemoryLayout{ { M, N } }))
+            .Define([=](Matrix A, Matrix B, Matrix C) {
+                Index i("i"), j("j"), k("k");
+                auto nest = Using({ A, B }, ArgumentType::Input)
+                                .Using({ C }, ArgumentType::InputOutput)
+                                .ForAll(i, 0, M)
+                                .ForAll(j, 0, N)
+                                .ForAll(k, 0, K)
+                                .Do([](Matrix A_, Matrix B_, Matrix C_, Scalar i_, Scalar j_, Scalar k_) {
+                                    C_(i_, j_) += A_(i_, k_) * B_(k_, j_);
+                                });
+
+                auto& schedule = nest.GetSchedule();
+                auto kOuter = schedule.Split(k, 4);
+                schedule.SetOrder({ i, kOuter, j, k });
+                schedule.Prefetch(B, { k, j }, kOuter, 1);
+                nest.Run();
+            });
+    }
+
+    // The emitted loops are, in order, i, kOuter, j and k. The prefetch belongs to the prologue of kOuter, so it must come
+    // after the first two loops open and before the j loop does
+    auto code = stream.str();
+    auto prefetchPosition = code.find("__builtin_prefetch(");
+    testing::ProcessTest("LoopNest_api_Prefetch_Emitted_test: emits __builtin_prefetch", prefetchPosition != std::string::npos);
+    if (prefetchPosition != std::string::npos)
+    {
+        int numLoopsBefore = 0;
+        for (auto position = code.find("for (;"); position < prefetchPosition; position = code.find("for (;", position + 1))
+        {
+            ++numLoopsBefore;
+        }
+        auto nextLoopPosition = code.find("for (;", prefetchPosition);
+        testing::ProcessTest("LoopNest_api_Prefetch_Emitted_test: prefetch is in the kOuter prologue", numLoopsBefore == 2 && nextLoopPosition != std::string::npos);
+    }
+}
+
 Scalar LoopNest_api_SetOrder_test1()
 {
     auto matrix = MakeMatrix<int>(4, 5);
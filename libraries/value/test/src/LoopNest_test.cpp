@@ -22,6 +22,7 @@
 #include <value/include/loopnests/CodeGenerator.h>
 #include <value/include/loopnests/Kernel.h>
 #include <value/include/loopnests/LoopNest.h>
+#include <value/include/loopnests/LoopNestInterpreter.h>
 #include <value/include/loopnests/LoopNestPrinter.h>
 
 #include <emitters/include/IRFunctionEmitter.h>
@@ -3658,4 +3659,89 @@ Scalar ConvertedConstraint_test2()
 
     return matrix(2, 3) - 19; // will return 0 if calculation is correct
 }
+
+// Test that a loop nest lowered by the interpreter computes the same thing as one run by CodeGenerator, and that it can be run more than once
+Scalar LoopNestInterpreter_test1()
+{
+    const int N = 8;
+    auto A = MakeMatrix<int>(N, N, "A");
+    auto B = MakeMatrix<int>(N, N, "B");
+    auto C = MakeMatrix<int>(N, N, "C");
+
+    ForRange(N, [&](Scalar i) {
+        ForRange(N, [&](Scalar j) {
+            A(i, j) = i - j;
+            B(i, j) = i + 2 * j;
+            C(i, j) = 100;
+        });
+    });
+
+    Index i("i"), j("j"), k("k");
+
+    auto innerKernel = Kernel("matmul")
+                           .Inputs(A.GetValue(), B.GetValue(), C.GetValue())
+                           .Indices(i, j, k)
+                           .Define(matmul_kernel);
+    auto initCKernel = Kernel("init")
+                           .Inputs(C.GetValue())
+                           .Indices(i, j)
+                           .Define(initToZero);
+    auto postProcessCKernel = Kernel("post")
+                                  .Inputs(C.GetValue())
+                                  .Indices(i, j)
+                                  .Define(addOne);
+
+    LoopNest loop({ { i, { 0, N } },
+                    { j, { 0, N } },
+                    { k, { 0, N } } });
+
+    CodePositionConstraints preConstraint{ LoopFragmentType::prologue, { i, j }, {} };
+    loop.AddKernel(initCKernel, preConstraint);
+    loop.AddKernel(innerKernel, LoopNest::ConstraintType::constraint);
+    CodePositionConstraints postConstraint{ LoopFragmentType::epilogue, { i, j }, {} };
+    loop.AddKernel(postProcessCKernel, postConstraint);
+
+    SplitAndSetOrder(loop, { i, j, k }, { 3 }, "ijijk");
+
+    LoopNestInterpreter interpreter(loop);
+    interpreter.Run();
+    interpreter.Run();
+
+    return C(1, 2) + C(2, 1) - (-191 + -107); // will return 0 if calculation is correct
+}
+
+// Test the interpreter with an alternate kernel that runs on the last iteration of an unevenly-split index
+Scalar LoopNestInterpreter_test2()
+{
+    const int n = 30;
+    std::vector<int> expectedValues(n);
+    for (int i = 0; i < n; ++i)
+    {
+        expectedValues[i] = i;
+    }
+    expectedValues[n - 1] = 1;
+    auto expected = Vector(expectedValues);
+
+    auto vector = MakeVector<int>(n);
+    Index i("i");
+    LoopNest loop({ { i, { 0, n } } });
+    loop.Split(i, 4);
+
+    auto kernel = Kernel("k", "k")
+                      .Inputs(vector.GetValue())
+                      .Indices(i)
+                      .Define(set_vector_kernel);
+
+    auto boundaryKernel = Kernel("boundary", "k")
+                              .Inputs(vector.GetValue())
+                              .Indices(i)
+                              .Define(increment_vector_kernel);
+
+    loop.AddKernel(boundaryKernel, { Last(i) });
+    loop.AddKernel(kernel, LoopNest::ConstraintType::predicate);
+
+    LoopNestInterpreter(loop).Run();
+
+    return VerifySame(vector, expected);
+}
 } // namespace ell
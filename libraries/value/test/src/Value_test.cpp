@@ -930,6 +930,41 @@ Scalar Parallelized_ComputeContext_test1()
     return ok;
 }
 
+Scalar Parallelized_ComputeContext_test2()
+{
+    constexpr int NumTasks = 8;
+    constexpr int DataPerTask = 3;
+    Scalar ok = Allocate(ValueType::Int32, ScalarLayout);
+    auto data = MakeVector<int>(NumTasks * DataPerTask);
+
+    // More tasks than pool threads, so workers have to pick up several tasks each
+    InvokeForContext<ComputeContext>([] { ComputeContext::SetNumParallelThreads(2); });
+    Parallelize(
+        NumTasks,
+        std::tuple{ data },
+        std::function<void(Scalar, Vector)>{ [&](Scalar id, Vector capturedData) {
+            ForRange(DataPerTask, [&](Scalar index) {
+                capturedData[id * DataPerTask + index] = id;
+            });
+        } });
+    InvokeForContext<ComputeContext>([] { ComputeContext::SetNumParallelThreads(0); });
+
+    auto expected = MakeVector<int>(data.Size());
+    for (auto task = 0; task < NumTasks; ++task)
+    {
+        for (auto dataIndex = 0; dataIndex < DataPerTask; ++dataIndex)
+        {
+            expected[task * DataPerTask + dataIndex] = task;
+        }
+    }
+
+    If(VerifySame(data, expected) != 0, [&] {
+        ok = 1;
+    });
+
+    return ok;
+}
+
 Scalar MemCopy_test1()
 {
     auto vec = MakeVector<int>(4);
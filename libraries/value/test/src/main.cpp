@@ -489,12 +489,17 @@ int main()
         ADD_TEST_FUNCTION(LoopNest_api_Parallelized_test1);
         ADD_TEST_FUNCTION(LoopNest_api_Parallelized_test2);
         ADD_TEST_FUNCTION(LoopNest_api_Unrolled_test1);
+        ADD_TEST_FUNCTION(LoopNest_api_Vectorized_Elementwise_test);
+        ADD_TEST_FUNCTION(LoopNest_api_Vectorized_GEMM_test);
+        ADD_TEST_FUNCTION(LoopNest_api_Prefetch_GEMM_test);
+        ADD_TEST_FUNCTION(LoopNest_api_Prefetch_AllKinds_test);
         ADD_TEST_FUNCTION(LoopNest_api_SetOrder_test1);
         // ADD_TEST_FUNCTION(LoopNest_api_CachedMatrix_test1); // Fails
         ADD_TEST_FUNCTION(GotoBLASGemmWithRefDeref);
         ADD_TEST_FUNCTION(YG12LowLevel_TestBoundary);
 
         ADD_TEST_FUNCTION(Parallelized_ComputeContext_test1);
+        ADD_TEST_FUNCTION(Parallelized_ComputeContext_test2);
 
         ADD_TEST_FUNCTION(MemCopy_test1);
         ADD_TEST_FUNCTION(MemSet_test1);
@@ -652,6 +657,8 @@ int main()
         ADD_TEST_FUNCTION(LoopNestFuse_test3);
         ADD_TEST_FUNCTION(ConvertedConstraint_test1);
         ADD_TEST_FUNCTION(ConvertedConstraint_test2);
+        ADD_TEST_FUNCTION(LoopNestInterpreter_test1);
+        ADD_TEST_FUNCTION(LoopNestInterpreter_test2);
 
         ADD_TEST_FUNCTION(FunctionPointer_test1);
 
@@ -660,6 +667,10 @@ int main()
             RunTest(name, fn);
         }
 
+        // Tests that inspect the emitted code instead of running it
+        LoopNest_api_Vectorized_IR_test();
+        LoopNest_api_Prefetch_Emitted_test();
+
 #undef ADD_TEST_FUNCTION
     }
     catch (const std::exception& exception)
@@ -35,6 +35,7 @@ struct CompileArguments
     bool outputCompiledMap = false;
     std::string outputDirectory;
     std::string outputFilenameBase;
+    std::string dispatchCpus;
     bool verbose = false;
 
     // model-generation options
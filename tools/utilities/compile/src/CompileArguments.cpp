@@ -91,6 +91,13 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Base filename for compiled model files (if none specified, use the input model filename)",
         "");
 
+    parser.AddOption(
+        dispatchCpus,
+        "dispatchCpus",
+        "",
+        "Comma-separated list of x86 CPUs to also compile the model for, in order of preference (e.g. 'skylake-avx512,haswell'). The compiled model picks the first one the machine it runs on supports, and falls back to the target CPU",
+        "");
+
     parser.AddDocumentationString("");
     parser.AddDocumentationString("Misc options");
     parser.AddOption(
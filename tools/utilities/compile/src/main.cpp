@@ -14,6 +14,8 @@
 #include <common/include/MapCompilerArguments.h>
 #include <common/include/MapLoadArguments.h>
 
+#include <emitters/include/IRCpuDispatch.h>
+
 #include <model/include/IRCompiledMap.h>
 #include <model/include/IRMapCompiler.h>
 #include <model/include/Map.h>
@@ -26,11 +28,14 @@
 #include <utilities/include/Exception.h>
 #include <utilities/include/Logger.h>
 #include <utilities/include/MillisecondTimer.h>
+#include <utilities/include/StringUtil.h>
 
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace ell;
 using namespace utilities::logging;
@@ -143,6 +148,35 @@ void ProduceMapOutput(ParsedCompileArguments& compileArguments, common::ParsedMa
     auto compiledMap = compiler.Compile(map);
     timer.Stop();
 
+    // Compile a version of the map for each CPU to dispatch to, and link them into the compiled map's module
+    std::vector<std::unique_ptr<model::IRMapCompiler>> cpuSpecificCompilers;
+    std::vector<std::unique_ptr<model::IRCompiledMap>> cpuSpecificMaps;
+    std::vector<emitters::IRModuleEmitter*> cpuSpecificModules;
+    for (const auto& cpu : utilities::Split(compileArguments.dispatchCpus, ','))
+    {
+        if (cpu.empty())
+        {
+            continue;
+        }
+
+        TimingOutputCollector timer(timingOutput, "Time to compile map for " + cpu, compileArguments.verbose);
+        auto cpuSettings = settings;
+        cpuSettings.compilerSettings.targetDevice = emitters::GetCpuSpecificTargetDevice(settings.compilerSettings.targetDevice, cpu);
+        cpuSettings.moduleName = emitters::GetCpuSpecificModuleName(settings.moduleName, cpu);
+        if (!settings.mapFunctionName.empty())
+        {
+            cpuSettings.mapFunctionName = emitters::GetCpuSpecificFunctionName(settings.mapFunctionName, settings.moduleName, cpu);
+        }
+        cpuSpecificCompilers.push_back(std::make_unique<model::IRMapCompiler>(cpuSettings, optimizerOptions));
+        cpuSpecificMaps.push_back(std::make_unique<model::IRCompiledMap>(cpuSpecificCompilers.back()->Compile(map)));
+        cpuSpecificModules.push_back(&cpuSpecificMaps.back()->GetModule());
+    }
+    if (!cpuSpecificModules.empty())
+    {
+        TimingOutputCollector timer(timingOutput, "Time to link CPU-specific maps", compileArguments.verbose);
+        emitters::LinkCpuSpecificModules(compiledMap.GetModule(), cpuSpecificModules);
+    }
+
     if (compileArguments.outputCompiledMap)
     {
         TimingOutputCollector timer(timingOutput, "Time to save compiled map", compileArguments.verbose);
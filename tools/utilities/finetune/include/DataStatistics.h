@@ -47,6 +47,9 @@ DataStatistics GetDataStatistics(const UnlabeledDataContainer& dataset);
 DataStatistics GetDataStatistics(const UnlabeledDataContainer& dataset, const ell::utilities::MemoryLayout& layout);
 DataStatistics GetDataStatistics(const UnlabeledDataContainer& dataset, const ell::utilities::MemoryLayout& layout, int dimension);
 
+/// <summary> Get the largest absolute value of any element in a data container </summary>
+double GetMaxAbsValue(const UnlabeledDataContainer& dataset);
+
 /// <summary> Get a version of a data container with its entries modified to match some given statistics. </summary>
 UnlabeledDataContainer GetNormalizedData(const UnlabeledDataContainer& dataset, const DataStatistics& stats);
 UnlabeledDataContainer GetNormalizedData(const UnlabeledDataContainer& dataset, const DataStatistics& stats, const ell::utilities::MemoryLayout& layout, int dimension);
@@ -96,6 +96,9 @@ struct FineTuneArguments
     double sparsityTarget = 0; // overrides l1 regularization if set
     double sparsityTargetEpsilon = 0.01;
 
+    // Quantization parameters
+    TargetNodeFlags quantizeTargets = TargetNodeType::none;
+
     // Misc
     std::string randomSeed;
     std::string reportFilename;
@@ -35,6 +35,7 @@ enum class FineTuneNodeAction
     finetune,
     sparsify,
     reoptimize,
+    quantize,
     none
 };
 
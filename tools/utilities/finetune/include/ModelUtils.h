@@ -34,7 +34,8 @@ enum class ConvolutionalNodeType
 {
     spatial,
     pointwise,
-    full
+    full,
+    grouped // grouped, but not depthwise-separable
 };
 
 /// <summary> Relevant convolutional parameters we need to pass around. </summary>
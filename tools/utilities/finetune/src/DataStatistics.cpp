@@ -18,6 +18,7 @@
 
 #include <utilities/include/ZipIterator.h>
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <numeric>
@@ -305,6 +306,16 @@ DataStatistics GetDataStatistics(const UnlabeledDataContainer& dataset, const el
     return result;
 }
 
+double GetMaxAbsValue(const UnlabeledDataContainer& dataset)
+{
+    double result = 0;
+    for (const auto& row : dataset)
+    {
+        result = std::max(result, static_cast<double>(row.NormInfinity()));
+    }
+    return result;
+}
+
 UnlabeledDataContainer GetNormalizedData(const UnlabeledDataContainer& dataset, const DataStatistics& stats)
 {
     ThrowIfEmpty(dataset);
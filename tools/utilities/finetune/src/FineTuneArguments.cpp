@@ -328,6 +328,20 @@ void InitArguments(utilities::CommandLineParser& parser, FineTuneArguments& args
 
     parser.AddOption(args.sparsifyMethod, "sparsifyMethod", "", "The method to use for sparsifying weights", { { "l1", SparsifyMethod::l1 }, { "threshold", SparsifyMethod::threshold }, { "random", SparsifyMethod::random } }, "l1");
 
+    parser.AddDocumentationString("");
+    parser.AddDocumentationString("Quantization parameters");
+    parser.AddOption(args.quantizeTargets,
+                     "quantize",
+                     "",
+                     "The types of nodes to replace with int8 versions, using activation ranges calibrated on the training data.",
+                     { { "none", TargetNodeType::none },
+                       { "pointwise", TargetNodeType::pointwiseConvolution },
+                       { "full", TargetNodeType::fullConvolution },
+                       { "dense", TargetNodeType::fullyConnected },
+                       { "pointwise+full", TargetNodeType::pointwiseConvolution | TargetNodeType::fullConvolution },
+                       { "pointwise+full+dense", TargetNodeType::pointwiseConvolution | TargetNodeType::fullConvolution | TargetNodeType::fullyConnected } },
+                     "none");
+
     parser.AddDocumentationString("");
     parser.AddDocumentationString("Misc parameters");
     parser.AddOption(args.randomSeed, "randomSeed", "seed", "The random seed string", "ABCDEFG");
@@ -23,6 +23,8 @@
 
 #include <nodes/include/ConvolutionalLayerNode.h>
 #include <nodes/include/FullyConnectedLayerNode.h>
+#include <nodes/include/QuantizedConvolutionNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 
 #include <utilities/include/Exception.h>
 #include <utilities/include/Files.h>
@@ -44,6 +46,7 @@ FineTuningLayerResult FineTuneLayer(ModelTransformer& transformer, const Node& n
 FineTuningLayerResult SparsifyLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, const FineTuneProblemParameters& optimizerParameters, ModelOutputDataCache& dataCache);
 
 FineTuningLayerResult RetrainLayer(ModelTransformer& transformer, const Node& node, FineTuneNodeAction action, MultiClassDataContainer& trainingData, const FineTuneProblemParameters& optimizerParameters, ModelOutputDataCache& dataCache);
+FineTuningLayerResult QuantizeLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache);
 
 template <typename ElementType>
 FineTuningLayerResult RetrainLayer(ModelTransformer& transformer, const Node& node, FineTuneNodeAction action, MultiClassDataContainer& trainingData, const FineTuneProblemParameters& optimizerParameters, ModelOutputDataCache& dataCache);
@@ -54,6 +57,15 @@ FineTuningLayerResult RetrainFullyConnectedLayer(ModelTransformer& transformer,
 template <typename ElementType>
 FineTuningLayerResult RetrainConvolutionalLayer(ModelTransformer& transformer, const Node& node, FineTuneNodeAction action, MultiClassDataContainer& trainingData, const FineTuneProblemParameters& optimizerParameters, ModelOutputDataCache& dataCache);
 
+template <typename ElementType>
+FineTuningLayerResult QuantizeLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache);
+
+template <typename ElementType>
+FineTuningLayerResult QuantizeFullyConnectedLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache);
+
+template <typename ElementType>
+FineTuningLayerResult QuantizeConvolutionalLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache);
+
 template <typename ElementType>
 const OutputPort<ElementType>& GetFeaturesPort(const UnlabeledDataContainer& imageFeatures, const OutputPort<ElementType>& rawFeatureOutput, bool normalize);
 
@@ -84,6 +96,7 @@ std::string ToString(FineTuneNodeAction action)
         ADD_TO_STRING_ENTRY(FineTuneNodeAction, finetune);
         ADD_TO_STRING_ENTRY(FineTuneNodeAction, sparsify);
         ADD_TO_STRING_ENTRY(FineTuneNodeAction, reoptimize);
+        ADD_TO_STRING_ENTRY(FineTuneNodeAction, quantize);
         ADD_TO_STRING_ENTRY(FineTuneNodeAction, none);
     default:
         throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Unknown node action type");
@@ -264,6 +277,10 @@ FineTuningResult FineTuneNodesInSubmodel(const Submodel& submodel,
             retrainingResult = SparsifyLayer(transformer, node, trainingData, problemParams, dataCache);
             didModifyAnyNodes = true;
             break;
+        case FineTuneNodeAction::quantize:
+            retrainingResult = QuantizeLayer(transformer, node, trainingData, dataCache);
+            didModifyAnyNodes = true;
+            break;
         default:
             transformer.CopyNode(node);
             return;
@@ -291,6 +308,8 @@ TargetNodeType GetConvNodeTargetType(const Node& node)
         return TargetNodeType::pointwiseConvolution;
     case ConvolutionalNodeType::spatial:
         return TargetNodeType::spatialConvolution;
+    case ConvolutionalNodeType::grouped:
+        return TargetNodeType::none;
     }
     return TargetNodeType::none;
 }
@@ -315,6 +334,21 @@ FineTuneNodeAction GetNodeAction(const Node& node, const FineTuneArguments& args
         return FineTuneNodeAction::none;
     }
 
+    // Grouped convolutions can't be quantized, and fine-tuning would retrain them as dense convolutions
+    if (IsConvolutionalLayerNode(&node) && GetConvolutionalNodeType(&node) == ConvolutionalNodeType::grouped)
+    {
+        using namespace logging;
+        Log() << "Copying grouped convolution node " << node.GetId() << " unchanged" << EOL;
+        return FineTuneNodeAction::copy;
+    }
+
+    // Quantizing replaces fine-tuning: layers that aren't quantized are copied unchanged
+    if (args.quantizeTargets.flags != static_cast<unsigned int>(TargetNodeType::none))
+    {
+        auto shouldQuantize = !args.SkipNode(node.GetId().ToString()) && (args.quantizeTargets & GetNodeTargetType(node));
+        return shouldQuantize ? FineTuneNodeAction::quantize : FineTuneNodeAction::none;
+    }
+
     if (args.SkipNode(node.GetId().ToString()))
     {
         using namespace logging;
@@ -446,6 +480,10 @@ FineTuningLayerResult RetrainConvolutionalLayer(ModelTransformer& transformer, c
 {
     // TODO: get input of submodel to retrain
     auto convolutionType = GetConvolutionalNodeType(&node);
+    if (convolutionType == ConvolutionalNodeType::grouped)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Can't fine-tune grouped convolutions");
+    }
     auto convNode = dynamic_cast<const nodes::ConvolutionalLayerNode<ElementType>*>(&node);
     const auto& convOutput = convNode->output;
     const auto& convLayer = convNode->GetLayer();
@@ -462,6 +500,144 @@ FineTuningLayerResult RetrainConvolutionalLayer(ModelTransformer& transformer, c
     return fineTunedOutput;
 }
 
+FineTuningLayerResult QuantizeLayer(ModelTransformer& transformer,
+                                    const Node& node,
+                                    MultiClassDataContainer& trainingData,
+                                    ModelOutputDataCache& dataCache)
+{
+    if (node.NumOutputPorts() != 1)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Unsupported node type");
+    }
+
+    switch (node.GetOutputPort(0)->GetType())
+    {
+    case model::Port::PortType::smallReal:
+        return QuantizeLayer<float>(transformer, node, trainingData, dataCache);
+        break;
+
+    case model::Port::PortType::real:
+        return QuantizeLayer<double>(transformer, node, trainingData, dataCache);
+        break;
+
+    default:
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Unsupported port type");
+    }
+}
+
+template <typename ElementType>
+FineTuningLayerResult QuantizeLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache)
+{
+    if (IsFullyConnectedLayerNode(&node))
+    {
+        return QuantizeFullyConnectedLayer<ElementType>(transformer, node, trainingData, dataCache);
+    }
+
+    if (GetConvolutionalNodeType(&node) == ConvolutionalNodeType::grouped)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Can't quantize grouped convolutions");
+    }
+    else if (IsConvolutionalLayerNode(&node))
+    {
+        return QuantizeConvolutionalLayer<ElementType>(transformer, node, trainingData, dataCache);
+    }
+    else
+    {
+        throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "attempting to quantize an unsupported layer type");
+    }
+}
+
+// Runs the training data through the original model and returns the data at the given port
+UnlabeledDataContainer GetActivations(const MultiClassDataContainer& trainingData, const OutputPortBase& port, ModelOutputDataCache& dataCache)
+{
+    Submodel submodel{ { &port } };
+    auto imageFeatures = GetDatasetInputs(trainingData);
+    return TransformDataWithSubmodel(imageFeatures, submodel, dataCache, true);
+}
+
+template <typename ElementType>
+ell::math::RowMatrix<ElementType> GetDequantizedWeights(const nodes::QuantizedWeights<ElementType>& weights)
+{
+    const auto numRows = weights.scales.size();
+    const auto numColumns = weights.values.size() / numRows;
+    ell::math::RowMatrix<ElementType> result(numRows, numColumns);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        for (size_t j = 0; j < numColumns; ++j)
+        {
+            result(i, j) = static_cast<ElementType>(weights.values[i * numColumns + j]) * weights.scales[i];
+        }
+    }
+    return result;
+}
+
+template <typename LayerNodeType, typename QuantizedNodeType>
+FineTuningLayerResult GetQuantizationResult(const LayerNodeType& layerNode, const QuantizedNodeType& quantizedNode, FineTuningStats stats, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache, std::chrono::milliseconds::rep dataTransformTime)
+{
+    stats.originalActivationStatistics = GetDataStatistics(GetActivations(trainingData, layerNode.output, dataCache));
+    stats.fineTunedActivationStatistics = GetDataStatistics(GetActivations(trainingData, quantizedNode.output, dataCache));
+    return FineTuningLayerResult{ true,
+                                  &layerNode.output,
+                                  &quantizedNode.output,
+                                  {},
+                                  stats,
+                                  dataTransformTime,
+                                  0 };
+}
+
+template <typename ElementType>
+FineTuningLayerResult QuantizeFullyConnectedLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache)
+{
+    using namespace logging;
+
+    auto fcNode = dynamic_cast<const nodes::FullyConnectedLayerNode<ElementType>*>(&node);
+    const auto& inputPort = fcNode->input.GetReferencedPort();
+
+    // Calibrate the input range on the original model
+    utilities::MillisecondTimer dataTransformTimer;
+    auto inputRange = static_cast<ElementType>(GetMaxAbsValue(GetActivations(trainingData, inputPort, dataCache)));
+    dataTransformTimer.Stop();
+    Log() << "Quantizing node " << node.GetId() << " with input range " << inputRange << EOL;
+
+    const auto& weights = fcNode->GetLayer().GetWeights();
+    const auto m = static_cast<int>(weights.NumRows());
+    const auto k = static_cast<int>(weights.NumColumns());
+    const auto& destination = transformer.GetCorrespondingOutputs(inputPort);
+    auto quantizedNode = transformer.AddNode<nodes::QuantizedMatrixMatrixMultiplyNode<ElementType>>(destination, m, 1, k, weights.ToArray(), inputRange, false, fcNode->GetOutputMemoryLayout());
+    transformer.MapNodeOutput(fcNode->output, quantizedNode->output);
+
+    FineTuningStats stats;
+    stats.originalWeightsStatistics = GetWeightsStatistics(weights);
+    stats.finalWeightsStatistics = GetWeightsStatistics(GetDequantizedWeights(quantizedNode->GetWeights()));
+    return GetQuantizationResult(*fcNode, *quantizedNode, stats, trainingData, dataCache, dataTransformTimer.Elapsed());
+}
+
+template <typename ElementType>
+FineTuningLayerResult QuantizeConvolutionalLayer(ModelTransformer& transformer, const Node& node, MultiClassDataContainer& trainingData, ModelOutputDataCache& dataCache)
+{
+    using namespace logging;
+
+    auto convNode = dynamic_cast<const nodes::ConvolutionalLayerNode<ElementType>*>(&node);
+    const auto& inputPort = convNode->input.GetReferencedPort();
+
+    // Calibrate the input range on the original model
+    utilities::MillisecondTimer dataTransformTimer;
+    auto inputRange = static_cast<ElementType>(GetMaxAbsValue(GetActivations(trainingData, inputPort, dataCache)));
+    dataTransformTimer.Stop();
+    Log() << "Quantizing node " << node.GetId() << " with input range " << inputRange << EOL;
+
+    const auto& convLayer = convNode->GetLayer();
+    const auto stride = static_cast<int>(convLayer.GetConvolutionalParameters().stride);
+    const auto& destination = transformer.GetCorrespondingOutputs(inputPort);
+    auto quantizedNode = transformer.AddNode<nodes::QuantizedConvolutionNode<ElementType>>(destination, convNode->GetInputMemoryLayout(), convNode->GetOutputMemoryLayout(), convLayer.GetWeights(), stride, inputRange);
+    transformer.MapNodeOutput(convNode->output, quantizedNode->output);
+
+    FineTuningStats stats;
+    stats.originalWeightsStatistics = GetWeightsStatistics<ElementType>(convLayer.GetWeights());
+    stats.finalWeightsStatistics = GetWeightsStatistics(GetDequantizedWeights(quantizedNode->GetWeights()));
+    return GetQuantizationResult(*convNode, *quantizedNode, stats, trainingData, dataCache, dataTransformTimer.Elapsed());
+}
+
 // TODO: rename this function to imply we're running an optimization
 template <typename ElementType, typename LayerParametersType>
 FineTuningLayerResult ApproximateSubmodelWithNewLayer(const MultiClassDataContainer& imageData,
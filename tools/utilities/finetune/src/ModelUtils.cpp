@@ -143,6 +143,10 @@ ConvolutionalNodeType GetConvolutionalNodeType(const Node* node)
     {
         return ConvolutionalNodeType::spatial;
     }
+    else if (convNode->GetLayer().NumGroups() > 1)
+    {
+        return ConvolutionalNodeType::grouped;
+    }
     else if (convNode->GetLayer().GetConvolutionalParameters().receptiveField == 1)
     {
         return ConvolutionalNodeType::pointwise;
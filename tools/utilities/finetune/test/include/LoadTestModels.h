@@ -25,3 +25,6 @@ ell::model::Model LoadTrivialConvolutionalModel();
 ell::model::Model LoadTrivialConvolutionalModel2();
 
 ell::model::Model GetNodeFindingTestModel();
+
+// A model with a full, a pointwise, a depthwise-separable and a grouped convolution, in that order
+ell::model::Model GetConvolutionTypesTestModel();
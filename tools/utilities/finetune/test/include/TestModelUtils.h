@@ -15,6 +15,7 @@ void TestModelUtils();
 void TestIsNeuralNetworkPredictorNode();
 void TestIsFullyConnectedLayerNode();
 void TestIsConvolutionalLayerNode();
+void TestGetConvolutionalNodeType();
 
 void TestAppendSinkNode();
 void TestAppendOutputWithSink();
@@ -60,7 +60,7 @@ const OutputPort<float>& AppendFullyConnectedNode(Model& model, const model::Out
     return newNode->output;
 }
 
-predictors::neural::ConvolutionalLayer<float> CreateConvolutionalLayer(const utilities::MemoryShape& inputShape, int filterSize, int numFilters)
+predictors::neural::ConvolutionalLayer<float> CreateConvolutionalLayer(const utilities::MemoryShape& inputShape, int filterSize, int numFilters, int numGroups = 1)
 {
     const auto numRows = inputShape[0];
     const auto numColumns = inputShape[1];
@@ -75,13 +75,13 @@ predictors::neural::ConvolutionalLayer<float> CreateConvolutionalLayer(const uti
     typename predictors::neural::Layer<float>::ConstTensorReferenceType inputTensorPlaceholderRef(inputTensorPlaceholder);
     typename predictors::neural::Layer<float>::LayerParameters layerParams{ inputTensorPlaceholderRef, predictors::neural::NoPadding(), { static_cast<size_t>(numOutputRows), static_cast<size_t>(numOutputColumns), static_cast<size_t>(numOutputChannels) }, predictors::neural::NoPadding() };
     predictors::neural::ConvolutionalParameters convParams{ static_cast<size_t>(filterSize), static_cast<size_t>(stride), predictors::neural::ConvolutionMethod::automatic, 1 };
-    math::ChannelColumnRowTensor<float> weightsTensor(static_cast<size_t>(numOutputChannels * filterSize), static_cast<size_t>(filterSize), numChannels);
+    math::ChannelColumnRowTensor<float> weightsTensor(static_cast<size_t>(numOutputChannels * filterSize), static_cast<size_t>(filterSize), numChannels / numGroups);
     return { layerParams, convParams, weightsTensor };
 }
 
-const OutputPort<float>& AppendConvolutionalNode(Model& model, const model::OutputPort<float>& input, int filterSize, int numFilters)
+const OutputPort<float>& AppendConvolutionalNode(Model& model, const model::OutputPort<float>& input, int filterSize, int numFilters, int numGroups = 1)
 {
-    auto newLayer = CreateConvolutionalLayer(input.GetMemoryLayout().GetActiveSize(), filterSize, numFilters);
+    auto newLayer = CreateConvolutionalLayer(input.GetMemoryLayout().GetActiveSize(), filterSize, numFilters, numGroups);
     auto newNode = model.AddNode<nodes::ConvolutionalLayerNode<float>>(input, newLayer);
     return newNode->output;
 }
@@ -185,3 +185,18 @@ Model GetNodeFindingTestModel()
     model::Output(fc);
     return model;
 }
+
+Model GetConvolutionTypesTestModel()
+{
+    Model model;
+    const utilities::MemoryShape inputShape{ 12, 12, 4 };
+    const int numFilters = 4;
+
+    const auto& in = model::Input<float>(model, inputShape);
+    const auto& full = AppendConvolutionalNode(model, in, 3, numFilters);
+    const auto& pointwise = AppendConvolutionalNode(model, full, 1, numFilters);
+    const auto& depthwise = AppendConvolutionalNode(model, pointwise, 3, numFilters, numFilters);
+    const auto& grouped = AppendConvolutionalNode(model, depthwise, 3, numFilters, 2);
+    model::Output(grouped);
+    return model;
+}
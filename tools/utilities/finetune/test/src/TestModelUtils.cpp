@@ -18,6 +18,7 @@
 #include <testing/include/testing.h>
 
 #include <functional>
+#include <vector>
 
 using namespace ell;
 using namespace ell::model;
@@ -47,6 +48,7 @@ void TestModelUtils()
 
     FailOnException(TestIsFullyConnectedLayerNode);
     FailOnException(TestIsConvolutionalLayerNode);
+    FailOnException(TestGetConvolutionalNodeType);
 
     NoFailOnUnimplemented(TestAppendSinkNode);
     NoFailOnUnimplemented(TestAppendOutputWithSink);
@@ -75,6 +77,24 @@ void TestIsConvolutionalLayerNode()
     ProcessTest("TestIsConvolutionalLayerNode", CheckNodes(model, 1, [](const Node* node) { return IsConvolutionalLayerNode(node); }));
 }
 
+void TestGetConvolutionalNodeType()
+{
+    auto model = GetConvolutionTypesTestModel();
+    std::vector<ConvolutionalNodeType> types;
+    auto it = model.GetNodeIterator();
+    while (it.IsValid())
+    {
+        if (IsConvolutionalLayerNode(it.Get()))
+        {
+            types.push_back(GetConvolutionalNodeType(it.Get()));
+        }
+        it.Next();
+    }
+
+    std::vector<ConvolutionalNodeType> expected = { ConvolutionalNodeType::full, ConvolutionalNodeType::pointwise, ConvolutionalNodeType::spatial, ConvolutionalNodeType::grouped };
+    ProcessTest("TestGetConvolutionalNodeType", types == expected);
+}
+
 // Appending nodes or whatnot to models
 void TestAppendSinkNode()
 {
@@ -22,3 +22,4 @@ ell::model::Model GenerateModel2();
 ell::model::Model GenerateModel3();
 ell::model::Model GenerateTreeModel(size_t numSplits);
 ell::model::Model GenerateRefinedTreeModel(size_t numSplits);
+ell::model::Model GenerateDeepModel(size_t numLayers, size_t dimension);
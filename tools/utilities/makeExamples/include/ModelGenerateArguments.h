@@ -23,6 +23,12 @@ struct ModelGenerateArguments
     };
     OutputType outputType;
     std::string outputPath;
+
+    /// <summary> Instead of saving the models, time compiling them serially and in parallel segments. </summary>
+    bool timeCompile = false;
+
+    /// <summary> The number of segments to split each model into when timing parallel compilation. </summary>
+    int numCompileSegments = 0;
 };
 
 /// <summary> A version of ModelGenerateArguments that adds its members to the command line parser. </summary>
@@ -209,6 +209,21 @@ model::Model GenerateRefinedTreeModel(size_t numSplits)
     return t.TransformModel(model, transformer, context);
 }
 
+model::Model GenerateDeepModel(size_t numLayers, size_t dimension)
+{
+    // A long chain of elementwise scale-and-shift layers, large enough that compiling it takes a noticeable time
+    model::Model model;
+    const model::OutputPort<double>* layer = &model::Input<double>(model, dimension);
+    for (size_t index = 0; index < numLayers; ++index)
+    {
+        const auto& scale = nodes::Constant(model, std::vector<double>(dimension, 1.0 + 0.001 * index));
+        const auto& shift = nodes::Constant(model, std::vector<double>(dimension, 0.01 * index));
+        layer = &nodes::Add(nodes::Multiply(*layer, scale), shift);
+    }
+    model::Output(*layer);
+    return model;
+}
+
 // explicit instantiations
 template model::Model GenerateBroadcastTimesTwoModel<int>(size_t dimension);
 
@@ -26,5 +26,19 @@ void ParsedModelGenerateArguments::AddArgs(utilities::CommandLineParser& parser)
         "p",
         "The output path",
         "");
+
+    parser.AddOption(
+        timeCompile,
+        "timeCompile",
+        "",
+        "Report the wall time taken to compile each model, serially and split into segments compiled in parallel",
+        false);
+
+    parser.AddOption(
+        numCompileSegments,
+        "numCompileSegments",
+        "",
+        "The number of segments to split each model into when timing parallel compilation (0 for the number of hardware threads)",
+        0);
 }
 } // namespace ell
@@ -11,10 +11,23 @@
 
 #include <common/include/LoadModel.h>
 
+#include <model/include/InputNodeBase.h>
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/Map.h>
+#include <model/include/OutputNodeBase.h>
+#include <model/include/ParallelMapCompiler.h>
+
 #include <utilities/include/CommandLineParser.h>
 #include <utilities/include/Files.h>
+#include <utilities/include/MillisecondTimer.h>
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace ell;
 
@@ -51,6 +64,84 @@ void SaveModels(const std::string& ext, std::string outputPath)
     common::SaveModel(GenerateBroadcastTimesTwoModel<float>(256), outputPath + "/broadcast_times_two." + ext);
 }
 
+// Wraps a generated model in a map. Models without an output node use the output of their last node.
+model::Map GetExampleMap(model::Model& model)
+{
+    auto inputNode = model.GetNodesByType<model::InputNodeBase>()[0];
+    auto outputNodes = model.GetNodesByType<model::OutputNodeBase>();
+    const model::OutputPortBase* output = nullptr;
+    if (!outputNodes.empty())
+    {
+        output = &outputNodes[0]->GetOutputPort();
+    }
+    else
+    {
+        model.Visit([&output](const model::Node& node) {
+            if (!node.GetOutputPorts().empty())
+            {
+                output = node.GetOutputPorts()[0];
+            }
+        });
+    }
+    return model::Map(model, { { "input", inputNode } }, { { "output", *output } });
+}
+
+void TimeCompile(int numSegments)
+{
+    if (numSegments <= 0)
+    {
+        numSegments = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    std::vector<std::pair<std::string, model::Model>> models;
+    models.emplace_back("times_two", GenerateTimesTwoModel(3));
+    models.emplace_back("multi_out", GenerateMultiOutModel(3));
+    models.emplace_back("model_1", GenerateModel1());
+    models.emplace_back("model_2", GenerateModel2());
+    models.emplace_back("model_3", GenerateModel3());
+    models.emplace_back("refined_tree_3", GenerateRefinedTreeModel(3));
+    models.emplace_back("broadcast_times_two", GenerateBroadcastTimesTwoModel<float>(256));
+    models.emplace_back("deep_100", GenerateDeepModel(100, 256));
+    models.emplace_back("deep_400", GenerateDeepModel(400, 256));
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    std::cout << std::left << std::setw(24) << "model" << std::setw(12) << "serial ms" << "parallel ms (segments)" << std::endl;
+    for (auto& entry : models)
+    {
+        auto map = GetExampleMap(entry.second);
+
+        utilities::MillisecondTimer timer;
+        {
+            settings.moduleName = entry.first;
+            model::IRMapCompiler compiler(settings, optimizerOptions);
+            auto compiledMap = compiler.Compile(map);
+            compiledMap.FinishJitting();
+        }
+        auto serialTime = timer.Elapsed();
+
+        // Small models can't always be split into as many segments as requested
+        std::cout << std::setw(24) << entry.first << std::setw(12) << serialTime;
+        bool split = false;
+        for (auto segments = numSegments; segments > 1 && !split; --segments)
+        {
+            try
+            {
+                timer.Reset();
+                model::SegmentedCompiledMap compiledMap(map, segments, settings, optimizerOptions);
+                std::cout << timer.Elapsed() << " (" << segments << ")";
+                split = true;
+            }
+            catch (const utilities::InputException& exception)
+            {
+                // SplitMapIntoStages throws when there aren't enough places to cut the map, so try fewer segments
+                std::cerr << "Couldn't split " << entry.first << " into " << segments << " segments: " << exception.GetMessage() << std::endl;
+            }
+        }
+        std::cout << (split ? "" : "-") << std::endl;
+    }
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -66,6 +157,12 @@ int main(int argc, char* argv[])
         // parse command line
         commandLineParser.Parse();
 
+        if (arguments.timeCompile)
+        {
+            TimeCompile(arguments.numCompileSegments);
+            return 0;
+        }
+
         // generate models
         SaveModels("model", arguments.outputPath);
     }
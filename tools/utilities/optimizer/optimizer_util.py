@@ -28,6 +28,7 @@ class ConvolutionMethod(Enum):
     Simple = "simple"
     Unrolled = "unrolled"
     Winograd = "winograd"
+    Tiled = "tiled"
 
 
 class WinogradConfiguration:
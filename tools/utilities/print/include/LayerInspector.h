@@ -63,6 +63,8 @@ static std::string ConvolutionMethodToString(ell::predictors::neural::Convolutio
         return "winograd";
     case ell::predictors::neural::ConvolutionMethod::unrolled:
         return "unrolled";
+    case ell::predictors::neural::ConvolutionMethod::tiled:
+        return "tiled";
     }
     return "";
 }